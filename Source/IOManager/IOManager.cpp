@@ -1,6 +1,6 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "IOManager.h"
-#include "Modules/ModuleManager.h"
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "IOManager.h"
+#include "Modules/ModuleManager.h"
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, IOManager, "IOManager" );
\ No newline at end of file
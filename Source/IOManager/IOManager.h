@@ -1,5 +1,5 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
 #include "CoreMinimal.h"
\ No newline at end of file
@@ -1,229 +1,502 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#include "Core/IOM_PlayerController.h"
-
-#include "EnhancedInputComponent.h"
-#include "EnhancedInputSubsystems.h"
-#include "GameFramework/Pawn.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
-
-AIOM_PlayerController::AIOM_PlayerController()
-{
-    bIsNavigationModeActive = false;
-
-    bShowMouseCursor = true;
-    bEnableClickEvents = true;
-    bEnableMouseOverEvents = true;
-}
-
-void AIOM_PlayerController::BeginPlay()
-{
-    Super::BeginPlay();
-
-    // Register the default mapping context with the local player subsystem.
-    if (ULocalPlayer* LocalPlayer = GetLocalPlayer())
-    {
-        if (UEnhancedInputLocalPlayerSubsystem* Subsystem = LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>())
-        {
-            if (DefaultMappingContext != nullptr)
-            {
-                Subsystem->AddMappingContext(DefaultMappingContext, 0);
-            }
-        }
-    }
-
-    // Start in UI mode so that the player can interact with widgets immediately.
-    EnterUiMode();
-}
-
-void AIOM_PlayerController::SetupInputComponent()
-{
-    Super::SetupInputComponent();
-
-    UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(InputComponent);
-    if (EnhancedInputComponent == nullptr)
-    {
-        return;
-    }
-
-    // Navigation mode toggle (for example, right mouse button hold).
-    if (NavigationModeAction != nullptr)
-    {
-        EnhancedInputComponent->BindAction(
-            NavigationModeAction,
-            ETriggerEvent::Started,
-            this,
-            &AIOM_PlayerController::OnNavigationModeStarted
-        );
-
-        EnhancedInputComponent->BindAction(
-            NavigationModeAction,
-            ETriggerEvent::Completed,
-            this,
-            &AIOM_PlayerController::OnNavigationModeCompleted
-        );
-    }
-
-    // Movement input.
-    if (MoveAction != nullptr)
-    {
-        EnhancedInputComponent->BindAction(
-            MoveAction,
-            ETriggerEvent::Triggered,
-            this,
-            &AIOM_PlayerController::HandleMoveInput
-        );
-    }
-
-    // Vertical movement input (for example Q and E).
-    if (VerticalMoveAction != nullptr)
-    {
-        EnhancedInputComponent->BindAction(
-            VerticalMoveAction,
-            ETriggerEvent::Triggered,
-            this,
-            &AIOM_PlayerController::HandleVerticalMoveInput
-        );
-    }
-
-    // Look input.
-    if (LookAction != nullptr)
-    {
-        EnhancedInputComponent->BindAction(
-            LookAction,
-            ETriggerEvent::Triggered,
-            this,
-            &AIOM_PlayerController::HandleLookInput
-        );
-    }
-
-    // Exit game input (for example Escape key).
-    if (ExitGameAction != nullptr)
-    {
-        EnhancedInputComponent->BindAction(
-            ExitGameAction,
-            ETriggerEvent::Started,
-            this,
-            &AIOM_PlayerController::HandleExitRequested
-        );
-    }
-}
-
-void AIOM_PlayerController::OnNavigationModeStarted(const FInputActionValue& ActionValue)
-{
-    bIsNavigationModeActive = true;
-    EnterNavigationMode();
-}
-
-void AIOM_PlayerController::OnNavigationModeCompleted(const FInputActionValue& ActionValue)
-{
-    bIsNavigationModeActive = false;
-    EnterUiMode();
-}
-
-void AIOM_PlayerController::HandleMoveInput(const FInputActionValue& ActionValue)
-{
-    if (!bIsNavigationModeActive)
-    {
-        return;
-    }
-
-    const FVector2D MovementVector = ActionValue.Get<FVector2D>();
-
-    APawn* ControlledPawn = GetPawn();
-    if (ControlledPawn == nullptr)
-    {
-        return;
-    }
-
-    const FRotator CurrentControlRotation = GetControlRotation();
-
-    const FVector ForwardDirection = UKismetMathLibrary::GetForwardVector(CurrentControlRotation);
-    const FVector RightDirection = UKismetMathLibrary::GetRightVector(CurrentControlRotation);
-
-    if (!MovementVector.IsNearlyZero())
-    {
-        if (!FMath::IsNearlyZero(MovementVector.Y))
-        {
-            ControlledPawn->AddMovementInput(ForwardDirection, MovementVector.Y);
-        }
-
-        if (!FMath::IsNearlyZero(MovementVector.X))
-        {
-            ControlledPawn->AddMovementInput(RightDirection, MovementVector.X);
-        }
-    }
-}
-
-void AIOM_PlayerController::HandleLookInput(const FInputActionValue& ActionValue)
-{
-    if (!bIsNavigationModeActive)
-    {
-        return;
-    }
-
-    const FVector2D LookAxisValue = ActionValue.Get<FVector2D>();
-
-    if (!LookAxisValue.IsNearlyZero())
-    {
-        AddYawInput(LookAxisValue.X);
-        AddPitchInput(LookAxisValue.Y);
-    }
-}
-
-void AIOM_PlayerController::HandleVerticalMoveInput(const FInputActionValue& ActionValue)
-{
-    if (!bIsNavigationModeActive)
-    {
-        return;
-    }
-
-    const float AxisValue = ActionValue.Get<float>();
-    if (FMath::IsNearlyZero(AxisValue))
-    {
-        return;
-    }
-
-    APawn* ControlledPawn = GetPawn();
-    if (ControlledPawn == nullptr)
-    {
-        return;
-    }
-
-    const FVector UpDirection = FVector::UpVector;
-    ControlledPawn->AddMovementInput(UpDirection, AxisValue);
-}
-
-void AIOM_PlayerController::HandleExitRequested(const FInputActionValue& ActionValue)
-{
-    UWorld* World = GetWorld();
-    if (World == nullptr)
-    {
-        return;
-    }
-
-    UKismetSystemLibrary::QuitGame(
-        World,
-        this,
-        EQuitPreference::Quit,
-        false
-    );
-}
-
-void AIOM_PlayerController::EnterNavigationMode()
-{
-    bShowMouseCursor = false;
-
-    FInputModeGameOnly InputMode;
-    SetInputMode(InputMode);
-}
-
-void AIOM_PlayerController::EnterUiMode()
-{
-    bShowMouseCursor = true;
-
-    FInputModeGameAndUI InputMode;
-    InputMode.SetHideCursorDuringCapture(false);
-    SetInputMode(InputMode);
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Core/IOM_PlayerController.h"
+
+#include "Subsystems/InteractiveObjectManagerSubsystem.h"
+
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "InputCoreTypes.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "SceneView.h"
+
+AIOM_PlayerController::AIOM_PlayerController()
+{
+    bIsNavigationModeActive = false;
+    MaxSelectionDistance = 100000.0f;
+    MarqueeDragThreshold = 5.0f;
+    bIsSelectPressed = false;
+    SelectPressPosition = FVector2D::ZeroVector;
+
+    bShowMouseCursor = true;
+    bEnableClickEvents = true;
+    bEnableMouseOverEvents = true;
+}
+
+void AIOM_PlayerController::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Register the default mapping context with the local player subsystem.
+    if (ULocalPlayer* LocalPlayer = GetLocalPlayer())
+    {
+        if (UEnhancedInputLocalPlayerSubsystem* Subsystem = LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>())
+        {
+            if (DefaultMappingContext != nullptr)
+            {
+                Subsystem->AddMappingContext(DefaultMappingContext, 0);
+            }
+        }
+    }
+
+    // Start in UI mode so that the player can interact with widgets immediately.
+    EnterUiMode();
+}
+
+void AIOM_PlayerController::SetupInputComponent()
+{
+    Super::SetupInputComponent();
+
+    UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(InputComponent);
+    if (EnhancedInputComponent == nullptr)
+    {
+        return;
+    }
+
+    // Navigation mode toggle (for example, right mouse button hold).
+    if (NavigationModeAction != nullptr)
+    {
+        EnhancedInputComponent->BindAction(
+            NavigationModeAction,
+            ETriggerEvent::Started,
+            this,
+            &AIOM_PlayerController::OnNavigationModeStarted
+        );
+
+        EnhancedInputComponent->BindAction(
+            NavigationModeAction,
+            ETriggerEvent::Completed,
+            this,
+            &AIOM_PlayerController::OnNavigationModeCompleted
+        );
+    }
+
+    // Movement input.
+    if (MoveAction != nullptr)
+    {
+        EnhancedInputComponent->BindAction(
+            MoveAction,
+            ETriggerEvent::Triggered,
+            this,
+            &AIOM_PlayerController::HandleMoveInput
+        );
+    }
+
+    // Vertical movement input (for example Q and E).
+    if (VerticalMoveAction != nullptr)
+    {
+        EnhancedInputComponent->BindAction(
+            VerticalMoveAction,
+            ETriggerEvent::Triggered,
+            this,
+            &AIOM_PlayerController::HandleVerticalMoveInput
+        );
+    }
+
+    // Look input.
+    if (LookAction != nullptr)
+    {
+        EnhancedInputComponent->BindAction(
+            LookAction,
+            ETriggerEvent::Triggered,
+            this,
+            &AIOM_PlayerController::HandleLookInput
+        );
+    }
+
+    // Exit game input (for example Escape key).
+    if (ExitGameAction != nullptr)
+    {
+        EnhancedInputComponent->BindAction(
+            ExitGameAction,
+            ETriggerEvent::Started,
+            this,
+            &AIOM_PlayerController::HandleExitRequested
+        );
+    }
+
+    // Click selection (for example left mouse button).
+    if (SelectAction != nullptr)
+    {
+        EnhancedInputComponent->BindAction(
+            SelectAction,
+            ETriggerEvent::Started,
+            this,
+            &AIOM_PlayerController::HandleSelectStarted
+        );
+
+        EnhancedInputComponent->BindAction(
+            SelectAction,
+            ETriggerEvent::Completed,
+            this,
+            &AIOM_PlayerController::HandleSelectCompleted
+        );
+    }
+    else
+    {
+        EnhancedInputComponent->BindKey(
+            EKeys::LeftMouseButton,
+            IE_Pressed,
+            this,
+            &AIOM_PlayerController::HandleSelectKeyPressed
+        );
+
+        EnhancedInputComponent->BindKey(
+            EKeys::LeftMouseButton,
+            IE_Released,
+            this,
+            &AIOM_PlayerController::HandleSelectKeyReleased
+        );
+    }
+
+    // Undo and redo of object operations.
+    EnhancedInputComponent->BindKey(
+        FInputChord(EKeys::Z, false, true, false, false),
+        IE_Pressed,
+        this,
+        &AIOM_PlayerController::HandleUndoRequested
+    );
+
+    EnhancedInputComponent->BindKey(
+        FInputChord(EKeys::Y, false, true, false, false),
+        IE_Pressed,
+        this,
+        &AIOM_PlayerController::HandleRedoRequested
+    );
+
+    EnhancedInputComponent->BindKey(
+        FInputChord(EKeys::Z, true, true, false, false),
+        IE_Pressed,
+        this,
+        &AIOM_PlayerController::HandleRedoRequested
+    );
+}
+
+void AIOM_PlayerController::OnNavigationModeStarted(const FInputActionValue& ActionValue)
+{
+    bIsNavigationModeActive = true;
+    bIsSelectPressed = false;
+    EnterNavigationMode();
+}
+
+void AIOM_PlayerController::OnNavigationModeCompleted(const FInputActionValue& ActionValue)
+{
+    bIsNavigationModeActive = false;
+    EnterUiMode();
+}
+
+void AIOM_PlayerController::HandleMoveInput(const FInputActionValue& ActionValue)
+{
+    if (!bIsNavigationModeActive)
+    {
+        return;
+    }
+
+    const FVector2D MovementVector = ActionValue.Get<FVector2D>();
+
+    APawn* ControlledPawn = GetPawn();
+    if (ControlledPawn == nullptr)
+    {
+        return;
+    }
+
+    const FRotator CurrentControlRotation = GetControlRotation();
+
+    const FVector ForwardDirection = UKismetMathLibrary::GetForwardVector(CurrentControlRotation);
+    const FVector RightDirection = UKismetMathLibrary::GetRightVector(CurrentControlRotation);
+
+    if (!MovementVector.IsNearlyZero())
+    {
+        if (!FMath::IsNearlyZero(MovementVector.Y))
+        {
+            ControlledPawn->AddMovementInput(ForwardDirection, MovementVector.Y);
+        }
+
+        if (!FMath::IsNearlyZero(MovementVector.X))
+        {
+            ControlledPawn->AddMovementInput(RightDirection, MovementVector.X);
+        }
+    }
+}
+
+void AIOM_PlayerController::HandleLookInput(const FInputActionValue& ActionValue)
+{
+    if (!bIsNavigationModeActive)
+    {
+        return;
+    }
+
+    const FVector2D LookAxisValue = ActionValue.Get<FVector2D>();
+
+    if (!LookAxisValue.IsNearlyZero())
+    {
+        AddYawInput(LookAxisValue.X);
+        AddPitchInput(LookAxisValue.Y);
+    }
+}
+
+void AIOM_PlayerController::HandleVerticalMoveInput(const FInputActionValue& ActionValue)
+{
+    if (!bIsNavigationModeActive)
+    {
+        return;
+    }
+
+    const float AxisValue = ActionValue.Get<float>();
+    if (FMath::IsNearlyZero(AxisValue))
+    {
+        return;
+    }
+
+    APawn* ControlledPawn = GetPawn();
+    if (ControlledPawn == nullptr)
+    {
+        return;
+    }
+
+    const FVector UpDirection = FVector::UpVector;
+    ControlledPawn->AddMovementInput(UpDirection, AxisValue);
+}
+
+void AIOM_PlayerController::HandleExitRequested(const FInputActionValue& ActionValue)
+{
+    UWorld* World = GetWorld();
+    if (World == nullptr)
+    {
+        return;
+    }
+
+    UKismetSystemLibrary::QuitGame(
+        World,
+        this,
+        EQuitPreference::Quit,
+        false
+    );
+}
+
+bool AIOM_PlayerController::GetActiveMarqueeRect(FVector2D& OutStart, FVector2D& OutEnd) const
+{
+    if (!bIsSelectPressed)
+    {
+        return false;
+    }
+
+    float MouseX = 0.0f;
+    float MouseY = 0.0f;
+    if (!GetMousePosition(MouseX, MouseY))
+    {
+        return false;
+    }
+
+    const FVector2D MousePosition(MouseX, MouseY);
+    if (FVector2D::Distance(SelectPressPosition, MousePosition) < MarqueeDragThreshold)
+    {
+        return false;
+    }
+
+    OutStart = SelectPressPosition;
+    OutEnd = MousePosition;
+    return true;
+}
+
+void AIOM_PlayerController::HandleSelectStarted(const FInputActionValue& ActionValue)
+{
+    BeginSelectPress();
+}
+
+void AIOM_PlayerController::HandleSelectCompleted(const FInputActionValue& ActionValue)
+{
+    EndSelectPress();
+}
+
+void AIOM_PlayerController::HandleSelectKeyPressed()
+{
+    BeginSelectPress();
+}
+
+void AIOM_PlayerController::HandleSelectKeyReleased()
+{
+    EndSelectPress();
+}
+
+void AIOM_PlayerController::HandleUndoRequested()
+{
+    if (UWorld* World = GetWorld())
+    {
+        if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            ManagerSubsystem->UndoLastOperation();
+        }
+    }
+}
+
+void AIOM_PlayerController::HandleRedoRequested()
+{
+    if (UWorld* World = GetWorld())
+    {
+        if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            ManagerSubsystem->RedoLastOperation();
+        }
+    }
+}
+
+void AIOM_PlayerController::BeginSelectPress()
+{
+    if (bIsNavigationModeActive)
+    {
+        return;
+    }
+
+    float MouseX = 0.0f;
+    float MouseY = 0.0f;
+    if (!GetMousePosition(MouseX, MouseY))
+    {
+        return;
+    }
+
+    SelectPressPosition = FVector2D(MouseX, MouseY);
+    bIsSelectPressed = true;
+}
+
+void AIOM_PlayerController::EndSelectPress()
+{
+    if (!bIsSelectPressed)
+    {
+        return;
+    }
+
+    bIsSelectPressed = false;
+
+    if (bIsNavigationModeActive)
+    {
+        return;
+    }
+
+    float MouseX = 0.0f;
+    float MouseY = 0.0f;
+    if (!GetMousePosition(MouseX, MouseY))
+    {
+        return;
+    }
+
+    const FVector2D ReleasePosition(MouseX, MouseY);
+    if (FVector2D::Distance(SelectPressPosition, ReleasePosition) < MarqueeDragThreshold)
+    {
+        SelectObjectUnderCursor();
+        return;
+    }
+
+    SelectObjectsInMarquee(SelectPressPosition, ReleasePosition);
+}
+
+void AIOM_PlayerController::SelectObjectUnderCursor()
+{
+    if (bIsNavigationModeActive)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    if (World == nullptr)
+    {
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>();
+    if (ManagerSubsystem == nullptr)
+    {
+        return;
+    }
+
+    FVector RayOrigin;
+    FVector RayDirection;
+    if (!DeprojectMousePositionToWorld(RayOrigin, RayDirection))
+    {
+        return;
+    }
+
+    float HitDistance = 0.0f;
+    const FInteractiveObjectHandle HitHandle = ManagerSubsystem->QueryObjectAlongRay(RayOrigin, RayDirection, MaxSelectionDistance, HitDistance);
+
+    const bool bIsShiftDown = IsInputKeyDown(EKeys::LeftShift) || IsInputKeyDown(EKeys::RightShift);
+
+    if (!HitHandle.IsSet())
+    {
+        if (!bIsShiftDown)
+        {
+            ManagerSubsystem->ClearSelection();
+        }
+        return;
+    }
+
+    if (bIsShiftDown)
+    {
+        ManagerSubsystem->ToggleObjectSelection(HitHandle);
+        return;
+    }
+
+    ManagerSubsystem->SelectObjectById(ManagerSubsystem->GetObjectIdForHandle(HitHandle));
+}
+
+void AIOM_PlayerController::SelectObjectsInMarquee(const FVector2D& RectStart, const FVector2D& RectEnd)
+{
+    UWorld* World = GetWorld();
+    if (World == nullptr)
+    {
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>();
+    if (ManagerSubsystem == nullptr)
+    {
+        return;
+    }
+
+    ULocalPlayer* LocalPlayer = GetLocalPlayer();
+    if (LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr)
+    {
+        return;
+    }
+
+    FSceneViewProjectionData ProjectionData;
+    if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+    {
+        return;
+    }
+
+    TArray<FInteractiveObjectHandle> HandlesInRect;
+    ManagerSubsystem->QueryObjectsInScreenRect(
+        ProjectionData.ComputeViewProjectionMatrix(),
+        ProjectionData.GetConstrainedViewRect(),
+        RectStart,
+        RectEnd,
+        HandlesInRect
+    );
+
+    // An empty rectangle clears the selection unless Shift is held, like a click on empty space.
+    const bool bIsShiftDown = IsInputKeyDown(EKeys::LeftShift) || IsInputKeyDown(EKeys::RightShift);
+    ManagerSubsystem->SelectObjects(HandlesInRect, bIsShiftDown);
+}
+
+void AIOM_PlayerController::EnterNavigationMode()
+{
+    bShowMouseCursor = false;
+
+    FInputModeGameOnly InputMode;
+    SetInputMode(InputMode);
+}
+
+void AIOM_PlayerController::EnterUiMode()
+{
+    bShowMouseCursor = true;
+
+    FInputModeGameAndUI InputMode;
+    InputMode.SetHideCursorDuringCapture(false);
+    SetInputMode(InputMode);
 }
\ No newline at end of file
@@ -1,106 +1,178 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/PlayerController.h"
-#include "InputActionValue.h"
-#include "IOM_PlayerController.generated.h"
-
-class UInputMappingContext;
-class UInputAction;
-
-/**
- * Player controller for the Interactive Object Manager demo level.
- *
- * Responsibilities:
- * - Switch between navigation mode (fly around the level) and UI interaction mode.
- * - Route Enhanced Input actions to pawn movement and camera look.
- *
- * Navigation mode:
- * - Active while the navigation action (for example, right mouse button) is held.
- * - Mouse cursor is hidden.
- * - Input mode is GameOnly.
- * - WASD (and other configured keys) move the pawn, mouse controls the camera.
- *
- * UI mode:
- * - Active when navigation is not held.
- * - Mouse cursor is visible.
- * - Input mode is GameAndUI.
- * - Movement and look input are ignored.
- */
-UCLASS()
-class AIOM_PlayerController : public APlayerController
-{
-    GENERATED_BODY()
-
-public:
-    AIOM_PlayerController();
-
-protected:
-    // APlayerController interface
-    virtual void BeginPlay() override;
-    virtual void SetupInputComponent() override;
-
-    /** Mapping context that defines movement, look and navigation actions. */
-    UPROPERTY(EditDefaultsOnly, Category = "Input")
-    TObjectPtr<UInputMappingContext> DefaultMappingContext;
-
-    /** 2D movement input (X = strafe, Y = forward/backward). */
-    UPROPERTY(EditDefaultsOnly, Category = "Input")
-    TObjectPtr<UInputAction> MoveAction;
-
-    /** 2D look input (X = yaw, Y = pitch). */
-    UPROPERTY(EditDefaultsOnly, Category = "Input")
-    TObjectPtr<UInputAction> LookAction;
-
-    /**
-     * Vertical movement axis (for example Q and E keys).
-     * Used to move the pawn up and down while in navigation mode.
-     */
-    UPROPERTY(EditDefaultsOnly, Category = "Input")
-    TObjectPtr<UInputAction> VerticalMoveAction;
-
-    /**
-     * Digital action used to toggle navigation mode while held.
-     * Typically bound to the right mouse button.
-     */
-    UPROPERTY(EditDefaultsOnly, Category = "Input")
-    TObjectPtr<UInputAction> NavigationModeAction;
-
-    /**
-     * Digital action used to request exiting the game.
-     * Typically bound to the Escape key.
-     */
-    UPROPERTY(EditDefaultsOnly, Category = "Input")
-    TObjectPtr<UInputAction> ExitGameAction;
-
-private:
-    /** Indicates whether the controller is currently in navigation mode. */
-    UPROPERTY(VisibleInstanceOnly, Category = "State")
-    bool bIsNavigationModeActive;
-
-    /** Called when the navigation mode action is pressed (started). */
-    void OnNavigationModeStarted(const FInputActionValue& ActionValue);
-
-    /** Called when the navigation mode action is released (completed). */
-    void OnNavigationModeCompleted(const FInputActionValue& ActionValue);
-
-    /** Handles movement input while in navigation mode. */
-    void HandleMoveInput(const FInputActionValue& ActionValue);
-
-    /** Handles look input while in navigation mode. */
-    void HandleLookInput(const FInputActionValue& ActionValue);
-
-    /** Handles vertical movement input while in navigation mode. */
-    void HandleVerticalMoveInput(const FInputActionValue& ActionValue);
-
-    /** Handles exit request (for example Esc key). */
-    void HandleExitRequested(const FInputActionValue& ActionValue);
-
-    /** Applies GameOnly input mode and hides the mouse cursor. */
-    void EnterNavigationMode();
-
-    /** Applies GameAndUI input mode and shows the mouse cursor. */
-    void EnterUiMode();
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+#include "InputActionValue.h"
+#include "IOM_PlayerController.generated.h"
+
+class UInputMappingContext;
+class UInputAction;
+
+/**
+ * Player controller for the Interactive Object Manager demo level.
+ *
+ * Responsibilities:
+ * - Switch between navigation mode (fly around the level) and UI interaction mode.
+ * - Route Enhanced Input actions to pawn movement and camera look.
+ * - Select interactive objects by clicking them in the world or dragging a rectangle around them.
+ *
+ * Navigation mode:
+ * - Active while the navigation action (for example, right mouse button) is held.
+ * - Mouse cursor is hidden.
+ * - Input mode is GameOnly.
+ * - WASD (and other configured keys) move the pawn, mouse controls the camera.
+ *
+ * UI mode:
+ * - Active when navigation is not held.
+ * - Mouse cursor is visible.
+ * - Input mode is GameAndUI.
+ * - Movement and look input are ignored.
+ * - Clicking selects the interactive object under the cursor, Shift+click toggles it in the selection.
+ * - Dragging with the select button held selects every object inside the rectangle,
+ *   Shift+drag adds them to the selection.
+ *
+ * Click selection casts the cursor ray against the spatial index of the
+ * Interactive Object Manager subsystem instead of tracing physics. Rectangle selection
+ * culls through the same index and projects the remaining candidates in parallel.
+ */
+UCLASS()
+class AIOM_PlayerController : public APlayerController
+{
+    GENERATED_BODY()
+
+public:
+    AIOM_PlayerController();
+
+    /**
+     * Returns the rectangle of the drag selection in progress, in viewport pixels.
+     * Lets UI draw the marquee. Returns false while no drag is in progress.
+     */
+    UFUNCTION(BlueprintPure, Category = "Selection")
+    bool GetActiveMarqueeRect(FVector2D& OutStart, FVector2D& OutEnd) const;
+
+protected:
+    // APlayerController interface
+    virtual void BeginPlay() override;
+    virtual void SetupInputComponent() override;
+
+    /** Mapping context that defines movement, look and navigation actions. */
+    UPROPERTY(EditDefaultsOnly, Category = "Input")
+    TObjectPtr<UInputMappingContext> DefaultMappingContext;
+
+    /** 2D movement input (X = strafe, Y = forward/backward). */
+    UPROPERTY(EditDefaultsOnly, Category = "Input")
+    TObjectPtr<UInputAction> MoveAction;
+
+    /** 2D look input (X = yaw, Y = pitch). */
+    UPROPERTY(EditDefaultsOnly, Category = "Input")
+    TObjectPtr<UInputAction> LookAction;
+
+    /**
+     * Vertical movement axis (for example Q and E keys).
+     * Used to move the pawn up and down while in navigation mode.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Input")
+    TObjectPtr<UInputAction> VerticalMoveAction;
+
+    /**
+     * Digital action used to toggle navigation mode while held.
+     * Typically bound to the right mouse button.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Input")
+    TObjectPtr<UInputAction> NavigationModeAction;
+
+    /**
+     * Digital action used to request exiting the game.
+     * Typically bound to the Escape key.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Input")
+    TObjectPtr<UInputAction> ExitGameAction;
+
+    /**
+     * Digital action used to select the interactive object under the cursor.
+     * Typically bound to the left mouse button. If not set, the left mouse button is bound directly.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Input")
+    TObjectPtr<UInputAction> SelectAction;
+
+    /** Maximum distance from the camera at which click selection finds objects. */
+    UPROPERTY(EditDefaultsOnly, Category = "Selection", meta = (ClampMin = "0.0"))
+    float MaxSelectionDistance;
+
+    /** Cursor travel in pixels after which a press of the select button becomes a drag selection. */
+    UPROPERTY(EditDefaultsOnly, Category = "Selection", meta = (ClampMin = "0.0"))
+    float MarqueeDragThreshold;
+
+private:
+    /** Indicates whether the controller is currently in navigation mode. */
+    UPROPERTY(VisibleInstanceOnly, Category = "State")
+    bool bIsNavigationModeActive;
+
+    /** True while the select button is held in UI mode. */
+    bool bIsSelectPressed;
+
+    /** Cursor position in viewport pixels at the moment the select button was pressed. */
+    FVector2D SelectPressPosition;
+
+    /** Called when the navigation mode action is pressed (started). */
+    void OnNavigationModeStarted(const FInputActionValue& ActionValue);
+
+    /** Called when the navigation mode action is released (completed). */
+    void OnNavigationModeCompleted(const FInputActionValue& ActionValue);
+
+    /** Handles movement input while in navigation mode. */
+    void HandleMoveInput(const FInputActionValue& ActionValue);
+
+    /** Handles look input while in navigation mode. */
+    void HandleLookInput(const FInputActionValue& ActionValue);
+
+    /** Handles vertical movement input while in navigation mode. */
+    void HandleVerticalMoveInput(const FInputActionValue& ActionValue);
+
+    /** Handles exit request (for example Esc key). */
+    void HandleExitRequested(const FInputActionValue& ActionValue);
+
+    /** Handles the select action press while in UI mode. */
+    void HandleSelectStarted(const FInputActionValue& ActionValue);
+
+    /** Handles the select action release while in UI mode. */
+    void HandleSelectCompleted(const FInputActionValue& ActionValue);
+
+    /** Fallback for the select action press when SelectAction is not set. */
+    void HandleSelectKeyPressed();
+
+    /** Fallback for the select action release when SelectAction is not set. */
+    void HandleSelectKeyReleased();
+
+    /** Reverts the last object operation (Ctrl+Z). */
+    void HandleUndoRequested();
+
+    /** Applies the last undone object operation again (Ctrl+Y or Ctrl+Shift+Z). */
+    void HandleRedoRequested();
+
+    /** Remembers where the select button went down. */
+    void BeginSelectPress();
+
+    /** Resolves a finished press into a click or a drag selection. */
+    void EndSelectPress();
+
+    /**
+     * Casts the cursor ray against the manager spatial index and selects the closest hit.
+     * A click on empty space clears the selection unless Shift is held.
+     */
+    void SelectObjectUnderCursor();
+
+    /**
+     * Selects every interactive object whose bounds center is inside the screen rectangle, in one batch.
+     * Replaces the selection unless Shift is held.
+     */
+    void SelectObjectsInMarquee(const FVector2D& RectStart, const FVector2D& RectEnd);
+
+    /** Applies GameOnly input mode and hides the mouse cursor. */
+    void EnterNavigationMode();
+
+    /** Applies GameAndUI input mode and shows the mouse cursor. */
+    void EnterUiMode();
 };
\ No newline at end of file
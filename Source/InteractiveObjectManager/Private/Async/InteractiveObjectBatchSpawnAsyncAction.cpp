@@ -0,0 +1,90 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Async/InteractiveObjectBatchSpawnAsyncAction.h"
+#include "InteractiveObjectManagerLog.h"
+
+#include "Subsystems/InteractiveObjectManagerSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+UInteractiveObjectBatchSpawnAsyncAction* UInteractiveObjectBatchSpawnAsyncAction::SpawnObjectsBatchAsync(
+    UObject* WorldContextObject,
+    int32 Count,
+    EInteractiveObjectSpawnType SpawnType,
+    const FInteractiveObjectBatchSpawnParams& Params)
+{
+    UInteractiveObjectBatchSpawnAsyncAction* Action = NewObject<UInteractiveObjectBatchSpawnAsyncAction>();
+    Action->RequestedCount = Count;
+    Action->RequestedSpawnType = SpawnType;
+    Action->RequestedParams = Params;
+
+    UWorld* World = (GEngine != nullptr)
+        ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull)
+        : nullptr;
+
+    if (World != nullptr)
+    {
+        Action->ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>();
+    }
+
+    Action->RegisterWithGameInstance(WorldContextObject);
+    return Action;
+}
+
+void UInteractiveObjectBatchSpawnAsyncAction::Activate()
+{
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectBatchSpawnAsyncAction: Manager subsystem is not available. Nothing will be spawned.")
+        );
+        Finish(0);
+        return;
+    }
+
+    // Bind before queueing so that no broadcast for this batch can be missed.
+    Subsystem->OnSpawnBatchProgress.AddDynamic(this, &UInteractiveObjectBatchSpawnAsyncAction::HandleSpawnBatchProgress);
+    Subsystem->OnSpawnBatchCompleted.AddDynamic(this, &UInteractiveObjectBatchSpawnAsyncAction::HandleSpawnBatchCompleted);
+
+    BatchId = Subsystem->SpawnObjectsBatch(RequestedCount, RequestedSpawnType, RequestedParams);
+    if (BatchId == INDEX_NONE)
+    {
+        Finish(0);
+    }
+}
+
+void UInteractiveObjectBatchSpawnAsyncAction::HandleSpawnBatchProgress(int32 InBatchId, int32 SpawnedCount, int32 InRequestedCount)
+{
+    if (InBatchId != BatchId)
+    {
+        return;
+    }
+
+    OnProgress.Broadcast(SpawnedCount, InRequestedCount);
+}
+
+void UInteractiveObjectBatchSpawnAsyncAction::HandleSpawnBatchCompleted(int32 InBatchId, int32 SpawnedCount, int32 InRequestedCount)
+{
+    if (InBatchId != BatchId)
+    {
+        return;
+    }
+
+    Finish(SpawnedCount);
+}
+
+void UInteractiveObjectBatchSpawnAsyncAction::Finish(int32 SpawnedCount)
+{
+    if (UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get())
+    {
+        Subsystem->OnSpawnBatchProgress.RemoveDynamic(this, &UInteractiveObjectBatchSpawnAsyncAction::HandleSpawnBatchProgress);
+        Subsystem->OnSpawnBatchCompleted.RemoveDynamic(this, &UInteractiveObjectBatchSpawnAsyncAction::HandleSpawnBatchCompleted);
+    }
+
+    OnCompleted.Broadcast(SpawnedCount, FMath::Max(RequestedCount, 0));
+    SetReadyToDestroy();
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Commands/InteractiveObjectCommandQueue.h"
+#include "InteractiveObjectManagerLog.h"
+
+#include "Async/Future.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Tasks/Task.h"
+
+static FAutoConsoleCommand GInteractiveObjectCommandStressTestCommand(
+    TEXT("IOM.Commands.StressTest"),
+    TEXT("Enqueues commands from concurrent producers while the calling thread drains, then validates ordering.\n")
+    TEXT("Usage: IOM.Commands.StressTest [NumProducers=8] [CommandsPerProducer=20000]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumProducers = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 8;
+        const int32 CommandsPerProducer = (Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 20000;
+
+        FInteractiveObjectCommandQueue::RunStressTest(FMath::Max(NumProducers, 1), FMath::Max(CommandsPerProducer, 1));
+    })
+);
+
+FInteractiveObjectCommandQueue::FInteractiveObjectCommandQueue()
+    : NumPending(0)
+    , bIsClosed(false)
+{
+}
+
+FInteractiveObjectCommandQueue::~FInteractiveObjectCommandQueue()
+{
+    // Commands that raced Close still get their discard call, so no future is left unresolved.
+    Close();
+}
+
+void FInteractiveObjectCommandQueue::Enqueue(FCommand&& Command)
+{
+    if (bIsClosed.load(std::memory_order_acquire))
+    {
+        Command(nullptr);
+        return;
+    }
+
+    NumPending.fetch_add(1, std::memory_order_relaxed);
+    Commands.Enqueue(MoveTemp(Command));
+}
+
+int32 FInteractiveObjectCommandQueue::Execute(UInteractiveObjectManagerSubsystem* Subsystem, int32 MaxCommands)
+{
+    int32 ExecutedCount = 0;
+
+    FCommand Command;
+    while ((MaxCommands <= 0 || ExecutedCount < MaxCommands) && Commands.Dequeue(Command))
+    {
+        NumPending.fetch_sub(1, std::memory_order_relaxed);
+
+        Command(Subsystem);
+        Command.Reset();
+
+        ++ExecutedCount;
+    }
+
+    return ExecutedCount;
+}
+
+void FInteractiveObjectCommandQueue::Close()
+{
+    bIsClosed.store(true, std::memory_order_release);
+    Execute(nullptr, 0);
+}
+
+int32 FInteractiveObjectCommandQueue::GetNumPending() const
+{
+    return NumPending.load(std::memory_order_relaxed);
+}
+
+FInteractiveObjectCommandQueue::FStressTestResult FInteractiveObjectCommandQueue::RunStressTest(int32 NumProducers, int32 CommandsPerProducer)
+{
+    FInteractiveObjectCommandQueue Queue;
+
+    // Written only by executing commands, which all run on this thread.
+    TArray<int32> NextSequencePerProducer;
+    NextSequencePerProducer.SetNumZeroed(NumProducers);
+    TArray<TBitArray<>> ExecutedPerProducer;
+    ExecutedPerProducer.Init(TBitArray<>(false, CommandsPerProducer), NumProducers);
+    int64 ExecutedCount = 0;
+    int64 DuplicatedCount = 0;
+    int64 OrderViolations = 0;
+
+    std::atomic<int32> NumProducersDone(0);
+    std::atomic<int64> FutureFailures(0);
+
+    TArray<UE::Tasks::FTask> ProducerTasks;
+    ProducerTasks.Reserve(NumProducers);
+
+    for (int32 ProducerIndex = 0; ProducerIndex < NumProducers; ++ProducerIndex)
+    {
+        ProducerTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Queue, &NextSequencePerProducer, &ExecutedPerProducer, &ExecutedCount, &DuplicatedCount, &OrderViolations, &NumProducersDone, &FutureFailures, ProducerIndex, CommandsPerProducer]()
+        {
+            TArray<TFuture<int32>> Futures;
+
+            for (int32 Sequence = 0; Sequence < CommandsPerProducer; ++Sequence)
+            {
+                // Every 64th command reports back through a future, the rest are fire and forget.
+                TPromise<int32> Promise;
+                const bool bHasFuture = (Sequence % 64) == 0;
+                if (bHasFuture)
+                {
+                    Futures.Add(Promise.GetFuture());
+                }
+
+                Queue.Enqueue([&NextSequencePerProducer, &ExecutedPerProducer, &ExecutedCount, &DuplicatedCount, &OrderViolations, ProducerIndex, Sequence, bHasFuture, Promise = MoveTemp(Promise)](UInteractiveObjectManagerSubsystem* Subsystem) mutable
+                {
+                    if (NextSequencePerProducer[ProducerIndex] != Sequence)
+                    {
+                        ++OrderViolations;
+                    }
+
+                    NextSequencePerProducer[ProducerIndex] = Sequence + 1;
+                    ++ExecutedCount;
+
+                    FBitReference ExecutedBit = ExecutedPerProducer[ProducerIndex][Sequence];
+                    if (ExecutedBit)
+                    {
+                        ++DuplicatedCount;
+                    }
+                    ExecutedBit = true;
+
+                    if (bHasFuture)
+                    {
+                        Promise.SetValue(Sequence);
+                    }
+                });
+            }
+
+            // Futures resolve on the draining thread, in enqueue order.
+            int32 ExpectedSequence = 0;
+            for (TFuture<int32>& Future : Futures)
+            {
+                if (Future.Get() != ExpectedSequence)
+                {
+                    ++FutureFailures;
+                }
+                ExpectedSequence += 64;
+            }
+
+            ++NumProducersDone;
+        }));
+    }
+
+    int32 DrainCount = 0;
+    int32 LargestDrain = 0;
+
+    const double StartTime = FPlatformTime::Seconds();
+    while (NumProducersDone.load() < NumProducers || Queue.GetNumPending() > 0)
+    {
+        const int32 DrainedCount = Queue.Execute(nullptr, 0);
+        if (DrainedCount > 0)
+        {
+            ++DrainCount;
+            LargestDrain = FMath::Max(LargestDrain, DrainedCount);
+        }
+        else
+        {
+            FPlatformProcess::Yield();
+        }
+    }
+    const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+    UE::Tasks::Wait(ProducerTasks);
+
+    FStressTestResult Result;
+    Result.ExpectedCount = static_cast<int64>(NumProducers) * CommandsPerProducer;
+    Result.ExecutedCount = ExecutedCount;
+    Result.DuplicatedCount = DuplicatedCount;
+    Result.OrderViolations = OrderViolations;
+    Result.FutureFailures = FutureFailures.load();
+
+    for (const TBitArray<>& Executed : ExecutedPerProducer)
+    {
+        Result.LostCount += Executed.Num() - Executed.CountSetBits();
+    }
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("IOM.Commands.StressTest: %d producers x %d commands in %.1f ms (%.0f commands per ms), %d drains, largest %d. Executed %lld of %lld, %lld lost, %lld duplicated, %lld order violations, %lld future failures."),
+        NumProducers,
+        CommandsPerProducer,
+        ElapsedSeconds * 1000.0,
+        (ElapsedSeconds > 0.0) ? ExecutedCount / (ElapsedSeconds * 1000.0) : 0.0,
+        DrainCount,
+        LargestDrain,
+        Result.ExecutedCount,
+        Result.ExpectedCount,
+        Result.LostCount,
+        Result.DuplicatedCount,
+        Result.OrderViolations,
+        Result.FutureFailures
+    );
+
+    if (!Result.HasPassed())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Error,
+            TEXT("IOM.Commands.StressTest: command queue guarantees were violated.")
+        );
+    }
+
+    return Result;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FInteractiveObjectCommandQueueStressTest,
+    "InteractiveObjectManager.Commands.StressTest",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FInteractiveObjectCommandQueueStressTest::RunTest(const FString& Parameters)
+{
+    const FInteractiveObjectCommandQueue::FStressTestResult Result = FInteractiveObjectCommandQueue::RunStressTest(8, 5000);
+
+    TestEqual(TEXT("Executed commands"), Result.ExecutedCount, Result.ExpectedCount);
+    TestEqual(TEXT("Lost commands"), Result.LostCount, static_cast<int64>(0));
+    TestEqual(TEXT("Duplicated commands"), Result.DuplicatedCount, static_cast<int64>(0));
+    TestEqual(TEXT("Order violations"), Result.OrderViolations, static_cast<int64>(0));
+    TestEqual(TEXT("Future failures"), Result.FutureFailures, static_cast<int64>(0));
+
+    return Result.HasPassed();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -1,297 +1,656 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#include "Components/InteractiveObjectComponent.h"
-#include "InteractiveObjectManagerLog.h"
-
-#include "Subsystems/InteractiveObjectManagerSubsystem.h"
-
-#include "Components/StaticMeshComponent.h"
-#include "Engine/World.h"
-#include "GameFramework/Actor.h"
-#include "Materials/MaterialInstanceDynamic.h"
-
-DEFINE_LOG_CATEGORY(LogInteractiveObjectManager);
-
-UInteractiveObjectComponent::UInteractiveObjectComponent()
-{
-    PrimaryComponentTick.bCanEverTick = false;
-
-    CurrentColor = FLinearColor::White;
-    CurrentScale = 1.0f;
-
-    ColorParameterName = TEXT("BaseColor");
-
-    bHasLoggedMissingMesh = false;
-    bAreDynamicMaterialsInitialized = false;
-}
-
-void UInteractiveObjectComponent::BeginPlay()
-{
-    Super::BeginPlay();
-
-    // Resolve mesh early so we can warn if the setup is invalid.
-    UStaticMeshComponent* MeshComponent = GetEffectiveMeshComponent();
-    if (MeshComponent == nullptr)
-    {
-        LogMissingMeshIfNeeded();
-    }
-
-    // Apply initial visual state (values set in editor).
-    InitializeDynamicMaterials();
-    ApplyColorInternal();
-    ApplyScaleInternal();
-
-    RegisterWithManager();
-}
-
-void UInteractiveObjectComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
-{
-    UnregisterFromManager();
-
-    Super::EndPlay(EndPlayReason);
-}
-
-void UInteractiveObjectComponent::ApplyColor(const FLinearColor& NewColor)
-{
-    CurrentColor = NewColor;
-
-    InitializeDynamicMaterials();
-    ApplyColorInternal();
-}
-
-void UInteractiveObjectComponent::ApplyScale(float NewScale)
-{
-    const float ClampedScale = FMath::Max(NewScale, 0.01f);
-    CurrentScale = ClampedScale;
-
-    ApplyScaleInternal();
-}
-
-FLinearColor UInteractiveObjectComponent::GetCurrentColor() const
-{
-    return CurrentColor;
-}
-
-float UInteractiveObjectComponent::GetCurrentScale() const
-{
-    return CurrentScale;
-}
-
-FString UInteractiveObjectComponent::GetDisplayNameForUI() const
-{
-    if (!DisplayLabel.IsEmpty())
-    {
-        return DisplayLabel;
-    }
-
-    const AActor* OwnerActor = GetOwner();
-
-    return OwnerActor != nullptr ? OwnerActor->GetName() : FString(TEXT("InteractiveObject"));
-}
-
-UStaticMeshComponent* UInteractiveObjectComponent::GetEffectiveMeshComponent()
-{
-    if (TargetMeshComponent.IsValid())
-    {
-        return TargetMeshComponent.Get();
-    }
-
-    AActor* OwnerActor = GetOwner();
-    if (OwnerActor == nullptr)
-    {
-        return nullptr;
-    }
-
-    UStaticMeshComponent* MeshComponent = OwnerActor->FindComponentByClass<UStaticMeshComponent>();
-    if (MeshComponent == nullptr)
-    {
-        return nullptr;
-    }
-
-    TargetMeshComponent = MeshComponent;
-    return MeshComponent;
-}
-
-USceneComponent* UInteractiveObjectComponent::GetEffectiveScaleComponent()
-{
-    if (ScaleTargetComponent.IsValid())
-    {
-        return ScaleTargetComponent.Get();
-    }
-
-    if (UStaticMeshComponent* MeshComponent = GetEffectiveMeshComponent())
-    {
-        return MeshComponent;
-    }
-
-    AActor* OwnerActor = GetOwner();
-    if (OwnerActor != nullptr)
-    {
-        return OwnerActor->GetRootComponent();
-    }
-
-    return nullptr;
-}
-
-void UInteractiveObjectComponent::InitializeDynamicMaterials()
-{
-    if (bAreDynamicMaterialsInitialized)
-    {
-        return;
-    }
-
-    UStaticMeshComponent* MeshComponent = GetEffectiveMeshComponent();
-    if (MeshComponent == nullptr)
-    {
-        LogMissingMeshIfNeeded();
-        return;
-    }
-
-    const int32 MaterialCount = MeshComponent->GetNumMaterials();
-    DynamicMaterialInstances.Reset();
-
-    for (int32 MaterialIndex = 0; MaterialIndex < MaterialCount; ++MaterialIndex)
-    {
-        UMaterialInstanceDynamic* DynamicMaterial = MeshComponent->CreateAndSetMaterialInstanceDynamic(MaterialIndex);
-        if (DynamicMaterial != nullptr)
-        {
-            DynamicMaterialInstances.Add(DynamicMaterial);
-        }
-    }
-
-    bAreDynamicMaterialsInitialized = true;
-
-    UE_LOG(
-        LogInteractiveObjectManager,
-        Log,
-        TEXT("InteractiveObjectComponent on Actor '%s' initialized %d dynamic material instances."),
-        *GetNameSafe(GetOwner()),
-        DynamicMaterialInstances.Num()
-    );
-}
-
-void UInteractiveObjectComponent::ApplyColorInternal()
-{
-    if (!bAreDynamicMaterialsInitialized)
-    {
-        InitializeDynamicMaterials();
-    }
-
-    if (DynamicMaterialInstances.Num() == 0)
-    {
-        return;
-    }
-
-    const FName ParameterName = ColorParameterName.IsNone() ? FName(TEXT("BaseColor")) : ColorParameterName;
-
-    for (UMaterialInstanceDynamic* DynamicMaterial : DynamicMaterialInstances)
-    {
-        if (DynamicMaterial != nullptr)
-        {
-            DynamicMaterial->SetVectorParameterValue(ParameterName, CurrentColor);
-        }
-    }
-}
-
-void UInteractiveObjectComponent::ApplyScaleInternal()
-{
-    USceneComponent* ScaleComponent = GetEffectiveScaleComponent();
-    const FVector NewScale(CurrentScale);
-
-    if (ScaleComponent != nullptr)
-    {
-        ScaleComponent->SetWorldScale3D(NewScale);
-    }
-    else if (AActor* OwnerActor = GetOwner())
-    {
-        OwnerActor->SetActorScale3D(NewScale);
-    }
-}
-
-void UInteractiveObjectComponent::RegisterWithManager()
-{
-    UWorld* World = GetWorld();
-    if (World == nullptr)
-    {
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>();
-    if (ManagerSubsystem == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectComponent '%s' on '%s' could not find InteractiveObjectManagerSubsystem."),
-            *GetName(),
-            *GetNameSafe(GetOwner())
-        );
-        return;
-    }
-
-    CachedManagerSubsystem = ManagerSubsystem;
-    ManagerSubsystem->RegisterInteractiveObject(this);
-
-    UE_LOG(
-        LogInteractiveObjectManager,
-        Log,
-        TEXT("InteractiveObjectComponent '%s' registered owner '%s' with manager."),
-        *GetName(),
-        *GetNameSafe(GetOwner())
-    );
-}
-
-void UInteractiveObjectComponent::UnregisterFromManager()
-{
-    if (CachedManagerSubsystem.IsValid())
-    {
-        CachedManagerSubsystem->UnregisterInteractiveObject(this);
-
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Log,
-            TEXT("InteractiveObjectComponent '%s' unregistered owner '%s' from cached manager."),
-            *GetName(),
-            *GetNameSafe(GetOwner())
-        );
-
-        CachedManagerSubsystem.Reset();
-        return;
-    }
-
-    UWorld* World = GetWorld();
-    if (World == nullptr)
-    {
-        return;
-    }
-
-    if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
-    {
-        ManagerSubsystem->UnregisterInteractiveObject(this);
-
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Log,
-            TEXT("InteractiveObjectComponent '%s' unregistered owner '%s' from world manager."),
-            *GetName(),
-            *GetNameSafe(GetOwner())
-        );
-    }
-}
-
-void UInteractiveObjectComponent::LogMissingMeshIfNeeded()
-{
-    if (bHasLoggedMissingMesh)
-    {
-        return;
-    }
-
-    bHasLoggedMissingMesh = true;
-
-    UE_LOG(
-        LogInteractiveObjectManager,
-        Warning,
-        TEXT("InteractiveObjectComponent on Actor '%s' could not find a valid StaticMeshComponent. Color changes will be skipped."),
-        *GetNameSafe(GetOwner())
-    );
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Components/InteractiveObjectComponent.h"
+#include "InteractiveObjectManagerLog.h"
+
+#include "Subsystems/InteractiveObjectManagerSubsystem.h"
+
+#include "Components/SceneComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectArray.h"
+
+DEFINE_LOG_CATEGORY(LogInteractiveObjectManager);
+
+static FAutoConsoleCommand GInteractiveObjectColorBenchmarkCommand(
+    TEXT("IOM.Color.Benchmark"),
+    TEXT("Compares UObjects, memory and garbage collection time of the dynamic material and custom primitive data color modes.\n")
+    TEXT("Usage: IOM.Color.Benchmark [NumObjects=20000]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumObjects = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 20000;
+
+        UInteractiveObjectComponent::RunColorModeBenchmark(FMath::Max(NumObjects, 1));
+    })
+);
+
+/** Measurements of one color mode in IOM.Color.Benchmark. */
+struct FColorModeBenchmarkResult
+{
+    int32 NumUObjects = 0;
+    int64 UsedPhysicalBytes = 0;
+    double SetupSeconds = 0.0;
+    double GarbageCollectSeconds = 0.0;
+};
+
+static FColorModeBenchmarkResult RunColorModeBenchmarkPass(EInteractiveObjectColorMode ColorMode, int32 NumObjects, UStaticMesh* StaticMesh, UMaterialInterface* Material)
+{
+    // Start from a clean heap, so that the pass only measures what it creates.
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+    FColorModeBenchmarkResult Result;
+    const int32 NumUObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+    const int64 UsedPhysicalBefore = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+
+    // Same seed for both passes, so that they set the same colors.
+    FRandomStream RandomStream(NumObjects);
+
+    TArray<UStaticMeshComponent*> MeshComponents;
+    MeshComponents.Reserve(NumObjects);
+
+    const double SetupStartTime = FPlatformTime::Seconds();
+
+    for (int32 Index = 0; Index < NumObjects; ++Index)
+    {
+        UStaticMeshComponent* MeshComponent = NewObject<UStaticMeshComponent>(GetTransientPackage(), NAME_None, RF_Transient);
+        MeshComponent->AddToRoot();
+        MeshComponent->SetStaticMesh(StaticMesh);
+        MeshComponents.Add(MeshComponent);
+
+        const FLinearColor Color(RandomStream.FRand(), RandomStream.FRand(), RandomStream.FRand());
+
+        if (ColorMode == EInteractiveObjectColorMode::CustomPrimitiveData)
+        {
+            MeshComponent->SetMaterial(0, Material);
+            MeshComponent->SetCustomPrimitiveDataVector4(0, FVector4(Color));
+        }
+        else if (UMaterialInstanceDynamic* DynamicMaterial = MeshComponent->CreateAndSetMaterialInstanceDynamicFromMaterial(0, Material))
+        {
+            DynamicMaterial->SetVectorParameterValue(TEXT("BaseColor"), Color);
+        }
+    }
+
+    Result.SetupSeconds = FPlatformTime::Seconds() - SetupStartTime;
+    Result.NumUObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - NumUObjectsBefore;
+    Result.UsedPhysicalBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - UsedPhysicalBefore;
+
+    // The components are rooted, so this collection only pays for walking them and what they reference.
+    const double CollectStartTime = FPlatformTime::Seconds();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+    Result.GarbageCollectSeconds = FPlatformTime::Seconds() - CollectStartTime;
+
+    for (UStaticMeshComponent* MeshComponent : MeshComponents)
+    {
+        MeshComponent->RemoveFromRoot();
+    }
+
+    MeshComponents.Empty();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+    return Result;
+}
+
+static void LogColorModeBenchmarkResult(const TCHAR* ModeName, int32 NumObjects, const FColorModeBenchmarkResult& Result)
+{
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("IOM.Color.Benchmark: %s, %d objects. %d UObjects, %.1f MB. Setup %.1f ms, garbage collection %.2f ms."),
+        ModeName,
+        NumObjects,
+        Result.NumUObjects,
+        Result.UsedPhysicalBytes / (1024.0 * 1024.0),
+        Result.SetupSeconds * 1000.0,
+        Result.GarbageCollectSeconds * 1000.0
+    );
+}
+
+UInteractiveObjectComponent::UInteractiveObjectComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+
+    CurrentColor = FLinearColor::White;
+    CurrentScale = 1.0f;
+
+    ColorParameterName = TEXT("BaseColor");
+    ColorMode = EInteractiveObjectColorMode::DynamicMaterial;
+    ColorPrimitiveDataIndex = 0;
+
+    bHasLoggedMissingMesh = false;
+    bAreDynamicMaterialsInitialized = false;
+    bUsesSharedDynamicMaterials = false;
+    bUsesCustomPrimitiveData = false;
+    bIsPooled = false;
+    bWasOwnerCollisionEnabled = true;
+    bWasOwnerTickEnabled = true;
+}
+
+void UInteractiveObjectComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Resolve mesh early so we can warn if the setup is invalid.
+    UStaticMeshComponent* MeshComponent = GetEffectiveMeshComponent();
+    if (MeshComponent == nullptr)
+    {
+        LogMissingMeshIfNeeded();
+    }
+
+    // Apply initial visual state (values set in editor).
+    InitializeDynamicMaterials();
+    UpdateMaterialColor(CurrentColor);
+    UpdateAppliedScale(CurrentScale);
+
+    RegisterWithManager();
+}
+
+void UInteractiveObjectComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UnregisterFromManager();
+    ReleaseSharedMaterials();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UInteractiveObjectComponent::ApplyColor(const FLinearColor& NewColor)
+{
+    // The manager stores the color and calls back into UpdateMaterialColor.
+    if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = GetOwningManager())
+    {
+        ManagerSubsystem->SetObjectColor(ManagerHandle, NewColor);
+        return;
+    }
+
+    CurrentColor = NewColor;
+    UpdateMaterialColor(NewColor);
+}
+
+void UInteractiveObjectComponent::ApplyScale(float NewScale)
+{
+    if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = GetOwningManager())
+    {
+        ManagerSubsystem->SetObjectUniformScale(ManagerHandle, NewScale);
+        return;
+    }
+
+    const float ClampedScale = FMath::Max(NewScale, 0.01f);
+    CurrentScale = ClampedScale;
+
+    UpdateAppliedScale(ClampedScale);
+}
+
+FLinearColor UInteractiveObjectComponent::GetCurrentColor() const
+{
+    FLinearColor Color = CurrentColor;
+
+    if (const UInteractiveObjectManagerSubsystem* ManagerSubsystem = GetOwningManager())
+    {
+        ManagerSubsystem->GetObjectColor(ManagerHandle, Color);
+    }
+
+    return Color;
+}
+
+float UInteractiveObjectComponent::GetCurrentScale() const
+{
+    float Scale = CurrentScale;
+
+    if (const UInteractiveObjectManagerSubsystem* ManagerSubsystem = GetOwningManager())
+    {
+        ManagerSubsystem->GetObjectUniformScale(ManagerHandle, Scale);
+    }
+
+    return Scale;
+}
+
+void UInteractiveObjectComponent::HandleRegisteredWithManager(FInteractiveObjectHandle Handle)
+{
+    ManagerHandle = Handle;
+
+    const AActor* OwnerActor = GetOwner();
+    USceneComponent* RootComponent = (OwnerActor != nullptr) ? OwnerActor->GetRootComponent() : nullptr;
+    if (RootComponent != nullptr && !RootTransformUpdatedHandle.IsValid())
+    {
+        RootTransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &UInteractiveObjectComponent::HandleRootTransformUpdated);
+        ObservedRootComponent = RootComponent;
+    }
+}
+
+void UInteractiveObjectComponent::HandleUnregisteredFromManager(const FLinearColor& LastColor, float LastScale)
+{
+    CurrentColor = LastColor;
+    CurrentScale = LastScale;
+    ManagerHandle.Reset();
+
+    if (USceneComponent* RootComponent = ObservedRootComponent.Get())
+    {
+        RootComponent->TransformUpdated.Remove(RootTransformUpdatedHandle);
+    }
+
+    ObservedRootComponent.Reset();
+    RootTransformUpdatedHandle.Reset();
+}
+
+void UInteractiveObjectComponent::HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = GetOwningManager())
+    {
+        ManagerSubsystem->NotifyObjectTransformChanged(ManagerHandle);
+    }
+}
+
+UInteractiveObjectManagerSubsystem* UInteractiveObjectComponent::GetOwningManager() const
+{
+    return ManagerHandle.IsSet() ? CachedManagerSubsystem.Get() : nullptr;
+}
+
+FString UInteractiveObjectComponent::GetDisplayNameForUI() const
+{
+    if (!DisplayLabel.IsEmpty())
+    {
+        return DisplayLabel;
+    }
+
+    const AActor* OwnerActor = GetOwner();
+
+    return OwnerActor != nullptr ? OwnerActor->GetName() : FString(TEXT("InteractiveObject"));
+}
+
+void UInteractiveObjectComponent::DeactivateForPool()
+{
+    if (bIsPooled)
+    {
+        return;
+    }
+
+    UnregisterFromManager();
+
+    // A parked actor must not keep colors alive in the shared cache. The next spawn acquires its color again.
+    ReleaseSharedMaterials();
+
+    if (AActor* OwnerActor = GetOwner())
+    {
+        bWasOwnerCollisionEnabled = OwnerActor->GetActorEnableCollision();
+        bWasOwnerTickEnabled = OwnerActor->IsActorTickEnabled();
+
+        OwnerActor->SetActorHiddenInGame(true);
+        OwnerActor->SetActorEnableCollision(false);
+        OwnerActor->SetActorTickEnabled(false);
+    }
+
+    bIsPooled = true;
+}
+
+void UInteractiveObjectComponent::ActivateFromPool()
+{
+    if (!bIsPooled)
+    {
+        return;
+    }
+
+    bIsPooled = false;
+
+    if (AActor* OwnerActor = GetOwner())
+    {
+        OwnerActor->SetActorHiddenInGame(false);
+        OwnerActor->SetActorEnableCollision(bWasOwnerCollisionEnabled);
+        OwnerActor->SetActorTickEnabled(bWasOwnerTickEnabled);
+    }
+
+    RegisterWithManager();
+}
+
+bool UInteractiveObjectComponent::IsPooled() const
+{
+    return bIsPooled;
+}
+
+UStaticMeshComponent* UInteractiveObjectComponent::GetEffectiveMeshComponent()
+{
+    if (TargetMeshComponent.IsValid())
+    {
+        return TargetMeshComponent.Get();
+    }
+
+    AActor* OwnerActor = GetOwner();
+    if (OwnerActor == nullptr)
+    {
+        return nullptr;
+    }
+
+    UStaticMeshComponent* MeshComponent = OwnerActor->FindComponentByClass<UStaticMeshComponent>();
+    if (MeshComponent == nullptr)
+    {
+        return nullptr;
+    }
+
+    TargetMeshComponent = MeshComponent;
+    return MeshComponent;
+}
+
+USceneComponent* UInteractiveObjectComponent::GetEffectiveScaleComponent()
+{
+    if (ScaleTargetComponent.IsValid())
+    {
+        return ScaleTargetComponent.Get();
+    }
+
+    if (UStaticMeshComponent* MeshComponent = GetEffectiveMeshComponent())
+    {
+        return MeshComponent;
+    }
+
+    AActor* OwnerActor = GetOwner();
+    if (OwnerActor != nullptr)
+    {
+        return OwnerActor->GetRootComponent();
+    }
+
+    return nullptr;
+}
+
+void UInteractiveObjectComponent::InitializeDynamicMaterials()
+{
+    if (bAreDynamicMaterialsInitialized)
+    {
+        return;
+    }
+
+    UStaticMeshComponent* MeshComponent = GetEffectiveMeshComponent();
+    if (MeshComponent == nullptr)
+    {
+        LogMissingMeshIfNeeded();
+        return;
+    }
+
+    const int32 MaterialCount = MeshComponent->GetNumMaterials();
+    DynamicMaterialInstances.Reset();
+
+    // The mesh materials rarely read primitive data, so without the shared material the color would not show.
+    if (ColorMode == EInteractiveObjectColorMode::CustomPrimitiveData && PrimitiveDataMaterial == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectComponent on Actor '%s' uses custom primitive data without a Primitive Data Material. Falling back to dynamic material instances."),
+            *GetNameSafe(GetOwner())
+        );
+    }
+    else if (ColorMode == EInteractiveObjectColorMode::CustomPrimitiveData)
+    {
+        // Every object points at the same material, so none of them owns a material object of its own.
+        for (int32 MaterialIndex = 0; MaterialIndex < MaterialCount; ++MaterialIndex)
+        {
+            MeshComponent->SetMaterial(MaterialIndex, PrimitiveDataMaterial);
+        }
+
+        bUsesCustomPrimitiveData = true;
+        bAreDynamicMaterialsInitialized = true;
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectComponent on Actor '%s' writes its color to custom primitive data %d, shared material '%s'."),
+            *GetNameSafe(GetOwner()),
+            ColorPrimitiveDataIndex,
+            *GetNameSafe(PrimitiveDataMaterial)
+        );
+        return;
+    }
+
+    const UWorld* World = GetWorld();
+    UInteractiveObjectManagerSubsystem* ManagerSubsystem = (World != nullptr) ? World->GetSubsystem<UInteractiveObjectManagerSubsystem>() : nullptr;
+
+    if (ManagerSubsystem != nullptr && ManagerSubsystem->IsSharingDynamicMaterials())
+    {
+        // Slots receive their shared instance on the first color update.
+        SharedMaterialParents.Reset();
+
+        for (int32 MaterialIndex = 0; MaterialIndex < MaterialCount; ++MaterialIndex)
+        {
+            SharedMaterialParents.Add(MeshComponent->GetMaterial(MaterialIndex));
+        }
+
+        SharedMaterialSubsystem = ManagerSubsystem;
+        bUsesSharedDynamicMaterials = true;
+        bAreDynamicMaterialsInitialized = true;
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectComponent on Actor '%s' shares dynamic material instances for %d material slots."),
+            *GetNameSafe(GetOwner()),
+            SharedMaterialParents.Num()
+        );
+        return;
+    }
+
+    for (int32 MaterialIndex = 0; MaterialIndex < MaterialCount; ++MaterialIndex)
+    {
+        UMaterialInstanceDynamic* DynamicMaterial = MeshComponent->CreateAndSetMaterialInstanceDynamic(MaterialIndex);
+        if (DynamicMaterial != nullptr)
+        {
+            DynamicMaterialInstances.Add(DynamicMaterial);
+        }
+    }
+
+    bAreDynamicMaterialsInitialized = true;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("InteractiveObjectComponent on Actor '%s' initialized %d dynamic material instances."),
+        *GetNameSafe(GetOwner()),
+        DynamicMaterialInstances.Num()
+    );
+}
+
+void UInteractiveObjectComponent::UpdateMaterialColor(const FLinearColor& NewColor)
+{
+    if (!bAreDynamicMaterialsInitialized)
+    {
+        InitializeDynamicMaterials();
+    }
+
+    if (bUsesCustomPrimitiveData)
+    {
+        if (UStaticMeshComponent* MeshComponent = GetEffectiveMeshComponent())
+        {
+            MeshComponent->SetCustomPrimitiveDataVector4(FMath::Max(ColorPrimitiveDataIndex, 0), FVector4(NewColor));
+        }
+        return;
+    }
+
+    const FName ParameterName = ColorParameterName.IsNone() ? FName(TEXT("BaseColor")) : ColorParameterName;
+
+    if (bUsesSharedDynamicMaterials)
+    {
+        UpdateSharedMaterials(ParameterName, NewColor);
+        return;
+    }
+
+    if (DynamicMaterialInstances.Num() == 0)
+    {
+        return;
+    }
+
+    for (UMaterialInstanceDynamic* DynamicMaterial : DynamicMaterialInstances)
+    {
+        if (DynamicMaterial != nullptr)
+        {
+            DynamicMaterial->SetVectorParameterValue(ParameterName, NewColor);
+        }
+    }
+}
+
+void UInteractiveObjectComponent::UpdateSharedMaterials(FName ParameterName, const FLinearColor& NewColor)
+{
+    UInteractiveObjectManagerSubsystem* ManagerSubsystem = SharedMaterialSubsystem.Get();
+    UStaticMeshComponent* MeshComponent = GetEffectiveMeshComponent();
+    if (ManagerSubsystem == nullptr || MeshComponent == nullptr)
+    {
+        return;
+    }
+
+    SharedMaterialInstances.SetNum(SharedMaterialParents.Num());
+
+    for (int32 MaterialIndex = 0; MaterialIndex < SharedMaterialParents.Num(); ++MaterialIndex)
+    {
+        // Acquire before releasing, so that a color quantized to the same value keeps its instance.
+        UMaterialInstanceDynamic* SharedMaterial = ManagerSubsystem->AcquireSharedMaterial(SharedMaterialParents[MaterialIndex], ParameterName, NewColor);
+        ManagerSubsystem->ReleaseSharedMaterial(SharedMaterialInstances[MaterialIndex]);
+        SharedMaterialInstances[MaterialIndex] = SharedMaterial;
+
+        if (SharedMaterial != nullptr)
+        {
+            MeshComponent->SetMaterial(MaterialIndex, SharedMaterial);
+        }
+    }
+}
+
+void UInteractiveObjectComponent::ReleaseSharedMaterials()
+{
+    if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = SharedMaterialSubsystem.Get())
+    {
+        for (UMaterialInstanceDynamic* SharedMaterial : SharedMaterialInstances)
+        {
+            ManagerSubsystem->ReleaseSharedMaterial(SharedMaterial);
+        }
+    }
+
+    SharedMaterialInstances.Reset();
+}
+
+void UInteractiveObjectComponent::UpdateAppliedScale(float NewScale)
+{
+    USceneComponent* ScaleComponent = GetEffectiveScaleComponent();
+    const FVector NewScale3D(NewScale);
+
+    if (ScaleComponent != nullptr)
+    {
+        ScaleComponent->SetWorldScale3D(NewScale3D);
+    }
+    else if (AActor* OwnerActor = GetOwner())
+    {
+        OwnerActor->SetActorScale3D(NewScale3D);
+    }
+}
+
+void UInteractiveObjectComponent::RunColorModeBenchmark(int32 NumObjects)
+{
+    // Engine content, so the benchmark runs in any project. Both passes share the default surface material,
+    // the dynamic material pass creates one instance of it per component.
+    UStaticMesh* StaticMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+    UMaterialInterface* Material = UMaterial::GetDefaultMaterial(MD_Surface);
+
+    if (StaticMesh == nullptr || Material == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("IOM.Color.Benchmark: Engine cube mesh or default material is not available.")
+        );
+        return;
+    }
+
+    const FColorModeBenchmarkResult DynamicMaterialResult = RunColorModeBenchmarkPass(EInteractiveObjectColorMode::DynamicMaterial, NumObjects, StaticMesh, Material);
+    const FColorModeBenchmarkResult PrimitiveDataResult = RunColorModeBenchmarkPass(EInteractiveObjectColorMode::CustomPrimitiveData, NumObjects, StaticMesh, Material);
+
+    LogColorModeBenchmarkResult(TEXT("Dynamic material"), NumObjects, DynamicMaterialResult);
+    LogColorModeBenchmarkResult(TEXT("Custom primitive data"), NumObjects, PrimitiveDataResult);
+}
+
+void UInteractiveObjectComponent::RegisterWithManager()
+{
+    UWorld* World = GetWorld();
+    if (World == nullptr)
+    {
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>();
+    if (ManagerSubsystem == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectComponent '%s' on '%s' could not find InteractiveObjectManagerSubsystem."),
+            *GetName(),
+            *GetNameSafe(GetOwner())
+        );
+        return;
+    }
+
+    CachedManagerSubsystem = ManagerSubsystem;
+    ManagerSubsystem->RegisterInteractiveObject(this);
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("InteractiveObjectComponent '%s' registered owner '%s' with manager."),
+        *GetName(),
+        *GetNameSafe(GetOwner())
+    );
+}
+
+void UInteractiveObjectComponent::UnregisterFromManager()
+{
+    if (CachedManagerSubsystem.IsValid())
+    {
+        CachedManagerSubsystem->UnregisterInteractiveObject(this);
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectComponent '%s' unregistered owner '%s' from cached manager."),
+            *GetName(),
+            *GetNameSafe(GetOwner())
+        );
+
+        CachedManagerSubsystem.Reset();
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    if (World == nullptr)
+    {
+        return;
+    }
+
+    if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+    {
+        ManagerSubsystem->UnregisterInteractiveObject(this);
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectComponent '%s' unregistered owner '%s' from world manager."),
+            *GetName(),
+            *GetNameSafe(GetOwner())
+        );
+    }
+}
+
+void UInteractiveObjectComponent::LogMissingMeshIfNeeded()
+{
+    if (bHasLoggedMissingMesh)
+    {
+        return;
+    }
+
+    bHasLoggedMissingMesh = true;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Warning,
+        TEXT("InteractiveObjectComponent on Actor '%s' could not find a valid StaticMeshComponent. Color changes will be skipped."),
+        *GetNameSafe(GetOwner())
+    );
 }
\ No newline at end of file
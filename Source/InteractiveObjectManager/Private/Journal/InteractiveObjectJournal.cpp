@@ -0,0 +1,229 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Journal/InteractiveObjectJournal.h"
+#include "InteractiveObjectManagerLog.h"
+
+// Checked exactly so that a member with a stricter alignment cannot grow the record unnoticed.
+static_assert(sizeof(FInteractiveObjectJournalRecord) == 68, "Journal records are meant to stay compact.");
+
+void FInteractiveObjectJournalRecord::SetRotation(const FQuat& InRotation)
+{
+    Rotation[0] = static_cast<float>(InRotation.X);
+    Rotation[1] = static_cast<float>(InRotation.Y);
+    Rotation[2] = static_cast<float>(InRotation.Z);
+    Rotation[3] = static_cast<float>(InRotation.W);
+}
+
+FQuat FInteractiveObjectJournalRecord::GetRotation() const
+{
+    return FQuat(Rotation[0], Rotation[1], Rotation[2], Rotation[3]).GetNormalized();
+}
+
+void FInteractiveObjectJournal::Reset(int32 InCapacity)
+{
+    Records.Empty();
+    Head = 0;
+    NumRecords = 0;
+    NumUndoable = 0;
+    Capacity = FMath::Max(InCapacity, 0);
+    OverflowedBatch = 0;
+    Classes.Empty();
+}
+
+uint32 FInteractiveObjectJournal::BeginBatch(uint32 ContinueBatch)
+{
+    if (OpenBatchDepth++ == 0)
+    {
+        OpenBatch = (ContinueBatch != 0) ? ContinueBatch : NextBatch++;
+    }
+
+    return OpenBatch;
+}
+
+void FInteractiveObjectJournal::EndBatch()
+{
+    check(OpenBatchDepth > 0);
+
+    if (--OpenBatchDepth == 0)
+    {
+        OpenBatch = 0;
+    }
+}
+
+void FInteractiveObjectJournal::Add(FInteractiveObjectJournalRecord&& Record)
+{
+    if (Capacity == 0)
+    {
+        return;
+    }
+
+    Record.Batch = (OpenBatchDepth > 0) ? OpenBatch : NextBatch++;
+
+    if (Record.Batch == OverflowedBatch)
+    {
+        return;
+    }
+
+    // New history invalidates whatever was undone before.
+    NumRecords = NumUndoable;
+
+    if (NumRecords == Capacity && !DropOldestBatch(Record.Batch))
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectJournal: Batch of more than %d operations does not fit, undo history cleared."),
+            Capacity
+        );
+
+        OverflowedBatch = Record.Batch;
+        Head = 0;
+        NumRecords = 0;
+        NumUndoable = 0;
+        return;
+    }
+
+    // The ring only wraps once it reached capacity, so while growing the next slot is at most one past the end.
+    const int32 PhysicalIndex = (Head + NumRecords) % Capacity;
+    if (PhysicalIndex == Records.Num())
+    {
+        Records.Add(MoveTemp(Record));
+    }
+    else
+    {
+        Records[PhysicalIndex] = MoveTemp(Record);
+    }
+
+    ++NumRecords;
+    NumUndoable = NumRecords;
+}
+
+uint16 FInteractiveObjectJournal::FindOrAddClass(UClass* Class)
+{
+    const int32 ExistingIndex = Classes.IndexOfByKey(Class);
+    if (ExistingIndex != INDEX_NONE)
+    {
+        return static_cast<uint16>(ExistingIndex);
+    }
+
+    check(Classes.Num() < MAX_uint16);
+    return static_cast<uint16>(Classes.Add(Class));
+}
+
+UClass* FInteractiveObjectJournal::GetClass(uint16 ClassIndex) const
+{
+    return Classes.IsValidIndex(ClassIndex) ? Classes[ClassIndex].Get() : nullptr;
+}
+
+bool FInteractiveObjectJournal::PopUndoBatch(TArray<FInteractiveObjectJournalRecord>& OutRecords)
+{
+    OutRecords.Reset();
+
+    if (NumUndoable == 0)
+    {
+        return false;
+    }
+
+    const uint32 Batch = GetRecord(NumUndoable - 1).Batch;
+    while (NumUndoable > 0 && GetRecord(NumUndoable - 1).Batch == Batch)
+    {
+        OutRecords.Add(GetRecord(NumUndoable - 1));
+        --NumUndoable;
+    }
+
+    return true;
+}
+
+bool FInteractiveObjectJournal::PopRedoBatch(TArray<FInteractiveObjectJournalRecord>& OutRecords)
+{
+    OutRecords.Reset();
+
+    if (NumUndoable == NumRecords)
+    {
+        return false;
+    }
+
+    const uint32 Batch = GetRecord(NumUndoable).Batch;
+    while (NumUndoable < NumRecords && GetRecord(NumUndoable).Batch == Batch)
+    {
+        OutRecords.Add(GetRecord(NumUndoable));
+        ++NumUndoable;
+    }
+
+    return true;
+}
+
+void FInteractiveObjectJournal::RemapHandles(const TMap<FInteractiveObjectHandle, FInteractiveObjectHandle>& OldToNewHandles)
+{
+    if (OldToNewHandles.Num() == 0)
+    {
+        return;
+    }
+
+    for (int32 LogicalIndex = 0; LogicalIndex < NumRecords; ++LogicalIndex)
+    {
+        FInteractiveObjectJournalRecord& Record = GetRecord(LogicalIndex);
+        if (const FInteractiveObjectHandle* NewHandle = OldToNewHandles.Find(Record.Handle))
+        {
+            Record.Handle = *NewHandle;
+        }
+    }
+}
+
+bool FInteractiveObjectJournal::CanUndo() const
+{
+    return NumUndoable > 0;
+}
+
+bool FInteractiveObjectJournal::CanRedo() const
+{
+    return NumUndoable < NumRecords;
+}
+
+int32 FInteractiveObjectJournal::GetNumRecords() const
+{
+    return NumRecords;
+}
+
+int32 FInteractiveObjectJournal::GetNumUndoable() const
+{
+    return NumUndoable;
+}
+
+int32 FInteractiveObjectJournal::GetCapacity() const
+{
+    return Capacity;
+}
+
+SIZE_T FInteractiveObjectJournal::GetAllocatedSize() const
+{
+    return Records.GetAllocatedSize() + Classes.GetAllocatedSize();
+}
+
+FInteractiveObjectJournalRecord& FInteractiveObjectJournal::GetRecord(int32 LogicalIndex)
+{
+    return Records[(Head + LogicalIndex) % Records.Num()];
+}
+
+const FInteractiveObjectJournalRecord& FInteractiveObjectJournal::GetRecord(int32 LogicalIndex) const
+{
+    return Records[(Head + LogicalIndex) % Records.Num()];
+}
+
+bool FInteractiveObjectJournal::DropOldestBatch(uint32 Batch)
+{
+    const uint32 OldestBatch = GetRecord(0).Batch;
+    if (OldestBatch == Batch)
+    {
+        return false;
+    }
+
+    while (NumRecords > 0 && GetRecord(0).Batch == OldestBatch)
+    {
+        Head = (Head + 1) % Records.Num();
+        --NumRecords;
+        --NumUndoable;
+    }
+
+    return true;
+}
@@ -0,0 +1,112 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Materials/InteractiveObjectMaterialCache.h"
+
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialInterface.h"
+
+UMaterialInstanceDynamic* FInteractiveObjectMaterialCache::Acquire(UMaterialInterface* ParentMaterial, FName ParameterName, const FLinearColor& Color, UObject* Outer)
+{
+    if (ParentMaterial == nullptr)
+    {
+        return nullptr;
+    }
+
+    ++NumAcquires;
+
+    FInteractiveObjectSharedMaterialKey Key;
+    Key.ParentMaterial = ParentMaterial;
+    Key.ParameterName = ParameterName;
+    Key.Color = Color.ToFColor(true);
+
+    FInteractiveObjectSharedMaterial& Entry = Entries.FindOrAdd(Key);
+
+    if (Entry.MaterialInstance != nullptr)
+    {
+        ++NumHits;
+    }
+    else
+    {
+        // Every user of the instance sees the quantized color, whichever of them created it.
+        Entry.MaterialInstance = UMaterialInstanceDynamic::Create(ParentMaterial, Outer);
+        if (Entry.MaterialInstance == nullptr)
+        {
+            Entries.Remove(Key);
+            return nullptr;
+        }
+
+        Entry.MaterialInstance->SetVectorParameterValue(ParameterName, FLinearColor(Key.Color));
+        KeysByInstance.Add(Entry.MaterialInstance, Key);
+        ++NumCreated;
+    }
+
+    ++Entry.NumReferences;
+    ++NumReferences;
+
+    return Entry.MaterialInstance;
+}
+
+void FInteractiveObjectMaterialCache::Release(UMaterialInstanceDynamic* MaterialInstance)
+{
+    if (MaterialInstance == nullptr)
+    {
+        return;
+    }
+
+    const FInteractiveObjectSharedMaterialKey* Key = KeysByInstance.Find(MaterialInstance);
+    if (Key == nullptr)
+    {
+        return;
+    }
+
+    FInteractiveObjectSharedMaterial* Entry = Entries.Find(*Key);
+    if (Entry == nullptr || !ensure(Entry->NumReferences > 0))
+    {
+        return;
+    }
+
+    --NumReferences;
+
+    // Meshes still showing the instance keep it alive, the cache only stops handing it out.
+    if (--Entry->NumReferences == 0)
+    {
+        Entries.Remove(*Key);
+        KeysByInstance.Remove(MaterialInstance);
+    }
+}
+
+void FInteractiveObjectMaterialCache::Reset()
+{
+    Entries.Empty();
+    KeysByInstance.Empty();
+
+    NumReferences = 0;
+    NumAcquires = 0;
+    NumHits = 0;
+    NumCreated = 0;
+}
+
+int32 FInteractiveObjectMaterialCache::GetNumInstances() const
+{
+    return Entries.Num();
+}
+
+int32 FInteractiveObjectMaterialCache::GetNumReferences() const
+{
+    return NumReferences;
+}
+
+int64 FInteractiveObjectMaterialCache::GetNumAcquires() const
+{
+    return NumAcquires;
+}
+
+int64 FInteractiveObjectMaterialCache::GetNumHits() const
+{
+    return NumHits;
+}
+
+int64 FInteractiveObjectMaterialCache::GetNumCreated() const
+{
+    return NumCreated;
+}
@@ -0,0 +1,337 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Persistence/InteractiveObjectCheckpointStore.h"
+#include "InteractiveObjectManagerLog.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/** Fixed header in front of the compressed block of a segment file. */
+struct FInteractiveObjectCheckpointSegmentHeader
+{
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    uint64 Chain = 0;
+    uint32 Sequence = 0;
+    uint32 NumDeleted = 0;
+
+    /** Bytes of the scene file image at the start of the uncompressed block. Deleted Ids follow it. */
+    uint64 ImageSize = 0;
+
+    uint64 UncompressedSize = 0;
+    uint64 CompressedSize = 0;
+};
+
+static_assert(sizeof(FInteractiveObjectCheckpointSegmentHeader) == 48, "Checkpoint segment header layout is part of the file format.");
+
+/** Zero padded, so that sorting file names sorts segments by chain, then sequence. */
+static FString GetSegmentFileName(uint64 Chain, int32 Sequence)
+{
+    return FString::Printf(TEXT("%020llu_%06d.iomc"), Chain, Sequence);
+}
+
+/** Also parses the backup name a segment is left under if its replacement was interrupted. */
+static bool ParseSegmentFileName(const FString& FileName, uint64& OutChain, int32& OutSequence)
+{
+    FString SegmentFileName = FileName;
+    SegmentFileName.RemoveFromEnd(TEXT(".bak"));
+
+    FString ChainPart;
+    FString SequencePart;
+    if (!FPaths::GetBaseFilename(SegmentFileName).Split(TEXT("_"), &ChainPart, &SequencePart) || !ChainPart.IsNumeric() || !SequencePart.IsNumeric())
+    {
+        return false;
+    }
+
+    OutChain = FCString::Strtoui64(*ChainPart, nullptr, 10);
+    OutSequence = FCString::Atoi(*SequencePart);
+    return true;
+}
+
+/** Segment files in Directory, including those only left under their backup name. */
+static void FindSegmentFiles(const FString& Directory, TArray<FString>& OutFileNames)
+{
+    IFileManager::Get().FindFiles(OutFileNames, *(Directory / TEXT("*.iomc")), true, false);
+
+    TArray<FString> BackupFileNames;
+    IFileManager::Get().FindFiles(BackupFileNames, *(Directory / TEXT("*.iomc.bak")), true, false);
+    OutFileNames.Append(BackupFileNames);
+}
+
+/** Reads and decompresses one segment. OutBytes holds the scene image followed by the deleted Ids. */
+static bool ReadSegment(const FString& FilePath, FInteractiveObjectCheckpointSegmentHeader& OutHeader, TArray64<uint8>& OutBytes, FString& OutError)
+{
+    TArray64<uint8> FileBytes;
+    if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+    {
+        OutError = FString::Printf(TEXT("Failed to read '%s'."), *FilePath);
+        return false;
+    }
+
+    if (FileBytes.Num() < static_cast<int64>(sizeof(OutHeader)))
+    {
+        OutError = FString::Printf(TEXT("'%s' is too small to be a checkpoint segment."), *FilePath);
+        return false;
+    }
+
+    FMemory::Memcpy(&OutHeader, FileBytes.GetData(), sizeof(OutHeader));
+
+    const bool bIsSizeValid = OutHeader.CompressedSize == static_cast<uint64>(FileBytes.Num()) - sizeof(OutHeader)
+        && OutHeader.UncompressedSize <= static_cast<uint64>(MAX_int32)
+        && OutHeader.ImageSize + static_cast<uint64>(OutHeader.NumDeleted) * sizeof(int32) == OutHeader.UncompressedSize;
+
+    if (OutHeader.Magic != FInteractiveObjectCheckpointStore::SegmentMagic || OutHeader.Version != FInteractiveObjectCheckpointStore::CurrentVersion || !bIsSizeValid)
+    {
+        OutError = FString::Printf(TEXT("'%s' is not a valid checkpoint segment of version %u."), *FilePath, FInteractiveObjectCheckpointStore::CurrentVersion);
+        return false;
+    }
+
+    OutBytes.SetNumUninitialized(OutHeader.UncompressedSize);
+
+    if (!FCompression::UncompressMemory(
+        NAME_Oodle,
+        OutBytes.GetData(),
+        static_cast<int32>(OutHeader.UncompressedSize),
+        FileBytes.GetData() + sizeof(OutHeader),
+        static_cast<int32>(OutHeader.CompressedSize)))
+    {
+        OutError = FString::Printf(TEXT("'%s' failed to decompress."), *FilePath);
+        return false;
+    }
+
+    return true;
+}
+
+FString FInteractiveObjectCheckpointStore::GetDirectory()
+{
+    return FPaths::ProjectSavedDir() / TEXT("InteractiveObjects") / TEXT("Checkpoints");
+}
+
+FInteractiveObjectCheckpointWriteResult FInteractiveObjectCheckpointStore::WriteSegment(const FInteractiveObjectCheckpointData& Data)
+{
+    FInteractiveObjectCheckpointWriteResult Result;
+    Result.Chain = Data.Chain;
+    Result.Sequence = Data.Sequence;
+    Result.NumRecords = Data.Records.Num();
+    Result.NumDeleted = Data.DeletedObjectIds.Num();
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray64<uint8> Uncompressed;
+    FInteractiveObjectSceneFile::BuildImage(Data.Chain, Data.ClassPaths, Data.Records, Uncompressed);
+
+    const int64 ImageSize = Uncompressed.Num();
+    Uncompressed.Append(reinterpret_cast<const uint8*>(Data.DeletedObjectIds.GetData()), static_cast<int64>(Data.DeletedObjectIds.Num()) * sizeof(int32));
+
+    if (Uncompressed.Num() > MAX_int32)
+    {
+        Result.Error = FString::Printf(TEXT("Segment of %lld bytes is too large to compress as one block."), Uncompressed.Num());
+        return Result;
+    }
+
+    const int32 UncompressedSize = static_cast<int32>(Uncompressed.Num());
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, UncompressedSize);
+
+    TArray<uint8> FileBytes;
+    FileBytes.SetNumUninitialized(sizeof(FInteractiveObjectCheckpointSegmentHeader) + CompressedSize);
+
+    if (!FCompression::CompressMemory(NAME_Oodle, FileBytes.GetData() + sizeof(FInteractiveObjectCheckpointSegmentHeader), CompressedSize, Uncompressed.GetData(), UncompressedSize))
+    {
+        Result.Error = TEXT("Compression failed.");
+        return Result;
+    }
+
+    FInteractiveObjectCheckpointSegmentHeader Header;
+    Header.Magic = SegmentMagic;
+    Header.Version = CurrentVersion;
+    Header.Chain = Data.Chain;
+    Header.Sequence = static_cast<uint32>(Data.Sequence);
+    Header.NumDeleted = static_cast<uint32>(Data.DeletedObjectIds.Num());
+    Header.ImageSize = ImageSize;
+    Header.UncompressedSize = UncompressedSize;
+    Header.CompressedSize = CompressedSize;
+
+    FMemory::Memcpy(FileBytes.GetData(), &Header, sizeof(Header));
+    FileBytes.SetNum(sizeof(Header) + CompressedSize);
+
+    const double CompressedTime = FPlatformTime::Seconds();
+    Result.CompressSeconds = CompressedTime - StartTime;
+    Result.UncompressedBytes = UncompressedSize;
+    Result.CompressedBytes = FileBytes.Num();
+
+    const FString Directory = GetDirectory();
+    const FString FilePath = Directory / GetSegmentFileName(Data.Chain, Data.Sequence);
+
+    // Same sequence as a scene save: flushed temporary file, previous segment kept as a backup until replaced.
+    const bool bIsReplaced = FInteractiveObjectSceneFile::ReplaceFile(FilePath, [&FileBytes](IFileHandle& FileHandle)
+    {
+        return FileHandle.Write(FileBytes.GetData(), FileBytes.Num());
+    }, Result.Error);
+
+    if (!bIsReplaced)
+    {
+        return Result;
+    }
+
+    // A complete first segment supersedes every older chain.
+    if (Data.Sequence == 0)
+    {
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+        TArray<FString> FileNames;
+        FindSegmentFiles(Directory, FileNames);
+
+        for (const FString& FileName : FileNames)
+        {
+            uint64 Chain = 0;
+            int32 Sequence = 0;
+            if (ParseSegmentFileName(FileName, Chain, Sequence) && Chain != Data.Chain)
+            {
+                PlatformFile.DeleteFile(*(Directory / FileName));
+            }
+        }
+    }
+
+    Result.WriteSeconds = FPlatformTime::Seconds() - CompressedTime;
+    Result.bIsWritten = true;
+    return Result;
+}
+
+TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> FInteractiveObjectCheckpointStore::LoadLatest(int32& OutNumSegments, FString& OutError)
+{
+    OutNumSegments = 0;
+
+    const FString Directory = GetDirectory();
+
+    TArray<FString> FileNames;
+    FindSegmentFiles(Directory, FileNames);
+
+    // Newest chain whose first segment made it to disk.
+    uint64 LatestChain = 0;
+    bool bHasChain = false;
+    for (const FString& FileName : FileNames)
+    {
+        uint64 Chain = 0;
+        int32 Sequence = 0;
+        if (ParseSegmentFileName(FileName, Chain, Sequence) && Sequence == 0 && (!bHasChain || Chain > LatestChain))
+        {
+            LatestChain = Chain;
+            bHasChain = true;
+        }
+    }
+
+    if (!bHasChain)
+    {
+        OutError = FString::Printf(TEXT("No checkpoint found in '%s'."), *Directory);
+        return nullptr;
+    }
+
+    TArray<FString> ClassPaths;
+    TMap<FString, uint16> ClassIndices;
+
+    TArray<FInteractiveObjectSceneRecord> Records;
+    TBitArray<> RemovedRecords;
+    TMap<int32, int32> ObjectIdToRecord;
+
+    for (int32 ExpectedSequence = 0; ; ++ExpectedSequence)
+    {
+        const FString FilePath = FInteractiveObjectSceneFile::GetReadPath(Directory / GetSegmentFileName(LatestChain, ExpectedSequence));
+        if (!FPaths::FileExists(FilePath))
+        {
+            break;
+        }
+
+        FInteractiveObjectCheckpointSegmentHeader Header;
+        TArray64<uint8> Bytes;
+        FString SegmentError;
+
+        TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> Segment;
+        if (ReadSegment(FilePath, Header, Bytes, SegmentError))
+        {
+            // Deleted Ids are applied before the records, a segment never deletes and writes the same object.
+            TArray<int32> DeletedObjectIds;
+            DeletedObjectIds.SetNumUninitialized(Header.NumDeleted);
+            FMemory::Memcpy(DeletedObjectIds.GetData(), Bytes.GetData() + Header.ImageSize, Header.NumDeleted * sizeof(int32));
+
+            for (const int32 DeletedObjectId : DeletedObjectIds)
+            {
+                int32 RecordIndex = INDEX_NONE;
+                if (ObjectIdToRecord.RemoveAndCopyValue(DeletedObjectId, RecordIndex))
+                {
+                    RemovedRecords[RecordIndex] = true;
+                }
+            }
+
+            Segment = FInteractiveObjectSceneFile::FromMemory(MoveTemp(Bytes), SegmentError);
+        }
+
+        if (!Segment.IsValid())
+        {
+            // Later segments build on this one, so replay ends at the last segment that reads back.
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Warning,
+                TEXT("InteractiveObjectCheckpointStore: %s Changes from segment %d on are lost."),
+                *SegmentError,
+                ExpectedSequence
+            );
+            break;
+        }
+
+        TArray<uint16> SegmentToMergedClass;
+        for (const FString& ClassPath : Segment->GetClassPaths())
+        {
+            const uint16* ClassIndex = ClassIndices.Find(ClassPath);
+            if (ClassIndex == nullptr)
+            {
+                ClassIndex = &ClassIndices.Add(ClassPath, static_cast<uint16>(ClassPaths.Add(ClassPath)));
+            }
+            SegmentToMergedClass.Add(*ClassIndex);
+        }
+
+        for (int32 Index = 0; Index < Segment->Num(); ++Index)
+        {
+            FInteractiveObjectSceneRecord Record = Segment->GetRecord(Index);
+            if (!SegmentToMergedClass.IsValidIndex(Record.ClassIndex))
+            {
+                continue;
+            }
+            Record.ClassIndex = SegmentToMergedClass[Record.ClassIndex];
+
+            if (const int32* RecordIndex = ObjectIdToRecord.Find(Record.ObjectId))
+            {
+                Records[*RecordIndex] = Record;
+            }
+            else
+            {
+                ObjectIdToRecord.Add(Record.ObjectId, Records.Add(Record));
+                RemovedRecords.Add(false);
+            }
+        }
+
+        ++OutNumSegments;
+    }
+
+    if (OutNumSegments == 0)
+    {
+        OutError = FString::Printf(TEXT("The first segment of checkpoint %llu could not be read."), LatestChain);
+        return nullptr;
+    }
+
+    TArray<FInteractiveObjectSceneRecord> LiveRecords;
+    LiveRecords.Reserve(ObjectIdToRecord.Num());
+    for (int32 RecordIndex = 0; RecordIndex < Records.Num(); ++RecordIndex)
+    {
+        if (!RemovedRecords[RecordIndex])
+        {
+            LiveRecords.Add(Records[RecordIndex]);
+        }
+    }
+
+    TArray64<uint8> Image;
+    FInteractiveObjectSceneFile::BuildImage(LatestChain, ClassPaths, LiveRecords, Image);
+    return FInteractiveObjectSceneFile::FromMemory(MoveTemp(Image), OutError);
+}
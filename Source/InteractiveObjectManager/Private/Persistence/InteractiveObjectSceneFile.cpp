@@ -0,0 +1,482 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Persistence/InteractiveObjectSceneFile.h"
+#include "InteractiveObjectManagerLog.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static_assert(sizeof(FInteractiveObjectSceneFileHeader) == 64, "Scene file header layout is part of the file format.");
+static_assert(sizeof(FInteractiveObjectSceneRecord) == 48, "Scene record layout is part of the file format.");
+
+static FAutoConsoleCommand GInteractiveObjectSceneBenchmarkCommand(
+    TEXT("IOM.Scene.Benchmark"),
+    TEXT("Writes and reads back a synthetic scene file and logs throughput.\n")
+    TEXT("Usage: IOM.Scene.Benchmark [NumObjects=1000000]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumObjects = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 1000000;
+
+        FInteractiveObjectSceneFile::RunBenchmark(FMath::Max(NumObjects, 1));
+    })
+);
+
+void FInteractiveObjectSceneRecord::SetTransform(const FVector& InLocation, const FQuat& InRotation)
+{
+    Location[0] = static_cast<float>(InLocation.X);
+    Location[1] = static_cast<float>(InLocation.Y);
+    Location[2] = static_cast<float>(InLocation.Z);
+
+    Rotation[0] = static_cast<float>(InRotation.X);
+    Rotation[1] = static_cast<float>(InRotation.Y);
+    Rotation[2] = static_cast<float>(InRotation.Z);
+    Rotation[3] = static_cast<float>(InRotation.W);
+}
+
+FVector FInteractiveObjectSceneRecord::GetLocation() const
+{
+    return FVector(Location[0], Location[1], Location[2]);
+}
+
+FQuat FInteractiveObjectSceneRecord::GetRotation() const
+{
+    return FQuat(Rotation[0], Rotation[1], Rotation[2], Rotation[3]).GetNormalized();
+}
+
+FLinearColor FInteractiveObjectSceneRecord::GetColor() const
+{
+    return FLinearColor(Color.R.GetFloat(), Color.G.GetFloat(), Color.B.GetFloat(), Color.A.GetFloat());
+}
+
+FInteractiveObjectSceneFile::FInteractiveObjectSceneFile()
+    : Data(nullptr)
+    , Size(0)
+    , Records(nullptr)
+    , RecordStride(0)
+    , NumRecords(0)
+    , Version(0)
+    , Checkpoint(0)
+{
+}
+
+FInteractiveObjectSceneFile::~FInteractiveObjectSceneFile()
+{
+    // The region must be unmapped before its file handle closes.
+    MappedRegion.Reset();
+    MappedHandle.Reset();
+}
+
+TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> FInteractiveObjectSceneFile::Open(const FString& RequestedFilePath, FString& OutError)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    const FString FilePath = GetReadPath(RequestedFilePath);
+
+    const int64 FileSize = PlatformFile.FileSize(*FilePath);
+    if (FileSize < static_cast<int64>(sizeof(FInteractiveObjectSceneFileHeader)))
+    {
+        OutError = FString::Printf(TEXT("'%s' is missing or too small to be a scene file."), *FilePath);
+        return nullptr;
+    }
+
+    TSharedRef<FInteractiveObjectSceneFile, ESPMode::ThreadSafe> SceneFile = MakeShared<FInteractiveObjectSceneFile, ESPMode::ThreadSafe>();
+
+    FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*FilePath);
+    if (MappedResult.HasValue())
+    {
+        SceneFile->MappedHandle = MappedResult.StealValue();
+        SceneFile->MappedRegion.Reset(SceneFile->MappedHandle->MapRegion(0, FileSize));
+    }
+
+    if (SceneFile->MappedRegion.IsValid())
+    {
+        SceneFile->Data = SceneFile->MappedRegion->GetMappedPtr();
+        SceneFile->Size = SceneFile->MappedRegion->GetMappedSize();
+    }
+    else
+    {
+        // Platforms without memory mapping read the whole file instead.
+        SceneFile->MappedHandle.Reset();
+
+        if (!FFileHelper::LoadFileToArray(SceneFile->FallbackBytes, *FilePath))
+        {
+            OutError = FString::Printf(TEXT("Failed to read '%s'."), *FilePath);
+            return nullptr;
+        }
+
+        SceneFile->Data = SceneFile->FallbackBytes.GetData();
+        SceneFile->Size = SceneFile->FallbackBytes.Num();
+    }
+
+    if (!SceneFile->Parse(OutError))
+    {
+        OutError = FString::Printf(TEXT("'%s': %s"), *FilePath, *OutError);
+        return nullptr;
+    }
+
+    return SceneFile;
+}
+
+bool FInteractiveObjectSceneFile::Parse(FString& OutError)
+{
+    FInteractiveObjectSceneFileHeader Header;
+    FMemory::Memcpy(&Header, Data, sizeof(Header));
+
+    if (Header.Magic != SceneMagic)
+    {
+        OutError = TEXT("not a scene file.");
+        return false;
+    }
+
+    if (Header.Version == 0 || Header.Version > CurrentVersion)
+    {
+        OutError = FString::Printf(TEXT("unsupported version %u, this build reads up to %u."), Header.Version, CurrentVersion);
+        return false;
+    }
+
+    if (Header.HeaderSize < sizeof(Header) || Header.RecordSize < sizeof(FInteractiveObjectSceneRecord) || Header.NumObjects > static_cast<uint64>(MAX_int32))
+    {
+        OutError = TEXT("corrupt header.");
+        return false;
+    }
+
+    const uint64 ClassTableEnd = static_cast<uint64>(Header.HeaderSize) + Header.ClassTableSize;
+    const uint64 RecordsEnd = Header.RecordsOffset + Header.NumObjects * Header.RecordSize;
+    if (ClassTableEnd > Header.RecordsOffset || RecordsEnd > static_cast<uint64>(Size) || (Header.RecordsOffset % alignof(FInteractiveObjectSceneRecord)) != 0)
+    {
+        OutError = TEXT("truncated or corrupt.");
+        return false;
+    }
+
+    ClassPaths.Reset(Header.NumClasses);
+
+    uint64 Offset = Header.HeaderSize;
+    for (uint32 ClassIndex = 0; ClassIndex < Header.NumClasses; ++ClassIndex)
+    {
+        uint32 Length = 0;
+        if (Offset + sizeof(Length) > ClassTableEnd)
+        {
+            OutError = TEXT("corrupt class table.");
+            return false;
+        }
+
+        FMemory::Memcpy(&Length, Data + Offset, sizeof(Length));
+        Offset += sizeof(Length);
+
+        if (Offset + Length > ClassTableEnd)
+        {
+            OutError = TEXT("corrupt class table.");
+            return false;
+        }
+
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Offset), Length);
+        ClassPaths.Emplace(Converted.Length(), Converted.Get());
+        Offset += Length;
+    }
+
+    Records = Data + Header.RecordsOffset;
+    RecordStride = Header.RecordSize;
+    NumRecords = static_cast<int32>(Header.NumObjects);
+    Version = Header.Version;
+    Checkpoint = Header.Checkpoint;
+    return true;
+}
+
+TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> FInteractiveObjectSceneFile::FromMemory(TArray64<uint8>&& Bytes, FString& OutError)
+{
+    if (Bytes.Num() < static_cast<int64>(sizeof(FInteractiveObjectSceneFileHeader)))
+    {
+        OutError = TEXT("Scene image is too small to be a scene file.");
+        return nullptr;
+    }
+
+    TSharedRef<FInteractiveObjectSceneFile, ESPMode::ThreadSafe> SceneFile = MakeShared<FInteractiveObjectSceneFile, ESPMode::ThreadSafe>();
+    SceneFile->FallbackBytes = MoveTemp(Bytes);
+    SceneFile->Data = SceneFile->FallbackBytes.GetData();
+    SceneFile->Size = SceneFile->FallbackBytes.Num();
+
+    if (!SceneFile->Parse(OutError))
+    {
+        OutError = FString::Printf(TEXT("Scene image: %s"), *OutError);
+        return nullptr;
+    }
+
+    return SceneFile;
+}
+
+void FInteractiveObjectSceneFile::BuildPrefix(uint64 InCheckpoint, const TArray<FString>& InClassPaths, int32 InNumRecords, TArray<uint8>& OutPrefix)
+{
+    TArray<uint8> ClassTable;
+    for (const FString& ClassPath : InClassPaths)
+    {
+        const FTCHARToUTF8 Converted(*ClassPath);
+        const uint32 Length = static_cast<uint32>(Converted.Length());
+
+        ClassTable.Append(reinterpret_cast<const uint8*>(&Length), sizeof(Length));
+        ClassTable.Append(reinterpret_cast<const uint8*>(Converted.Get()), Length);
+    }
+
+    FInteractiveObjectSceneFileHeader Header;
+    Header.Magic = SceneMagic;
+    Header.Version = CurrentVersion;
+    Header.HeaderSize = sizeof(Header);
+    Header.RecordSize = sizeof(FInteractiveObjectSceneRecord);
+    Header.NumObjects = InNumRecords;
+    Header.RecordsOffset = Align(sizeof(Header) + ClassTable.Num(), SceneRecordsAlignment);
+    Header.NumClasses = InClassPaths.Num();
+    Header.ClassTableSize = ClassTable.Num();
+    Header.Checkpoint = InCheckpoint;
+
+    OutPrefix.Reset(static_cast<int32>(Header.RecordsOffset));
+    OutPrefix.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+    OutPrefix.Append(ClassTable);
+    OutPrefix.SetNumZeroed(static_cast<int32>(Header.RecordsOffset));
+}
+
+void FInteractiveObjectSceneFile::BuildImage(uint64 InCheckpoint, const TArray<FString>& InClassPaths, TConstArrayView<FInteractiveObjectSceneRecord> InRecords, TArray64<uint8>& OutBytes)
+{
+    TArray<uint8> Prefix;
+    BuildPrefix(InCheckpoint, InClassPaths, InRecords.Num(), Prefix);
+
+    const int64 RecordBytes = static_cast<int64>(InRecords.Num()) * sizeof(FInteractiveObjectSceneRecord);
+
+    OutBytes.Reset(Prefix.Num() + RecordBytes);
+    OutBytes.Append(Prefix.GetData(), Prefix.Num());
+    OutBytes.Append(reinterpret_cast<const uint8*>(InRecords.GetData()), RecordBytes);
+}
+
+bool FInteractiveObjectSceneFile::Write(const FString& FilePath, uint64 InCheckpoint, const TArray<FString>& InClassPaths, TConstArrayView<FInteractiveObjectSceneRecord> InRecords, FString& OutError)
+{
+    TArray<uint8> Prefix;
+    BuildPrefix(InCheckpoint, InClassPaths, InRecords.Num(), Prefix);
+
+    return ReplaceFile(FilePath, [&Prefix, InRecords](IFileHandle& FileHandle)
+    {
+        return FileHandle.Write(Prefix.GetData(), Prefix.Num())
+            && (InRecords.Num() == 0 || FileHandle.Write(reinterpret_cast<const uint8*>(InRecords.GetData()), static_cast<int64>(InRecords.Num()) * sizeof(FInteractiveObjectSceneRecord)));
+    }, OutError);
+}
+
+bool FInteractiveObjectSceneFile::ReplaceFile(const FString& FilePath, TFunctionRef<bool(IFileHandle&)> WriteContents, FString& OutError)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+    const FString TempFilePath = FilePath + TEXT(".tmp");
+
+    TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*TempFilePath));
+    if (!FileHandle.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Failed to open '%s' for writing."), *TempFilePath);
+        return false;
+    }
+
+    bool bIsWritten = WriteContents(*FileHandle);
+    bIsWritten = bIsWritten && FileHandle->Flush(true);
+
+    FileHandle.Reset();
+
+    if (!bIsWritten)
+    {
+        PlatformFile.DeleteFile(*TempFilePath);
+        OutError = FString::Printf(TEXT("Failed to write '%s'."), *TempFilePath);
+        return false;
+    }
+
+    // The previous file is moved aside rather than deleted, so a complete file exists at every point,
+    // under its own name or the backup name GetReadPath falls back to.
+    const FString BackupFilePath = GetBackupPath(FilePath);
+    const bool bHasPreviousFile = PlatformFile.FileExists(*FilePath);
+
+    if (bHasPreviousFile)
+    {
+        PlatformFile.DeleteFile(*BackupFilePath);
+
+        if (!PlatformFile.MoveFile(*BackupFilePath, *FilePath))
+        {
+            PlatformFile.DeleteFile(*TempFilePath);
+            OutError = FString::Printf(TEXT("Failed to replace '%s', it may be in use."), *FilePath);
+            return false;
+        }
+    }
+
+    if (!PlatformFile.MoveFile(*FilePath, *TempFilePath))
+    {
+        if (bHasPreviousFile)
+        {
+            PlatformFile.MoveFile(*FilePath, *BackupFilePath);
+        }
+
+        OutError = FString::Printf(TEXT("Failed to move '%s' to '%s'."), *TempFilePath, *FilePath);
+        return false;
+    }
+
+    if (bHasPreviousFile)
+    {
+        PlatformFile.DeleteFile(*BackupFilePath);
+    }
+
+    return true;
+}
+
+FString FInteractiveObjectSceneFile::GetDefaultPath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("InteractiveObjects") / TEXT("Scene.iom");
+}
+
+FString FInteractiveObjectSceneFile::GetBackupPath(const FString& FilePath)
+{
+    return FilePath + TEXT(".bak");
+}
+
+FString FInteractiveObjectSceneFile::GetReadPath(const FString& FilePath)
+{
+    // A replacement interrupted between its two moves leaves only the previous file, under its backup name.
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    const FString BackupFilePath = GetBackupPath(FilePath);
+    return (!PlatformFile.FileExists(*FilePath) && PlatformFile.FileExists(*BackupFilePath)) ? BackupFilePath : FilePath;
+}
+
+int32 FInteractiveObjectSceneFile::Num() const
+{
+    return NumRecords;
+}
+
+const FInteractiveObjectSceneRecord& FInteractiveObjectSceneFile::GetRecord(int32 Index) const
+{
+    check(Index >= 0 && Index < NumRecords);
+    return *reinterpret_cast<const FInteractiveObjectSceneRecord*>(Records + Index * RecordStride);
+}
+
+const TArray<FString>& FInteractiveObjectSceneFile::GetClassPaths() const
+{
+    return ClassPaths;
+}
+
+uint32 FInteractiveObjectSceneFile::GetVersion() const
+{
+    return Version;
+}
+
+uint64 FInteractiveObjectSceneFile::GetCheckpoint() const
+{
+    return Checkpoint;
+}
+
+bool FInteractiveObjectSceneFile::IsMapped() const
+{
+    return MappedRegion.IsValid();
+}
+
+int64 FInteractiveObjectSceneFile::GetSize() const
+{
+    return Size;
+}
+
+void FInteractiveObjectSceneFile::RunBenchmark(int32 NumObjects)
+{
+    const FString FilePath = FPaths::ProjectSavedDir() / TEXT("InteractiveObjects") / TEXT("Benchmark.iom");
+
+    TArray<FString> BenchmarkClassPaths;
+    BenchmarkClassPaths.Add(TEXT("/Script/Engine.StaticMeshActor"));
+    BenchmarkClassPaths.Add(TEXT("/Script/Engine.Actor"));
+
+    FRandomStream RandomStream(NumObjects);
+
+    TArray<FInteractiveObjectSceneRecord> SourceRecords;
+    SourceRecords.SetNum(NumObjects);
+    for (int32 Index = 0; Index < NumObjects; ++Index)
+    {
+        FInteractiveObjectSceneRecord& Record = SourceRecords[Index];
+        Record.SetTransform(RandomStream.GetUnitVector() * 100000.0, FQuat(FRotator(0.0, RandomStream.FRandRange(0.0, 360.0), 0.0)));
+        Record.UniformScale = RandomStream.FRandRange(0.5f, 2.0f);
+        Record.Color = FFloat16Color(FLinearColor::MakeRandomColor());
+        Record.ClassIndex = static_cast<uint16>(Index % BenchmarkClassPaths.Num());
+        Record.ObjectId = Index + 1;
+    }
+
+    FString Error;
+
+    const double WriteStartTime = FPlatformTime::Seconds();
+    const bool bIsWritten = Write(FilePath, 0, BenchmarkClassPaths, SourceRecords, Error);
+    const double WriteSeconds = FPlatformTime::Seconds() - WriteStartTime;
+
+    if (!bIsWritten)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Error,
+            TEXT("IOM.Scene.Benchmark: %s"),
+            *Error
+        );
+        return;
+    }
+
+    const double OpenStartTime = FPlatformTime::Seconds();
+    TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> SceneFile = Open(FilePath, Error);
+    const double OpenSeconds = FPlatformTime::Seconds() - OpenStartTime;
+
+    if (!SceneFile.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Error,
+            TEXT("IOM.Scene.Benchmark: %s"),
+            *Error
+        );
+        return;
+    }
+
+    // Touch every record the way a load does, and compare against what was written.
+    int32 Mismatches = (SceneFile->Num() == NumObjects) ? 0 : 1;
+
+    const double ReadStartTime = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < SceneFile->Num() && Index < NumObjects; ++Index)
+    {
+        const FInteractiveObjectSceneRecord& Record = SceneFile->GetRecord(Index);
+        const FInteractiveObjectSceneRecord& Source = SourceRecords[Index];
+
+        if (Record.ClassIndex != Source.ClassIndex || Record.UniformScale != Source.UniformScale || !Record.GetLocation().Equals(Source.GetLocation(), 0.0))
+        {
+            ++Mismatches;
+        }
+    }
+    const double ReadSeconds = FPlatformTime::Seconds() - ReadStartTime;
+
+    const double FileMegabytes = SceneFile->GetSize() / (1024.0 * 1024.0);
+    const bool bIsMapped = SceneFile->IsMapped();
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("IOM.Scene.Benchmark: %d objects, %.1f MB. Write %.1f ms (%.0f MB/s). Open %.2f ms (%s). Read %.1f ms (%.0f MB/s, %.1f M objects per second). %d mismatches."),
+        NumObjects,
+        FileMegabytes,
+        WriteSeconds * 1000.0,
+        (WriteSeconds > 0.0) ? FileMegabytes / WriteSeconds : 0.0,
+        OpenSeconds * 1000.0,
+        bIsMapped ? TEXT("memory mapped") : TEXT("read into memory"),
+        ReadSeconds * 1000.0,
+        (ReadSeconds > 0.0) ? FileMegabytes / ReadSeconds : 0.0,
+        (ReadSeconds > 0.0) ? NumObjects / ReadSeconds / 1000000.0 : 0.0,
+        Mismatches
+    );
+
+    if (Mismatches > 0)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Error,
+            TEXT("IOM.Scene.Benchmark: records read back do not match the ones written.")
+        );
+    }
+
+    // Unmap before deleting, some platforms refuse to delete a mapped file.
+    SceneFile.Reset();
+    FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*FilePath);
+}
@@ -0,0 +1,658 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Persistence/InteractiveObjectWriteAheadLog.h"
+#include "InteractiveObjectManagerLog.h"
+
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Memory/MemoryView.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/** File header, part of the file format. */
+struct FInteractiveObjectWalFileHeader
+{
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    uint64 BaseCheckpoint = 0;
+};
+
+static_assert(sizeof(FInteractiveObjectWalFileHeader) == 16, "Write-ahead log header layout is part of the file format.");
+
+/** Payload size and CRC32 in front of every frame. */
+static constexpr int64 WalFrameHeaderSize = 2 * sizeof(uint32);
+
+static FAutoConsoleCommand GInteractiveObjectWalBenchmarkCommand(
+    TEXT("IOM.WAL.Benchmark"),
+    TEXT("Appends records to a temporary write-ahead log under every fsync policy and logs producer cost and writer throughput.\n")
+    TEXT("Usage: IOM.WAL.Benchmark [NumRecords=200000]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumRecords = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 200000;
+
+        FInteractiveObjectWriteAheadLog::RunBenchmark(FMath::Max(NumRecords, 1));
+    })
+);
+
+/** Reads or writes the payload of one frame. Only the fields used by the operation are stored. ClassPath is used by DefineClass only. */
+static void SerializeWalRecord(FArchive& Ar, FInteractiveObjectWalRecord& Record, FString& ClassPath)
+{
+    uint8 Op = static_cast<uint8>(Record.Op);
+    Ar << Op;
+    Record.Op = static_cast<EInteractiveObjectWalOp>(Op);
+
+    Ar << Record.ObjectId;
+
+    switch (Record.Op)
+    {
+    case EInteractiveObjectWalOp::DefineClass:
+        Ar << Record.ClassIndex;
+        Ar << ClassPath;
+        break;
+
+    case EInteractiveObjectWalOp::Spawn:
+        Ar << Record.ClassIndex;
+        Ar << Record.Color;
+        Ar << Record.UniformScale;
+        Ar << Record.Location;
+        Ar << Record.Rotation;
+        break;
+
+    case EInteractiveObjectWalOp::Delete:
+        break;
+
+    case EInteractiveObjectWalOp::SetColor:
+        Ar << Record.Color;
+        break;
+
+    case EInteractiveObjectWalOp::SetScale:
+        Ar << Record.UniformScale;
+        break;
+
+    default:
+        Ar.SetError();
+        break;
+    }
+}
+
+FInteractiveObjectWriteAheadLog::FInteractiveObjectWriteAheadLog()
+    : Thread(nullptr)
+    , WakeEvent(nullptr)
+    , OverflowHead(0)
+    , bHasDroppedRecords(false)
+    , LastFsyncTime(0.0)
+    , bHasUnsyncedCommits(false)
+    , bIsStopRequested(false)
+    , bHasFailed(false)
+    , NumAppended(0)
+    , NumStalls(0)
+    , NumDropped(0)
+    , NumCommitted(0)
+    , NumGroupCommits(0)
+    , NumFsyncs(0)
+    , BytesWritten(0)
+{
+}
+
+FInteractiveObjectWriteAheadLog::~FInteractiveObjectWriteAheadLog()
+{
+    Close();
+}
+
+bool FInteractiveObjectWriteAheadLog::Open(const FString& FilePath, uint64 BaseCheckpoint, const FInteractiveObjectWalSettings& Settings, FString& OutError)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+    FileHandle.Reset(PlatformFile.OpenWrite(*FilePath));
+    if (!FileHandle.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Failed to open '%s' for writing."), *FilePath);
+        return false;
+    }
+
+    FInteractiveObjectWalFileHeader Header;
+    Header.Magic = LogMagic;
+    Header.Version = CurrentVersion;
+    Header.BaseCheckpoint = BaseCheckpoint;
+
+    // The header is made durable right away, so a log is never left without one.
+    if (!FileHandle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header)) || !FileHandle->Flush(true))
+    {
+        FileHandle.Reset();
+        OutError = FString::Printf(TEXT("Failed to write '%s'."), *FilePath);
+        return false;
+    }
+
+    ActiveSettings = Settings;
+    ActiveSettings.GroupCommitMilliseconds = FMath::Max(ActiveSettings.GroupCommitMilliseconds, 1);
+    ActiveSettings.FsyncIntervalMilliseconds = FMath::Max(ActiveSettings.FsyncIntervalMilliseconds, 0);
+    ActiveSettings.OverflowCapacity = FMath::Max(ActiveSettings.OverflowCapacity, 0);
+
+    Queue = MakeUnique<TCircularQueue<FInteractiveObjectWalRecord>>(static_cast<uint32>(FMath::Max(ActiveSettings.QueueCapacity, 2)) + 1);
+    Overflow.Empty(ActiveSettings.OverflowCapacity);
+    OverflowHead = 0;
+    bHasDroppedRecords = false;
+
+    {
+        FScopeLock Lock(&ClassPathsLock);
+        ClassPaths.Reset();
+    }
+
+    NumAppended = 0;
+    NumStalls = 0;
+    NumDropped = 0;
+    NumCommitted = 0;
+    NumGroupCommits = 0;
+    NumFsyncs = 1;
+    BytesWritten = sizeof(Header);
+    LastFsyncTime = FPlatformTime::Seconds();
+    bHasUnsyncedCommits = false;
+
+    bIsStopRequested = false;
+    bHasFailed = false;
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("InteractiveObjectWriteAheadLog"), 0, TPri_BelowNormal);
+
+    return true;
+}
+
+void FInteractiveObjectWriteAheadLog::Close()
+{
+    if (Thread != nullptr)
+    {
+        // Run commits whatever is still queued before it returns.
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+
+        // The writer is gone, so the overflow is committed here, one ring at a time.
+        while (!MoveOverflowToQueue())
+        {
+            CommitPending();
+        }
+
+        CommitPending();
+    }
+
+    if (WakeEvent != nullptr)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+
+    if (FileHandle.IsValid())
+    {
+        if (!bHasFailed.load() && !FileHandle->Flush(true))
+        {
+            MarkFailed(TEXT("fsync on close"), 0);
+        }
+
+        FileHandle.Reset();
+    }
+
+    Queue.Reset();
+}
+
+bool FInteractiveObjectWriteAheadLog::IsOpen() const
+{
+    return Queue.IsValid();
+}
+
+bool FInteractiveObjectWriteAheadLog::HasFailed() const
+{
+    return bHasFailed.load(std::memory_order_acquire);
+}
+
+void FInteractiveObjectWriteAheadLog::MarkFailed(const TCHAR* What, int64 NumRecords)
+{
+    if (bHasFailed.exchange(true, std::memory_order_acq_rel))
+    {
+        return;
+    }
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Error,
+        TEXT("InteractiveObjectWriteAheadLog: %s failed with %lld records in flight. Only the %lld records committed before are durable, logging stops."),
+        What,
+        NumRecords,
+        NumCommitted.load()
+    );
+}
+
+void FInteractiveObjectWriteAheadLog::Append(const FInteractiveObjectWalRecord& Record)
+{
+    if (!Queue.IsValid())
+    {
+        return;
+    }
+
+    if (bHasDroppedRecords || bHasFailed.load(std::memory_order_relaxed))
+    {
+        ++NumDropped;
+        return;
+    }
+
+    // Records already waiting go first, so the log keeps the append order.
+    if (!MoveOverflowToQueue() || !Queue->Enqueue(Record))
+    {
+        // The writer fell a full queue behind. The record waits here instead of the caller.
+        if (Overflow.Num() == ActiveSettings.OverflowCapacity && OverflowHead > 0)
+        {
+            Overflow.RemoveAt(0, OverflowHead, EAllowShrinking::No);
+            OverflowHead = 0;
+        }
+
+        if (Overflow.Num() >= ActiveSettings.OverflowCapacity)
+        {
+            bHasDroppedRecords = true;
+            ++NumDropped;
+
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Error,
+                TEXT("InteractiveObjectWriteAheadLog: Queue and overflow are full after %lld records, the writer is stalled. Logging stops here, later changes are not recoverable."),
+                NumAppended
+            );
+            return;
+        }
+
+        Overflow.Add(Record);
+        ++NumStalls;
+        WakeEvent->Trigger();
+    }
+
+    ++NumAppended;
+}
+
+uint16 FInteractiveObjectWriteAheadLog::DefineClass(const FString& ClassPath)
+{
+    FInteractiveObjectWalRecord Record;
+    Record.Op = EInteractiveObjectWalOp::DefineClass;
+
+    {
+        FScopeLock Lock(&ClassPathsLock);
+        Record.ClassIndex = static_cast<uint16>(ClassPaths.Add(ClassPath));
+    }
+
+    Append(Record);
+    return Record.ClassIndex;
+}
+
+void FInteractiveObjectWriteAheadLog::DrainOverflow()
+{
+    if (Queue.IsValid() && !MoveOverflowToQueue())
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+bool FInteractiveObjectWriteAheadLog::MoveOverflowToQueue()
+{
+    while (OverflowHead < Overflow.Num())
+    {
+        if (!Queue->Enqueue(Overflow[OverflowHead]))
+        {
+            return false;
+        }
+
+        ++OverflowHead;
+    }
+
+    if (OverflowHead > 0)
+    {
+        Overflow.Reset();
+        OverflowHead = 0;
+    }
+
+    return true;
+}
+
+uint32 FInteractiveObjectWriteAheadLog::Run()
+{
+    while (!bIsStopRequested.load(std::memory_order_acquire))
+    {
+        WakeEvent->Wait(ActiveSettings.GroupCommitMilliseconds);
+        CommitPending();
+    }
+
+    CommitPending();
+    return 0;
+}
+
+void FInteractiveObjectWriteAheadLog::Stop()
+{
+    bIsStopRequested.store(true, std::memory_order_release);
+
+    if (WakeEvent != nullptr)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+void FInteractiveObjectWriteAheadLog::CommitPending()
+{
+    // Nothing written after a failure could be trusted, so queued records are discarded instead.
+    if (bHasFailed.load(std::memory_order_acquire))
+    {
+        FInteractiveObjectWalRecord DiscardedRecord;
+        while (Queue->Dequeue(DiscardedRecord))
+        {
+        }
+        return;
+    }
+
+    CommitBuffer.Reset();
+    int64 CommittedCount = 0;
+
+    FMemoryWriter Writer(CommitBuffer);
+    FInteractiveObjectWalRecord Record;
+    FString ClassPath;
+
+    while (Queue->Dequeue(Record))
+    {
+        ClassPath.Reset();
+        if (Record.Op == EInteractiveObjectWalOp::DefineClass)
+        {
+            FScopeLock Lock(&ClassPathsLock);
+            if (ClassPaths.IsValidIndex(Record.ClassIndex))
+            {
+                ClassPath = ClassPaths[Record.ClassIndex];
+            }
+        }
+
+        const int64 FrameStart = Writer.Tell();
+
+        uint32 PayloadSize = 0;
+        uint32 Checksum = 0;
+        Writer << PayloadSize;
+        Writer << Checksum;
+
+        SerializeWalRecord(Writer, Record, ClassPath);
+
+        const uint8* Payload = CommitBuffer.GetData() + FrameStart + WalFrameHeaderSize;
+        PayloadSize = static_cast<uint32>(Writer.Tell() - FrameStart - WalFrameHeaderSize);
+        Checksum = FCrc::MemCrc32(Payload, PayloadSize);
+
+        FMemory::Memcpy(CommitBuffer.GetData() + FrameStart, &PayloadSize, sizeof(PayloadSize));
+        FMemory::Memcpy(CommitBuffer.GetData() + FrameStart + sizeof(PayloadSize), &Checksum, sizeof(Checksum));
+
+        ++CommittedCount;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    const bool bHasDataToSync = (CommittedCount > 0) || bHasUnsyncedCommits;
+
+    bool bShouldFsync = false;
+    switch (ActiveSettings.FsyncPolicy)
+    {
+    case EInteractiveObjectWalFsyncPolicy::EveryCommit:
+        bShouldFsync = bHasDataToSync;
+        break;
+
+    case EInteractiveObjectWalFsyncPolicy::Interval:
+        // Also checked while idle, so the last commit before a pause is synced once the interval is up.
+        bShouldFsync = bHasDataToSync && (Now - LastFsyncTime) * 1000.0 >= ActiveSettings.FsyncIntervalMilliseconds;
+        break;
+
+    default:
+        break;
+    }
+
+    if (CommittedCount > 0)
+    {
+        if (!FileHandle->Write(CommitBuffer.GetData(), CommitBuffer.Num()))
+        {
+            MarkFailed(TEXT("Write"), CommittedCount);
+            return;
+        }
+
+        ++NumGroupCommits;
+        BytesWritten += CommitBuffer.Num();
+        bHasUnsyncedCommits = true;
+    }
+
+    if (bShouldFsync)
+    {
+        if (!FileHandle->Flush(true))
+        {
+            MarkFailed(TEXT("Fsync"), CommittedCount);
+            return;
+        }
+
+        ++NumFsyncs;
+        LastFsyncTime = Now;
+        bHasUnsyncedCommits = false;
+    }
+    else if (CommittedCount > 0)
+    {
+        // Hands the commit to the operating system, which is enough to survive a crash of the process.
+        if (!FileHandle->Flush(false))
+        {
+            MarkFailed(TEXT("Flush"), CommittedCount);
+            return;
+        }
+    }
+
+    // Counted only once the records reached the file, and the disk when the policy asks for it.
+    NumCommitted += CommittedCount;
+}
+
+bool FInteractiveObjectWriteAheadLog::Replay(const FString& FilePath, uint64 ExpectedBaseCheckpoint, TFunctionRef<void(const FInteractiveObjectWalRecord& Record, const FString& ClassPath)> Visitor, int32& OutNumRecords, FString& OutError)
+{
+    OutNumRecords = 0;
+
+    TArray64<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        OutError = FString::Printf(TEXT("Failed to read '%s'."), *FilePath);
+        return false;
+    }
+
+    FInteractiveObjectWalFileHeader Header;
+    if (Bytes.Num() < static_cast<int64>(sizeof(Header)))
+    {
+        OutError = FString::Printf(TEXT("'%s' is too small to be a write-ahead log."), *FilePath);
+        return false;
+    }
+
+    FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+
+    if (Header.Magic != LogMagic || Header.Version != CurrentVersion)
+    {
+        OutError = FString::Printf(TEXT("'%s' is not a write-ahead log of version %u."), *FilePath, CurrentVersion);
+        return false;
+    }
+
+    if (Header.BaseCheckpoint != ExpectedBaseCheckpoint)
+    {
+        OutError = FString::Printf(
+            TEXT("'%s' continues checkpoint %llu but the scene is at checkpoint %llu, its changes are already saved."),
+            *FilePath,
+            Header.BaseCheckpoint,
+            ExpectedBaseCheckpoint
+        );
+        return false;
+    }
+
+    int64 Offset = sizeof(Header);
+    while (Offset + WalFrameHeaderSize <= Bytes.Num())
+    {
+        uint32 PayloadSize = 0;
+        uint32 Checksum = 0;
+        FMemory::Memcpy(&PayloadSize, Bytes.GetData() + Offset, sizeof(PayloadSize));
+        FMemory::Memcpy(&Checksum, Bytes.GetData() + Offset + sizeof(PayloadSize), sizeof(Checksum));
+
+        const uint8* Payload = Bytes.GetData() + Offset + WalFrameHeaderSize;
+        if (Offset + WalFrameHeaderSize + PayloadSize > Bytes.Num() || FCrc::MemCrc32(Payload, PayloadSize) != Checksum)
+        {
+            break;
+        }
+
+        FMemoryReaderView Reader(FMemoryView(Payload, PayloadSize));
+        FInteractiveObjectWalRecord Record;
+        FString ClassPath;
+        SerializeWalRecord(Reader, Record, ClassPath);
+        if (Reader.IsError())
+        {
+            break;
+        }
+
+        Visitor(Record, ClassPath);
+        ++OutNumRecords;
+
+        Offset += WalFrameHeaderSize + PayloadSize;
+    }
+
+    if (Offset != Bytes.Num())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectWriteAheadLog: Ignored %lld bytes of torn or corrupt records at the end of '%s'."),
+            Bytes.Num() - Offset,
+            *FilePath
+        );
+    }
+
+    return true;
+}
+
+FString FInteractiveObjectWriteAheadLog::GetPathForScene(const FString& SceneFilePath)
+{
+    return FPaths::ChangeExtension(SceneFilePath, TEXT("wal"));
+}
+
+void FInteractiveObjectWriteAheadLog::RunBenchmark(int32 NumRecords)
+{
+    const FString FilePath = FPaths::ProjectSavedDir() / TEXT("InteractiveObjects") / TEXT("Benchmark.wal");
+
+    const EInteractiveObjectWalFsyncPolicy Policies[] =
+    {
+        EInteractiveObjectWalFsyncPolicy::Never,
+        EInteractiveObjectWalFsyncPolicy::Interval,
+        EInteractiveObjectWalFsyncPolicy::EveryCommit
+    };
+
+    for (const EInteractiveObjectWalFsyncPolicy Policy : Policies)
+    {
+        FInteractiveObjectWalSettings Settings;
+        Settings.FsyncPolicy = Policy;
+
+        FInteractiveObjectWriteAheadLog Log;
+
+        FString Error;
+        if (!Log.Open(FilePath, 1, Settings, Error))
+        {
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Warning,
+                TEXT("IOM.WAL.Benchmark: %s"),
+                *Error
+            );
+            return;
+        }
+
+        FInteractiveObjectWalRecord Record;
+        double LongestAppendSeconds = 0.0;
+
+        const double AppendStartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumRecords; ++Index)
+        {
+            Record.Op = (Index % 2 == 0) ? EInteractiveObjectWalOp::SetColor : EInteractiveObjectWalOp::SetScale;
+            Record.ObjectId = Index + 1;
+            Record.UniformScale = 1.0f + (Index % 100) * 0.01f;
+
+            const double RecordStartTime = FPlatformTime::Seconds();
+            Log.Append(Record);
+            LongestAppendSeconds = FMath::Max(LongestAppendSeconds, FPlatformTime::Seconds() - RecordStartTime);
+        }
+        const double AppendSeconds = FPlatformTime::Seconds() - AppendStartTime;
+
+        Log.Close();
+        const double TotalSeconds = FPlatformTime::Seconds() - AppendStartTime;
+
+        int32 ReplayedCount = 0;
+        int32 Mismatches = 0;
+        Replay(FilePath, 1, [&ReplayedCount, &Mismatches](const FInteractiveObjectWalRecord& ReplayedRecord, const FString& ClassPath)
+        {
+            if (ReplayedRecord.ObjectId != ReplayedCount + 1)
+            {
+                ++Mismatches;
+            }
+            ++ReplayedCount;
+        }, ReplayedCount, Error);
+
+        const double FileMegabytes = Log.GetBytesWritten() / (1024.0 * 1024.0);
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("IOM.WAL.Benchmark: fsync policy %d, %d records. Append %.1f ns per record, longest %.1f us, %lld stalls. Durable after %.1f ms (%.0f MB/s), %lld group commits averaging %.0f records, %lld fsyncs. Replayed %d, %d mismatches."),
+            static_cast<int32>(Policy),
+            NumRecords,
+            AppendSeconds * 1.0e9 / NumRecords,
+            LongestAppendSeconds * 1.0e6,
+            Log.GetNumStalls(),
+            TotalSeconds * 1000.0,
+            (TotalSeconds > 0.0) ? FileMegabytes / TotalSeconds : 0.0,
+            Log.GetNumGroupCommits(),
+            (Log.GetNumGroupCommits() > 0) ? static_cast<double>(Log.GetNumCommitted()) / Log.GetNumGroupCommits() : 0.0,
+            Log.GetNumFsyncs(),
+            ReplayedCount,
+            Mismatches
+        );
+    }
+
+    FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*FilePath);
+}
+
+int64 FInteractiveObjectWriteAheadLog::GetNumAppended() const
+{
+    return NumAppended;
+}
+
+int64 FInteractiveObjectWriteAheadLog::GetNumCommitted() const
+{
+    return NumCommitted.load();
+}
+
+int64 FInteractiveObjectWriteAheadLog::GetNumGroupCommits() const
+{
+    return NumGroupCommits.load();
+}
+
+int64 FInteractiveObjectWriteAheadLog::GetNumFsyncs() const
+{
+    return NumFsyncs.load();
+}
+
+int64 FInteractiveObjectWriteAheadLog::GetBytesWritten() const
+{
+    return BytesWritten.load();
+}
+
+int64 FInteractiveObjectWriteAheadLog::GetNumStalls() const
+{
+    return NumStalls;
+}
+
+int32 FInteractiveObjectWriteAheadLog::GetNumOverflowed() const
+{
+    return Overflow.Num() - OverflowHead;
+}
+
+int64 FInteractiveObjectWriteAheadLog::GetNumDropped() const
+{
+    return NumDropped;
+}
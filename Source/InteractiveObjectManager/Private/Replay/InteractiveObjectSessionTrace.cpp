@@ -0,0 +1,235 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Replay/InteractiveObjectSessionTrace.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static void SerializeSettings(FArchive& Ar, FInteractiveObjectSettingsViewData& Settings)
+{
+    uint8 SpawnType = static_cast<uint8>(Settings.DefaultSpawnType);
+    Ar << SpawnType;
+    Ar << Settings.DefaultColor;
+    Ar << Settings.DefaultUniformScale;
+
+    Settings.DefaultSpawnType = static_cast<EInteractiveObjectSpawnType>(SpawnType);
+}
+
+static void SerializeBatchParams(FArchive& Ar, FInteractiveObjectBatchSpawnParams& Params)
+{
+    Ar << Params.FrameBudgetMilliseconds;
+    Ar << Params.SpawnRadius;
+    Ar << Params.SpawnHeight;
+    Ar << Params.bOverrideColor;
+    Ar << Params.Color;
+    Ar << Params.bOverrideUniformScale;
+    Ar << Params.UniformScale;
+}
+
+bool FInteractiveObjectSessionTrace::Save(const FString& FilePath, FString& OutError)
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 Magic = TraceMagic;
+    uint32 Version = CurrentVersion;
+    Writer << Magic;
+    Writer << Version;
+    Writer << Seed;
+    Writer << NumInitialObjects;
+    SerializeSettings(Writer, InitialSettings);
+    Writer << MapName;
+
+    SerializeEvents(Writer);
+
+    FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+    if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+    {
+        OutError = FString::Printf(TEXT("Failed to write '%s'."), *FilePath);
+        return false;
+    }
+
+    return true;
+}
+
+bool FInteractiveObjectSessionTrace::Load(const FString& FilePath, FString& OutError)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        OutError = FString::Printf(TEXT("Failed to read '%s'."), *FilePath);
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    Reader << Magic;
+    Reader << Version;
+
+    if (Reader.IsError() || Magic != TraceMagic)
+    {
+        OutError = FString::Printf(TEXT("'%s' is not a session trace."), *FilePath);
+        return false;
+    }
+
+    if (Version != CurrentVersion)
+    {
+        OutError = FString::Printf(TEXT("'%s' has unsupported version %u."), *FilePath, Version);
+        return false;
+    }
+
+    Reader << Seed;
+    Reader << NumInitialObjects;
+    SerializeSettings(Reader, InitialSettings);
+    Reader << MapName;
+
+    SerializeEvents(Reader);
+
+    if (Reader.IsError())
+    {
+        Events.Empty();
+        OutError = FString::Printf(TEXT("'%s' is truncated or corrupt."), *FilePath);
+        return false;
+    }
+
+    return true;
+}
+
+FString FInteractiveObjectSessionTrace::GetDefaultPath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("InteractiveObjects") / TEXT("Session.iomtrace");
+}
+
+void FInteractiveObjectSessionTrace::SerializeEvents(FArchive& Ar)
+{
+    int32 NumEvents = Events.Num();
+    Ar << NumEvents;
+
+    if (Ar.IsLoading())
+    {
+        // Every event takes at least one byte, which bounds the count of an intact file.
+        if (NumEvents < 0 || NumEvents > Ar.TotalSize() - Ar.Tell())
+        {
+            Ar.SetError();
+            return;
+        }
+
+        Events.SetNum(NumEvents);
+    }
+
+    // Frame, time and registration count never decrease, so each is stored as a packed delta to the previous event.
+    uint32 PreviousFrame = 0;
+    uint64 PreviousMicroseconds = 0;
+    uint32 PreviousNumRegistered = 0;
+
+    for (FInteractiveObjectTraceEvent& Event : Events)
+    {
+        uint8 Op = static_cast<uint8>(Event.Op);
+        Ar << Op;
+
+        if (Op >= static_cast<uint8>(EInteractiveObjectTraceOp::Count))
+        {
+            Ar.SetError();
+            return;
+        }
+
+        Event.Op = static_cast<EInteractiveObjectTraceOp>(Op);
+
+        uint32 FrameDelta = Event.Frame - PreviousFrame;
+        Ar.SerializeIntPacked(FrameDelta);
+        Event.Frame = PreviousFrame + FrameDelta;
+        PreviousFrame = Event.Frame;
+
+        const uint64 Microseconds = static_cast<uint64>(FMath::Max(Event.Time, 0.0) * 1000000.0);
+        uint64 MicrosecondsDelta = FMath::Max(Microseconds, PreviousMicroseconds) - PreviousMicroseconds;
+        Ar.SerializeIntPacked64(MicrosecondsDelta);
+        PreviousMicroseconds += MicrosecondsDelta;
+        Event.Time = PreviousMicroseconds / 1000000.0;
+
+        uint32 NumRegisteredDelta = static_cast<uint32>(Event.NumRegistered) - PreviousNumRegistered;
+        Ar.SerializeIntPacked(NumRegisteredDelta);
+        PreviousNumRegistered += NumRegisteredDelta;
+        Event.NumRegistered = static_cast<int32>(PreviousNumRegistered);
+
+        // Indices are stored plus one, so a stale handle packs as zero.
+        uint32 NumObjects = Event.Objects.Num();
+        Ar.SerializeIntPacked(NumObjects);
+
+        if (Ar.IsLoading())
+        {
+            if (NumObjects > Ar.TotalSize() - Ar.Tell())
+            {
+                Ar.SetError();
+                return;
+            }
+
+            Event.Objects.SetNum(NumObjects);
+        }
+
+        for (int32& ObjectIndex : Event.Objects)
+        {
+            uint32 PackedIndex = static_cast<uint32>(ObjectIndex + 1);
+            Ar.SerializeIntPacked(PackedIndex);
+            ObjectIndex = static_cast<int32>(PackedIndex) - 1;
+        }
+
+        switch (Event.Op)
+        {
+        case EInteractiveObjectTraceOp::SpawnObjectOfType:
+        {
+            uint8 SpawnType = static_cast<uint8>(Event.SpawnType);
+            Ar << SpawnType;
+            Event.SpawnType = static_cast<EInteractiveObjectSpawnType>(SpawnType);
+            break;
+        }
+
+        case EInteractiveObjectTraceOp::SpawnObjectsBatch:
+        {
+            uint8 SpawnType = static_cast<uint8>(Event.SpawnType);
+            Ar << SpawnType;
+            Event.SpawnType = static_cast<EInteractiveObjectSpawnType>(SpawnType);
+            Ar << Event.Count;
+            SerializeBatchParams(Ar, Event.BatchParams);
+            break;
+        }
+
+        case EInteractiveObjectTraceOp::SelectObjectByIndex:
+            Ar << Event.Count;
+            break;
+
+        case EInteractiveObjectTraceOp::SelectObjects:
+            Ar << Event.bAddToSelection;
+            break;
+
+        case EInteractiveObjectTraceOp::SetObjectColor:
+        case EInteractiveObjectTraceOp::SetSelectedObjectColor:
+        case EInteractiveObjectTraceOp::SetSelectedObjectsColor:
+            Ar << Event.Color;
+            break;
+
+        case EInteractiveObjectTraceOp::SetObjectUniformScale:
+        case EInteractiveObjectTraceOp::SetSelectedObjectUniformScale:
+        case EInteractiveObjectTraceOp::SetSelectedObjectsUniformScale:
+            Ar << Event.UniformScale;
+            break;
+
+        case EInteractiveObjectTraceOp::ApplySettings:
+            SerializeSettings(Ar, Event.Settings);
+            break;
+
+        default:
+            break;
+        }
+
+        if (Ar.IsError())
+        {
+            return;
+        }
+    }
+}
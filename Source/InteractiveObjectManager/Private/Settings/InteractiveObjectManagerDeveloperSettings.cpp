@@ -1,20 +1,50 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#include "Settings/InteractiveObjectManagerDeveloperSettings.h"
-#include "InteractiveObjectManagerLog.h"
-
-#include "GameFramework/Actor.h"
-
-UInteractiveObjectManagerDeveloperSettings::UInteractiveObjectManagerDeveloperSettings()
-{
-    UE_LOG(
-        LogInteractiveObjectManager,
-        Log,
-        TEXT("UInteractiveObjectManagerDeveloperSettings constructed.")
-    );
-}
-
-FName UInteractiveObjectManagerDeveloperSettings::GetCategoryName() const
-{
-    return TEXT("Game");
-}
\ No newline at end of file
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Settings/InteractiveObjectManagerDeveloperSettings.h"
+#include "InteractiveObjectManagerLog.h"
+
+#include "GameFramework/Actor.h"
+
+UInteractiveObjectManagerDeveloperSettings::UInteractiveObjectManagerDeveloperSettings()
+{
+    bEnableActorPooling = true;
+    PoolPrewarmCount = 16;
+    PoolMaxSize = 256;
+
+    RenderingMode = EInteractiveObjectRenderingMode::Actors;
+    bShareDynamicMaterials = true;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("UInteractiveObjectManagerDeveloperSettings constructed.")
+    );
+}
+
+FName UInteractiveObjectManagerDeveloperSettings::GetCategoryName() const
+{
+    return TEXT("Game");
+}
+
+void UInteractiveObjectManagerDeveloperSettings::GetPrimitiveClassPaths(TArray<FSoftObjectPath>& OutClassPaths) const
+{
+    OutClassPaths.Reset();
+
+    if (!CubePrimitiveClass.IsNull())
+    {
+        OutClassPaths.AddUnique(CubePrimitiveClass.ToSoftObjectPath());
+    }
+
+    if (!SpherePrimitiveClass.IsNull())
+    {
+        OutClassPaths.AddUnique(SpherePrimitiveClass.ToSoftObjectPath());
+    }
+
+    for (const TSoftClassPtr<AActor>& AdditionalClass : AdditionalPreloadClasses)
+    {
+        if (!AdditionalClass.IsNull())
+        {
+            OutClassPaths.AddUnique(AdditionalClass.ToSoftObjectPath());
+        }
+    }
+}
@@ -0,0 +1,256 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Snapshot/InteractiveObjectRegistrySnapshot.h"
+#include "InteractiveObjectManagerLog.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeRWLock.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+static FAutoConsoleCommand GInteractiveObjectSnapshotStressTestCommand(
+    TEXT("IOM.Snapshot.StressTest"),
+    TEXT("Publishes synthetic registry snapshots while concurrent readers validate them.\n")
+    TEXT("Usage: IOM.Snapshot.StressTest [NumReaders=8] [NumPublishes=2000] [NumObjects=10000]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumReaders = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 8;
+        const int32 NumPublishes = (Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 2000;
+        const int32 NumObjects = (Args.Num() > 2) ? FCString::Atoi(*Args[2]) : 10000;
+
+        FInteractiveObjectSnapshotPublisher::RunStressTest(FMath::Max(NumReaders, 1), FMath::Max(NumPublishes, 1), FMath::Max(NumObjects, 1));
+    })
+);
+
+int32 FInteractiveObjectRegistrySnapshot::Num() const
+{
+    return ObjectIds.Num();
+}
+
+void FInteractiveObjectRegistrySnapshot::ResetForReuse(int32 ExpectedNum)
+{
+    Version = 0;
+    FrameNumber = 0;
+
+    ObjectIds.Reset(ExpectedNum);
+    Handles.Reset(ExpectedNum);
+    Locations.Reset(ExpectedNum);
+    Colors.Reset(ExpectedNum);
+    Scales.Reset(ExpectedNum);
+    Types.Reset(ExpectedNum);
+}
+
+SIZE_T FInteractiveObjectRegistrySnapshot::GetAllocatedSize() const
+{
+    return ObjectIds.GetAllocatedSize()
+        + Handles.GetAllocatedSize()
+        + Locations.GetAllocatedSize()
+        + Colors.GetAllocatedSize()
+        + Scales.GetAllocatedSize()
+        + Types.GetAllocatedSize();
+}
+
+FInteractiveObjectSnapshotPublisher::FWritableSnapshotRef FInteractiveObjectSnapshotPublisher::AllocateForWrite(int32 ExpectedNum)
+{
+    // Readers can only reach Current, so once the retired snapshot is unique nobody else can ever see it again.
+    if (Retired.IsValid() && Retired.IsUnique())
+    {
+        FWritableSnapshotRef Reused = Retired.ToSharedRef();
+        Retired.Reset();
+
+        Reused->ResetForReuse(ExpectedNum);
+        return Reused;
+    }
+
+    FWritableSnapshotRef NewSnapshot = MakeShared<FInteractiveObjectRegistrySnapshot, ESPMode::ThreadSafe>();
+    NewSnapshot->ResetForReuse(ExpectedNum);
+    return NewSnapshot;
+}
+
+void FInteractiveObjectSnapshotPublisher::Publish(const FWritableSnapshotRef& Snapshot)
+{
+    Snapshot->Version = ++LastVersion;
+    Snapshot->FrameNumber = GFrameCounter;
+
+    TSharedPtr<FInteractiveObjectRegistrySnapshot, ESPMode::ThreadSafe> Replaced;
+    {
+        FWriteScopeLock WriteLock(CurrentLock);
+        Replaced = MoveTemp(Current);
+        Current = Snapshot;
+    }
+
+    // Keep the old snapshot for reuse. If readers still hold it, the next write allocates instead.
+    Retired = MoveTemp(Replaced);
+}
+
+FInteractiveObjectRegistrySnapshotPtr FInteractiveObjectSnapshotPublisher::Acquire() const
+{
+    FReadScopeLock ReadLock(CurrentLock);
+    return Current;
+}
+
+void FInteractiveObjectSnapshotPublisher::Reset()
+{
+    {
+        FWriteScopeLock WriteLock(CurrentLock);
+        Current.Reset();
+    }
+
+    Retired.Reset();
+}
+
+uint64 FInteractiveObjectSnapshotPublisher::GetPublishedVersion() const
+{
+    return LastVersion;
+}
+
+FInteractiveObjectSnapshotPublisher::FStressTestResult FInteractiveObjectSnapshotPublisher::RunStressTest(int32 NumReaders, int32 NumPublishes, int32 NumObjects)
+{
+    FInteractiveObjectSnapshotPublisher Publisher;
+
+    std::atomic<bool> bIsWriterDone(false);
+    std::atomic<int64> TotalAcquires(0);
+    std::atomic<int64> TotalViolations(0);
+    std::atomic<int64> TotalStaleReads(0);
+
+    TArray<UE::Tasks::FTask> ReaderTasks;
+    ReaderTasks.Reserve(NumReaders);
+
+    for (int32 ReaderIndex = 0; ReaderIndex < NumReaders; ++ReaderIndex)
+    {
+        ReaderTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Publisher, &bIsWriterDone, &TotalAcquires, &TotalViolations, &TotalStaleReads, ReaderIndex]()
+        {
+            uint64 LastSeenVersion = 0;
+            int64 Acquires = 0;
+            int64 Violations = 0;
+            int64 StaleReads = 0;
+
+            while (!bIsWriterDone.load(std::memory_order_acquire))
+            {
+                const FInteractiveObjectRegistrySnapshotPtr Snapshot = Publisher.Acquire();
+                ++Acquires;
+
+                if (!Snapshot.IsValid())
+                {
+                    continue;
+                }
+
+                // Versions seen by one reader never go backwards.
+                if (Snapshot->Version < LastSeenVersion)
+                {
+                    ++Violations;
+                }
+                else if (Snapshot->Version == LastSeenVersion)
+                {
+                    ++StaleReads;
+                }
+                LastSeenVersion = Snapshot->Version;
+
+                // A published snapshot is never written again, so every entry must still carry its version.
+                const int32 Num = Snapshot->Num();
+                if (Snapshot->Handles.Num() != Num || Snapshot->Locations.Num() != Num || Snapshot->Colors.Num() != Num
+                    || Snapshot->Scales.Num() != Num || Snapshot->Types.Num() != Num)
+                {
+                    ++Violations;
+                    continue;
+                }
+
+                const int32 Stride = FMath::Max(Num / 64, 1);
+                for (int32 EntryIndex = (ReaderIndex % Stride); EntryIndex < Num; EntryIndex += Stride)
+                {
+                    if (Snapshot->ObjectIds[EntryIndex] != static_cast<int32>(Snapshot->Version) + EntryIndex
+                        || Snapshot->Scales[EntryIndex] != static_cast<float>(Snapshot->Version % 1024))
+                    {
+                        ++Violations;
+                        break;
+                    }
+                }
+            }
+
+            TotalAcquires += Acquires;
+            TotalViolations += Violations;
+            TotalStaleReads += StaleReads;
+        }));
+    }
+
+    int32 ReusedCount = 0;
+
+    const double WriterStartTime = FPlatformTime::Seconds();
+    for (int32 PublishIndex = 0; PublishIndex < NumPublishes; ++PublishIndex)
+    {
+        const bool bWillReuse = Publisher.Retired.IsValid() && Publisher.Retired.IsUnique();
+        ReusedCount += bWillReuse ? 1 : 0;
+
+        FWritableSnapshotRef Snapshot = Publisher.AllocateForWrite(NumObjects);
+        const uint64 NextVersion = Publisher.GetPublishedVersion() + 1;
+
+        for (int32 EntryIndex = 0; EntryIndex < NumObjects; ++EntryIndex)
+        {
+            Snapshot->ObjectIds.Add(static_cast<int32>(NextVersion) + EntryIndex);
+            Snapshot->Handles.AddDefaulted();
+            Snapshot->Locations.Add(FVector(EntryIndex));
+            Snapshot->Colors.Add(FLinearColor::White);
+            Snapshot->Scales.Add(static_cast<float>(NextVersion % 1024));
+            Snapshot->Types.Add(EInteractiveObjectPrimitiveType::Cube);
+        }
+
+        Publisher.Publish(Snapshot);
+    }
+    const double WriterSeconds = FPlatformTime::Seconds() - WriterStartTime;
+
+    bIsWriterDone.store(true, std::memory_order_release);
+    UE::Tasks::Wait(ReaderTasks);
+
+    FStressTestResult Result;
+    Result.TotalAcquires = TotalAcquires.load();
+    Result.TotalStaleReads = TotalStaleReads.load();
+    Result.TotalViolations = TotalViolations.load();
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("IOM.Snapshot.StressTest: %d readers, %d publishes of %d objects in %.1f ms (%.3f ms per publish, %d reused buffers). %lld acquires (%.1f per ms), %lld repeated reads, %lld violations."),
+        NumReaders,
+        NumPublishes,
+        NumObjects,
+        WriterSeconds * 1000.0,
+        WriterSeconds * 1000.0 / NumPublishes,
+        ReusedCount,
+        Result.TotalAcquires,
+        (WriterSeconds > 0.0) ? Result.TotalAcquires / (WriterSeconds * 1000.0) : 0.0,
+        Result.TotalStaleReads,
+        Result.TotalViolations
+    );
+
+    if (Result.TotalViolations > 0)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Error,
+            TEXT("IOM.Snapshot.StressTest: readers observed inconsistent snapshots.")
+        );
+    }
+
+    return Result;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FInteractiveObjectSnapshotStressTest,
+    "InteractiveObjectManager.Snapshot.StressTest",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FInteractiveObjectSnapshotStressTest::RunTest(const FString& Parameters)
+{
+    const FInteractiveObjectSnapshotPublisher::FStressTestResult Result = FInteractiveObjectSnapshotPublisher::RunStressTest(8, 500, 10000);
+
+    TestEqual(TEXT("Snapshot violations"), Result.TotalViolations, static_cast<int64>(0));
+
+    return Result.TotalViolations == 0;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,654 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Spatial/InteractiveObjectSpatialHash.h"
+#include "InteractiveObjectManagerLog.h"
+
+#include "ConvexVolume.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+static FAutoConsoleCommand GInteractiveObjectSpatialBenchmarkCommand(
+    TEXT("IOM.Spatial.Benchmark"),
+    TEXT("Benchmarks the interactive object spatial hash against a brute force scan.\n")
+    TEXT("Usage: IOM.Spatial.Benchmark [NumObjects=100000] [NumQueries=1000]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumEntries = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 100000;
+        const int32 NumQueries = (Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 1000;
+
+        FInteractiveObjectSpatialHash::RunBenchmark(FMath::Max(NumEntries, 1), FMath::Max(NumQueries, 1));
+    })
+);
+
+/** Stand-in for 1 / 0 in slab tests. Large enough to push the slab out of range without producing NaN. */
+static constexpr double RayInverseDirectionLimit = 1.0e30;
+
+FInteractiveObjectSpatialHash::FInteractiveObjectSpatialHash(float InCellSize)
+    : CellSize(1.0f)
+    , InverseCellSize(1.0f)
+    , MinOccupiedCell(MAX_int32)
+    , MaxOccupiedCell(MIN_int32)
+    , bIsOccupiedCellRangeDirty(false)
+    , NumEntries(0)
+{
+    Reset(InCellSize);
+}
+
+void FInteractiveObjectSpatialHash::Reset(float NewCellSize)
+{
+    Entries.Empty();
+    Cells.Empty();
+    OversizedSlots.Empty();
+
+    CellSize = FMath::Max(NewCellSize, 1.0f);
+    InverseCellSize = 1.0f / CellSize;
+    MinOccupiedCell = FIntVector(MAX_int32);
+    MaxOccupiedCell = FIntVector(MIN_int32);
+    bIsOccupiedCellRangeDirty = false;
+    NumEntries = 0;
+}
+
+void FInteractiveObjectSpatialHash::Update(int32 SlotIndex, const FVector& Center, const FVector& Extent)
+{
+    check(SlotIndex >= 0);
+
+    if (!Entries.IsValidIndex(SlotIndex))
+    {
+        Entries.SetNum(SlotIndex + 1);
+    }
+
+    FEntry& Entry = Entries[SlotIndex];
+    const FIntVector NewCell = ToCell(Center);
+    const FVector AbsExtent = Extent.GetAbs();
+    const bool bIsOversized = AbsExtent.GetMax() > CellSize;
+
+    if (Entry.IndexInCell == INDEX_NONE)
+    {
+        Entry.Cell = NewCell;
+        Entry.bIsOversized = bIsOversized;
+        AddToCell(SlotIndex, Entry);
+        ++NumEntries;
+    }
+    else if (Entry.bIsOversized != bIsOversized || (!bIsOversized && Entry.Cell != NewCell))
+    {
+        RemoveFromCell(Entry);
+        Entry.Cell = NewCell;
+        Entry.bIsOversized = bIsOversized;
+        AddToCell(SlotIndex, Entry);
+    }
+
+    Entry.Center = Center;
+    Entry.Extent = AbsExtent;
+}
+
+void FInteractiveObjectSpatialHash::Remove(int32 SlotIndex)
+{
+    if (!Entries.IsValidIndex(SlotIndex) || Entries[SlotIndex].IndexInCell == INDEX_NONE)
+    {
+        return;
+    }
+
+    RemoveFromCell(Entries[SlotIndex]);
+    --NumEntries;
+}
+
+void FInteractiveObjectSpatialHash::QuerySphere(const FVector& Center, float Radius, TArray<int32>& OutSlots) const
+{
+    const FBox SearchBox(Center - FVector(Radius), Center + FVector(Radius));
+    const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+
+    ForEachCandidateInBox(SearchBox, [&Center, RadiusSquared, &OutSlots](int32 SlotIndex, const FEntry& Entry)
+    {
+        const FBox EntryBox(Entry.Center - Entry.Extent, Entry.Center + Entry.Extent);
+        if (EntryBox.ComputeSquaredDistanceToPoint(Center) <= RadiusSquared)
+        {
+            OutSlots.Add(SlotIndex);
+        }
+    });
+}
+
+void FInteractiveObjectSpatialHash::QueryBox(const FBox& Box, TArray<int32>& OutSlots) const
+{
+    ForEachCandidateInBox(Box, [&Box, &OutSlots](int32 SlotIndex, const FEntry& Entry)
+    {
+        if (Box.Intersect(FBox(Entry.Center - Entry.Extent, Entry.Center + Entry.Extent)))
+        {
+            OutSlots.Add(SlotIndex);
+        }
+    });
+}
+
+void FInteractiveObjectSpatialHash::QueryConvexVolume(const FConvexVolume& Volume, TArray<int32>& OutSlots) const
+{
+    // A frustum has no cheap bounding box, so cull whole cells first and then test entries.
+    // A grid entry reaches at most one cell size past the cell holding its center.
+    const FVector LooseCellExtent = FVector(1.5f * CellSize);
+
+    for (const TPair<FIntVector, TArray<int32>>& CellPair : Cells)
+    {
+        const FVector CellCenter = (FVector(CellPair.Key) + FVector(0.5f)) * CellSize;
+        if (!Volume.IntersectBox(CellCenter, LooseCellExtent))
+        {
+            continue;
+        }
+
+        for (const int32 SlotIndex : CellPair.Value)
+        {
+            const FEntry& Entry = Entries[SlotIndex];
+            if (Volume.IntersectBox(Entry.Center, Entry.Extent))
+            {
+                OutSlots.Add(SlotIndex);
+            }
+        }
+    }
+
+    for (const int32 SlotIndex : OversizedSlots)
+    {
+        const FEntry& Entry = Entries[SlotIndex];
+        if (Volume.IntersectBox(Entry.Center, Entry.Extent))
+        {
+            OutSlots.Add(SlotIndex);
+        }
+    }
+}
+
+int32 FInteractiveObjectSpatialHash::Raycast(const FVector& Origin, const FVector& Direction, float MaxDistance, float& OutHitDistance) const
+{
+    if (NumEntries == 0 || MaxDistance <= 0.0f)
+    {
+        return INDEX_NONE;
+    }
+
+    FVector InverseDirection;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        InverseDirection[Axis] = FMath::IsNearlyZero(Direction[Axis])
+            ? RayInverseDirectionLimit
+            : 1.0 / Direction[Axis];
+    }
+
+    int32 BestSlotIndex = INDEX_NONE;
+    float BestDistance = MaxDistance;
+
+    // Oversized boxes first, a hit among them shortens the grid walk.
+    for (const int32 SlotIndex : OversizedSlots)
+    {
+        TestRayEntry(SlotIndex, Origin, InverseDirection, BestSlotIndex, BestDistance);
+    }
+
+    RefreshOccupiedCellRange();
+
+    // Only the part of the ray inside the occupied cells, widened by the one cell a grid entry may reach past its own,
+    // can hit a grid entry.
+    float RayEnterDistance = 0.0f;
+    float RayExitDistance = 0.0f;
+    if (Cells.Num() > 0
+        && IntersectRayBox(
+            Origin,
+            InverseDirection,
+            (FVector(MinOccupiedCell) - FVector(1.0f)) * CellSize,
+            (FVector(MaxOccupiedCell) + FVector(2.0f)) * CellSize,
+            BestDistance,
+            RayEnterDistance,
+            RayExitDistance
+        ))
+    {
+        RaycastGrid(Origin, Direction, InverseDirection, RayEnterDistance, RayExitDistance, BestSlotIndex, BestDistance);
+    }
+
+    if (BestSlotIndex != INDEX_NONE)
+    {
+        OutHitDistance = BestDistance;
+    }
+
+    return BestSlotIndex;
+}
+
+void FInteractiveObjectSpatialHash::RaycastGrid(const FVector& Origin, const FVector& Direction, const FVector& InverseDirection, float EnterDistance, float ExitDistance, int32& InOutBestSlotIndex, float& InOutBestDistance) const
+{
+    // A grid entry hit at ray point P is stored at most one cell away from the cell containing P.
+    const FIntVector Padding(1);
+
+    // Walk the cells along the ray front to back (Amanatides and Woo).
+    const FVector StartPoint = Origin + Direction * EnterDistance;
+    FIntVector Cell = ToCell(StartPoint);
+
+    FIntVector Step;
+    FVector NextBoundaryDistance;
+    FVector BoundaryDistanceDelta;
+
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        if (FMath::IsNearlyZero(Direction[Axis]))
+        {
+            Step[Axis] = 0;
+            NextBoundaryDistance[Axis] = TNumericLimits<float>::Max();
+            BoundaryDistanceDelta[Axis] = TNumericLimits<float>::Max();
+            continue;
+        }
+
+        Step[Axis] = (Direction[Axis] > 0.0) ? 1 : -1;
+
+        const double Boundary = (Cell[Axis] + ((Step[Axis] > 0) ? 1 : 0)) * static_cast<double>(CellSize);
+        NextBoundaryDistance[Axis] = EnterDistance + (Boundary - StartPoint[Axis]) * InverseDirection[Axis];
+        BoundaryDistanceDelta[Axis] = CellSize * FMath::Abs(InverseDirection[Axis]);
+    }
+
+    // The first cell tests its whole neighbourhood. After that, each step only adds the layer of neighbours in front
+    // of the new cell along the step axis: the walk never moves backwards on any axis, so no earlier neighbourhood
+    // reaches that layer, and every cell is tested once without keeping track of visited cells.
+    FIntVector RangeMin = Cell - Padding;
+    FIntVector RangeMax = Cell + Padding;
+    float CellEnterDistance = EnterDistance;
+
+    // Cells entered past the best hit cannot contain a closer one.
+    while (CellEnterDistance <= ExitDistance && CellEnterDistance <= InOutBestDistance)
+    {
+        for (int32 CellZ = RangeMin.Z; CellZ <= RangeMax.Z; ++CellZ)
+        {
+            for (int32 CellY = RangeMin.Y; CellY <= RangeMax.Y; ++CellY)
+            {
+                for (int32 CellX = RangeMin.X; CellX <= RangeMax.X; ++CellX)
+                {
+                    const TArray<int32>* CellSlots = Cells.Find(FIntVector(CellX, CellY, CellZ));
+                    if (CellSlots == nullptr)
+                    {
+                        continue;
+                    }
+
+                    for (const int32 SlotIndex : *CellSlots)
+                    {
+                        TestRayEntry(SlotIndex, Origin, InverseDirection, InOutBestSlotIndex, InOutBestDistance);
+                    }
+                }
+            }
+        }
+
+        const int32 StepAxis = (NextBoundaryDistance.X < NextBoundaryDistance.Y)
+            ? ((NextBoundaryDistance.X < NextBoundaryDistance.Z) ? 0 : 2)
+            : ((NextBoundaryDistance.Y < NextBoundaryDistance.Z) ? 1 : 2);
+
+        CellEnterDistance = NextBoundaryDistance[StepAxis];
+        NextBoundaryDistance[StepAxis] += BoundaryDistanceDelta[StepAxis];
+        Cell[StepAxis] += Step[StepAxis];
+
+        RangeMin = Cell - Padding;
+        RangeMax = Cell + Padding;
+        RangeMin[StepAxis] = Cell[StepAxis] + Step[StepAxis] * Padding[StepAxis];
+        RangeMax[StepAxis] = RangeMin[StepAxis];
+    }
+}
+
+void FInteractiveObjectSpatialHash::TestRayEntry(int32 SlotIndex, const FVector& Origin, const FVector& InverseDirection, int32& InOutBestSlotIndex, float& InOutBestDistance) const
+{
+    const FEntry& Entry = Entries[SlotIndex];
+
+    float EnterDistance = 0.0f;
+    float ExitDistance = 0.0f;
+    if (IntersectRayBox(Origin, InverseDirection, Entry.Center - Entry.Extent, Entry.Center + Entry.Extent, InOutBestDistance, EnterDistance, ExitDistance)
+        && (InOutBestSlotIndex == INDEX_NONE || EnterDistance < InOutBestDistance))
+    {
+        InOutBestSlotIndex = SlotIndex;
+        InOutBestDistance = EnterDistance;
+    }
+}
+
+bool FInteractiveObjectSpatialHash::GetEntry(int32 SlotIndex, FVector& OutCenter, FVector& OutExtent) const
+{
+    if (!Entries.IsValidIndex(SlotIndex) || Entries[SlotIndex].IndexInCell == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutCenter = Entries[SlotIndex].Center;
+    OutExtent = Entries[SlotIndex].Extent;
+    return true;
+}
+
+int32 FInteractiveObjectSpatialHash::Num() const
+{
+    return NumEntries;
+}
+
+SIZE_T FInteractiveObjectSpatialHash::GetAllocatedSize() const
+{
+    SIZE_T TotalBytes = Entries.GetAllocatedSize() + Cells.GetAllocatedSize() + OversizedSlots.GetAllocatedSize();
+
+    for (const TPair<FIntVector, TArray<int32>>& CellPair : Cells)
+    {
+        TotalBytes += CellPair.Value.GetAllocatedSize();
+    }
+
+    return TotalBytes;
+}
+
+FIntVector FInteractiveObjectSpatialHash::ToCell(const FVector& Location) const
+{
+    return FIntVector(
+        FMath::FloorToInt32(Location.X * InverseCellSize),
+        FMath::FloorToInt32(Location.Y * InverseCellSize),
+        FMath::FloorToInt32(Location.Z * InverseCellSize)
+    );
+}
+
+void FInteractiveObjectSpatialHash::AddToCell(int32 SlotIndex, FEntry& Entry)
+{
+    if (Entry.bIsOversized)
+    {
+        Entry.IndexInCell = OversizedSlots.Add(SlotIndex);
+        return;
+    }
+
+    TArray<int32>& CellSlots = Cells.FindOrAdd(Entry.Cell);
+    if (CellSlots.Num() == 0 && !bIsOccupiedCellRangeDirty)
+    {
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            MinOccupiedCell[Axis] = FMath::Min(MinOccupiedCell[Axis], Entry.Cell[Axis]);
+            MaxOccupiedCell[Axis] = FMath::Max(MaxOccupiedCell[Axis], Entry.Cell[Axis]);
+        }
+    }
+
+    Entry.IndexInCell = CellSlots.Add(SlotIndex);
+}
+
+void FInteractiveObjectSpatialHash::RemoveFromCell(FEntry& Entry)
+{
+    if (Entry.bIsOversized)
+    {
+        const int32 RemovedIndex = Entry.IndexInCell;
+        OversizedSlots.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+
+        if (OversizedSlots.IsValidIndex(RemovedIndex))
+        {
+            Entries[OversizedSlots[RemovedIndex]].IndexInCell = RemovedIndex;
+        }
+
+        Entry.IndexInCell = INDEX_NONE;
+        return;
+    }
+
+    TArray<int32>* CellSlots = Cells.Find(Entry.Cell);
+    check(CellSlots != nullptr);
+
+    const int32 RemovedIndex = Entry.IndexInCell;
+    CellSlots->RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+
+    // The former last slot of the cell now lives at RemovedIndex.
+    if (CellSlots->IsValidIndex(RemovedIndex))
+    {
+        Entries[(*CellSlots)[RemovedIndex]].IndexInCell = RemovedIndex;
+    }
+
+    if (CellSlots->Num() == 0)
+    {
+        Cells.Remove(Entry.Cell);
+
+        // Only an emptied border cell can shrink the range.
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            if (Entry.Cell[Axis] == MinOccupiedCell[Axis] || Entry.Cell[Axis] == MaxOccupiedCell[Axis])
+            {
+                bIsOccupiedCellRangeDirty = true;
+                break;
+            }
+        }
+    }
+
+    Entry.IndexInCell = INDEX_NONE;
+}
+
+void FInteractiveObjectSpatialHash::RefreshOccupiedCellRange() const
+{
+    if (!bIsOccupiedCellRangeDirty)
+    {
+        return;
+    }
+
+    MinOccupiedCell = FIntVector(MAX_int32);
+    MaxOccupiedCell = FIntVector(MIN_int32);
+
+    for (const TPair<FIntVector, TArray<int32>>& CellPair : Cells)
+    {
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            MinOccupiedCell[Axis] = FMath::Min(MinOccupiedCell[Axis], CellPair.Key[Axis]);
+            MaxOccupiedCell[Axis] = FMath::Max(MaxOccupiedCell[Axis], CellPair.Key[Axis]);
+        }
+    }
+
+    bIsOccupiedCellRangeDirty = false;
+}
+
+void FInteractiveObjectSpatialHash::ForEachCandidateInBox(const FBox& SearchBox, TFunctionRef<void(int32 SlotIndex, const FEntry& Entry)> Visitor) const
+{
+    if (NumEntries == 0)
+    {
+        return;
+    }
+
+    const FBox LooseBox = SearchBox.ExpandBy(FVector(CellSize));
+    const FIntVector MinCell = ToCell(LooseBox.Min);
+    const FIntVector MaxCell = ToCell(LooseBox.Max);
+
+    const int64 CellRangeCount =
+        static_cast<int64>(MaxCell.X - MinCell.X + 1) *
+        static_cast<int64>(MaxCell.Y - MinCell.Y + 1) *
+        static_cast<int64>(MaxCell.Z - MinCell.Z + 1);
+
+    // Large ranges over a sparse grid: walking the occupied cells is cheaper than probing.
+    if (CellRangeCount > Cells.Num())
+    {
+        for (const TPair<FIntVector, TArray<int32>>& CellPair : Cells)
+        {
+            const FIntVector& Cell = CellPair.Key;
+            if (Cell.X < MinCell.X || Cell.Y < MinCell.Y || Cell.Z < MinCell.Z ||
+                Cell.X > MaxCell.X || Cell.Y > MaxCell.Y || Cell.Z > MaxCell.Z)
+            {
+                continue;
+            }
+
+            for (const int32 SlotIndex : CellPair.Value)
+            {
+                Visitor(SlotIndex, Entries[SlotIndex]);
+            }
+        }
+    }
+    else
+    {
+        for (int32 CellZ = MinCell.Z; CellZ <= MaxCell.Z; ++CellZ)
+        {
+            for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+            {
+                for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+                {
+                    const TArray<int32>* CellSlots = Cells.Find(FIntVector(CellX, CellY, CellZ));
+                    if (CellSlots == nullptr)
+                    {
+                        continue;
+                    }
+
+                    for (const int32 SlotIndex : *CellSlots)
+                    {
+                        Visitor(SlotIndex, Entries[SlotIndex]);
+                    }
+                }
+            }
+        }
+    }
+
+    for (const int32 SlotIndex : OversizedSlots)
+    {
+        Visitor(SlotIndex, Entries[SlotIndex]);
+    }
+}
+
+bool FInteractiveObjectSpatialHash::IntersectRayBox(const FVector& Origin, const FVector& InverseDirection, const FVector& BoxMin, const FVector& BoxMax, float MaxDistance, float& OutEnterDistance, float& OutExitDistance)
+{
+    const FVector FirstSlab = (BoxMin - Origin) * InverseDirection;
+    const FVector SecondSlab = (BoxMax - Origin) * InverseDirection;
+
+    const FVector SlabEnter = FirstSlab.ComponentMin(SecondSlab);
+    const FVector SlabExit = FirstSlab.ComponentMax(SecondSlab);
+
+    const double EnterDistance = FMath::Max(SlabEnter.GetMax(), 0.0);
+    const double ExitDistance = FMath::Min(SlabExit.GetMin(), static_cast<double>(MaxDistance));
+
+    if (EnterDistance > ExitDistance)
+    {
+        return false;
+    }
+
+    OutEnterDistance = static_cast<float>(EnterDistance);
+    OutExitDistance = static_cast<float>(ExitDistance);
+    return true;
+}
+
+void FInteractiveObjectSpatialHash::RunBenchmark(int32 NumEntries, int32 NumQueries)
+{
+    // Objects of the demo size spread over a 2 km square play area.
+    constexpr float AreaHalfSize = 100000.0f;
+    constexpr float QueryRadius = 1000.0f;
+    const FVector ObjectExtent(50.0f);
+
+    FRandomStream RandomStream(12345);
+
+    TArray<FVector> Centers;
+    Centers.Reserve(NumEntries);
+    for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+    {
+        Centers.Add(FVector(
+            RandomStream.FRandRange(-AreaHalfSize, AreaHalfSize),
+            RandomStream.FRandRange(-AreaHalfSize, AreaHalfSize),
+            RandomStream.FRandRange(0.0f, 2000.0f)
+        ));
+    }
+
+    TArray<FVector> QueryCenters;
+    QueryCenters.Reserve(NumQueries);
+    for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+    {
+        QueryCenters.Add(Centers[RandomStream.RandHelper(NumEntries)]);
+    }
+
+    // Rays cast from a camera above the area towards random objects, as click picking does.
+    TArray<FVector> RayOrigins;
+    TArray<FVector> RayDirections;
+    RayOrigins.Reserve(NumQueries);
+    RayDirections.Reserve(NumQueries);
+    for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+    {
+        const FVector Target = QueryCenters[QueryIndex];
+        const FVector RayOrigin = Target + FVector(RandomStream.FRandRange(-5000.0f, 5000.0f), RandomStream.FRandRange(-5000.0f, 5000.0f), 5000.0f);
+
+        RayOrigins.Add(RayOrigin);
+        RayDirections.Add((Target - RayOrigin).GetSafeNormal());
+    }
+
+    FInteractiveObjectSpatialHash SpatialHash;
+
+    const double BuildStartTime = FPlatformTime::Seconds();
+    for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+    {
+        SpatialHash.Update(EntryIndex, Centers[EntryIndex], ObjectExtent);
+    }
+    const double BuildSeconds = FPlatformTime::Seconds() - BuildStartTime;
+
+    int64 HashResultCount = 0;
+    TArray<int32> QueryResults;
+
+    const double HashStartTime = FPlatformTime::Seconds();
+    for (const FVector& QueryCenter : QueryCenters)
+    {
+        QueryResults.Reset();
+        SpatialHash.QuerySphere(QueryCenter, QueryRadius, QueryResults);
+        HashResultCount += QueryResults.Num();
+    }
+    const double HashSeconds = FPlatformTime::Seconds() - HashStartTime;
+
+    int64 BruteForceResultCount = 0;
+
+    const double BruteForceStartTime = FPlatformTime::Seconds();
+    for (const FVector& QueryCenter : QueryCenters)
+    {
+        QueryResults.Reset();
+        for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+        {
+            const FBox EntryBox(Centers[EntryIndex] - ObjectExtent, Centers[EntryIndex] + ObjectExtent);
+            if (EntryBox.ComputeSquaredDistanceToPoint(QueryCenter) <= FMath::Square(QueryRadius))
+            {
+                QueryResults.Add(EntryIndex);
+            }
+        }
+        BruteForceResultCount += QueryResults.Num();
+    }
+    const double BruteForceSeconds = FPlatformTime::Seconds() - BruteForceStartTime;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("IOM.Spatial.Benchmark: %d objects, %d sphere queries. Build %.2f ms, hash %.3f ms per query, brute force %.3f ms per query (%.1fx). Results %lld / %lld, %.1f KB."),
+        NumEntries,
+        NumQueries,
+        BuildSeconds * 1000.0,
+        HashSeconds * 1000.0 / NumQueries,
+        BruteForceSeconds * 1000.0 / NumQueries,
+        (HashSeconds > 0.0) ? BruteForceSeconds / HashSeconds : 0.0,
+        HashResultCount,
+        BruteForceResultCount,
+        SpatialHash.GetAllocatedSize() / 1024.0
+    );
+
+    int32 MatchingRayCount = 0;
+    TArray<int32> HashRayHits;
+    HashRayHits.Reserve(NumQueries);
+
+    const double HashRayStartTime = FPlatformTime::Seconds();
+    for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+    {
+        float HitDistance = 0.0f;
+        HashRayHits.Add(SpatialHash.Raycast(RayOrigins[QueryIndex], RayDirections[QueryIndex], 100000.0f, HitDistance));
+    }
+    const double HashRaySeconds = FPlatformTime::Seconds() - HashRayStartTime;
+
+    const double BruteForceRayStartTime = FPlatformTime::Seconds();
+    for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+    {
+        FVector InverseDirection;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            InverseDirection[Axis] = FMath::IsNearlyZero(RayDirections[QueryIndex][Axis])
+                ? RayInverseDirectionLimit
+                : 1.0 / RayDirections[QueryIndex][Axis];
+        }
+
+        int32 BestEntryIndex = INDEX_NONE;
+        float BestDistance = 100000.0f;
+        for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+        {
+            float EnterDistance = 0.0f;
+            float ExitDistance = 0.0f;
+            if (IntersectRayBox(RayOrigins[QueryIndex], InverseDirection, Centers[EntryIndex] - ObjectExtent, Centers[EntryIndex] + ObjectExtent, BestDistance, EnterDistance, ExitDistance)
+                && (BestEntryIndex == INDEX_NONE || EnterDistance < BestDistance))
+            {
+                BestEntryIndex = EntryIndex;
+                BestDistance = EnterDistance;
+            }
+        }
+
+        MatchingRayCount += (BestEntryIndex == HashRayHits[QueryIndex]) ? 1 : 0;
+    }
+    const double BruteForceRaySeconds = FPlatformTime::Seconds() - BruteForceRayStartTime;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("IOM.Spatial.Benchmark: %d raycasts. Hash %.4f ms per ray, brute force %.3f ms per ray (%.1fx). %d of %d hits match."),
+        NumQueries,
+        HashRaySeconds * 1000.0 / NumQueries,
+        BruteForceRaySeconds * 1000.0 / NumQueries,
+        (HashRaySeconds > 0.0) ? BruteForceRaySeconds / HashRaySeconds : 0.0,
+        MatchingRayCount,
+        NumQueries
+    );
+}
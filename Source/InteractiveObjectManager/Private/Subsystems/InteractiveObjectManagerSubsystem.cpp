@@ -1,641 +1,5271 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#include "Subsystems/InteractiveObjectManagerSubsystem.h"
-#include "InteractiveObjectManagerLog.h"
-
-#include "Components/InteractiveObjectComponent.h"
-#include "Settings/InteractiveObjectSettings.h"
-#include "Settings/InteractiveObjectManagerDeveloperSettings.h"
-
-#include "Engine/World.h"
-#include "GameFramework/Actor.h"
-
-UInteractiveObjectManagerSubsystem::UInteractiveObjectManagerSubsystem()
-    : NextObjectId(1)
-    , SelectedObjectId(INDEX_NONE)
-{
-}
-
-void UInteractiveObjectManagerSubsystem::Deinitialize()
-{
-    RegisteredObjects.Empty();
-    SelectedObject.Reset();
-    SelectedObjectId = INDEX_NONE;
-
-    Super::Deinitialize();
-}
-
-void UInteractiveObjectManagerSubsystem::SpawnDefaultObject()
-{
-    UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get();
-    if (Settings == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerSubsystem::SpawnDefaultObject: Settings object is null, using Cube as fallback.")
-        );
-
-        SpawnObjectOfType(EInteractiveObjectSpawnType::Cube);
-        return;
-    }
-
-    const EInteractiveObjectSpawnType DefaultType = Settings->GetDefaultSpawnType();
-    SpawnObjectOfType(DefaultType);
-}
-
-void UInteractiveObjectManagerSubsystem::SpawnObjectOfType(EInteractiveObjectSpawnType SpawnType)
-{
-    UWorld* World = GetWorld();
-    if (World == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerSubsystem::SpawnObjectOfType: World is null.")
-        );
-        return;
-    }
-
-    const UInteractiveObjectManagerDeveloperSettings* DeveloperSettings = GetDefault<UInteractiveObjectManagerDeveloperSettings>();
-    if (DeveloperSettings == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerSubsystem::SpawnObjectOfType: Developer settings are null.")
-        );
-        return;
-    }
-
-    // Resolve cube and sphere classes from developer settings.
-    UClass* CubeClass = DeveloperSettings->CubePrimitiveClass.LoadSynchronous();
-    UClass* SphereClass = DeveloperSettings->SpherePrimitiveClass.LoadSynchronous();
-
-    if (CubeClass == nullptr && SphereClass == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerSubsystem::SpawnObjectOfType: No primitive classes configured in developer settings.")
-        );
-        return;
-    }
-
-    TSubclassOf<AActor> ClassToSpawn = nullptr;
-
-    switch (SpawnType)
-    {
-    case EInteractiveObjectSpawnType::Cube:
-        ClassToSpawn = CubeClass;
-        break;
-
-    case EInteractiveObjectSpawnType::Sphere:
-        ClassToSpawn = SphereClass;
-        break;
-
-    case EInteractiveObjectSpawnType::Random:
-    {
-        const bool bHasCube = (CubeClass != nullptr);
-        const bool bHasSphere = (SphereClass != nullptr);
-
-        if (bHasCube && bHasSphere)
-        {
-            const bool bChooseCube = FMath::RandBool();
-            ClassToSpawn = bChooseCube ? CubeClass : SphereClass;
-        }
-        else if (bHasCube)
-        {
-            ClassToSpawn = CubeClass;
-        }
-        else if (bHasSphere)
-        {
-            ClassToSpawn = SphereClass;
-        }
-        break;
-    }
-
-    default:
-        break;
-    }
-
-    if (ClassToSpawn == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerSubsystem::SpawnObjectOfType: No class resolved for spawn type %d."),
-            static_cast<int32>(SpawnType)
-        );
-        return;
-    }
-
-    // Randomized spawn transform for the demo: around world origin in a small radius.
-    const float SpawnRadius = 1000.0f;
-    const float SpawnHeight = 100.0f;
-
-    const float AngleRadians = FMath::FRand() * 2.0f * PI;
-    const float Distance = FMath::FRandRange(0.0f, SpawnRadius);
-
-    const float SpawnX = FMath::Cos(AngleRadians) * Distance;
-    const float SpawnY = FMath::Sin(AngleRadians) * Distance;
-
-    const FVector SpawnLocation(SpawnX, SpawnY, SpawnHeight);
-    const FRotator SpawnRotation = FRotator::ZeroRotator;
-
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-    AActor* NewActor = World->SpawnActor<AActor>(ClassToSpawn, SpawnLocation, SpawnRotation, SpawnParams);
-    if (NewActor == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerSubsystem::SpawnObjectOfType: Failed to spawn actor for class '%s'."),
-            *GetNameSafe(ClassToSpawn)
-        );
-        return;
-    }
-
-    // Apply default color and scale via interactive component if present.
-    UInteractiveObjectComponent* InteractiveComponent = NewActor->FindComponentByClass<UInteractiveObjectComponent>();
-    if (InteractiveComponent == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerSubsystem::SpawnObjectOfType: Spawned actor '%s' has no UInteractiveObjectComponent."),
-            *GetNameSafe(NewActor)
-        );
-        return;
-    }
-
-    if (UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get())
-    {
-        const FInteractiveObjectRuntimeSettings RuntimeSettings = Settings->GetRuntimeSettingsCopy();
-
-        InteractiveComponent->ApplyColor(RuntimeSettings.DefaultColor);
-        InteractiveComponent->ApplyScale(RuntimeSettings.DefaultScale.X);
-    }
-}
-
-void UInteractiveObjectManagerSubsystem::RegisterInteractiveObject(UInteractiveObjectComponent* InteractiveComponent)
-{
-    if (InteractiveComponent == nullptr)
-    {
-        return;
-    }
-
-    CleanupInvalidRecords();
-
-    // Avoid duplicate registration.
-    if (FInteractiveObjectRecord* ExistingRecord = FindRecordByComponent(InteractiveComponent))
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerSubsystem: Attempted to register component '%s' that is already registered with Id %d."),
-            *GetNameSafe(InteractiveComponent),
-            ExistingRecord->ObjectId
-        );
-        return;
-    }
-
-    FInteractiveObjectRecord NewRecord;
-    NewRecord.ObjectId = NextObjectId++;
-    NewRecord.Component = InteractiveComponent;
-
-    RegisteredObjects.Add(NewRecord);
-
-    UE_LOG(
-        LogInteractiveObjectManager,
-        Log,
-        TEXT("Registered interactive object component '%s' with Id %d."),
-        *GetNameSafe(InteractiveComponent),
-        NewRecord.ObjectId
-    );
-
-    BroadcastObjectsListChanged();
-}
-
-void UInteractiveObjectManagerSubsystem::UnregisterInteractiveObject(UInteractiveObjectComponent* InteractiveComponent)
-{
-    if (InteractiveComponent == nullptr)
-    {
-        return;
-    }
-
-    CleanupInvalidRecords();
-
-    for (int32 Index = 0; Index < RegisteredObjects.Num(); ++Index)
-    {
-        FInteractiveObjectRecord& Record = RegisteredObjects[Index];
-        if (Record.Component.Get() == InteractiveComponent)
-        {
-            UE_LOG(
-                LogInteractiveObjectManager,
-                Log,
-                TEXT("Unregistered interactive object component '%s' with Id %d."),
-                *GetNameSafe(InteractiveComponent),
-                Record.ObjectId
-            );
-
-            const int32 RemovedId = Record.ObjectId;
-
-            RegisteredObjects.RemoveAt(Index);
-
-            if (SelectedObjectId == RemovedId)
-            {
-                SelectedObjectId = INDEX_NONE;
-                SelectedObject.Reset();
-                BroadcastSelectedObjectChanged();
-            }
-
-            BroadcastObjectsListChanged();
-            return;
-        }
-    }
-}
-
-void UInteractiveObjectManagerSubsystem::GetInteractiveObjectsList(TArray<FInteractiveObjectListItem>& OutItems)
-{
-    CleanupInvalidRecords();
-
-    OutItems.Reset();
-    OutItems.Reserve(RegisteredObjects.Num());
-
-    for (const FInteractiveObjectRecord& Record : RegisteredObjects)
-    {
-        UInteractiveObjectComponent* InteractiveComponent = Record.Component.Get();
-        if (InteractiveComponent == nullptr)
-        {
-            continue;
-        }
-
-        AActor* OwnerActor = InteractiveComponent->GetOwner();
-        const FString DisplayName = (OwnerActor != nullptr) ? OwnerActor->GetName() : FString(TEXT("Unknown"));
-
-        FInteractiveObjectListItem ListItem;
-        ListItem.Id = Record.ObjectId;
-        ListItem.DisplayName = InteractiveComponent->GetDisplayNameForUI();
-
-        OutItems.Add(ListItem);
-    }
-}
-
-bool UInteractiveObjectManagerSubsystem::SelectObjectById(int32 ObjectId)
-{
-    if (ObjectId == SelectedObjectId)
-    {
-        return false;
-    }
-
-    CleanupInvalidRecords();
-
-    if (FInteractiveObjectRecord* Record = FindRecordById(ObjectId))
-    {
-        SelectedObjectId = Record->ObjectId;
-        SelectedObject = Record->Component;
-
-        BroadcastSelectedObjectChanged();
-        return true;
-    }
-
-    return false;
-}
-
-bool UInteractiveObjectManagerSubsystem::SelectObjectByIndex(int32 Index)
-{
-    CleanupInvalidRecords();
-
-    if (!RegisteredObjects.IsValidIndex(Index))
-    {
-        return false;
-    }
-
-    FInteractiveObjectRecord& Record = RegisteredObjects[Index];
-    if (!Record.Component.IsValid())
-    {
-        return false;
-    }
-
-    if (Record.ObjectId == SelectedObjectId)
-    {
-        return false;
-    }
-
-    SelectedObjectId = Record.ObjectId;
-    SelectedObject = Record.Component;
-
-    BroadcastSelectedObjectChanged();
-    return true;
-}
-
-bool UInteractiveObjectManagerSubsystem::ClearSelection()
-{
-    if (SelectedObjectId == INDEX_NONE && !SelectedObject.IsValid())
-    {
-        return false;
-    }
-
-    SelectedObjectId = INDEX_NONE;
-    SelectedObject.Reset();
-
-    BroadcastSelectedObjectChanged();
-    return true;
-}
-
-FInteractiveObjectListItem UInteractiveObjectManagerSubsystem::GetSelectedObjectInfo(bool& bOutIsValid) const
-{
-    bOutIsValid = false;
-
-    FInteractiveObjectListItem Result;
-    Result.Id = INDEX_NONE;
-
-    if (SelectedObjectId == INDEX_NONE || !SelectedObject.IsValid())
-    {
-        return Result;
-    }
-
-    UInteractiveObjectComponent* InteractiveComponent = SelectedObject.Get();
-    if (InteractiveComponent == nullptr)
-    {
-        return Result;
-    }
-
-    AActor* OwnerActor = InteractiveComponent->GetOwner();
-    const FString DisplayName = (OwnerActor != nullptr) ? OwnerActor->GetName() : FString(TEXT("Unknown"));
-
-    Result.Id = SelectedObjectId;
-    Result.DisplayName = DisplayName;
-
-    bOutIsValid = true;
-    return Result;
-}
-
-//bool UInteractiveObjectManagerSubsystem::GetSelectedObjectProperties(FLinearColor& OutColor, float& OutUniformScale) const
-//{
-//    OutColor = FLinearColor::White;
-//    OutUniformScale = 1.0f;
-//
-//    if (!SelectedObject.IsValid())
-//    {
-//        UE_LOG(
-//            LogInteractiveObjectManager,
-//            Log,
-//            TEXT("GetSelectedObjectProperties: no selected object.")
-//        );
-//        return false;
-//    }
-//
-//    UInteractiveObjectComponent* InteractiveComponent = SelectedObject.Get();
-//    if (InteractiveComponent == nullptr)
-//    {
-//        UE_LOG(
-//            LogInteractiveObjectManager,
-//            Warning,
-//            TEXT("GetSelectedObjectProperties: selected object pointer is invalid.")
-//        );
-//        return false;
-//    }
-//
-//    OutColor = InteractiveComponent->GetCurrentColor();
-//    OutUniformScale = InteractiveComponent->GetCurrentScale();
-//    return true;
-//}
-
-void UInteractiveObjectManagerSubsystem::GetSelectedObjectVisualState(bool& bOutHasSelection, FLinearColor& OutColor, float& OutScale) const
-{
-    bOutHasSelection = false;
-
-    // Default fallback: safe defaults from settings or hardcoded values.
-    FInteractiveObjectRuntimeSettings RuntimeDefaults;
-    RuntimeDefaults.ApplySafeDefaults();
-
-    if (const UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get())
-    {
-        RuntimeDefaults = Settings->GetRuntimeSettingsCopy();
-    }
-
-    OutColor = RuntimeDefaults.DefaultColor;
-    OutScale = RuntimeDefaults.DefaultScale.X;
-
-    if (SelectedObjectId == INDEX_NONE || !SelectedObject.IsValid())
-    {
-        return;
-    }
-
-    UInteractiveObjectComponent* InteractiveComponent = SelectedObject.Get();
-    if (InteractiveComponent == nullptr)
-    {
-        return;
-    }
-
-    bOutHasSelection = true;
-    OutColor = InteractiveComponent->GetCurrentColor();
-    OutScale = InteractiveComponent->GetCurrentScale();
-}
-
-bool UInteractiveObjectManagerSubsystem::SetSelectedObjectColor(const FLinearColor& NewColor)
-{
-    if (!SelectedObject.IsValid())
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Log,
-            TEXT("SetSelectedObjectColor: no selected object.")
-        );
-        return false;
-    }
-
-    UInteractiveObjectComponent* InteractiveComponent = SelectedObject.Get();
-    if (InteractiveComponent == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("SetSelectedObjectColor: selected object pointer is invalid.")
-        );
-        return false;
-    }
-
-    InteractiveComponent->ApplyColor(NewColor);
-    return true;
-}
-
-bool UInteractiveObjectManagerSubsystem::SetSelectedObjectUniformScale(float NewUniformScale)
-{
-    if (!SelectedObject.IsValid())
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Log,
-            TEXT("SetSelectedObjectUniformScale: no selected object.")
-        );
-        return false;
-    }
-
-    UInteractiveObjectComponent* InteractiveComponent = SelectedObject.Get();
-    if (InteractiveComponent == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("SetSelectedObjectUniformScale: selected object pointer is invalid.")
-        );
-        return false;
-    }
-
-    InteractiveComponent->ApplyScale(NewUniformScale);
-    return true;
-}
-
-bool UInteractiveObjectManagerSubsystem::DeleteSelectedObject()
-{
-    if (!SelectedObject.IsValid())
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Log,
-            TEXT("DeleteSelectedObject: no selected object.")
-        );
-        return false;
-    }
-
-    UInteractiveObjectComponent* InteractiveComponent = SelectedObject.Get();
-    AActor* OwnerActor = (InteractiveComponent != nullptr) ? InteractiveComponent->GetOwner() : nullptr;
-    const int32 ObjectIdToRemove = SelectedObjectId;
-
-    SelectedObjectId = INDEX_NONE;
-    SelectedObject.Reset();
-
-    int32 RemovedIndex = INDEX_NONE;
-
-    for (int32 Index = 0; Index < RegisteredObjects.Num(); ++Index)
-    {
-        if (RegisteredObjects[Index].ObjectId == ObjectIdToRemove)
-        {
-            RegisteredObjects.RemoveAt(Index);
-            RemovedIndex = Index;
-            break;
-        }
-    }
-
-    if (OwnerActor != nullptr)
-    {
-        OwnerActor->Destroy();
-    }
-
-    if (RegisteredObjects.Num() > 0)
-    {
-        const FInteractiveObjectRecord& FirstRecord = RegisteredObjects[0];
-        SelectedObjectId = FirstRecord.ObjectId;
-        SelectedObject = FirstRecord.Component;
-    }
-
-    BroadcastObjectsListChanged();
-    BroadcastSelectedObjectChanged();
-
-    const bool bSuccess = (RemovedIndex != INDEX_NONE);
-
-    UE_LOG(
-        LogInteractiveObjectManager,
-        Log,
-        TEXT("DeleteSelectedObject: Id %d, success = %s."),
-        ObjectIdToRemove,
-        bSuccess ? TEXT("true") : TEXT("false")
-    );
-
-    return bSuccess;
-}
-
-void UInteractiveObjectManagerSubsystem::CleanupInvalidRecords()
-{
-    for (int32 Index = RegisteredObjects.Num() - 1; Index >= 0; --Index)
-    {
-        if (!RegisteredObjects[Index].Component.IsValid())
-        {
-            RegisteredObjects.RemoveAt(Index);
-        }
-    }
-
-    InvalidateSelectionIfNoLongerValid();
-}
-
-UInteractiveObjectManagerSubsystem::FInteractiveObjectRecord* UInteractiveObjectManagerSubsystem::FindRecordById(int32 ObjectId)
-{
-    for (FInteractiveObjectRecord& Record : RegisteredObjects)
-    {
-        if (Record.ObjectId == ObjectId && Record.Component.IsValid())
-        {
-            return &Record;
-        }
-    }
-
-    return nullptr;
-}
-
-UInteractiveObjectManagerSubsystem::FInteractiveObjectRecord* UInteractiveObjectManagerSubsystem::FindRecordByComponent(UInteractiveObjectComponent* InteractiveComponent)
-{
-    if (InteractiveComponent == nullptr)
-    {
-        return nullptr;
-    }
-
-    for (FInteractiveObjectRecord& Record : RegisteredObjects)
-    {
-        if (Record.Component.Get() == InteractiveComponent)
-        {
-            return &Record;
-        }
-    }
-
-    return nullptr;
-}
-
-void UInteractiveObjectManagerSubsystem::InvalidateSelectionIfNoLongerValid()
-{
-    if (SelectedObjectId == INDEX_NONE)
-    {
-        return;
-    }
-
-    if (!SelectedObject.IsValid())
-    {
-        SelectedObjectId = INDEX_NONE;
-        SelectedObject.Reset();
-        BroadcastSelectedObjectChanged();
-        return;
-    }
-
-    bool bFound = false;
-    for (const FInteractiveObjectRecord& Record : RegisteredObjects)
-    {
-        if (Record.ObjectId == SelectedObjectId && Record.Component == SelectedObject)
-        {
-            bFound = true;
-            break;
-        }
-    }
-
-    if (!bFound)
-    {
-        SelectedObjectId = INDEX_NONE;
-        SelectedObject.Reset();
-        BroadcastSelectedObjectChanged();
-    }
-}
-
-void UInteractiveObjectManagerSubsystem::BroadcastObjectsListChanged()
-{
-    TArray<FInteractiveObjectListItem> Items;
-    GetInteractiveObjectsList(Items);
-
-    OnObjectsListChanged.Broadcast(Items);
-}
-
-void UInteractiveObjectManagerSubsystem::BroadcastSelectedObjectChanged()
-{
-    OnSelectedObjectChanged.Broadcast(SelectedObjectId);
-}
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "Subsystems/InteractiveObjectManagerSubsystem.h"
+#include "InteractiveObjectManagerLog.h"
+#include "InteractiveObjectManagerStats.h"
+
+#include "Components/InteractiveObjectComponent.h"
+#include "Settings/InteractiveObjectSettings.h"
+#include "Settings/InteractiveObjectManagerDeveloperSettings.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "ConvexVolume.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Registered Objects"), STAT_IOM_RegisteredObjects, STATGROUP_InteractiveObjectManager);
+DECLARE_MEMORY_STAT(TEXT("Registry Memory"), STAT_IOM_RegistryMemory, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Register Object"), STAT_IOM_RegisterObject, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Unregister Object"), STAT_IOM_UnregisterObject, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Select Object"), STAT_IOM_SelectObject, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Bulk Selection Operation"), STAT_IOM_BulkSelectionOperation, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Sweep Invalid Records"), STAT_IOM_SweepInvalidRecords, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Subsystem Tick"), STAT_IOM_SubsystemTick, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Flush Notifications"), STAT_IOM_FlushNotifications, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Process Spawn Batches"), STAT_IOM_ProcessSpawnBatches, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Pool Prewarm"), STAT_IOM_PoolPrewarm, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Spatial Query"), STAT_IOM_SpatialQuery, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Ray Query"), STAT_IOM_RayQuery, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Screen Rect Query"), STAT_IOM_ScreenRectQuery, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Fetch Objects Page"), STAT_IOM_FetchObjectsPage, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Rebuild Sort Index"), STAT_IOM_RebuildSortIndex, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Publish Snapshot"), STAT_IOM_PublishSnapshot, STATGROUP_InteractiveObjectManager);
+DECLARE_MEMORY_STAT(TEXT("Snapshot Memory"), STAT_IOM_SnapshotMemory, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Execute Queued Commands"), STAT_IOM_ExecuteQueuedCommands, STATGROUP_InteractiveObjectManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Commands Executed"), STAT_IOM_QueuedCommandsExecuted, STATGROUP_InteractiveObjectManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Commands Pending"), STAT_IOM_QueuedCommandsPending, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Apply Undo Redo"), STAT_IOM_ApplyJournal, STATGROUP_InteractiveObjectManager);
+DECLARE_MEMORY_STAT(TEXT("Journal Memory"), STAT_IOM_JournalMemory, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Save Scene"), STAT_IOM_SaveScene, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Write-Ahead Log Recovery"), STAT_IOM_WriteAheadLogRecovery, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Checkpoint Slice"), STAT_IOM_CheckpointSlice, STATGROUP_InteractiveObjectManager);
+DECLARE_CYCLE_STAT(TEXT("Trace Replay"), STAT_IOM_TraceReplay, STATGROUP_InteractiveObjectManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Actors"), STAT_IOM_PooledActors, STATGROUP_InteractiveObjectManager);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Pool Hit Rate %"), STAT_IOM_PoolHitRate, STATGROUP_InteractiveObjectManager);
+DECLARE_MEMORY_STAT(TEXT("Pool Memory"), STAT_IOM_PoolMemory, STATGROUP_InteractiveObjectManager);
+
+static TAutoConsoleVariable<float> CVarMaxNotificationFlushRate(
+    TEXT("IOM.Notifications.MaxFlushRate"),
+    0.0f,
+    TEXT("Maximum number of list and selection notification flushes per second.\n")
+    TEXT("0 flushes once per frame. Explicit FlushPendingNotifications calls ignore this limit."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarRegistrySweepBudget(
+    TEXT("IOM.Registry.SweepBudget"),
+    256,
+    TEXT("Maximum number of registry records checked per frame by the incremental stale record sweep\n")
+    TEXT("that runs after garbage collection."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarPoolPrewarmBudget(
+    TEXT("IOM.Pool.PrewarmBudgetMs"),
+    1.0f,
+    TEXT("Milliseconds per frame spent spawning inactive actors into the actor pools after the primitive classes loaded.\n")
+    TEXT("At least one actor is spawned per frame while prewarm is pending."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarSpatialCellSize(
+    TEXT("IOM.Spatial.CellSize"),
+    500.0f,
+    TEXT("Cell size in world units of the interactive object spatial index.\n")
+    TEXT("Read when the subsystem initializes. Around twice the typical query radius works well."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarSortIndexRebuildThreshold(
+    TEXT("IOM.List.SortIndexRebuildThreshold"),
+    256,
+    TEXT("Number of incremental updates a list sort index accepts between two page requests.\n")
+    TEXT("Past this count the index is dropped and rebuilt in one sort on the next page request."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<bool> CVarSnapshotEnabled(
+    TEXT("IOM.Snapshot.Enabled"),
+    true,
+    TEXT("Publish an immutable registry snapshot for worker threads at the end of every frame in which the registry changed."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarMaxQueuedCommandsPerFrame(
+    TEXT("IOM.Commands.MaxPerFrame"),
+    0,
+    TEXT("Maximum number of queued commands executed per frame. Remaining commands wait for the next frame, in order.\n")
+    TEXT("0 executes everything queued."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarJournalCapacity(
+    TEXT("IOM.Journal.Capacity"),
+    65536,
+    TEXT("Number of operations kept in the undo journal. Memory is bounded by this count times the record size.\n")
+    TEXT("0 disables undo. Applied when the world starts or the history is cleared."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<bool> CVarWriteAheadLogEnabled(
+    TEXT("IOM.WAL.Enabled"),
+    false,
+    TEXT("Logs every spawn, delete, color and scale change next to the default scene file, from a background thread.\n")
+    TEXT("When a game world starts, the default scene is restored and the log replayed on top of it. Read when the world starts."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarWriteAheadLogFsyncPolicy(
+    TEXT("IOM.WAL.FsyncPolicy"),
+    1,
+    TEXT("When logged changes are forced to disk. 0 never, changes survive a crash of the process but not of the machine.\n")
+    TEXT("1 after every group commit. 2 at most once per IOM.WAL.FsyncIntervalMs. Read when the log is opened."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarWriteAheadLogGroupCommitMs(
+    TEXT("IOM.WAL.GroupCommitMs"),
+    5,
+    TEXT("Milliseconds the log writer waits between group commits. Every change queued meanwhile is written at once."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarWriteAheadLogFsyncIntervalMs(
+    TEXT("IOM.WAL.FsyncIntervalMs"),
+    100,
+    TEXT("Minimum milliseconds between two fsyncs when IOM.WAL.FsyncPolicy is 2."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarWriteAheadLogRecoveryFrameBudgetMs(
+    TEXT("IOM.WAL.RecoveryFrameBudgetMs"),
+    8.0f,
+    TEXT("Milliseconds per frame spent respawning the objects recovered from the default scene and its log."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<bool> CVarCheckpointEnabled(
+    TEXT("IOM.Checkpoint.Enabled"),
+    false,
+    TEXT("Tracks changed objects and writes incremental checkpoints under Saved/InteractiveObjects/Checkpoints.\n")
+    TEXT("Read when a game world starts."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarCheckpointIntervalSeconds(
+    TEXT("IOM.Checkpoint.IntervalSeconds"),
+    30.0f,
+    TEXT("Seconds between two automatic checkpoints. 0 only checkpoints on request."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarCheckpointFrameBudgetMs(
+    TEXT("IOM.Checkpoint.FrameBudgetMs"),
+    1.0f,
+    TEXT("Milliseconds per frame spent serializing objects of a checkpoint in progress."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarSpawnSeed(
+    TEXT("IOM.Spawn.Seed"),
+    0,
+    TEXT("Seed of the random stream used for spawn placement and random class picks. 0 seeds from the clock.\n")
+    TEXT("Read when the world starts and when a trace recording starts. A replay uses the seed of its trace."),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCheckpointMaxDeltas(
+    TEXT("IOM.Checkpoint.MaxDeltas"),
+    32,
+    TEXT("Delta checkpoints written on top of a full one before the next checkpoint starts a new chain.\n")
+    TEXT("Bounds the number of segments a load has to merge."),
+    ECVF_Default
+);
+
+/** Wraps Operation in a queued command whose result resolves the returned future. Discarded commands resolve to DiscardedResult. */
+template <typename ResultType>
+static TFuture<ResultType> EnqueueCommandWithResult(
+    FInteractiveObjectCommandQueue& Queue,
+    ResultType DiscardedResult,
+    TUniqueFunction<ResultType(UInteractiveObjectManagerSubsystem&)>&& Operation)
+{
+    TPromise<ResultType> Promise;
+    TFuture<ResultType> Future = Promise.GetFuture();
+
+    Queue.Enqueue([DiscardedResult, Operation = MoveTemp(Operation), Promise = MoveTemp(Promise)](UInteractiveObjectManagerSubsystem* Subsystem) mutable
+    {
+        Promise.SetValue((Subsystem != nullptr) ? Operation(*Subsystem) : DiscardedResult);
+    });
+
+    return Future;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GInteractiveObjectSceneSaveCommand(
+    TEXT("IOM.Scene.Save"),
+    TEXT("Saves every interactive object of the current world to a scene file.\n")
+    TEXT("Usage: IOM.Scene.Save [FilePath=Saved/InteractiveObjects/Scene.iom]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (World == nullptr)
+        {
+            return;
+        }
+
+        if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            ManagerSubsystem->SaveScene((Args.Num() > 0) ? Args[0] : FString());
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GInteractiveObjectSceneLoadCommand(
+    TEXT("IOM.Scene.Load"),
+    TEXT("Replaces the interactive objects of the current world with the ones of a scene file.\n")
+    TEXT("Usage: IOM.Scene.Load [FilePath=Saved/InteractiveObjects/Scene.iom] [FrameBudgetMilliseconds=8]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (World == nullptr)
+        {
+            return;
+        }
+
+        if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            const float FrameBudgetMilliseconds = (Args.Num() > 1) ? FCString::Atof(*Args[1]) : 8.0f;
+            ManagerSubsystem->LoadScene((Args.Num() > 0) ? Args[0] : FString(), true, FrameBudgetMilliseconds);
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GInteractiveObjectCheckpointSaveCommand(
+    TEXT("IOM.Checkpoint.Save"),
+    TEXT("Starts a checkpoint of the objects changed since the previous one. Requires IOM.Checkpoint.Enabled.\n")
+    TEXT("Usage: IOM.Checkpoint.Save [full]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (World == nullptr)
+        {
+            return;
+        }
+
+        if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            const bool bFull = (Args.Num() > 0) && Args[0].Equals(TEXT("full"), ESearchCase::IgnoreCase);
+            if (!ManagerSubsystem->RequestCheckpoint(bFull))
+            {
+                UE_LOG(
+                    LogInteractiveObjectManager,
+                    Log,
+                    TEXT("IOM.Checkpoint.Save: No checkpoint started. Checkpoints are disabled, one is in progress or nothing changed.")
+                );
+            }
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GInteractiveObjectCheckpointLoadCommand(
+    TEXT("IOM.Checkpoint.Load"),
+    TEXT("Replaces the interactive objects of the current world with the ones of the latest checkpoint.\n")
+    TEXT("Usage: IOM.Checkpoint.Load [FrameBudgetMilliseconds=8]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (World == nullptr)
+        {
+            return;
+        }
+
+        if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            const float FrameBudgetMilliseconds = (Args.Num() > 0) ? FCString::Atof(*Args[0]) : 8.0f;
+            ManagerSubsystem->LoadLatestCheckpoint(true, FrameBudgetMilliseconds);
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GInteractiveObjectTraceRecordCommand(
+    TEXT("IOM.Trace.Record"),
+    TEXT("Starts recording subsystem calls to a session trace, written by IOM.Trace.Stop.\n")
+    TEXT("Usage: IOM.Trace.Record [FilePath=Saved/InteractiveObjects/Session.iomtrace]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (World == nullptr)
+        {
+            return;
+        }
+
+        if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            ManagerSubsystem->StartTraceRecording((Args.Num() > 0) ? Args[0] : FString());
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorld GInteractiveObjectTraceStopCommand(
+    TEXT("IOM.Trace.Stop"),
+    TEXT("Stops the session trace recording and writes the trace."),
+    FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+    {
+        if (World == nullptr)
+        {
+            return;
+        }
+
+        if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            ManagerSubsystem->StopTraceRecording();
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GInteractiveObjectTraceReplayCommand(
+    TEXT("IOM.Trace.Replay"),
+    TEXT("Replays a session trace as fast as possible, or at the recorded pacing with 'original'.\n")
+    TEXT("Usage: IOM.Trace.Replay [FilePath=Saved/InteractiveObjects/Session.iomtrace] [original]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (World == nullptr)
+        {
+            return;
+        }
+
+        if (UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            const bool bOriginalPacing = (Args.Num() > 1) && Args[1].Equals(TEXT("original"), ESearchCase::IgnoreCase);
+            ManagerSubsystem->StartTraceReplay((Args.Num() > 0) ? Args[0] : FString(), bOriginalPacing);
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorld GInteractiveObjectManagerReportCommand(
+    TEXT("IOM.Report"),
+    TEXT("Logs Interactive Object Manager registry and actor pool statistics for the current world."),
+    FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+    {
+        if (World == nullptr)
+        {
+            return;
+        }
+
+        if (const UInteractiveObjectManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>())
+        {
+            ManagerSubsystem->LogRuntimeReport();
+        }
+    })
+);
+
+static FAutoConsoleCommand GInteractiveObjectRegistryBenchmarkCommand(
+    TEXT("IOM.Registry.Benchmark"),
+    TEXT("Benchmarks register, lookup, select and unregister on the object registry at 1000 objects and every tenfold up to NumObjects.\n")
+    TEXT("Usage: IOM.Registry.Benchmark [NumObjects=100000] [NumLookups=100000]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumObjects = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 100000;
+        const int32 NumLookups = (Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 100000;
+        UInteractiveObjectManagerSubsystem::RunRegistryBenchmark(FMath::Max(NumObjects, 1000), FMath::Max(NumLookups, 1));
+    })
+);
+
+/** Placeholder name for records whose component is gone. Built once. */
+static const FText& GetUnknownDisplayText()
+{
+    static const FText UnknownDisplayText = FText::FromString(TEXT("Unknown"));
+    return UnknownDisplayText;
+}
+
+/** Lower bound for uniform scale, matches the clamp in UInteractiveObjectComponent. */
+static constexpr float MinUniformScale = 0.01f;
+
+/** Per instance custom data of instanced objects: linear red, green and blue. */
+static constexpr int32 InstanceColorCustomDataFloats = 3;
+
+static FLinearColor ToLinearColor(const FFloat16Color& Color)
+{
+    return FLinearColor(Color.R.GetFloat(), Color.G.GetFloat(), Color.B.GetFloat(), Color.A.GetFloat());
+}
+
+/** Returns the index of ActorClass in a scene class table, adding it on first use. */
+static uint16 FindOrAddSceneClass(const UClass* ActorClass, TMap<const UClass*, uint16>& ClassIndices, TArray<FString>& ClassPaths)
+{
+    if (const uint16* ClassIndex = ClassIndices.Find(ActorClass))
+    {
+        return *ClassIndex;
+    }
+
+    return ClassIndices.Add(ActorClass, static_cast<uint16>(ClassPaths.Add(ActorClass->GetPathName())));
+}
+
+/** Unique, non zero checkpoint stamp for a scene save. */
+static uint64 MakeSceneCheckpoint()
+{
+    return static_cast<uint64>(FDateTime::UtcNow().GetTicks());
+}
+
+/** Default scene records with the write-ahead log replayed on top, restored by a single spawn batch. */
+struct FRecoveredScene
+{
+    TArray<FString> ClassPaths;
+    TArray<FInteractiveObjectSceneRecord> Records;
+
+    /** Index in Records by the Id the object had when it was saved or logged. Records without an Id are not listed. */
+    TMap<int32, int32> ObjectIdToRecord;
+
+    /** Index in ClassPaths of every class the log defined, INDEX_NONE for indices it never defined. */
+    TArray<int32> LogToSceneClass;
+
+    void AddRecord(const FInteractiveObjectSceneRecord& Record)
+    {
+        const int32 RecordIndex = Records.Add(Record);
+        if (Record.ObjectId != 0)
+        {
+            ObjectIdToRecord.Add(Record.ObjectId, RecordIndex);
+        }
+    }
+
+    void Apply(const FInteractiveObjectWalRecord& Record, const FString& LogClassPath)
+    {
+        switch (Record.Op)
+        {
+        case EInteractiveObjectWalOp::DefineClass:
+        {
+            int32 ClassIndex = ClassPaths.Find(LogClassPath);
+            if (ClassIndex == INDEX_NONE)
+            {
+                ClassIndex = ClassPaths.Add(LogClassPath);
+            }
+
+            while (LogToSceneClass.Num() <= Record.ClassIndex)
+            {
+                LogToSceneClass.Add(INDEX_NONE);
+            }
+            LogToSceneClass[Record.ClassIndex] = ClassIndex;
+            break;
+        }
+
+        case EInteractiveObjectWalOp::Spawn:
+        {
+            if (!LogToSceneClass.IsValidIndex(Record.ClassIndex) || LogToSceneClass[Record.ClassIndex] == INDEX_NONE)
+            {
+                break;
+            }
+
+            FInteractiveObjectSceneRecord SceneRecord;
+            SceneRecord.SetTransform(FVector(Record.Location), FQuat(Record.Rotation));
+            SceneRecord.UniformScale = Record.UniformScale;
+            SceneRecord.Color = FFloat16Color(Record.Color);
+            SceneRecord.ClassIndex = static_cast<uint16>(LogToSceneClass[Record.ClassIndex]);
+            SceneRecord.ObjectId = Record.ObjectId;
+            AddRecord(SceneRecord);
+            break;
+        }
+
+        case EInteractiveObjectWalOp::Delete:
+        {
+            int32 RecordIndex = INDEX_NONE;
+            if (!ObjectIdToRecord.RemoveAndCopyValue(Record.ObjectId, RecordIndex))
+            {
+                break;
+            }
+
+            Records.RemoveAtSwap(RecordIndex, 1, EAllowShrinking::No);
+            if (Records.IsValidIndex(RecordIndex))
+            {
+                if (int32* MovedRecordIndex = ObjectIdToRecord.Find(Records[RecordIndex].ObjectId))
+                {
+                    *MovedRecordIndex = RecordIndex;
+                }
+            }
+            break;
+        }
+
+        case EInteractiveObjectWalOp::SetColor:
+            if (const int32* RecordIndex = ObjectIdToRecord.Find(Record.ObjectId))
+            {
+                Records[*RecordIndex].Color = FFloat16Color(Record.Color);
+            }
+            break;
+
+        case EInteractiveObjectWalOp::SetScale:
+            if (const int32* RecordIndex = ObjectIdToRecord.Find(Record.ObjectId))
+            {
+                Records[*RecordIndex].UniformScale = Record.UniformScale;
+            }
+            break;
+        }
+    }
+};
+
+/** Rough memory held by an actor and its components: object sizes plus exclusive resource sizes. */
+static int64 EstimateActorMemoryBytes(AActor* Actor)
+{
+    int64 TotalBytes = Actor->GetClass()->GetStructureSize() + Actor->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+    for (UActorComponent* Component : Actor->GetComponents())
+    {
+        if (Component != nullptr)
+        {
+            TotalBytes += Component->GetClass()->GetStructureSize() + Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+        }
+    }
+
+    return TotalBytes;
+}
+
+UInteractiveObjectManagerSubsystem::UInteractiveObjectManagerSubsystem()
+    : NextObjectId(1)
+    , SelectedObjectCount(0)
+    , PendingRegistrationFlags(EInteractiveObjectFlags::None)
+    , bIsSnapshotDirty(false)
+    , bIsApplyingJournal(false)
+    , bIsWriteAheadRecoveryPending(false)
+    , bHasWriteAheadLogFailed(false)
+    , bIsCheckpointTrackingEnabled(false)
+    , CheckpointChain(0)
+    , NextCheckpointSequence(0)
+    , LastCheckpointTime(0.0)
+    , bIsRecordingTrace(false)
+    , TraceStartFrame(0)
+    , TraceStartTime(0.0)
+    , bIsInsideTracedCall(false)
+    , bIsObjectsListDirty(false)
+    , ObjectsListVersion(0)
+    , bIsSelectionDirty(false)
+    , LastNotificationFlushTime(0.0)
+    , SweepCursor(INDEX_NONE)
+    , NextSpawnBatchId(1)
+    , bArePrimitiveClassesLoaded(false)
+    , bHasSpawnedFirstObject(false)
+    , InitializeTime(0.0)
+    , PrimitiveClassesLoadedTime(0.0)
+    , TotalPoolHits(0)
+    , TotalPoolMisses(0)
+    , bIsActorPoolingEnabled(false)
+    , PoolPrewarmCount(0)
+    , PoolMaxSize(0)
+    , bIsPoolPrewarmPending(false)
+    , bIsPrewarmingPool(false)
+    , RenderingMode(EInteractiveObjectRenderingMode::Actors)
+    , bIsSharingDynamicMaterials(false)
+{
+}
+
+void UInteractiveObjectManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (UWorld* World = GetWorld())
+    {
+        ActorDestroyedHandle = World->AddOnActorDestroyedHandler(
+            FOnActorDestroyed::FDelegate::CreateUObject(this, &UInteractiveObjectManagerSubsystem::HandleActorDestroyed)
+        );
+    }
+
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(
+        this,
+        &UInteractiveObjectManagerSubsystem::HandlePostGarbageCollect
+    );
+
+    SpatialIndex.Reset(CVarSpatialCellSize.GetValueOnGameThread());
+    Journal.Reset(CVarJournalCapacity.GetValueOnGameThread());
+
+    const UWorld* World = GetWorld();
+    bIsWriteAheadRecoveryPending = CVarWriteAheadLogEnabled.GetValueOnGameThread() && World != nullptr && World->IsGameWorld();
+    bIsCheckpointTrackingEnabled = CVarCheckpointEnabled.GetValueOnGameThread() && World != nullptr && World->IsGameWorld();
+
+    const UInteractiveObjectManagerDeveloperSettings* DeveloperSettings = GetDefault<UInteractiveObjectManagerDeveloperSettings>();
+    RenderingMode = (DeveloperSettings != nullptr && World != nullptr && World->IsGameWorld())
+        ? DeveloperSettings->RenderingMode
+        : EInteractiveObjectRenderingMode::Actors;
+    bIsSharingDynamicMaterials = DeveloperSettings != nullptr && DeveloperSettings->bShareDynamicMaterials && World != nullptr && World->IsGameWorld();
+
+    // Acquire and release run for every spawn and delete, so they work on these copies.
+    bIsActorPoolingEnabled = DeveloperSettings != nullptr && DeveloperSettings->bEnableActorPooling;
+    PoolPrewarmCount = bIsActorPoolingEnabled ? FMath::Max(DeveloperSettings->PoolPrewarmCount, 0) : 0;
+    PoolMaxSize = bIsActorPoolingEnabled ? FMath::Max(DeveloperSettings->PoolMaxSize, 0) : 0;
+
+    const int32 SpawnSeed = CVarSpawnSeed.GetValueOnGameThread();
+    SpawnRandomStream.Initialize((SpawnSeed != 0) ? SpawnSeed : static_cast<int32>(FPlatformTime::Cycles()));
+
+    InitializeTime = FPlatformTime::Seconds();
+    LastCheckpointTime = InitializeTime;
+
+    // Headless runs replay a trace straight away, the replay itself waits for the primitive classes.
+    FString ReplayFilePath;
+    if (World != nullptr && World->IsGameWorld() && FParse::Value(FCommandLine::Get(), TEXT("IOMReplay="), ReplayFilePath))
+    {
+        if (StartTraceReplay(ReplayFilePath, FParse::Param(FCommandLine::Get(), TEXT("IOMReplayOriginalPacing"))))
+        {
+            ActiveReplay.bExitWhenDone = FParse::Param(FCommandLine::Get(), TEXT("IOMReplayExit"));
+        }
+    }
+
+    RequestPrimitiveClassesLoad();
+}
+
+void UInteractiveObjectManagerSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+    }
+
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+    // Resolves every queued future as discarded. Later enqueues are discarded on the calling thread.
+    CommandQueue.Close();
+
+    // Everything logged so far reaches the file before the world goes away.
+    WriteAheadLog.Close();
+    WriteAheadLogClassIndices.Empty();
+    bIsWriteAheadRecoveryPending = false;
+    bHasWriteAheadLogFailed = false;
+
+    // An unfinished recovery leaves the old scene and log in place, the next start recovers from them again.
+    WriteAheadRecovery = FWriteAheadRecovery();
+
+    // The segment being written is kept, a checkpoint still being serialized is dropped.
+    if (CheckpointWriteTask.IsValid())
+    {
+        CheckpointWriteTask.Wait();
+        CheckpointWriteTask = {};
+    }
+
+    ActiveCheckpoint = FActiveCheckpoint();
+    bIsCheckpointTrackingEnabled = false;
+
+    if (bIsRecordingTrace)
+    {
+        StopTraceRecording();
+    }
+
+    ActiveReplay = FActiveReplay();
+    CheckpointDirtyIds.Empty();
+    CheckpointDeletedIds.Empty();
+    CheckpointChain = 0;
+    NextCheckpointSequence = 0;
+
+    ActorDestroyedHandle.Reset();
+    PostGarbageCollectHandle.Reset();
+    SweepCursor = INDEX_NONE;
+    PendingSpawnBatches.Empty();
+
+    if (PrimitiveClassesLoadHandle.IsValid())
+    {
+        PrimitiveClassesLoadHandle->CancelHandle();
+        PrimitiveClassesLoadHandle.Reset();
+    }
+
+    LoadedCubeClass = nullptr;
+    LoadedSphereClass = nullptr;
+    LoadedAdditionalClasses.Empty();
+    SceneClasses.Empty();
+    bArePrimitiveClassesLoaded = false;
+
+    ActorPools.Empty();
+    TotalPoolHits = 0;
+    TotalPoolMisses = 0;
+    bIsActorPoolingEnabled = false;
+    bIsPoolPrewarmPending = false;
+
+    // Owner actors go away with the world.
+    InstanceBatches.Empty();
+    InstanceBatchIndices.Empty();
+    LoadedInstancedMaterial = nullptr;
+
+    // Components release into the emptied cache as a no-op, their meshes keep the instances alive.
+    MaterialCache.Reset();
+    bIsSharingDynamicMaterials = false;
+
+    RegisteredObjects.Empty();
+    ObjectColumns.Empty();
+    Slots.Empty();
+    FreeSlotIndices.Empty();
+    SpatialIndex.Reset(CVarSpatialCellSize.GetValueOnGameThread());
+    ResetSortIndices();
+    SnapshotPublisher.Reset();
+    bIsSnapshotDirty = false;
+    Journal.Reset(0);
+    ObjectIdToSlot.Empty();
+    ComponentToSlot.Empty();
+    SelectedHandle.Reset();
+    SelectionBits.Empty();
+    SelectedObjectCount = 0;
+    bIsObjectsListDirty = false;
+    bIsSelectionDirty = false;
+    PendingAddedIds.Empty();
+    PendingRemovedIds.Empty();
+    PendingChangedIds.Empty();
+
+    Super::Deinitialize();
+}
+
+void UInteractiveObjectManagerSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_SubsystemTick);
+
+    Super::Tick(DeltaTime);
+
+    if (SweepCursor != INDEX_NONE)
+    {
+        SweepInvalidRecords(FMath::Max(CVarRegistrySweepBudget.GetValueOnGameThread(), 1));
+    }
+
+    if (bIsWriteAheadRecoveryPending && bArePrimitiveClassesLoaded)
+    {
+        RecoverFromWriteAheadLog();
+    }
+
+    // Records a bulk operation spilled past the log ring move in as the writer catches up.
+    WriteAheadLog.DrainOverflow();
+
+    if (WriteAheadLog.IsOpen() && WriteAheadLog.HasFailed())
+    {
+        WriteAheadLog.Close();
+        bHasWriteAheadLogFailed = true;
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Error,
+            TEXT("InteractiveObjectManagerSubsystem: Write-ahead log closed after an I/O error. Changes are not crash safe until the default scene is saved again.")
+        );
+    }
+
+    ProcessTraceReplay();
+    ExecuteQueuedCommands();
+    ProcessPendingSpawnBatches();
+    ProcessPoolPrewarm();
+    PublishSnapshotIfDirty();
+    ProcessCheckpoint();
+
+    if (!bIsObjectsListDirty && !bIsSelectionDirty)
+    {
+        return;
+    }
+
+    const float MaxFlushRate = CVarMaxNotificationFlushRate.GetValueOnGameThread();
+    if (MaxFlushRate > 0.0f)
+    {
+        const double Now = FPlatformTime::Seconds();
+        if (Now - LastNotificationFlushTime < 1.0 / MaxFlushRate)
+        {
+            return;
+        }
+    }
+
+    FlushPendingNotifications();
+}
+
+void UInteractiveObjectManagerSubsystem::EnqueueCommand(FInteractiveObjectCommandQueue::FCommand&& Command)
+{
+    CommandQueue.Enqueue(MoveTemp(Command));
+}
+
+TFuture<int32> UInteractiveObjectManagerSubsystem::EnqueueSpawnObjectsBatch(int32 Count, EInteractiveObjectSpawnType SpawnType, const FInteractiveObjectBatchSpawnParams& Params)
+{
+    return EnqueueCommandWithResult<int32>(CommandQueue, INDEX_NONE, [Count, SpawnType, Params](UInteractiveObjectManagerSubsystem& Subsystem)
+    {
+        return Subsystem.SpawnObjectsBatch(Count, SpawnType, Params);
+    });
+}
+
+TFuture<bool> UInteractiveObjectManagerSubsystem::EnqueueSelectObject(FInteractiveObjectHandle Handle)
+{
+    return EnqueueCommandWithResult<bool>(CommandQueue, false, [Handle](UInteractiveObjectManagerSubsystem& Subsystem)
+    {
+        return Subsystem.SelectObject(Handle);
+    });
+}
+
+TFuture<int32> UInteractiveObjectManagerSubsystem::EnqueueSelectObjects(TArray<FInteractiveObjectHandle>&& Handles, bool bAddToSelection)
+{
+    return EnqueueCommandWithResult<int32>(CommandQueue, 0, [Handles = MoveTemp(Handles), bAddToSelection](UInteractiveObjectManagerSubsystem& Subsystem)
+    {
+        return Subsystem.SelectObjects(Handles, bAddToSelection);
+    });
+}
+
+TFuture<bool> UInteractiveObjectManagerSubsystem::EnqueueSetObjectColor(FInteractiveObjectHandle Handle, const FLinearColor& NewColor)
+{
+    return EnqueueCommandWithResult<bool>(CommandQueue, false, [Handle, NewColor](UInteractiveObjectManagerSubsystem& Subsystem)
+    {
+        return Subsystem.SetObjectColor(Handle, NewColor);
+    });
+}
+
+TFuture<bool> UInteractiveObjectManagerSubsystem::EnqueueSetObjectUniformScale(FInteractiveObjectHandle Handle, float NewUniformScale)
+{
+    return EnqueueCommandWithResult<bool>(CommandQueue, false, [Handle, NewUniformScale](UInteractiveObjectManagerSubsystem& Subsystem)
+    {
+        return Subsystem.SetObjectUniformScale(Handle, NewUniformScale);
+    });
+}
+
+TFuture<bool> UInteractiveObjectManagerSubsystem::EnqueueDeleteObject(FInteractiveObjectHandle Handle)
+{
+    return EnqueueCommandWithResult<bool>(CommandQueue, false, [Handle](UInteractiveObjectManagerSubsystem& Subsystem)
+    {
+        return Subsystem.DeleteObject(Handle);
+    });
+}
+
+void UInteractiveObjectManagerSubsystem::AddJournalRecord(FInteractiveObjectJournalRecord&& Record)
+{
+    if (bIsApplyingJournal)
+    {
+        return;
+    }
+
+    Journal.Add(MoveTemp(Record));
+    SET_MEMORY_STAT(STAT_IOM_JournalMemory, Journal.GetAllocatedSize());
+}
+
+uint16 UInteractiveObjectManagerSubsystem::FindOrAddWriteAheadLogClass(const UClass* ObjectClass)
+{
+    if (ObjectClass == nullptr || !WriteAheadLog.IsOpen())
+    {
+        return 0;
+    }
+
+    if (const uint16* ClassIndex = WriteAheadLogClassIndices.Find(ObjectClass))
+    {
+        return *ClassIndex;
+    }
+
+    // The first object of a class defines it, so the log replays without the scene file class table.
+    const uint16 NewClassIndex = WriteAheadLog.DefineClass(ObjectClass->GetPathName());
+    WriteAheadLogClassIndices.Add(ObjectClass, NewClassIndex);
+    return NewClassIndex;
+}
+
+void UInteractiveObjectManagerSubsystem::RecordColorChange(FInteractiveObjectHandle Handle, const FLinearColor& PreviousColor, const FLinearColor& NewColor)
+{
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    MarkCheckpointDirty(DenseIndex);
+
+    if (WriteAheadLog.IsOpen() && DenseIndex != INDEX_NONE)
+    {
+        FInteractiveObjectWalRecord WalRecord;
+        WalRecord.Op = EInteractiveObjectWalOp::SetColor;
+        WalRecord.ObjectId = RegisteredObjects[DenseIndex].ObjectId;
+        WalRecord.Color = NewColor;
+        WriteAheadLog.Append(WalRecord);
+    }
+
+    FInteractiveObjectJournalRecord Record;
+    Record.Handle = Handle;
+    Record.Op = EInteractiveObjectJournalOp::SetColor;
+    Record.BeforeColor = FFloat16Color(PreviousColor);
+    Record.AfterColor = FFloat16Color(NewColor);
+
+    AddJournalRecord(MoveTemp(Record));
+}
+
+void UInteractiveObjectManagerSubsystem::RecordScaleChange(FInteractiveObjectHandle Handle, float PreviousScale, float NewScale)
+{
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    MarkCheckpointDirty(DenseIndex);
+
+    if (WriteAheadLog.IsOpen() && DenseIndex != INDEX_NONE)
+    {
+        FInteractiveObjectWalRecord WalRecord;
+        WalRecord.Op = EInteractiveObjectWalOp::SetScale;
+        WalRecord.ObjectId = RegisteredObjects[DenseIndex].ObjectId;
+        WalRecord.UniformScale = NewScale;
+        WriteAheadLog.Append(WalRecord);
+    }
+
+    FInteractiveObjectJournalRecord Record;
+    Record.Handle = Handle;
+    Record.Op = EInteractiveObjectJournalOp::SetScale;
+    Record.BeforeScale = PreviousScale;
+    Record.AfterScale = NewScale;
+
+    AddJournalRecord(MoveTemp(Record));
+}
+
+void UInteractiveObjectManagerSubsystem::RecordSpawnOrDelete(EInteractiveObjectJournalOp Op, FInteractiveObjectHandle Handle, const FLinearColor& Color, float UniformScale)
+{
+    const int32 DenseIndex = FindDenseIndex(Handle);
+
+    UClass* ObjectClass = nullptr;
+    FTransform ObjectTransform;
+    if (DenseIndex == INDEX_NONE || !GetObjectClassAndTransform(DenseIndex, ObjectClass, ObjectTransform))
+    {
+        return;
+    }
+
+    // Undo and redo are mutations like any other for the log, only the journal skips them.
+    if (WriteAheadLog.IsOpen())
+    {
+        FInteractiveObjectWalRecord WalRecord;
+        WalRecord.ObjectId = RegisteredObjects[DenseIndex].ObjectId;
+
+        if (Op == EInteractiveObjectJournalOp::Spawn)
+        {
+            WalRecord.Op = EInteractiveObjectWalOp::Spawn;
+            WalRecord.ClassIndex = FindOrAddWriteAheadLogClass(ObjectClass);
+            WalRecord.Color = Color;
+            WalRecord.UniformScale = UniformScale;
+            WalRecord.Location = FVector3f(ObjectTransform.GetLocation());
+            WalRecord.Rotation = FQuat4f(ObjectTransform.GetRotation());
+        }
+        else
+        {
+            WalRecord.Op = EInteractiveObjectWalOp::Delete;
+        }
+
+        WriteAheadLog.Append(WalRecord);
+    }
+
+    if (bIsApplyingJournal)
+    {
+        return;
+    }
+
+    FInteractiveObjectJournalRecord Record;
+    Record.Handle = Handle;
+    Record.Op = Op;
+    Record.ClassIndex = Journal.FindOrAddClass(ObjectClass);
+    Record.Location = FVector3f(ObjectTransform.GetLocation());
+    Record.SetRotation(ObjectTransform.GetRotation());
+
+    // A spawn is undone by deleting, so it only needs the state it created. A delete needs the state it destroyed.
+    if (Op == EInteractiveObjectJournalOp::Spawn)
+    {
+        Record.AfterColor = FFloat16Color(Color);
+        Record.AfterScale = UniformScale;
+    }
+    else
+    {
+        Record.BeforeColor = FFloat16Color(Color);
+        Record.BeforeScale = UniformScale;
+    }
+
+    AddJournalRecord(MoveTemp(Record));
+}
+
+int32 UInteractiveObjectManagerSubsystem::ApplyJournalRecords(const TArray<FInteractiveObjectJournalRecord>& Records, bool bIsUndo)
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_ApplyJournal);
+
+    TGuardValue<bool> ApplyGuard(bIsApplyingJournal, true);
+
+    int32 ColorChangeCount = 0;
+    int32 ScaleChangeCount = 0;
+    for (const FInteractiveObjectJournalRecord& Record : Records)
+    {
+        ColorChangeCount += (Record.Op == EInteractiveObjectJournalOp::SetColor) ? 1 : 0;
+        ScaleChangeCount += (Record.Op == EInteractiveObjectJournalOp::SetScale) ? 1 : 0;
+    }
+
+    PrepareSortIndexForBulkChange(EInteractiveObjectSortKey::ColorHue, ColorChangeCount);
+    PrepareSortIndexForBulkChange(EInteractiveObjectSortKey::Scale, ScaleChangeCount);
+
+    // Objects brought back get new handles. Later records of this batch and the rest of the journal follow them.
+    TMap<FInteractiveObjectHandle, FInteractiveObjectHandle> RespawnedHandles;
+
+    int32 AppliedCount = 0;
+    for (const FInteractiveObjectJournalRecord& Record : Records)
+    {
+        FInteractiveObjectHandle Handle = Record.Handle;
+        if (const FInteractiveObjectHandle* RespawnedHandle = RespawnedHandles.Find(Handle))
+        {
+            Handle = *RespawnedHandle;
+        }
+
+        bool bApplied = false;
+        switch (Record.Op)
+        {
+        case EInteractiveObjectJournalOp::SetColor:
+            bApplied = SetObjectColor(Handle, ToLinearColor(bIsUndo ? Record.BeforeColor : Record.AfterColor));
+            break;
+
+        case EInteractiveObjectJournalOp::SetScale:
+            bApplied = SetObjectUniformScale(Handle, bIsUndo ? Record.BeforeScale : Record.AfterScale);
+            break;
+
+        case EInteractiveObjectJournalOp::Spawn:
+        case EInteractiveObjectJournalOp::Delete:
+        {
+            // Undoing a spawn and redoing a delete remove the object. The other two bring it back.
+            const bool bIsSpawn = (Record.Op == EInteractiveObjectJournalOp::Spawn);
+            if (bIsSpawn == bIsUndo)
+            {
+                bApplied = DeleteObject(Handle);
+                break;
+            }
+
+            const FInteractiveObjectHandle NewHandle = SpawnInteractiveObject(
+                Journal.GetClass(Record.ClassIndex),
+                FVector(Record.Location),
+                ToLinearColor(bIsSpawn ? Record.AfterColor : Record.BeforeColor),
+                bIsSpawn ? Record.AfterScale : Record.BeforeScale,
+                Record.GetRotation()
+            );
+
+            if (NewHandle.IsSet())
+            {
+                RespawnedHandles.Add(Record.Handle, NewHandle);
+                bApplied = true;
+            }
+            break;
+        }
+        }
+
+        AppliedCount += bApplied ? 1 : 0;
+    }
+
+    Journal.RemapHandles(RespawnedHandles);
+    return AppliedCount;
+}
+
+void UInteractiveObjectManagerSubsystem::ExecuteQueuedCommands()
+{
+    if (CommandQueue.GetNumPending() == 0)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_ExecuteQueuedCommands);
+
+    const int32 ExecutedCount = CommandQueue.Execute(this, CVarMaxQueuedCommandsPerFrame.GetValueOnGameThread());
+
+    INC_DWORD_STAT_BY(STAT_IOM_QueuedCommandsExecuted, ExecutedCount);
+    SET_DWORD_STAT(STAT_IOM_QueuedCommandsPending, CommandQueue.GetNumPending());
+}
+
+TStatId UInteractiveObjectManagerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UInteractiveObjectManagerSubsystem, STATGROUP_Tickables);
+}
+
+bool UInteractiveObjectManagerSubsystem::IsTickableWhenPaused() const
+{
+    // UI still needs list and selection updates while the game is paused.
+    return true;
+}
+
+void UInteractiveObjectManagerSubsystem::FlushPendingNotifications()
+{
+    if (!bIsObjectsListDirty && !bIsSelectionDirty)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_FlushNotifications);
+
+    LastNotificationFlushTime = FPlatformTime::Seconds();
+
+    // Clear flags before broadcasting so that listeners may mark new changes for the next flush.
+    if (bIsObjectsListDirty)
+    {
+        bIsObjectsListDirty = false;
+        BroadcastObjectsListDelta();
+
+        // The full snapshot is expensive at large object counts, only build it for legacy listeners.
+        if (OnObjectsListChanged.IsBound())
+        {
+            BroadcastObjectsListChanged();
+        }
+    }
+
+    if (bIsSelectionDirty)
+    {
+        bIsSelectionDirty = false;
+        BroadcastSelectedObjectChanged();
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::SpawnDefaultObject()
+{
+    TraceCall(EInteractiveObjectTraceOp::SpawnDefaultObject);
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get();
+    if (Settings == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem::SpawnDefaultObject: Settings object is null, using Cube as fallback.")
+        );
+
+        SpawnObjectOfType(EInteractiveObjectSpawnType::Cube);
+        return;
+    }
+
+    const EInteractiveObjectSpawnType DefaultType = Settings->GetDefaultSpawnType();
+    SpawnObjectOfType(DefaultType);
+}
+
+void UInteractiveObjectManagerSubsystem::SpawnObjectOfType(EInteractiveObjectSpawnType SpawnType)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SpawnObjectOfType))
+    {
+        TraceEvent->SpawnType = SpawnType;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    UWorld* World = GetWorld();
+    if (World == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem::SpawnObjectOfType: World is null.")
+        );
+        return;
+    }
+
+    const FInteractiveObjectBatchSpawnParams DefaultParams;
+
+    // Primitive classes are still streaming in, spawn as soon as they arrive.
+    if (!bArePrimitiveClassesLoaded)
+    {
+        SpawnObjectsBatch(1, SpawnType, DefaultParams);
+        return;
+    }
+
+    UClass* ClassToSpawn = ResolveSpawnClass(SpawnType);
+    if (ClassToSpawn == nullptr)
+    {
+        return;
+    }
+
+    FInteractiveObjectRuntimeSettings RuntimeSettings;
+    RuntimeSettings.ApplySafeDefaults();
+
+    if (UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get())
+    {
+        RuntimeSettings = Settings->GetRuntimeSettingsCopy();
+    }
+
+    SpawnInteractiveObject(
+        ClassToSpawn,
+        ComputeRandomSpawnLocation(DefaultParams),
+        RuntimeSettings.DefaultColor,
+        RuntimeSettings.DefaultScale.X
+    );
+}
+
+int32 UInteractiveObjectManagerSubsystem::SpawnObjectsBatch(int32 Count, EInteractiveObjectSpawnType SpawnType, const FInteractiveObjectBatchSpawnParams& Params)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SpawnObjectsBatch))
+    {
+        TraceEvent->Count = Count;
+        TraceEvent->SpawnType = SpawnType;
+        TraceEvent->BatchParams = Params;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (Count <= 0)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem::SpawnObjectsBatch: Count must be positive, got %d."),
+            Count
+        );
+        return INDEX_NONE;
+    }
+
+    FPendingSpawnBatch NewBatch;
+    NewBatch.BatchId = NextSpawnBatchId++;
+    NewBatch.SpawnType = SpawnType;
+    NewBatch.Params = Params;
+    NewBatch.RequestedCount = Count;
+
+    // Resolve defaults once per batch instead of once per object.
+    FInteractiveObjectRuntimeSettings RuntimeSettings;
+    RuntimeSettings.ApplySafeDefaults();
+
+    if (UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get())
+    {
+        RuntimeSettings = Settings->GetRuntimeSettingsCopy();
+    }
+
+    if (!NewBatch.Params.bOverrideColor)
+    {
+        NewBatch.Params.Color = RuntimeSettings.DefaultColor;
+    }
+
+    if (!NewBatch.Params.bOverrideUniformScale)
+    {
+        NewBatch.Params.UniformScale = RuntimeSettings.DefaultScale.X;
+    }
+
+    PendingSpawnBatches.Add(NewBatch);
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("InteractiveObjectManagerSubsystem: Queued spawn batch %d with %d objects, budget %.2f ms per frame."),
+        NewBatch.BatchId,
+        Count,
+        Params.FrameBudgetMilliseconds
+    );
+
+    return NewBatch.BatchId;
+}
+
+bool UInteractiveObjectManagerSubsystem::CancelSpawnBatch(int32 BatchId)
+{
+    const int32 BatchIndex = PendingSpawnBatches.IndexOfByPredicate(
+        [BatchId](const FPendingSpawnBatch& Batch)
+        {
+            return Batch.BatchId == BatchId;
+        }
+    );
+
+    if (BatchIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FPendingSpawnBatch CancelledBatch = PendingSpawnBatches[BatchIndex];
+    PendingSpawnBatches.RemoveAt(BatchIndex);
+
+    OnSpawnBatchCompleted.Broadcast(CancelledBatch.BatchId, CancelledBatch.SpawnedCount, CancelledBatch.RequestedCount);
+
+    if (CancelledBatch.BatchId == WriteAheadRecovery.BatchId)
+    {
+        FinishWriteAheadRecovery(CancelledBatch.SpawnedCount);
+    }
+
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::IsSpawnBatchPending(int32 BatchId) const
+{
+    return PendingSpawnBatches.ContainsByPredicate(
+        [BatchId](const FPendingSpawnBatch& Batch)
+        {
+            return Batch.BatchId == BatchId;
+        }
+    );
+}
+
+void UInteractiveObjectManagerSubsystem::ProcessPendingSpawnBatches()
+{
+    if (PendingSpawnBatches.Num() == 0 || !bArePrimitiveClassesLoaded)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_ProcessSpawnBatches);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Always spawn at least one object so that a tiny budget still makes progress.
+    bool bHasSpawnedThisFrame = false;
+
+    while (PendingSpawnBatches.Num() > 0)
+    {
+        // Each batch brings its own budget, a batch reached within the frame is held to it as well.
+        const double BudgetSeconds = FMath::Max(PendingSpawnBatches[0].Params.FrameBudgetMilliseconds, 0.0f) / 1000.0;
+        if (bHasSpawnedThisFrame && (FPlatformTime::Seconds() - StartTime) >= BudgetSeconds)
+        {
+            break;
+        }
+
+        const int32 BatchId = PendingSpawnBatches[0].BatchId;
+
+        // BeginPlay of the spawned actor may queue or cancel batches and reallocate PendingSpawnBatches,
+        // so the batch is only referenced until the spawn and looked up again afterwards.
+        FInteractiveObjectHandle SpawnedHandle;
+        {
+            FPendingSpawnBatch& Batch = PendingSpawnBatches[0];
+
+            // The whole batch is one undo step, even when spread over many frames.
+            Batch.JournalBatch = Journal.BeginBatch(Batch.JournalBatch);
+
+            TGuardValue<bool> JournalGuard(bIsApplyingJournal, bIsApplyingJournal || !Batch.bIsJournaled);
+
+            if (Batch.SceneFile.IsValid())
+            {
+                SpawnedHandle = SpawnSceneObject(Batch);
+            }
+            else if (UClass* ClassToSpawn = ResolveSpawnClass(Batch.SpawnType))
+            {
+                const FLinearColor SpawnColor = Batch.Params.Color;
+                SpawnedHandle = SpawnInteractiveObject(ClassToSpawn, ComputeRandomSpawnLocation(Batch.Params), SpawnColor, Batch.Params.UniformScale);
+            }
+        }
+
+        Journal.EndBatch();
+        bHasSpawnedThisFrame = true;
+
+        const int32 BatchIndex = PendingSpawnBatches.IndexOfByPredicate(
+            [BatchId](const FPendingSpawnBatch& Batch)
+            {
+                return Batch.BatchId == BatchId;
+            }
+        );
+
+        // Cancelled by the spawn, CancelSpawnBatch already reported it.
+        if (BatchIndex == INDEX_NONE)
+        {
+            continue;
+        }
+
+        FPendingSpawnBatch& Batch = PendingSpawnBatches[BatchIndex];
+
+        if (SpawnedHandle.IsSet())
+        {
+            ++Batch.SpawnedCount;
+        }
+
+        ++Batch.ProcessedCount;
+
+        if (Batch.ProcessedCount >= Batch.RequestedCount)
+        {
+            const FPendingSpawnBatch FinishedBatch = Batch;
+            PendingSpawnBatches.RemoveAt(BatchIndex);
+
+            OnSpawnBatchProgress.Broadcast(FinishedBatch.BatchId, FinishedBatch.SpawnedCount, FinishedBatch.RequestedCount);
+            OnSpawnBatchCompleted.Broadcast(FinishedBatch.BatchId, FinishedBatch.SpawnedCount, FinishedBatch.RequestedCount);
+
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Log,
+                TEXT("InteractiveObjectManagerSubsystem: Spawn batch %d finished, %d of %d objects spawned."),
+                FinishedBatch.BatchId,
+                FinishedBatch.SpawnedCount,
+                FinishedBatch.RequestedCount
+            );
+
+            if (FinishedBatch.SceneFile.IsValid())
+            {
+                const double LoadSeconds = FPlatformTime::Seconds() - FinishedBatch.QueueTime;
+
+                UE_LOG(
+                    LogInteractiveObjectManager,
+                    Log,
+                    TEXT("InteractiveObjectManagerSubsystem: Scene load finished in %.2f s, %.0f objects per second."),
+                    LoadSeconds,
+                    (LoadSeconds > 0.0) ? FinishedBatch.SpawnedCount / LoadSeconds : 0.0
+                );
+            }
+
+            if (FinishedBatch.BatchId == WriteAheadRecovery.BatchId)
+            {
+                FinishWriteAheadRecovery(FinishedBatch.SpawnedCount);
+            }
+        }
+    }
+
+    // Progress is reported once per frame for the batch that is still in flight.
+    if (PendingSpawnBatches.Num() > 0)
+    {
+        const FPendingSpawnBatch& CurrentBatch = PendingSpawnBatches[0];
+        OnSpawnBatchProgress.Broadcast(CurrentBatch.BatchId, CurrentBatch.SpawnedCount, CurrentBatch.RequestedCount);
+    }
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::SpawnSceneObject(const FPendingSpawnBatch& Batch)
+{
+    return SpawnSceneRecord(Batch.SceneFile->GetRecord(Batch.ProcessedCount), Batch.SceneFileClasses);
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::SpawnSceneRecord(const FInteractiveObjectSceneRecord& Record, const TArray<UClass*>& Classes)
+{
+    UClass* ClassToSpawn = Classes.IsValidIndex(Record.ClassIndex) ? Classes[Record.ClassIndex] : nullptr;
+    if (ClassToSpawn == nullptr)
+    {
+        return FInteractiveObjectHandle();
+    }
+
+    return SpawnInteractiveObject(ClassToSpawn, Record.GetLocation(), Record.GetColor(), Record.UniformScale, Record.GetRotation());
+}
+
+bool UInteractiveObjectManagerSubsystem::SaveScene(const FString& FilePath)
+{
+    const FString DefaultFilePath = FInteractiveObjectSceneFile::GetDefaultPath();
+    const FString ResolvedFilePath = FilePath.IsEmpty() ? DefaultFilePath : FilePath;
+    const uint64 Checkpoint = MakeSceneCheckpoint();
+
+    if (!WriteSceneFile(ResolvedFilePath, Checkpoint))
+    {
+        return false;
+    }
+
+    // A log that survived this point would be refused at recovery anyway, its base no longer matches the scene.
+    // A log closed after an I/O error starts over here, the saved scene holds everything it lost.
+    if ((WriteAheadLog.IsOpen() || bHasWriteAheadLogFailed) && FPaths::IsSamePath(ResolvedFilePath, DefaultFilePath))
+    {
+        OpenWriteAheadLog(Checkpoint);
+    }
+
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::WriteSceneFile(const FString& FilePath, uint64 Checkpoint)
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_SaveScene);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray<FString> ClassPaths;
+    TMap<const UClass*, uint16> ClassIndices;
+
+    TArray<FInteractiveObjectSceneRecord> Records;
+    Records.Reserve(RegisteredObjects.Num());
+
+    for (int32 DenseIndex = 0; DenseIndex < RegisteredObjects.Num(); ++DenseIndex)
+    {
+        UClass* ObjectClass = nullptr;
+        FTransform ObjectTransform;
+        if (!GetObjectClassAndTransform(DenseIndex, ObjectClass, ObjectTransform))
+        {
+            continue;
+        }
+
+        const uint16 ClassIndex = FindOrAddSceneClass(ObjectClass, ClassIndices, ClassPaths);
+        FillSceneRecord(DenseIndex, ObjectTransform, ClassIndex, Records.AddDefaulted_GetRef());
+    }
+
+    const double GatherSeconds = FPlatformTime::Seconds() - StartTime;
+
+    FString Error;
+    if (!FInteractiveObjectSceneFile::Write(FilePath, Checkpoint, ClassPaths, Records, Error))
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("SaveScene: %s"),
+            *Error
+        );
+        return false;
+    }
+
+    const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+    const double WriteSeconds = TotalSeconds - GatherSeconds;
+    const double FileMegabytes = FPlatformFileManager::Get().GetPlatformFile().FileSize(*FilePath) / (1024.0 * 1024.0);
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("SaveScene: %d objects of %d classes, %.1f MB to '%s' in %.1f ms (gather %.1f ms, write %.1f ms at %.0f MB/s)."),
+        Records.Num(),
+        ClassPaths.Num(),
+        FileMegabytes,
+        *FilePath,
+        TotalSeconds * 1000.0,
+        GatherSeconds * 1000.0,
+        WriteSeconds * 1000.0,
+        (WriteSeconds > 0.0) ? FileMegabytes / WriteSeconds : 0.0
+    );
+
+    return true;
+}
+
+void UInteractiveObjectManagerSubsystem::FillSceneRecord(int32 DenseIndex, const FTransform& ObjectTransform, uint16 ClassIndex, FInteractiveObjectSceneRecord& OutRecord) const
+{
+    OutRecord.SetTransform(ObjectTransform.GetLocation(), ObjectTransform.GetRotation());
+    OutRecord.UniformScale = ObjectColumns.Scales[DenseIndex];
+    OutRecord.Color = FFloat16Color(ObjectColumns.Colors[DenseIndex]);
+    OutRecord.ClassIndex = ClassIndex;
+    OutRecord.ObjectId = RegisteredObjects[DenseIndex].ObjectId;
+}
+
+int32 UInteractiveObjectManagerSubsystem::LoadScene(const FString& FilePath, bool bReplaceExisting, float FrameBudgetMilliseconds)
+{
+    const FString ResolvedFilePath = FilePath.IsEmpty() ? FInteractiveObjectSceneFile::GetDefaultPath() : FilePath;
+    const double StartTime = FPlatformTime::Seconds();
+
+    FString Error;
+    TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> SceneFile = FInteractiveObjectSceneFile::Open(ResolvedFilePath, Error);
+    if (!SceneFile.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("LoadScene: %s"),
+            *Error
+        );
+        return INDEX_NONE;
+    }
+
+    return QueueSceneRestore(SceneFile, FString::Printf(TEXT("'%s'"), *ResolvedFilePath), bReplaceExisting, FrameBudgetMilliseconds, StartTime);
+}
+
+int32 UInteractiveObjectManagerSubsystem::LoadLatestCheckpoint(bool bReplaceExisting, float FrameBudgetMilliseconds)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    int32 NumSegments = 0;
+    FString Error;
+    TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> SceneFile = FInteractiveObjectCheckpointStore::LoadLatest(NumSegments, Error);
+    if (!SceneFile.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("LoadLatestCheckpoint: %s"),
+            *Error
+        );
+        return INDEX_NONE;
+    }
+
+    return QueueSceneRestore(SceneFile, FString::Printf(TEXT("Checkpoint %llu (%d segments)"), SceneFile->GetCheckpoint(), NumSegments), bReplaceExisting, FrameBudgetMilliseconds, StartTime);
+}
+
+int32 UInteractiveObjectManagerSubsystem::QueueSceneRestore(const TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe>& SceneFile, const FString& SourceName, bool bReplaceExisting, float FrameBudgetMilliseconds, double StartTime)
+{
+    FPendingSpawnBatch NewBatch;
+
+    for (const FString& ClassPath : SceneFile->GetClassPaths())
+    {
+        NewBatch.SceneFileClasses.Add(LoadSceneClass(ClassPath));
+    }
+
+    if (bReplaceExisting)
+    {
+        DeleteAllObjects();
+    }
+
+    const double OpenSeconds = FPlatformTime::Seconds() - StartTime;
+
+    if (SceneFile->Num() == 0)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("LoadScene: %s holds no objects."),
+            *SourceName
+        );
+        return INDEX_NONE;
+    }
+
+    NewBatch.BatchId = NextSpawnBatchId++;
+    NewBatch.Params.FrameBudgetMilliseconds = FrameBudgetMilliseconds;
+    NewBatch.RequestedCount = SceneFile->Num();
+    NewBatch.SceneFile = SceneFile;
+    NewBatch.QueueTime = StartTime;
+
+    PendingSpawnBatches.Add(MoveTemp(NewBatch));
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("LoadScene: %s version %u, %d objects of %d classes, %.1f MB %s in %.1f ms. Queued as spawn batch %d, budget %.2f ms per frame."),
+        *SourceName,
+        SceneFile->GetVersion(),
+        SceneFile->Num(),
+        SceneFile->GetClassPaths().Num(),
+        SceneFile->GetSize() / (1024.0 * 1024.0),
+        SceneFile->IsMapped() ? TEXT("mapped") : TEXT("read"),
+        OpenSeconds * 1000.0,
+        NextSpawnBatchId - 1,
+        FrameBudgetMilliseconds
+    );
+
+    return NextSpawnBatchId - 1;
+}
+
+bool UInteractiveObjectManagerSubsystem::RequestCheckpoint(bool bFull)
+{
+    if (!bIsCheckpointTrackingEnabled || ActiveCheckpoint.bIsInProgress)
+    {
+        return false;
+    }
+
+    // Segments are written in order, one at a time, so a chain never has a gap left by a write still in flight.
+    CollectCheckpointWrite();
+    if (CheckpointWriteTask.IsValid())
+    {
+        return false;
+    }
+
+    const bool bStartsChain = bFull || CheckpointChain == 0 || NextCheckpointSequence > FMath::Max(CVarCheckpointMaxDeltas.GetValueOnGameThread(), 0);
+    if (!bStartsChain && CheckpointDirtyIds.Num() == 0 && CheckpointDeletedIds.Num() == 0)
+    {
+        return false;
+    }
+
+    LastCheckpointTime = FPlatformTime::Seconds();
+
+    if (bStartsChain)
+    {
+        CheckpointChain = MakeSceneCheckpoint();
+        NextCheckpointSequence = 0;
+
+        // The full segment covers every pending change.
+        CheckpointDirtyIds.Reset();
+        CheckpointDeletedIds.Reset();
+    }
+
+    ActiveCheckpoint = FActiveCheckpoint();
+    ActiveCheckpoint.bIsInProgress = true;
+    ActiveCheckpoint.bIsFull = bStartsChain;
+    ActiveCheckpoint.StartTime = LastCheckpointTime;
+    ActiveCheckpoint.Data.Chain = CheckpointChain;
+    ActiveCheckpoint.Data.Sequence = NextCheckpointSequence++;
+    ActiveCheckpoint.Data.DeletedObjectIds = MoveTemp(CheckpointDeletedIds);
+    ActiveCheckpoint.ObjectIds = MoveTemp(CheckpointDirtyIds);
+    ActiveCheckpoint.Data.Records.Reserve(bStartsChain ? RegisteredObjects.Num() : ActiveCheckpoint.ObjectIds.Num());
+
+    return true;
+}
+
+void UInteractiveObjectManagerSubsystem::MarkCheckpointDirty(int32 DenseIndex)
+{
+    if (!bIsCheckpointTrackingEnabled || !ObjectColumns.Flags.IsValidIndex(DenseIndex))
+    {
+        return;
+    }
+
+    EInteractiveObjectFlags& Flags = ObjectColumns.Flags[DenseIndex];
+    if (!EnumHasAnyFlags(Flags, EInteractiveObjectFlags::CheckpointDirty))
+    {
+        Flags |= EInteractiveObjectFlags::CheckpointDirty;
+        CheckpointDirtyIds.Add(RegisteredObjects[DenseIndex].ObjectId);
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::ProcessCheckpoint()
+{
+    if (!bIsCheckpointTrackingEnabled)
+    {
+        return;
+    }
+
+    CollectCheckpointWrite();
+
+    if (!ActiveCheckpoint.bIsInProgress)
+    {
+        const float IntervalSeconds = CVarCheckpointIntervalSeconds.GetValueOnGameThread();
+        if (IntervalSeconds <= 0.0f || FPlatformTime::Seconds() - LastCheckpointTime < IntervalSeconds || !RequestCheckpoint(false))
+        {
+            return;
+        }
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_CheckpointSlice);
+
+    // Checking the clock every object would cost more than serializing it.
+    constexpr int32 ObjectsPerClockCheck = 64;
+
+    const double SliceStartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = FMath::Max(CVarCheckpointFrameBudgetMs.GetValueOnGameThread(), 0.01f) / 1000.0;
+
+    int32 NumVisited = 0;
+    bool bIsComplete = false;
+
+    if (ActiveCheckpoint.bIsFull)
+    {
+        while (ActiveCheckpoint.Cursor < Slots.Num())
+        {
+            const int32 DenseIndex = Slots[ActiveCheckpoint.Cursor++].DenseIndex;
+            if (DenseIndex != INDEX_NONE)
+            {
+                SerializeCheckpointObject(DenseIndex);
+            }
+
+            if (++NumVisited % ObjectsPerClockCheck == 0 && FPlatformTime::Seconds() - SliceStartTime >= BudgetSeconds)
+            {
+                break;
+            }
+        }
+
+        bIsComplete = ActiveCheckpoint.Cursor >= Slots.Num();
+    }
+    else
+    {
+        while (ActiveCheckpoint.Cursor < ActiveCheckpoint.ObjectIds.Num())
+        {
+            // Objects deleted, or serialized again, since they were flagged are skipped.
+            const int32* SlotIndex = ObjectIdToSlot.Find(ActiveCheckpoint.ObjectIds[ActiveCheckpoint.Cursor++]);
+            if (SlotIndex != nullptr)
+            {
+                const int32 DenseIndex = Slots[*SlotIndex].DenseIndex;
+                if (EnumHasAnyFlags(ObjectColumns.Flags[DenseIndex], EInteractiveObjectFlags::CheckpointDirty))
+                {
+                    SerializeCheckpointObject(DenseIndex);
+                }
+            }
+
+            if (++NumVisited % ObjectsPerClockCheck == 0 && FPlatformTime::Seconds() - SliceStartTime >= BudgetSeconds)
+            {
+                break;
+            }
+        }
+
+        bIsComplete = ActiveCheckpoint.Cursor >= ActiveCheckpoint.ObjectIds.Num();
+    }
+
+    ++ActiveCheckpoint.NumSlices;
+    ActiveCheckpoint.LongestSliceSeconds = FMath::Max(ActiveCheckpoint.LongestSliceSeconds, FPlatformTime::Seconds() - SliceStartTime);
+
+    if (bIsComplete)
+    {
+        FinishCheckpoint();
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::SerializeCheckpointObject(int32 DenseIndex)
+{
+    // Changes from here on belong to the next checkpoint.
+    ObjectColumns.Flags[DenseIndex] &= ~EInteractiveObjectFlags::CheckpointDirty;
+
+    UClass* ObjectClass = nullptr;
+    FTransform ObjectTransform;
+    if (!GetObjectClassAndTransform(DenseIndex, ObjectClass, ObjectTransform))
+    {
+        return;
+    }
+
+    FInteractiveObjectCheckpointData& Data = ActiveCheckpoint.Data;
+    const uint16 ClassIndex = FindOrAddSceneClass(ObjectClass, ActiveCheckpoint.ClassIndices, Data.ClassPaths);
+    FillSceneRecord(DenseIndex, ObjectTransform, ClassIndex, Data.Records.AddDefaulted_GetRef());
+}
+
+void UInteractiveObjectManagerSubsystem::FinishCheckpoint()
+{
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Verbose,
+        TEXT("Checkpoint %llu.%d: %d objects and %d deletions serialized in %d slices over %.1f ms, longest slice %.2f ms."),
+        ActiveCheckpoint.Data.Chain,
+        ActiveCheckpoint.Data.Sequence,
+        ActiveCheckpoint.Data.Records.Num(),
+        ActiveCheckpoint.Data.DeletedObjectIds.Num(),
+        ActiveCheckpoint.NumSlices,
+        (FPlatformTime::Seconds() - ActiveCheckpoint.StartTime) * 1000.0,
+        ActiveCheckpoint.LongestSliceSeconds * 1000.0
+    );
+
+    CheckpointWriteTask = UE::Tasks::Launch(
+        UE_SOURCE_LOCATION,
+        [Data = MoveTemp(ActiveCheckpoint.Data)]()
+        {
+            return FInteractiveObjectCheckpointStore::WriteSegment(Data);
+        },
+        UE::Tasks::ETaskPriority::BackgroundNormal
+    );
+
+    ActiveCheckpoint = FActiveCheckpoint();
+}
+
+void UInteractiveObjectManagerSubsystem::CollectCheckpointWrite()
+{
+    if (!CheckpointWriteTask.IsValid() || !CheckpointWriteTask.IsCompleted())
+    {
+        return;
+    }
+
+    LastCheckpointWrite = CheckpointWriteTask.GetResult();
+    CheckpointWriteTask = {};
+
+    if (!LastCheckpointWrite.bIsWritten)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("Checkpoint %llu.%d: %s The next checkpoint starts a new chain."),
+            LastCheckpointWrite.Chain,
+            LastCheckpointWrite.Sequence,
+            *LastCheckpointWrite.Error
+        );
+
+        // Later deltas would not load past the missing segment.
+        if (LastCheckpointWrite.Chain == CheckpointChain)
+        {
+            CheckpointChain = 0;
+        }
+        return;
+    }
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("Checkpoint %llu.%d: %d objects, %d deletions. %.1f KB compressed to %.1f KB in %.1f ms, written in %.1f ms."),
+        LastCheckpointWrite.Chain,
+        LastCheckpointWrite.Sequence,
+        LastCheckpointWrite.NumRecords,
+        LastCheckpointWrite.NumDeleted,
+        LastCheckpointWrite.UncompressedBytes / 1024.0,
+        LastCheckpointWrite.CompressedBytes / 1024.0,
+        LastCheckpointWrite.CompressSeconds * 1000.0,
+        LastCheckpointWrite.WriteSeconds * 1000.0
+    );
+}
+
+void UInteractiveObjectManagerSubsystem::ApplySettings(const FInteractiveObjectSettingsViewData& NewSettings)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::ApplySettings))
+    {
+        TraceEvent->Settings = NewSettings;
+    }
+
+    UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get();
+    if (Settings == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem::ApplySettings: Settings object is null. Changes will be ignored.")
+        );
+        return;
+    }
+
+    Settings->UpdateFromViewData(NewSettings);
+    Settings->ApplyDefaultsIfInvalid();
+}
+
+bool UInteractiveObjectManagerSubsystem::StartTraceRecording(const FString& FilePath)
+{
+    if (bIsRecordingTrace || ActiveReplay.bIsActive)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("StartTraceRecording: A trace is already being %s."),
+            bIsRecordingTrace ? TEXT("recorded") : TEXT("replayed")
+        );
+        return false;
+    }
+
+    RecordingTrace = FInteractiveObjectSessionTrace();
+    RecordingTracePath = FilePath.IsEmpty() ? FInteractiveObjectSessionTrace::GetDefaultPath() : FilePath;
+
+    const int32 SpawnSeed = CVarSpawnSeed.GetValueOnGameThread();
+    RecordingTrace.Seed = static_cast<uint32>((SpawnSeed != 0) ? SpawnSeed : static_cast<int32>(FPlatformTime::Cycles()));
+    SpawnRandomStream.Initialize(static_cast<int32>(RecordingTrace.Seed));
+
+    if (const UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get())
+    {
+        Settings->ToViewData(RecordingTrace.InitialSettings);
+    }
+
+    RecordingTrace.MapName = GetWorld() ? GetWorld()->GetMapName() : FString();
+    RecordingTrace.NumInitialObjects = RegisteredObjects.Num();
+
+    TraceObjectIndices.Reset();
+    for (int32 DenseIndex = 0; DenseIndex < RegisteredObjects.Num(); ++DenseIndex)
+    {
+        TraceObjectIndices.Add(RegisteredObjects[DenseIndex].ObjectId, DenseIndex);
+    }
+
+    TraceStartFrame = GFrameCounter;
+    TraceStartTime = FPlatformTime::Seconds();
+    bIsRecordingTrace = true;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("StartTraceRecording: Recording to '%s' with spawn seed %u and %d objects registered."),
+        *RecordingTracePath,
+        RecordingTrace.Seed,
+        RecordingTrace.NumInitialObjects
+    );
+
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::StopTraceRecording()
+{
+    if (!bIsRecordingTrace)
+    {
+        return false;
+    }
+
+    bIsRecordingTrace = false;
+    TraceObjectIndices.Empty();
+
+    FString Error;
+    const bool bIsSaved = RecordingTrace.Save(RecordingTracePath, Error);
+
+    if (bIsSaved)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("StopTraceRecording: %d calls over %llu frames and %.1f s, %.1f KB written to '%s'."),
+            RecordingTrace.Events.Num(),
+            GFrameCounter - TraceStartFrame,
+            FPlatformTime::Seconds() - TraceStartTime,
+            FPlatformFileManager::Get().GetPlatformFile().FileSize(*RecordingTracePath) / 1024.0,
+            *RecordingTracePath
+        );
+    }
+    else
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("StopTraceRecording: %s"),
+            *Error
+        );
+    }
+
+    RecordingTrace = FInteractiveObjectSessionTrace();
+    return bIsSaved;
+}
+
+bool UInteractiveObjectManagerSubsystem::StartTraceReplay(const FString& FilePath, bool bOriginalPacing)
+{
+    if (bIsRecordingTrace || ActiveReplay.bIsActive)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("StartTraceReplay: A trace is already being %s."),
+            bIsRecordingTrace ? TEXT("recorded") : TEXT("replayed")
+        );
+        return false;
+    }
+
+    FActiveReplay NewReplay;
+    NewReplay.FilePath = FilePath.IsEmpty() ? FInteractiveObjectSessionTrace::GetDefaultPath() : FilePath;
+    NewReplay.bOriginalPacing = bOriginalPacing;
+
+    FString Error;
+    if (!NewReplay.Trace.Load(NewReplay.FilePath, Error))
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("StartTraceReplay: %s"),
+            *Error
+        );
+        return false;
+    }
+
+    NewReplay.bIsActive = true;
+    ActiveReplay = MoveTemp(NewReplay);
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("StartTraceReplay: '%s', %d calls recorded in map '%s', %s pacing."),
+        *ActiveReplay.FilePath,
+        ActiveReplay.Trace.Events.Num(),
+        *ActiveReplay.Trace.MapName,
+        bOriginalPacing ? TEXT("original") : TEXT("maximum")
+    );
+
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::IsRecordingTrace() const
+{
+    return bIsRecordingTrace;
+}
+
+bool UInteractiveObjectManagerSubsystem::IsReplayingTrace() const
+{
+    return ActiveReplay.bIsActive;
+}
+
+FInteractiveObjectTraceEvent* UInteractiveObjectManagerSubsystem::TraceCall(EInteractiveObjectTraceOp Op)
+{
+    if (!bIsRecordingTrace || bIsInsideTracedCall)
+    {
+        return nullptr;
+    }
+
+    FInteractiveObjectTraceEvent& Event = RecordingTrace.Events.AddDefaulted_GetRef();
+    Event.Op = Op;
+    Event.Frame = static_cast<uint32>(GFrameCounter - TraceStartFrame);
+    Event.Time = FPlatformTime::Seconds() - TraceStartTime;
+    Event.NumRegistered = TraceObjectIndices.Num();
+    return &Event;
+}
+
+int32 UInteractiveObjectManagerSubsystem::GetTraceObjectIndex(FInteractiveObjectHandle Handle) const
+{
+    const FInteractiveObjectRecord* Record = FindRecordByHandle(Handle);
+    const int32* TraceIndex = (Record != nullptr) ? TraceObjectIndices.Find(Record->ObjectId) : nullptr;
+    return (TraceIndex != nullptr) ? *TraceIndex : INDEX_NONE;
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::GetReplayHandle(int32 TraceIndex) const
+{
+    return ActiveReplay.Objects.IsValidIndex(TraceIndex) ? ActiveReplay.Objects[TraceIndex] : FInteractiveObjectHandle();
+}
+
+void UInteractiveObjectManagerSubsystem::ProcessTraceReplay()
+{
+    if (!ActiveReplay.bIsActive || !bArePrimitiveClassesLoaded)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_TraceReplay);
+
+    // Longest an event waits for the objects it refers to before the replay gives up on matching the recording.
+    constexpr double MaxObjectWaitSeconds = 10.0;
+
+    const FInteractiveObjectSessionTrace& Trace = ActiveReplay.Trace;
+    const double Now = FPlatformTime::Seconds();
+
+    if (!ActiveReplay.bIsStarted)
+    {
+        if (RegisteredObjects.Num() != Trace.NumInitialObjects)
+        {
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Warning,
+                TEXT("Replay: The trace was recorded with %d objects registered, %d are. Calls may refer to other objects than recorded."),
+                Trace.NumInitialObjects,
+                RegisteredObjects.Num()
+            );
+        }
+
+        for (int32 DenseIndex = 0; DenseIndex < RegisteredObjects.Num(); ++DenseIndex)
+        {
+            ActiveReplay.Objects.Add(GetHandleAtDenseIndex(DenseIndex));
+        }
+
+        SpawnRandomStream.Initialize(static_cast<int32>(Trace.Seed));
+
+        if (UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get())
+        {
+            Settings->UpdateFromViewData(Trace.InitialSettings);
+            Settings->ApplyDefaultsIfInvalid();
+        }
+
+        ActiveReplay.StartFrame = GFrameCounter;
+        ActiveReplay.StartTime = Now;
+        ActiveReplay.LastTickTime = Now;
+        ActiveReplay.bIsStarted = true;
+    }
+    else
+    {
+        const double FrameSeconds = Now - ActiveReplay.LastTickTime;
+        ActiveReplay.LastTickTime = Now;
+        ActiveReplay.LongestFrameSeconds = FMath::Max(ActiveReplay.LongestFrameSeconds, FrameSeconds);
+        ++ActiveReplay.NumFrames;
+    }
+
+    const double ElapsedSeconds = Now - ActiveReplay.StartTime;
+
+    while (ActiveReplay.Cursor < Trace.Events.Num())
+    {
+        const FInteractiveObjectTraceEvent& Event = Trace.Events[ActiveReplay.Cursor];
+        if (ActiveReplay.bOriginalPacing && Event.Time > ElapsedSeconds)
+        {
+            break;
+        }
+
+        // Objects spawned by earlier calls can still be in a spawn batch.
+        if (ActiveReplay.Objects.Num() < Event.NumRegistered)
+        {
+            if (ActiveReplay.WaitStartTime == 0.0)
+            {
+                ActiveReplay.WaitStartTime = Now;
+            }
+
+            if (Now - ActiveReplay.WaitStartTime < MaxObjectWaitSeconds)
+            {
+                break;
+            }
+
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Warning,
+                TEXT("Replay: Call %d was recorded with %d objects registered, only %d are after %.0f s. Replaying it anyway."),
+                ActiveReplay.Cursor,
+                Event.NumRegistered,
+                ActiveReplay.Objects.Num(),
+                MaxObjectWaitSeconds
+            );
+            ++ActiveReplay.NumDivergences;
+        }
+
+        ActiveReplay.WaitStartTime = 0.0;
+        ++ActiveReplay.Cursor;
+
+        ExecuteTraceEvent(Event);
+    }
+
+    if (ActiveReplay.Cursor >= Trace.Events.Num() && PendingSpawnBatches.Num() == 0)
+    {
+        FinishTraceReplay();
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::ExecuteTraceEvent(const FInteractiveObjectTraceEvent& Event)
+{
+    const FInteractiveObjectHandle Handle = (Event.Objects.Num() > 0) ? GetReplayHandle(Event.Objects[0]) : FInteractiveObjectHandle();
+
+    switch (Event.Op)
+    {
+    case EInteractiveObjectTraceOp::SpawnDefaultObject:
+        SpawnDefaultObject();
+        break;
+
+    case EInteractiveObjectTraceOp::SpawnObjectOfType:
+        SpawnObjectOfType(Event.SpawnType);
+        break;
+
+    case EInteractiveObjectTraceOp::SpawnObjectsBatch:
+        SpawnObjectsBatch(Event.Count, Event.SpawnType, Event.BatchParams);
+        break;
+
+    case EInteractiveObjectTraceOp::SelectObject:
+        SelectObject(Handle);
+        break;
+
+    case EInteractiveObjectTraceOp::SelectObjectById:
+    {
+        const FInteractiveObjectRecord* Record = FindRecordByHandle(Handle);
+        SelectObjectById((Record != nullptr) ? Record->ObjectId : INDEX_NONE);
+        break;
+    }
+
+    case EInteractiveObjectTraceOp::SelectObjectByIndex:
+        SelectObjectByIndex(Event.Count);
+        break;
+
+    case EInteractiveObjectTraceOp::AddObjectToSelection:
+        AddObjectToSelection(Handle);
+        break;
+
+    case EInteractiveObjectTraceOp::RemoveObjectFromSelection:
+        RemoveObjectFromSelection(Handle);
+        break;
+
+    case EInteractiveObjectTraceOp::ToggleObjectSelection:
+        ToggleObjectSelection(Handle);
+        break;
+
+    case EInteractiveObjectTraceOp::SelectObjects:
+    {
+        TArray<FInteractiveObjectHandle> Handles;
+        Handles.Reserve(Event.Objects.Num());
+        for (const int32 TraceIndex : Event.Objects)
+        {
+            Handles.Add(GetReplayHandle(TraceIndex));
+        }
+
+        SelectObjects(Handles, Event.bAddToSelection);
+        break;
+    }
+
+    case EInteractiveObjectTraceOp::SelectAllObjects:
+        SelectAllObjects();
+        break;
+
+    case EInteractiveObjectTraceOp::ClearSelection:
+        ClearSelection();
+        break;
+
+    case EInteractiveObjectTraceOp::SetObjectColor:
+        SetObjectColor(Handle, Event.Color);
+        break;
+
+    case EInteractiveObjectTraceOp::SetObjectUniformScale:
+        SetObjectUniformScale(Handle, Event.UniformScale);
+        break;
+
+    case EInteractiveObjectTraceOp::SetSelectedObjectColor:
+        SetSelectedObjectColor(Event.Color);
+        break;
+
+    case EInteractiveObjectTraceOp::SetSelectedObjectUniformScale:
+        SetSelectedObjectUniformScale(Event.UniformScale);
+        break;
+
+    case EInteractiveObjectTraceOp::SetSelectedObjectsColor:
+        SetSelectedObjectsColor(Event.Color);
+        break;
+
+    case EInteractiveObjectTraceOp::SetSelectedObjectsUniformScale:
+        SetSelectedObjectsUniformScale(Event.UniformScale);
+        break;
+
+    case EInteractiveObjectTraceOp::DeleteObject:
+        DeleteObject(Handle);
+        break;
+
+    case EInteractiveObjectTraceOp::DeleteSelectedObject:
+        DeleteSelectedObject();
+        break;
+
+    case EInteractiveObjectTraceOp::DeleteSelectedObjects:
+        DeleteSelectedObjects();
+        break;
+
+    case EInteractiveObjectTraceOp::UndoLastOperation:
+        UndoLastOperation();
+        break;
+
+    case EInteractiveObjectTraceOp::RedoLastOperation:
+        RedoLastOperation();
+        break;
+
+    case EInteractiveObjectTraceOp::ApplySettings:
+        ApplySettings(Event.Settings);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::FinishTraceReplay()
+{
+    const FInteractiveObjectSessionTrace& Trace = ActiveReplay.Trace;
+    const double ReplaySeconds = FPlatformTime::Seconds() - ActiveReplay.StartTime;
+    const FInteractiveObjectTraceEvent* LastEvent = (Trace.Events.Num() > 0) ? &Trace.Events.Last() : nullptr;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("Replay of '%s' finished: %d calls in %d frames over %.2f s, recorded in %u frames over %.2f s. Frame time mean %.2f ms, max %.2f ms. %d calls diverged."),
+        *ActiveReplay.FilePath,
+        Trace.Events.Num(),
+        ActiveReplay.NumFrames,
+        ReplaySeconds,
+        (LastEvent != nullptr) ? LastEvent->Frame : 0,
+        (LastEvent != nullptr) ? LastEvent->Time : 0.0,
+        (ActiveReplay.NumFrames > 0) ? ReplaySeconds * 1000.0 / ActiveReplay.NumFrames : 0.0,
+        ActiveReplay.LongestFrameSeconds * 1000.0,
+        ActiveReplay.NumDivergences
+    );
+
+    const bool bExitWhenDone = ActiveReplay.bExitWhenDone;
+    ActiveReplay = FActiveReplay();
+
+    if (bExitWhenDone)
+    {
+        FPlatformMisc::RequestExit(false, TEXT("InteractiveObjectManager trace replay"));
+    }
+}
+
+UClass* UInteractiveObjectManagerSubsystem::LoadSceneClass(const FString& ClassPath)
+{
+    UClass* LoadedClass = FSoftClassPath(ClassPath).TryLoadClass<AActor>();
+    if (LoadedClass == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("LoadScene: Class '%s' could not be loaded, its objects are skipped."),
+            *ClassPath
+        );
+        return nullptr;
+    }
+
+    SceneClasses.AddUnique(LoadedClass);
+    return LoadedClass;
+}
+
+void UInteractiveObjectManagerSubsystem::DeleteAllObjects()
+{
+    if (RegisteredObjects.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<FInteractiveObjectHandle> HandlesToRemove;
+    HandlesToRemove.Reserve(RegisteredObjects.Num());
+    for (int32 DenseIndex = 0; DenseIndex < RegisteredObjects.Num(); ++DenseIndex)
+    {
+        HandlesToRemove.Add(GetHandleAtDenseIndex(DenseIndex));
+    }
+
+    // Part of a scene load, which is not traced either.
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    Journal.BeginBatch();
+    for (const FInteractiveObjectHandle& Handle : HandlesToRemove)
+    {
+        DeleteObject(Handle);
+    }
+    Journal.EndBatch();
+}
+
+void UInteractiveObjectManagerSubsystem::RecoverFromWriteAheadLog()
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_WriteAheadLogRecovery);
+
+    bIsWriteAheadRecoveryPending = false;
+
+    const FString SceneFilePath = FInteractiveObjectSceneFile::GetDefaultPath();
+    const FString LogFilePath = FInteractiveObjectWriteAheadLog::GetPathForScene(SceneFilePath);
+    const double StartTime = FPlatformTime::Seconds();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const bool bHasScene = PlatformFile.FileExists(*SceneFilePath) || PlatformFile.FileExists(*FInteractiveObjectSceneFile::GetBackupPath(SceneFilePath));
+    const bool bHasLog = PlatformFile.FileExists(*LogFilePath);
+
+    FRecoveredScene RecoveredScene;
+    uint64 SceneCheckpoint = 0;
+    int32 ReplayedCount = 0;
+
+    FString Error;
+    TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> SceneFile;
+    if (bHasScene)
+    {
+        SceneFile = FInteractiveObjectSceneFile::Open(SceneFilePath, Error);
+        if (SceneFile.IsValid())
+        {
+            RecoveredScene.ClassPaths = SceneFile->GetClassPaths();
+            RecoveredScene.Records.Reserve(SceneFile->Num());
+
+            for (int32 RecordIndex = 0; RecordIndex < SceneFile->Num(); ++RecordIndex)
+            {
+                RecoveredScene.AddRecord(SceneFile->GetRecord(RecordIndex));
+            }
+
+            SceneCheckpoint = SceneFile->GetCheckpoint();
+        }
+        else
+        {
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Warning,
+                TEXT("RecoverFromWriteAheadLog: %s The log is not replayed without its scene."),
+                *Error
+            );
+        }
+    }
+
+    // The log is replayed on the records, nothing is spawned before the merged result is queued.
+    if (bHasLog && (SceneCheckpoint != 0 || !bHasScene))
+    {
+        const bool bIsReplayed = FInteractiveObjectWriteAheadLog::Replay(
+            LogFilePath,
+            SceneCheckpoint,
+            [&RecoveredScene](const FInteractiveObjectWalRecord& Record, const FString& ClassPath)
+            {
+                RecoveredScene.Apply(Record, ClassPath);
+            },
+            ReplayedCount,
+            Error
+        );
+
+        if (!bIsReplayed)
+        {
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Log,
+                TEXT("RecoverFromWriteAheadLog: %s"),
+                *Error
+            );
+        }
+    }
+
+    TArray64<uint8> Image;
+    FInteractiveObjectSceneFile::BuildImage(SceneCheckpoint, RecoveredScene.ClassPaths, RecoveredScene.Records, Image);
+
+    TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> MergedSceneFile = FInteractiveObjectSceneFile::FromMemory(MoveTemp(Image), Error);
+    if (!MergedSceneFile.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("RecoverFromWriteAheadLog: %s Logging stays disabled."),
+            *Error
+        );
+        return;
+    }
+
+    WriteAheadRecovery = FWriteAheadRecovery();
+    WriteAheadRecovery.NumReplayed = ReplayedCount;
+    WriteAheadRecovery.StartTime = StartTime;
+
+    // Recovery rebuilds a previous session, it is not something to undo. The saved state replaces the objects
+    // placed in the level, which it already contains.
+    {
+        TGuardValue<bool> JournalGuard(bIsApplyingJournal, true);
+
+        WriteAheadRecovery.BatchId = QueueSceneRestore(
+            MergedSceneFile,
+            FString::Printf(TEXT("Write-ahead log recovery of '%s'"), *SceneFilePath),
+            SceneFile.IsValid(),
+            FMath::Max(CVarWriteAheadLogRecoveryFrameBudgetMs.GetValueOnGameThread(), 0.0f),
+            StartTime
+        );
+    }
+
+    if (WriteAheadRecovery.BatchId == INDEX_NONE)
+    {
+        FinishWriteAheadRecovery(0);
+        return;
+    }
+
+    PendingSpawnBatches.Last().bIsJournaled = false;
+}
+
+void UInteractiveObjectManagerSubsystem::FinishWriteAheadRecovery(int32 RestoredCount)
+{
+    const FString SceneFilePath = FInteractiveObjectSceneFile::GetDefaultPath();
+    const double RecoverSeconds = FPlatformTime::Seconds() - WriteAheadRecovery.StartTime;
+    const int32 ReplayedCount = WriteAheadRecovery.NumReplayed;
+
+    WriteAheadRecovery = FWriteAheadRecovery();
+
+    // Only now does the scene on disk hold everything restored, until then the old scene and log stay the
+    // recovery point. Checkpoint, so the new log only has to hold what happens from now on and starts from Ids
+    // of this session.
+    const uint64 Checkpoint = MakeSceneCheckpoint();
+    const bool bIsCheckpointWritten = WriteSceneFile(SceneFilePath, Checkpoint);
+    if (bIsCheckpointWritten)
+    {
+        OpenWriteAheadLog(Checkpoint);
+    }
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("RecoverFromWriteAheadLog: Restored %d objects from '%s' and replayed %d logged changes in %.1f ms. %s"),
+        RestoredCount,
+        *SceneFilePath,
+        ReplayedCount,
+        RecoverSeconds * 1000.0,
+        bIsCheckpointWritten ? TEXT("Logging enabled.") : TEXT("Checkpoint failed, logging stays disabled.")
+    );
+}
+
+bool UInteractiveObjectManagerSubsystem::OpenWriteAheadLog(uint64 Checkpoint)
+{
+    FInteractiveObjectWalSettings Settings;
+    Settings.FsyncPolicy = static_cast<EInteractiveObjectWalFsyncPolicy>(FMath::Clamp(CVarWriteAheadLogFsyncPolicy.GetValueOnGameThread(), 0, 2));
+    Settings.GroupCommitMilliseconds = CVarWriteAheadLogGroupCommitMs.GetValueOnGameThread();
+    Settings.FsyncIntervalMilliseconds = CVarWriteAheadLogFsyncIntervalMs.GetValueOnGameThread();
+
+    WriteAheadLogClassIndices.Reset();
+
+    FString Error;
+    if (!WriteAheadLog.Open(FInteractiveObjectWriteAheadLog::GetPathForScene(FInteractiveObjectSceneFile::GetDefaultPath()), Checkpoint, Settings, Error))
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem: Write-ahead log disabled. %s"),
+            *Error
+        );
+        return false;
+    }
+
+    bHasWriteAheadLogFailed = false;
+    return true;
+}
+
+void UInteractiveObjectManagerSubsystem::RequestPrimitiveClassesLoad()
+{
+    const UInteractiveObjectManagerDeveloperSettings* DeveloperSettings = GetDefault<UInteractiveObjectManagerDeveloperSettings>();
+    UWorld* World = GetWorld();
+
+    // Editor and preview worlds never spawn primitives, do not stream anything for them.
+    if (DeveloperSettings == nullptr || World == nullptr || !World->IsGameWorld())
+    {
+        bArePrimitiveClassesLoaded = true;
+        return;
+    }
+
+    TArray<FSoftObjectPath> ClassPaths;
+    DeveloperSettings->GetPrimitiveClassPaths(ClassPaths);
+
+    if (ClassPaths.Num() == 0)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem: No primitive classes configured in developer settings.")
+        );
+        bArePrimitiveClassesLoaded = true;
+        return;
+    }
+
+    // Instanced spawns need their material as much as their class, so both stream in together.
+    if (RenderingMode != EInteractiveObjectRenderingMode::Actors && !DeveloperSettings->InstancedMaterial.IsNull())
+    {
+        ClassPaths.Add(DeveloperSettings->InstancedMaterial.ToSoftObjectPath());
+    }
+
+    PrimitiveClassesLoadHandle = StreamableManager.RequestAsyncLoad(
+        ClassPaths,
+        FStreamableDelegate::CreateUObject(this, &UInteractiveObjectManagerSubsystem::HandlePrimitiveClassesLoaded)
+    );
+
+    // RequestAsyncLoad may complete synchronously when everything is already in memory,
+    // in which case the delegate already ran.
+    if (!PrimitiveClassesLoadHandle.IsValid() && !bArePrimitiveClassesLoaded)
+    {
+        HandlePrimitiveClassesLoaded();
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::HandlePrimitiveClassesLoaded()
+{
+    const UInteractiveObjectManagerDeveloperSettings* DeveloperSettings = GetDefault<UInteractiveObjectManagerDeveloperSettings>();
+    if (DeveloperSettings == nullptr)
+    {
+        bArePrimitiveClassesLoaded = true;
+        return;
+    }
+
+    // Keep hard references so the classes stay resident for the lifetime of the world.
+    LoadedCubeClass = DeveloperSettings->CubePrimitiveClass.Get();
+    LoadedSphereClass = DeveloperSettings->SpherePrimitiveClass.Get();
+
+    LoadedAdditionalClasses.Reset();
+    for (const TSoftClassPtr<AActor>& AdditionalClass : DeveloperSettings->AdditionalPreloadClasses)
+    {
+        if (UClass* LoadedClass = AdditionalClass.Get())
+        {
+            LoadedAdditionalClasses.Add(LoadedClass);
+        }
+    }
+
+    if (RenderingMode != EInteractiveObjectRenderingMode::Actors)
+    {
+        LoadedInstancedMaterial = DeveloperSettings->InstancedMaterial.Get();
+    }
+
+    bArePrimitiveClassesLoaded = true;
+    bIsPoolPrewarmPending = true;
+    PrimitiveClassesLoadedTime = FPlatformTime::Seconds();
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("InteractiveObjectManagerSubsystem: Primitive classes streamed in %.2f ms (cube '%s', sphere '%s', %d additional). %d spawn batches were waiting."),
+        (PrimitiveClassesLoadedTime - InitializeTime) * 1000.0,
+        *GetNameSafe(LoadedCubeClass),
+        *GetNameSafe(LoadedSphereClass),
+        LoadedAdditionalClasses.Num(),
+        PendingSpawnBatches.Num()
+    );
+}
+
+UClass* UInteractiveObjectManagerSubsystem::ResolveSpawnClass(EInteractiveObjectSpawnType SpawnType) const
+{
+    // Classes were streamed in at world init, see RequestPrimitiveClassesLoad.
+    UClass* CubeClass = LoadedCubeClass;
+    UClass* SphereClass = LoadedSphereClass;
+
+    if (CubeClass == nullptr && SphereClass == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem::ResolveSpawnClass: No primitive classes configured in developer settings.")
+        );
+        return nullptr;
+    }
+
+    UClass* ClassToSpawn = nullptr;
+
+    switch (SpawnType)
+    {
+    case EInteractiveObjectSpawnType::Cube:
+        ClassToSpawn = CubeClass;
+        break;
+
+    case EInteractiveObjectSpawnType::Sphere:
+        ClassToSpawn = SphereClass;
+        break;
+
+    case EInteractiveObjectSpawnType::Random:
+    {
+        const bool bHasCube = (CubeClass != nullptr);
+        const bool bHasSphere = (SphereClass != nullptr);
+
+        if (bHasCube && bHasSphere)
+        {
+            const bool bChooseCube = (SpawnRandomStream.RandRange(0, 1) == 0);
+            ClassToSpawn = bChooseCube ? CubeClass : SphereClass;
+        }
+        else if (bHasCube)
+        {
+            ClassToSpawn = CubeClass;
+        }
+        else if (bHasSphere)
+        {
+            ClassToSpawn = SphereClass;
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    if (ClassToSpawn == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem::ResolveSpawnClass: No class resolved for spawn type %d."),
+            static_cast<int32>(SpawnType)
+        );
+    }
+
+    return ClassToSpawn;
+}
+
+FVector UInteractiveObjectManagerSubsystem::ComputeRandomSpawnLocation(const FInteractiveObjectBatchSpawnParams& Params) const
+{
+    // Randomized spawn location for the demo: around world origin in a small radius.
+    const float AngleRadians = SpawnRandomStream.FRand() * 2.0f * PI;
+    const float Distance = SpawnRandomStream.FRandRange(0.0f, FMath::Max(Params.SpawnRadius, 0.0f));
+
+    const float SpawnX = FMath::Cos(AngleRadians) * Distance;
+    const float SpawnY = FMath::Sin(AngleRadians) * Distance;
+
+    return FVector(SpawnX, SpawnY, Params.SpawnHeight);
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::SpawnInteractiveObject(UClass* ClassToSpawn, const FVector& SpawnLocation, const FLinearColor& Color, float UniformScale, const FQuat& SpawnRotation)
+{
+    FInteractiveObjectHandle NewHandle;
+
+    const int32 BatchIndex = FindOrAddInstanceBatch(ClassToSpawn);
+    if (BatchIndex != INDEX_NONE)
+    {
+        NewHandle = SpawnInstancedObject(BatchIndex, SpawnLocation, Color, UniformScale, SpawnRotation);
+    }
+    else if (const AActor* NewActor = SpawnInteractiveActor(ClassToSpawn, SpawnLocation, Color, UniformScale, SpawnRotation))
+    {
+        NewHandle = GetHandleForComponent(NewActor->FindComponentByClass<UInteractiveObjectComponent>());
+    }
+
+    if (!NewHandle.IsSet())
+    {
+        return NewHandle;
+    }
+
+    RecordSpawnOrDelete(EInteractiveObjectJournalOp::Spawn, NewHandle, Color, UniformScale);
+
+    if (!bHasSpawnedFirstObject)
+    {
+        bHasSpawnedFirstObject = true;
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectManagerSubsystem: Time to first spawn %.2f ms after world init."),
+            (FPlatformTime::Seconds() - InitializeTime) * 1000.0
+        );
+    }
+
+    return NewHandle;
+}
+
+AActor* UInteractiveObjectManagerSubsystem::SpawnInteractiveActor(UClass* ClassToSpawn, const FVector& SpawnLocation, const FLinearColor& Color, float UniformScale, const FQuat& SpawnRotation)
+{
+    UWorld* World = GetWorld();
+    if (World == nullptr || ClassToSpawn == nullptr)
+    {
+        return nullptr;
+    }
+
+    AActor* NewActor = AcquirePooledActor(ClassToSpawn, SpawnLocation, SpawnRotation);
+    const bool bIsReusedActor = (NewActor != nullptr);
+
+    if (NewActor == nullptr)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+        // Fresh actors register from BeginPlay inside SpawnActor.
+        TGuardValue<EInteractiveObjectFlags> FlagsGuard(PendingRegistrationFlags, EInteractiveObjectFlags::SpawnedByManager);
+        NewActor = World->SpawnActor<AActor>(ClassToSpawn, SpawnLocation, SpawnRotation.Rotator(), SpawnParams);
+        if (NewActor == nullptr)
+        {
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Warning,
+                TEXT("InteractiveObjectManagerSubsystem::SpawnInteractiveActor: Failed to spawn actor for class '%s'."),
+                *GetNameSafe(ClassToSpawn)
+            );
+            return nullptr;
+        }
+    }
+
+    // Apply color and scale via interactive component if present.
+    UInteractiveObjectComponent* InteractiveComponent = NewActor->FindComponentByClass<UInteractiveObjectComponent>();
+    if (InteractiveComponent == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem::SpawnInteractiveActor: Spawned actor '%s' has no UInteractiveObjectComponent."),
+            *GetNameSafe(NewActor)
+        );
+        return NewActor;
+    }
+
+    InteractiveComponent->ApplyColor(Color);
+    InteractiveComponent->ApplyScale(UniformScale);
+
+    // Reused actors register again only after their new state is applied.
+    if (bIsReusedActor)
+    {
+        TGuardValue<EInteractiveObjectFlags> FlagsGuard(PendingRegistrationFlags, EInteractiveObjectFlags::SpawnedByManager | EInteractiveObjectFlags::ReusedFromPool);
+        InteractiveComponent->ActivateFromPool();
+    }
+
+    return NewActor;
+}
+
+int32 UInteractiveObjectManagerSubsystem::FindOrAddInstanceBatch(UClass* ObjectClass)
+{
+    if (RenderingMode == EInteractiveObjectRenderingMode::Actors || ObjectClass == nullptr)
+    {
+        return INDEX_NONE;
+    }
+
+    if (const int32* ExistingBatchIndex = InstanceBatchIndices.Find(ObjectClass))
+    {
+        return *ExistingBatchIndex;
+    }
+
+    // An instance carries a transform and a color, nothing else of the class survives. Blueprint added
+    // components are found too, the class default lookup walks the construction script templates.
+    const UStaticMeshComponent* MeshTemplate = AActor::GetActorClassDefaultComponent<UStaticMeshComponent>(ObjectClass);
+    const UInteractiveObjectComponent* InteractiveTemplate = AActor::GetActorClassDefaultComponent<UInteractiveObjectComponent>(ObjectClass);
+    UStaticMesh* StaticMesh = (MeshTemplate != nullptr) ? MeshTemplate->GetStaticMesh() : nullptr;
+    UWorld* World = GetWorld();
+
+    if (StaticMesh == nullptr || InteractiveTemplate == nullptr || World == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem: Class '%s' has no default static mesh or interactive component and is spawned as actors."),
+            *GetNameSafe(ObjectClass)
+        );
+
+        InstanceBatchIndices.Add(ObjectClass, INDEX_NONE);
+        return INDEX_NONE;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    SpawnParams.ObjectFlags |= RF_Transient;
+
+    AActor* OwnerActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+    if (OwnerActor == nullptr)
+    {
+        InstanceBatchIndices.Add(ObjectClass, INDEX_NONE);
+        return INDEX_NONE;
+    }
+
+    const TSubclassOf<UInstancedStaticMeshComponent> ComponentClass = (RenderingMode == EInteractiveObjectRenderingMode::HierarchicalInstanced)
+        ? UHierarchicalInstancedStaticMeshComponent::StaticClass()
+        : UInstancedStaticMeshComponent::StaticClass();
+
+    UInstancedStaticMeshComponent* MeshComponent = NewObject<UInstancedStaticMeshComponent>(OwnerActor, ComponentClass);
+    MeshComponent->SetMobility(EComponentMobility::Movable);
+    MeshComponent->SetStaticMesh(StaticMesh);
+    MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    MeshComponent->SetCastShadow(MeshTemplate->CastShadow);
+    MeshComponent->SetNumCustomDataFloats(InstanceColorCustomDataFloats);
+
+    for (int32 MaterialIndex = 0; MaterialIndex < MeshTemplate->GetNumMaterials(); ++MaterialIndex)
+    {
+        MeshComponent->SetMaterial(MaterialIndex, (LoadedInstancedMaterial != nullptr) ? LoadedInstancedMaterial.Get() : MeshTemplate->GetMaterial(MaterialIndex));
+    }
+
+    OwnerActor->SetRootComponent(MeshComponent);
+    OwnerActor->AddInstanceComponent(MeshComponent);
+    MeshComponent->RegisterComponent();
+
+    FString DisplayBaseName = ObjectClass->GetName();
+    DisplayBaseName.RemoveFromEnd(TEXT("_C"));
+
+    const int32 NewBatchIndex = InstanceBatches.AddDefaulted();
+    FInteractiveObjectInstanceBatch& Batch = InstanceBatches[NewBatchIndex];
+    Batch.ObjectClass = ObjectClass;
+    Batch.OwnerActor = OwnerActor;
+    Batch.MeshComponent = MeshComponent;
+    Batch.MeshBounds = StaticMesh->GetBounds();
+    Batch.DisplayBaseName = MoveTemp(DisplayBaseName);
+    Batch.PrimitiveType = ResolvePrimitiveType(ObjectClass);
+
+    InstanceBatchIndices.Add(ObjectClass, NewBatchIndex);
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("InteractiveObjectManagerSubsystem: Class '%s' is drawn as instances of mesh '%s' by a %s."),
+        *GetNameSafe(ObjectClass),
+        *GetNameSafe(StaticMesh),
+        *GetNameSafe(ComponentClass.Get())
+    );
+
+    return NewBatchIndex;
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::SpawnInstancedObject(int32 BatchIndex, const FVector& SpawnLocation, const FLinearColor& Color, float UniformScale, const FQuat& SpawnRotation)
+{
+    FInteractiveObjectInstanceBatch& Batch = InstanceBatches[BatchIndex];
+    UInstancedStaticMeshComponent* MeshComponent = Batch.MeshComponent;
+    if (MeshComponent == nullptr)
+    {
+        return FInteractiveObjectHandle();
+    }
+
+    const float ClampedScale = FMath::Max(UniformScale, MinUniformScale);
+
+    FInteractiveObjectRecord NewRecord;
+    NewRecord.ObjectId = NextObjectId++;
+    NewRecord.InstanceBatchIndex = BatchIndex;
+    NewRecord.InstanceIndex = MeshComponent->AddInstance(FTransform(SpawnRotation, SpawnLocation, FVector(ClampedScale)), true);
+
+    // Interned as one name plus a number, so a hundred thousand objects do not add as many name entries.
+    NewRecord.DisplayName = FName(*Batch.DisplayBaseName, NAME_EXTERNAL_TO_INTERNAL(NewRecord.ObjectId));
+    NewRecord.DisplayText = FText::FromString(FString::Printf(TEXT("%s_%d"), *Batch.DisplayBaseName, NewRecord.ObjectId));
+
+    TGuardValue<EInteractiveObjectFlags> FlagsGuard(PendingRegistrationFlags, EInteractiveObjectFlags::SpawnedByManager | EInteractiveObjectFlags::Instanced);
+    const FInteractiveObjectHandle NewHandle = AddRecord(MoveTemp(NewRecord), Color, ClampedScale, Batch.PrimitiveType);
+    FindOrAddWriteAheadLogClass(Batch.ObjectClass);
+
+    Batch.InstanceSlots.Add(NewHandle.SlotIndex);
+    UpdateObjectColor(Slots[NewHandle.SlotIndex].DenseIndex, Color);
+
+    return NewHandle;
+}
+
+void UInteractiveObjectManagerSubsystem::RemoveObjectInstance(int32 DenseIndex)
+{
+    FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+    FInteractiveObjectInstanceBatch& Batch = InstanceBatches[Record.InstanceBatchIndex];
+    UInstancedStaticMeshComponent* MeshComponent = Batch.MeshComponent;
+
+    const int32 RemovedIndex = Record.InstanceIndex;
+    const int32 LastIndex = Batch.InstanceSlots.Num() - 1;
+    Record.InstanceIndex = INDEX_NONE;
+
+    // Only the last instance ever leaves the component, which keeps every other index valid
+    // whether the component shifts or swaps instances on removal.
+    if (RemovedIndex != LastIndex)
+    {
+        const int32 MovedSlotIndex = Batch.InstanceSlots[LastIndex];
+        const int32 MovedDenseIndex = Slots[MovedSlotIndex].DenseIndex;
+
+        FTransform MovedTransform;
+        if (MeshComponent != nullptr && MeshComponent->GetInstanceTransform(LastIndex, MovedTransform, true))
+        {
+            MeshComponent->UpdateInstanceTransform(RemovedIndex, MovedTransform, true, true, true);
+        }
+
+        Batch.InstanceSlots[RemovedIndex] = MovedSlotIndex;
+        RegisteredObjects[MovedDenseIndex].InstanceIndex = RemovedIndex;
+        UpdateObjectColor(MovedDenseIndex, ObjectColumns.Colors[MovedDenseIndex]);
+    }
+
+    Batch.InstanceSlots.Pop(EAllowShrinking::No);
+
+    if (MeshComponent != nullptr)
+    {
+        MeshComponent->RemoveInstance(LastIndex);
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::UpdateObjectColor(int32 DenseIndex, const FLinearColor& NewColor)
+{
+    const FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+
+    if (Record.InstanceIndex != INDEX_NONE)
+    {
+        if (UInstancedStaticMeshComponent* MeshComponent = InstanceBatches[Record.InstanceBatchIndex].MeshComponent)
+        {
+            const float CustomData[InstanceColorCustomDataFloats] = { NewColor.R, NewColor.G, NewColor.B };
+            MeshComponent->SetCustomData(Record.InstanceIndex, CustomData, true);
+        }
+        return;
+    }
+
+    if (UInteractiveObjectComponent* InteractiveComponent = Record.Component.Get())
+    {
+        InteractiveComponent->UpdateMaterialColor(NewColor);
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::UpdateObjectScale(int32 DenseIndex, float NewScale)
+{
+    const FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+
+    if (Record.InstanceIndex != INDEX_NONE)
+    {
+        UInstancedStaticMeshComponent* MeshComponent = InstanceBatches[Record.InstanceBatchIndex].MeshComponent;
+
+        FTransform InstanceTransform;
+        if (MeshComponent != nullptr && MeshComponent->GetInstanceTransform(Record.InstanceIndex, InstanceTransform, true))
+        {
+            InstanceTransform.SetScale3D(FVector(NewScale));
+            MeshComponent->UpdateInstanceTransform(Record.InstanceIndex, InstanceTransform, true, true);
+        }
+        return;
+    }
+
+    if (UInteractiveObjectComponent* InteractiveComponent = Record.Component.Get())
+    {
+        InteractiveComponent->UpdateAppliedScale(NewScale);
+    }
+}
+
+bool UInteractiveObjectManagerSubsystem::GetObjectClassAndTransform(int32 DenseIndex, UClass*& OutClass, FTransform& OutTransform) const
+{
+    const FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+
+    if (Record.InstanceIndex != INDEX_NONE)
+    {
+        const FInteractiveObjectInstanceBatch& Batch = InstanceBatches[Record.InstanceBatchIndex];
+        if (Batch.MeshComponent == nullptr || !Batch.MeshComponent->GetInstanceTransform(Record.InstanceIndex, OutTransform, true))
+        {
+            return false;
+        }
+
+        OutClass = Batch.ObjectClass;
+        return true;
+    }
+
+    const UInteractiveObjectComponent* InteractiveComponent = Record.Component.Get();
+    const AActor* OwnerActor = (InteractiveComponent != nullptr) ? InteractiveComponent->GetOwner() : nullptr;
+    if (OwnerActor == nullptr)
+    {
+        return false;
+    }
+
+    OutClass = OwnerActor->GetClass();
+    OutTransform = OwnerActor->GetActorTransform();
+    return true;
+}
+
+AActor* UInteractiveObjectManagerSubsystem::AcquirePooledActor(UClass* ActorClass, const FVector& SpawnLocation, const FQuat& SpawnRotation)
+{
+    if (ActorClass == nullptr || !bIsActorPoolingEnabled)
+    {
+        return nullptr;
+    }
+
+    FInteractiveObjectActorPool& Pool = ActorPools.FindOrAdd(ActorClass);
+
+    while (Pool.InactiveActors.Num() > 0)
+    {
+        AActor* PooledActor = Pool.InactiveActors.Pop(EAllowShrinking::No);
+
+        // Parked actors can still be destroyed from outside, for example by a level unload.
+        if (IsValid(PooledActor))
+        {
+            PooledActor->SetActorLocationAndRotation(SpawnLocation, SpawnRotation, false, nullptr, ETeleportType::ResetPhysics);
+
+            ++Pool.Hits;
+            ++TotalPoolHits;
+            UpdatePoolStats();
+            return PooledActor;
+        }
+    }
+
+    ++Pool.Misses;
+    ++TotalPoolMisses;
+    UpdatePoolStats();
+    return nullptr;
+}
+
+bool UInteractiveObjectManagerSubsystem::ReleaseActorToPool(AActor* Actor)
+{
+    if (Actor == nullptr || !bIsActorPoolingEnabled)
+    {
+        return false;
+    }
+
+    UInteractiveObjectComponent* InteractiveComponent = Actor->FindComponentByClass<UInteractiveObjectComponent>();
+    if (InteractiveComponent == nullptr)
+    {
+        return false;
+    }
+
+    FInteractiveObjectActorPool& Pool = ActorPools.FindOrAdd(Actor->GetClass());
+    if (Pool.InactiveActors.Num() >= PoolMaxSize)
+    {
+        ++Pool.Overflows;
+        return false;
+    }
+
+    InteractiveComponent->DeactivateForPool();
+
+    if (Pool.EstimatedBytesPerActor == 0)
+    {
+        Pool.EstimatedBytesPerActor = EstimateActorMemoryBytes(Actor);
+    }
+
+    Pool.InactiveActors.Add(Actor);
+    UpdatePoolStats();
+    return true;
+}
+
+void UInteractiveObjectManagerSubsystem::ProcessPoolPrewarm()
+{
+    // Queued spawns take priority over prewarm.
+    if (!bIsPoolPrewarmPending || PendingSpawnBatches.Num() > 0)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    if (World == nullptr || !bIsActorPoolingEnabled || PoolPrewarmCount <= 0)
+    {
+        bIsPoolPrewarmPending = false;
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_PoolPrewarm);
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = FMath::Max(CVarPoolPrewarmBudget.GetValueOnGameThread(), 0.0f) / 1000.0;
+    const int32 TargetCount = FMath::Min(PoolPrewarmCount, PoolMaxSize);
+
+    TArray<UClass*, TInlineAllocator<8>> PrewarmClasses;
+    PrewarmClasses.Add(LoadedCubeClass);
+    PrewarmClasses.Add(LoadedSphereClass);
+    PrewarmClasses.Append(LoadedAdditionalClasses);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    // Prewarmed actors must not show up in the registry, see RegisterInteractiveObject.
+    TGuardValue<bool> PrewarmGuard(bIsPrewarmingPool, true);
+
+    for (UClass* PrewarmClass : PrewarmClasses)
+    {
+        // Instanced classes never spawn actors, parking any would only hold memory.
+        if (PrewarmClass == nullptr || FindOrAddInstanceBatch(PrewarmClass) != INDEX_NONE)
+        {
+            continue;
+        }
+
+        while (ActorPools.FindOrAdd(PrewarmClass).InactiveActors.Num() < TargetCount)
+        {
+            AActor* NewActor = World->SpawnActor<AActor>(PrewarmClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+            if (NewActor == nullptr)
+            {
+                break;
+            }
+
+            if (!ReleaseActorToPool(NewActor))
+            {
+                // Class cannot be pooled, do not keep trying every frame.
+                NewActor->Destroy();
+                break;
+            }
+
+            if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+            {
+                return;
+            }
+        }
+    }
+
+    bIsPoolPrewarmPending = false;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("InteractiveObjectManagerSubsystem: Actor pool prewarm finished with %d actors per class."),
+        TargetCount
+    );
+}
+
+void UInteractiveObjectManagerSubsystem::UpdatePoolStats() const
+{
+    int32 PooledActorCount = 0;
+    int64 PoolMemoryBytes = 0;
+
+    for (const TPair<TObjectPtr<UClass>, FInteractiveObjectActorPool>& PoolPair : ActorPools)
+    {
+        PooledActorCount += PoolPair.Value.InactiveActors.Num();
+        PoolMemoryBytes += PoolPair.Value.InactiveActors.Num() * PoolPair.Value.EstimatedBytesPerActor;
+    }
+
+    const int32 TotalRequests = TotalPoolHits + TotalPoolMisses;
+    const float HitRate = (TotalRequests > 0) ? 100.0f * TotalPoolHits / TotalRequests : 0.0f;
+
+    SET_DWORD_STAT(STAT_IOM_PooledActors, PooledActorCount);
+    SET_FLOAT_STAT(STAT_IOM_PoolHitRate, HitRate);
+    SET_MEMORY_STAT(STAT_IOM_PoolMemory, PoolMemoryBytes);
+}
+
+void UInteractiveObjectManagerSubsystem::LogRuntimeReport() const
+{
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("InteractiveObjectManagerSubsystem report for world '%s': %d registered objects, %d slots, %d free slots."),
+        *GetNameSafe(GetWorld()),
+        RegisteredObjects.Num(),
+        Slots.Num(),
+        FreeSlotIndices.Num()
+    );
+
+    const SIZE_T RegistryBytes = GetRegistryAllocatedSize();
+    const SIZE_T ColumnBytesPerObject = sizeof(int32) + sizeof(FLinearColor) + sizeof(float) + sizeof(EInteractiveObjectPrimitiveType) + sizeof(EInteractiveObjectFlags);
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("  Registry: %.1f KB allocated, %.1f bytes per object including slack and indices. Hot columns %d bytes and record %d bytes per object."),
+        RegistryBytes / 1024.0,
+        (RegisteredObjects.Num() > 0) ? static_cast<double>(RegistryBytes) / RegisteredObjects.Num() : 0.0,
+        static_cast<int32>(ColumnBytesPerObject),
+        static_cast<int32>(sizeof(FInteractiveObjectRecord))
+    );
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("  Spatial index: %d entries, %.1f KB allocated."),
+        SpatialIndex.Num(),
+        SpatialIndex.GetAllocatedSize() / 1024.0
+    );
+
+    for (const FInteractiveObjectInstanceBatch& Batch : InstanceBatches)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("  Instanced '%s': %d objects drawn by one %s of mesh '%s'."),
+            *GetNameSafe(Batch.ObjectClass),
+            Batch.InstanceSlots.Num(),
+            *GetNameSafe((Batch.MeshComponent != nullptr) ? Batch.MeshComponent->GetClass() : nullptr),
+            *GetNameSafe((Batch.MeshComponent != nullptr) ? Batch.MeshComponent->GetStaticMesh() : nullptr)
+        );
+    }
+
+    const SIZE_T JournalBytesPerOperation = sizeof(FInteractiveObjectJournalRecord);
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("  Journal: %d of %d operations kept, %d undoable. %.1f KB allocated, %d bytes per operation, %.1f KB per 10k operations."),
+        Journal.GetNumRecords(),
+        Journal.GetCapacity(),
+        Journal.GetNumUndoable(),
+        Journal.GetAllocatedSize() / 1024.0,
+        static_cast<int32>(JournalBytesPerOperation),
+        JournalBytesPerOperation * 10000 / 1024.0
+    );
+
+    if (WriteAheadLog.IsOpen())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("  Write-ahead log: %lld records appended, %lld committed in %lld group commits, %lld fsyncs, %.1f KB written, %lld stalls, %d overflowed, %lld dropped."),
+            WriteAheadLog.GetNumAppended(),
+            WriteAheadLog.GetNumCommitted(),
+            WriteAheadLog.GetNumGroupCommits(),
+            WriteAheadLog.GetNumFsyncs(),
+            WriteAheadLog.GetBytesWritten() / 1024.0,
+            WriteAheadLog.GetNumStalls(),
+            WriteAheadLog.GetNumOverflowed(),
+            WriteAheadLog.GetNumDropped()
+        );
+    }
+    else if (bHasWriteAheadLogFailed)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("  Write-ahead log: closed after an I/O error, changes are not crash safe until the default scene is saved.")
+        );
+    }
+
+    if (bIsCheckpointTrackingEnabled)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("  Checkpoints: chain %llu, next segment %d, %d objects and %d deletions pending. Last write %d objects, %.1f KB compressed from %.1f KB."),
+            CheckpointChain,
+            NextCheckpointSequence,
+            CheckpointDirtyIds.Num(),
+            CheckpointDeletedIds.Num(),
+            LastCheckpointWrite.NumRecords,
+            LastCheckpointWrite.CompressedBytes / 1024.0,
+            LastCheckpointWrite.UncompressedBytes / 1024.0
+        );
+    }
+
+    if (bIsSharingDynamicMaterials)
+    {
+        const int64 NumMaterialAcquires = MaterialCache.GetNumAcquires();
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("  Shared materials: %d instances serve %d material slots, %d instances saved. %lld lookups, hit rate %.1f%%, %lld created."),
+            MaterialCache.GetNumInstances(),
+            MaterialCache.GetNumReferences(),
+            MaterialCache.GetNumReferences() - MaterialCache.GetNumInstances(),
+            NumMaterialAcquires,
+            (NumMaterialAcquires > 0) ? 100.0 * MaterialCache.GetNumHits() / NumMaterialAcquires : 0.0,
+            MaterialCache.GetNumCreated()
+        );
+    }
+
+    const int32 TotalRequests = TotalPoolHits + TotalPoolMisses;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("  Actor pools: %d hits, %d misses, hit rate %.1f%%."),
+        TotalPoolHits,
+        TotalPoolMisses,
+        (TotalRequests > 0) ? 100.0f * TotalPoolHits / TotalRequests : 0.0f
+    );
+
+    for (const TPair<TObjectPtr<UClass>, FInteractiveObjectActorPool>& PoolPair : ActorPools)
+    {
+        const FInteractiveObjectActorPool& Pool = PoolPair.Value;
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("  Pool '%s': %d parked, %.1f KB held, %d hits, %d misses, %d overflows."),
+            *GetNameSafe(PoolPair.Key),
+            Pool.InactiveActors.Num(),
+            Pool.InactiveActors.Num() * Pool.EstimatedBytesPerActor / 1024.0,
+            Pool.Hits,
+            Pool.Misses,
+            Pool.Overflows
+        );
+    }
+}
+
+TArray<UInteractiveObjectManagerSubsystem::FRegistryBenchmarkResult> UInteractiveObjectManagerSubsystem::RunRegistryBenchmark(int32 MaxObjects, int32 NumLookups)
+{
+    // A subsystem outside of any world, so only the registry itself is measured: slots, dense records, columns,
+    // both lookup indices and the selection set. Records share one component without an owner, which makes them
+    // valid for selection while bounds, materials and instances stay untouched.
+    UInteractiveObjectManagerSubsystem* Registry = NewObject<UInteractiveObjectManagerSubsystem>(GetTransientPackage());
+    UInteractiveObjectComponent* SharedComponent = NewObject<UInteractiveObjectComponent>(Registry);
+
+    FRandomStream RandomStream(12345);
+    TArray<FInteractiveObjectHandle> Handles;
+    TArray<int32> LookupIndices;
+    TArray<FRegistryBenchmarkResult> Results;
+
+    for (int32 NumObjects = 1000; NumObjects <= MaxObjects; NumObjects *= 10)
+    {
+        FRegistryBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+        Result.NumObjects = NumObjects;
+
+        Handles.Reset(NumObjects);
+
+        const double RegisterStartTime = FPlatformTime::Seconds();
+        for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+        {
+            FInteractiveObjectRecord NewRecord;
+            NewRecord.ObjectId = Registry->NextObjectId++;
+            NewRecord.Component = SharedComponent;
+            NewRecord.DisplayName = FName(TEXT("BenchmarkObject"), NAME_EXTERNAL_TO_INTERNAL(NewRecord.ObjectId));
+
+            Handles.Add(Registry->AddRecord(MoveTemp(NewRecord), FLinearColor::White, 1.0f, EInteractiveObjectPrimitiveType::Other));
+        }
+        Result.RegisterNs = (FPlatformTime::Seconds() - RegisterStartTime) * 1.0e9 / NumObjects;
+
+        LookupIndices.Reset(NumLookups);
+        for (int32 LookupIndex = 0; LookupIndex < NumLookups; ++LookupIndex)
+        {
+            LookupIndices.Add(RandomStream.RandHelper(NumObjects));
+        }
+
+        // Summed so the lookups are not optimized away.
+        int64 IdLookupSum = 0;
+        int64 HandleLookupSum = 0;
+        int32 NumSelected = 0;
+
+        const double IdLookupStartTime = FPlatformTime::Seconds();
+        for (const int32 LookupIndex : LookupIndices)
+        {
+            const FInteractiveObjectRecord* Record = Registry->FindRecordById(Registry->RegisteredObjects[LookupIndex].ObjectId);
+            IdLookupSum += (Record != nullptr) ? Record->ObjectId : 0;
+        }
+        Result.IdLookupNs = (FPlatformTime::Seconds() - IdLookupStartTime) * 1.0e9 / NumLookups;
+
+        const double HandleLookupStartTime = FPlatformTime::Seconds();
+        for (const int32 LookupIndex : LookupIndices)
+        {
+            HandleLookupSum += Registry->FindDenseIndex(Handles[LookupIndex]);
+        }
+        Result.HandleLookupNs = (FPlatformTime::Seconds() - HandleLookupStartTime) * 1.0e9 / NumLookups;
+
+        // Each call replaces the selection, as a click in the list or the viewport does.
+        const double SelectStartTime = FPlatformTime::Seconds();
+        for (const int32 LookupIndex : LookupIndices)
+        {
+            NumSelected += Registry->SelectObject(Handles[LookupIndex]) ? 1 : 0;
+        }
+        Result.SelectNs = (FPlatformTime::Seconds() - SelectStartTime) * 1.0e9 / NumLookups;
+
+        // Unregistered in random order, so swap-remove keeps moving records around as it does at runtime.
+        for (int32 HandleIndex = Handles.Num() - 1; HandleIndex > 0; --HandleIndex)
+        {
+            Handles.Swap(HandleIndex, RandomStream.RandHelper(HandleIndex + 1));
+        }
+
+        const double UnregisterStartTime = FPlatformTime::Seconds();
+        for (const FInteractiveObjectHandle& Handle : Handles)
+        {
+            Registry->RemoveRecordAtIndex(Registry->FindDenseIndex(Handle));
+        }
+        Result.UnregisterNs = (FPlatformTime::Seconds() - UnregisterStartTime) * 1.0e9 / NumObjects;
+
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("IOM.Registry.Benchmark: %d objects. Register %.1f ns, lookup by Id %.1f ns, lookup by handle %.1f ns, select %.1f ns, unregister %.1f ns per object. %d selections, %d left, checksum %lld."),
+            NumObjects,
+            Result.RegisterNs,
+            Result.IdLookupNs,
+            Result.HandleLookupNs,
+            Result.SelectNs,
+            Result.UnregisterNs,
+            NumSelected,
+            Registry->RegisteredObjects.Num(),
+            IdLookupSum + HandleLookupSum
+        );
+
+        if (NumObjects > MaxObjects / 10)
+        {
+            break;
+        }
+    }
+
+    Registry->MarkAsGarbage();
+    return Results;
+}
+
+void UInteractiveObjectManagerSubsystem::RegisterInteractiveObject(UInteractiveObjectComponent* InteractiveComponent)
+{
+    // Prewarmed actors are parked in the pool right after BeginPlay and register once reused.
+    if (InteractiveComponent == nullptr || bIsPrewarmingPool)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_RegisterObject);
+
+    // Avoid duplicate registration.
+    if (FInteractiveObjectRecord* ExistingRecord = FindRecordByComponent(InteractiveComponent))
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerSubsystem: Attempted to register component '%s' that is already registered with Id %d."),
+            *GetNameSafe(InteractiveComponent),
+            ExistingRecord->ObjectId
+        );
+        return;
+    }
+
+    const int32 NewObjectId = NextObjectId++;
+    const FInteractiveObjectHandle NewHandle = AddRecord(NewObjectId, InteractiveComponent);
+    InteractiveComponent->HandleRegisteredWithManager(NewHandle);
+
+    if (const AActor* OwnerActor = InteractiveComponent->GetOwner())
+    {
+        FindOrAddWriteAheadLogClass(OwnerActor->GetClass());
+    }
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("Registered interactive object component '%s' with Id %d (slot %d, generation %d)."),
+        *GetNameSafe(InteractiveComponent),
+        NewObjectId,
+        NewHandle.SlotIndex,
+        NewHandle.Generation
+    );
+}
+
+void UInteractiveObjectManagerSubsystem::UnregisterInteractiveObject(UInteractiveObjectComponent* InteractiveComponent)
+{
+    if (InteractiveComponent == nullptr)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_UnregisterObject);
+
+    const int32* SlotIndexPtr = ComponentToSlot.Find(InteractiveComponent);
+    if (SlotIndexPtr == nullptr)
+    {
+        return;
+    }
+
+    const int32 DenseIndex = Slots[*SlotIndexPtr].DenseIndex;
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("Unregistered interactive object component '%s' with Id %d."),
+        *GetNameSafe(InteractiveComponent),
+        RegisteredObjects[DenseIndex].ObjectId
+    );
+
+    RemoveRecordAtIndex(DenseIndex);
+}
+
+int32 UInteractiveObjectManagerSubsystem::GetInteractiveObjectsPage(int32 Offset, int32 Count, EInteractiveObjectSortKey SortKey, bool bAscending, TArray<FInteractiveObjectListItem>& OutItems)
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_FetchObjectsPage);
+
+    OutItems.Reset();
+
+    const int32 SortKeyIndex = static_cast<int32>(SortKey);
+    if (SortKeyIndex < 0 || SortKeyIndex >= NumSortKeys)
+    {
+        return RegisteredObjects.Num();
+    }
+
+    FObjectSortIndex& SortIndex = SortIndices[SortKeyIndex];
+    if (!SortIndex.bIsBuilt)
+    {
+        RebuildSortIndex(SortKey);
+    }
+
+    SortIndex.UpdatesSinceLastFetch = 0;
+
+    const int32 TotalCount = SortIndex.SortedSlots.Num();
+    const int32 FirstPosition = FMath::Clamp(Offset, 0, TotalCount);
+    const int32 PageSize = FMath::Clamp(Count, 0, TotalCount - FirstPosition);
+
+    OutItems.SetNum(PageSize);
+    for (int32 PageIndex = 0; PageIndex < PageSize; ++PageIndex)
+    {
+        const int32 SortedPosition = bAscending
+            ? FirstPosition + PageIndex
+            : TotalCount - 1 - (FirstPosition + PageIndex);
+
+        FillListItem(Slots[SortIndex.SortedSlots[SortedPosition]].DenseIndex, OutItems[PageIndex]);
+    }
+
+    return TotalCount;
+}
+
+void UInteractiveObjectManagerSubsystem::GetInteractiveObjectsList(TArray<FInteractiveObjectListItem>& OutItems) const
+{
+    OutItems.Reset();
+    OutItems.Reserve(RegisteredObjects.Num());
+
+    for (int32 DenseIndex = 0; DenseIndex < RegisteredObjects.Num(); ++DenseIndex)
+    {
+        if (!RegisteredObjects[DenseIndex].IsValid())
+        {
+            continue;
+        }
+
+        FillListItem(DenseIndex, OutItems.AddDefaulted_GetRef());
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::FillListItemDisplayNameStrings(TArray<FInteractiveObjectListItem>& Items)
+{
+    for (FInteractiveObjectListItem& Item : Items)
+    {
+        Item.DisplayName = Item.DisplayNameText.ToString();
+    }
+}
+
+bool UInteractiveObjectManagerSubsystem::GetObjectListItem(int32 ObjectId, FInteractiveObjectListItem& OutItem) const
+{
+    const int32 DenseIndex = FindDenseIndex(GetHandleForObjectId(ObjectId));
+    if (DenseIndex == INDEX_NONE || !RegisteredObjects[DenseIndex].IsValid())
+    {
+        return false;
+    }
+
+    FillListItem(DenseIndex, OutItem);
+    return true;
+}
+
+int64 UInteractiveObjectManagerSubsystem::GetObjectsListVersion() const
+{
+    return ObjectsListVersion;
+}
+
+bool UInteractiveObjectManagerSubsystem::IsObjectHandleValid(FInteractiveObjectHandle Handle) const
+{
+    return FindDenseIndex(Handle) != INDEX_NONE;
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::GetHandleForObjectId(int32 ObjectId) const
+{
+    const int32* SlotIndexPtr = ObjectIdToSlot.Find(ObjectId);
+    if (SlotIndexPtr == nullptr)
+    {
+        return FInteractiveObjectHandle();
+    }
+
+    return MakeHandleForSlot(*SlotIndexPtr);
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::GetHandleForComponent(const UInteractiveObjectComponent* InteractiveComponent) const
+{
+    if (InteractiveComponent == nullptr)
+    {
+        return FInteractiveObjectHandle();
+    }
+
+    const int32* SlotIndexPtr = ComponentToSlot.Find(InteractiveComponent);
+    if (SlotIndexPtr == nullptr)
+    {
+        return FInteractiveObjectHandle();
+    }
+
+    return MakeHandleForSlot(*SlotIndexPtr);
+}
+
+const FText& UInteractiveObjectManagerSubsystem::GetObjectDisplayName(FInteractiveObjectHandle Handle) const
+{
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    return (DenseIndex != INDEX_NONE) ? RegisteredObjects[DenseIndex].DisplayText : FText::GetEmpty();
+}
+
+UInteractiveObjectComponent* UInteractiveObjectManagerSubsystem::ResolveHandle(FInteractiveObjectHandle Handle) const
+{
+    const FInteractiveObjectRecord* Record = FindRecordByHandle(Handle);
+    return (Record != nullptr) ? Record->Component.Get() : nullptr;
+}
+
+bool UInteractiveObjectManagerSubsystem::SelectObject(FInteractiveObjectHandle Handle)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SelectObject))
+    {
+        TraceEvent->Objects.Add(GetTraceObjectIndex(Handle));
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (Handle == SelectedHandle && SelectedObjectCount == 1)
+    {
+        return false;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_SelectObject);
+
+    const FInteractiveObjectRecord* Record = FindRecordByHandle(Handle);
+    if (Record == nullptr || !Record->IsValid())
+    {
+        return false;
+    }
+
+    ResetSelectionSet();
+    SetSlotSelected(Handle.SlotIndex, true);
+    SelectedHandle = Handle;
+
+    MarkSelectionDirty();
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::AddObjectToSelection(FInteractiveObjectHandle Handle)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::AddObjectToSelection))
+    {
+        TraceEvent->Objects.Add(GetTraceObjectIndex(Handle));
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_SelectObject);
+
+    const FInteractiveObjectRecord* Record = FindRecordByHandle(Handle);
+    if (Record == nullptr || !Record->IsValid())
+    {
+        return false;
+    }
+
+    const bool bWasSelected = SelectionBits[Handle.SlotIndex];
+    if (bWasSelected && SelectedHandle == Handle)
+    {
+        return false;
+    }
+
+    SetSlotSelected(Handle.SlotIndex, true);
+    SelectedHandle = Handle;
+
+    MarkSelectionDirty();
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::RemoveObjectFromSelection(FInteractiveObjectHandle Handle)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::RemoveObjectFromSelection))
+    {
+        TraceEvent->Objects.Add(GetTraceObjectIndex(Handle));
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (!IsObjectSelected(Handle))
+    {
+        return false;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_SelectObject);
+
+    SetSlotSelected(Handle.SlotIndex, false);
+
+    if (SelectedHandle == Handle)
+    {
+        PromotePrimarySelection();
+    }
+
+    MarkSelectionDirty();
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::ToggleObjectSelection(FInteractiveObjectHandle Handle)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::ToggleObjectSelection))
+    {
+        TraceEvent->Objects.Add(GetTraceObjectIndex(Handle));
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    return IsObjectSelected(Handle) ? RemoveObjectFromSelection(Handle) : AddObjectToSelection(Handle);
+}
+
+int32 UInteractiveObjectManagerSubsystem::SelectObjects(const TArray<FInteractiveObjectHandle>& Handles, bool bAddToSelection)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SelectObjects))
+    {
+        for (const FInteractiveObjectHandle& Handle : Handles)
+        {
+            TraceEvent->Objects.Add(GetTraceObjectIndex(Handle));
+        }
+
+        TraceEvent->bAddToSelection = bAddToSelection;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_BulkSelectionOperation);
+
+    const int32 PreviousCount = SelectedObjectCount;
+    const FInteractiveObjectHandle PreviousPrimary = SelectedHandle;
+
+    if (!bAddToSelection)
+    {
+        ResetSelectionSet();
+    }
+
+    int32 SelectedFromHandles = 0;
+    for (const FInteractiveObjectHandle& Handle : Handles)
+    {
+        const FInteractiveObjectRecord* Record = FindRecordByHandle(Handle);
+        if (Record == nullptr || !Record->IsValid())
+        {
+            continue;
+        }
+
+        SetSlotSelected(Handle.SlotIndex, true);
+        SelectedHandle = Handle;
+        ++SelectedFromHandles;
+    }
+
+    if (!SelectedHandle.IsSet() && SelectedObjectCount > 0)
+    {
+        PromotePrimarySelection();
+    }
+
+    // Replacing a selection with the same set still rewrites the bits, so compare counts and primary.
+    if (!bAddToSelection || SelectedObjectCount != PreviousCount || SelectedHandle != PreviousPrimary)
+    {
+        MarkSelectionDirty();
+    }
+
+    return SelectedFromHandles;
+}
+
+int32 UInteractiveObjectManagerSubsystem::SelectAllObjects()
+{
+    TraceCall(EInteractiveObjectTraceOp::SelectAllObjects);
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_BulkSelectionOperation);
+
+    for (const int32 SlotIndex : ObjectColumns.OwningSlots)
+    {
+        SetSlotSelected(SlotIndex, true);
+    }
+
+    if (!SelectedHandle.IsSet())
+    {
+        PromotePrimarySelection();
+    }
+
+    MarkSelectionDirty();
+    return SelectedObjectCount;
+}
+
+bool UInteractiveObjectManagerSubsystem::IsObjectSelected(FInteractiveObjectHandle Handle) const
+{
+    return IsObjectHandleValid(Handle) && SelectionBits[Handle.SlotIndex];
+}
+
+int32 UInteractiveObjectManagerSubsystem::GetSelectedObjectCount() const
+{
+    return SelectedObjectCount;
+}
+
+void UInteractiveObjectManagerSubsystem::GetSelectedObjectHandles(TArray<FInteractiveObjectHandle>& OutHandles) const
+{
+    OutHandles.Reset(SelectedObjectCount);
+
+    for (TConstSetBitIterator<> It(SelectionBits); It; ++It)
+    {
+        OutHandles.Add(MakeHandleForSlot(It.GetIndex()));
+    }
+}
+
+int32 UInteractiveObjectManagerSubsystem::SetSelectedObjectsColor(const FLinearColor& NewColor)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SetSelectedObjectsColor))
+    {
+        TraceEvent->Color = NewColor;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_BulkSelectionOperation);
+
+    PrepareSortIndexForBulkChange(EInteractiveObjectSortKey::ColorHue, SelectedObjectCount);
+    Journal.BeginBatch();
+
+    int32 AppliedCount = 0;
+    for (TConstSetBitIterator<> It(SelectionBits); It; ++It)
+    {
+        const int32 DenseIndex = Slots[It.GetIndex()].DenseIndex;
+        const FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+        if (Record.IsValid())
+        {
+            const int32 SlotIndex = ObjectColumns.OwningSlots[DenseIndex];
+            const FLinearColor PreviousColor = ObjectColumns.Colors[DenseIndex];
+
+            BeginSortKeyChange(EInteractiveObjectSortKey::ColorHue, SlotIndex);
+            ObjectColumns.SetColor(DenseIndex, NewColor);
+            EndSortKeyChange(EInteractiveObjectSortKey::ColorHue, SlotIndex);
+
+            UpdateObjectColor(DenseIndex, NewColor);
+            RecordColorChange(MakeHandleForSlot(SlotIndex), PreviousColor, NewColor);
+            MarkObjectChanged(Record.ObjectId);
+            ++AppliedCount;
+        }
+    }
+
+    Journal.EndBatch();
+    return AppliedCount;
+}
+
+int32 UInteractiveObjectManagerSubsystem::SetSelectedObjectsUniformScale(float NewUniformScale)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SetSelectedObjectsUniformScale))
+    {
+        TraceEvent->UniformScale = NewUniformScale;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_BulkSelectionOperation);
+
+    PrepareSortIndexForBulkChange(EInteractiveObjectSortKey::Scale, SelectedObjectCount);
+
+    const float ClampedScale = FMath::Max(NewUniformScale, MinUniformScale);
+    Journal.BeginBatch();
+
+    int32 AppliedCount = 0;
+    for (TConstSetBitIterator<> It(SelectionBits); It; ++It)
+    {
+        const int32 DenseIndex = Slots[It.GetIndex()].DenseIndex;
+        const FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+        if (Record.IsValid())
+        {
+            const int32 SlotIndex = ObjectColumns.OwningSlots[DenseIndex];
+            const float PreviousScale = ObjectColumns.Scales[DenseIndex];
+
+            BeginSortKeyChange(EInteractiveObjectSortKey::Scale, SlotIndex);
+            ObjectColumns.Scales[DenseIndex] = ClampedScale;
+            EndSortKeyChange(EInteractiveObjectSortKey::Scale, SlotIndex);
+
+            UpdateObjectScale(DenseIndex, ClampedScale);
+            UpdateSpatialEntry(DenseIndex);
+            RecordScaleChange(MakeHandleForSlot(SlotIndex), PreviousScale, ClampedScale);
+            MarkObjectChanged(Record.ObjectId);
+            ++AppliedCount;
+        }
+    }
+
+    Journal.EndBatch();
+    return AppliedCount;
+}
+
+int32 UInteractiveObjectManagerSubsystem::DeleteSelectedObjects()
+{
+    TraceCall(EInteractiveObjectTraceOp::DeleteSelectedObjects);
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (SelectedObjectCount == 0)
+    {
+        return 0;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_BulkSelectionOperation);
+
+    // Deleting releases slots, so collect the handles before touching the registry.
+    TArray<FInteractiveObjectHandle> HandlesToRemove;
+    GetSelectedObjectHandles(HandlesToRemove);
+
+    ResetSelectionSet();
+    Journal.BeginBatch();
+
+    int32 RemovedCount = 0;
+    for (const FInteractiveObjectHandle& Handle : HandlesToRemove)
+    {
+        if (DeleteObject(Handle))
+        {
+            ++RemovedCount;
+        }
+    }
+
+    Journal.EndBatch();
+
+    // Same behaviour as DeleteSelectedObject: keep something selected while objects remain.
+    if (RegisteredObjects.Num() > 0)
+    {
+        SetSlotSelected(ObjectColumns.OwningSlots[0], true);
+        SelectedHandle = GetHandleAtDenseIndex(0);
+    }
+
+    MarkSelectionDirty();
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("DeleteSelectedObjects: removed %d of %d selected objects."),
+        RemovedCount,
+        HandlesToRemove.Num()
+    );
+
+    return RemovedCount;
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::GetSelectedObjectHandle() const
+{
+    return IsObjectHandleValid(SelectedHandle) ? SelectedHandle : FInteractiveObjectHandle();
+}
+
+bool UInteractiveObjectManagerSubsystem::SelectObjectById(int32 ObjectId)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SelectObjectById))
+    {
+        TraceEvent->Objects.Add(GetTraceObjectIndex(GetHandleForObjectId(ObjectId)));
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (ObjectId == GetSelectedObjectId() && SelectedObjectCount == 1)
+    {
+        return false;
+    }
+
+    return SelectObject(GetHandleForObjectId(ObjectId));
+}
+
+bool UInteractiveObjectManagerSubsystem::SelectObjectByIndex(int32 Index)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SelectObjectByIndex))
+    {
+        TraceEvent->Count = Index;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (!RegisteredObjects.IsValidIndex(Index))
+    {
+        return false;
+    }
+
+    return SelectObject(GetHandleAtDenseIndex(Index));
+}
+
+bool UInteractiveObjectManagerSubsystem::ClearSelection()
+{
+    TraceCall(EInteractiveObjectTraceOp::ClearSelection);
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (!SelectedHandle.IsSet() && SelectedObjectCount == 0)
+    {
+        return false;
+    }
+
+    ResetSelectionSet();
+
+    MarkSelectionDirty();
+    return true;
+}
+
+FInteractiveObjectListItem UInteractiveObjectManagerSubsystem::GetSelectedObjectInfo(bool& bOutIsValid) const
+{
+    bOutIsValid = false;
+
+    FInteractiveObjectListItem Result;
+    Result.Id = INDEX_NONE;
+
+    const FInteractiveObjectRecord* Record = FindRecordByHandle(SelectedHandle);
+    if (Record == nullptr)
+    {
+        return Result;
+    }
+
+    if (!Record->IsValid())
+    {
+        return Result;
+    }
+
+    Result.Id = Record->ObjectId;
+    Result.Handle = SelectedHandle;
+    Result.DisplayNameText = Record->DisplayText;
+
+    bOutIsValid = true;
+    return Result;
+}
+
+//bool UInteractiveObjectManagerSubsystem::GetSelectedObjectProperties(FLinearColor& OutColor, float& OutUniformScale) const
+//{
+//    OutColor = FLinearColor::White;
+//    OutUniformScale = 1.0f;
+//
+//    if (!SelectedObject.IsValid())
+//    {
+//        UE_LOG(
+//            LogInteractiveObjectManager,
+//            Log,
+//            TEXT("GetSelectedObjectProperties: no selected object.")
+//        );
+//        return false;
+//    }
+//
+//    UInteractiveObjectComponent* InteractiveComponent = SelectedObject.Get();
+//    if (InteractiveComponent == nullptr)
+//    {
+//        UE_LOG(
+//            LogInteractiveObjectManager,
+//            Warning,
+//            TEXT("GetSelectedObjectProperties: selected object pointer is invalid.")
+//        );
+//        return false;
+//    }
+//
+//    OutColor = InteractiveComponent->GetCurrentColor();
+//    OutUniformScale = InteractiveComponent->GetCurrentScale();
+//    return true;
+//}
+
+void UInteractiveObjectManagerSubsystem::GetSelectedObjectVisualState(bool& bOutHasSelection, FLinearColor& OutColor, float& OutScale) const
+{
+    bOutHasSelection = false;
+
+    // Default fallback: safe defaults from settings or hardcoded values.
+    FInteractiveObjectRuntimeSettings RuntimeDefaults;
+    RuntimeDefaults.ApplySafeDefaults();
+
+    if (const UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get())
+    {
+        RuntimeDefaults = Settings->GetRuntimeSettingsCopy();
+    }
+
+    OutColor = RuntimeDefaults.DefaultColor;
+    OutScale = RuntimeDefaults.DefaultScale.X;
+
+    const int32 DenseIndex = FindDenseIndex(SelectedHandle);
+    if (DenseIndex == INDEX_NONE || !RegisteredObjects[DenseIndex].IsValid())
+    {
+        return;
+    }
+
+    bOutHasSelection = true;
+    OutColor = ObjectColumns.Colors[DenseIndex];
+    OutScale = ObjectColumns.Scales[DenseIndex];
+}
+
+bool UInteractiveObjectManagerSubsystem::SetSelectedObjectColor(const FLinearColor& NewColor)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SetSelectedObjectColor))
+    {
+        TraceEvent->Color = NewColor;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (!SelectedHandle.IsSet())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("SetSelectedObjectColor: no selected object.")
+        );
+        return false;
+    }
+
+    if (!SetObjectColor(SelectedHandle, NewColor))
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("SetSelectedObjectColor: selected object handle is stale.")
+        );
+        return false;
+    }
+
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::SetSelectedObjectUniformScale(float NewUniformScale)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SetSelectedObjectUniformScale))
+    {
+        TraceEvent->UniformScale = NewUniformScale;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (!SelectedHandle.IsSet())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("SetSelectedObjectUniformScale: no selected object.")
+        );
+        return false;
+    }
+
+    if (!SetObjectUniformScale(SelectedHandle, NewUniformScale))
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("SetSelectedObjectUniformScale: selected object handle is stale.")
+        );
+        return false;
+    }
+
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::DeleteSelectedObject()
+{
+    TraceCall(EInteractiveObjectTraceOp::DeleteSelectedObject);
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    if (!SelectedHandle.IsSet())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("DeleteSelectedObject: no selected object.")
+        );
+        return false;
+    }
+
+    const int32 ObjectIdToRemove = GetSelectedObjectId();
+    const FInteractiveObjectHandle HandleToRemove = SelectedHandle;
+
+    const bool bSuccess = DeleteObject(HandleToRemove);
+
+    // Removing the record promoted another selected object if there was one.
+    if (!SelectedHandle.IsSet() && RegisteredObjects.Num() > 0)
+    {
+        SetSlotSelected(ObjectColumns.OwningSlots[0], true);
+        SelectedHandle = GetHandleAtDenseIndex(0);
+    }
+
+    MarkSelectionDirty();
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("DeleteSelectedObject: Id %d, success = %s."),
+        ObjectIdToRemove,
+        bSuccess ? TEXT("true") : TEXT("false")
+    );
+
+    return bSuccess;
+}
+
+bool UInteractiveObjectManagerSubsystem::SetObjectColor(FInteractiveObjectHandle Handle, const FLinearColor& NewColor)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SetObjectColor))
+    {
+        TraceEvent->Objects.Add(GetTraceObjectIndex(Handle));
+        TraceEvent->Color = NewColor;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    if (DenseIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+    if (!Record.IsValid())
+    {
+        return false;
+    }
+
+    const FLinearColor PreviousColor = ObjectColumns.Colors[DenseIndex];
+
+    BeginSortKeyChange(EInteractiveObjectSortKey::ColorHue, Handle.SlotIndex);
+    ObjectColumns.SetColor(DenseIndex, NewColor);
+    EndSortKeyChange(EInteractiveObjectSortKey::ColorHue, Handle.SlotIndex);
+
+    UpdateObjectColor(DenseIndex, NewColor);
+    RecordColorChange(Handle, PreviousColor, NewColor);
+    MarkObjectChanged(Record.ObjectId);
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::SetObjectUniformScale(FInteractiveObjectHandle Handle, float NewUniformScale)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::SetObjectUniformScale))
+    {
+        TraceEvent->Objects.Add(GetTraceObjectIndex(Handle));
+        TraceEvent->UniformScale = NewUniformScale;
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    if (DenseIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+    if (!Record.IsValid())
+    {
+        return false;
+    }
+
+    const float ClampedScale = FMath::Max(NewUniformScale, MinUniformScale);
+    const float PreviousScale = ObjectColumns.Scales[DenseIndex];
+
+    BeginSortKeyChange(EInteractiveObjectSortKey::Scale, Handle.SlotIndex);
+    ObjectColumns.Scales[DenseIndex] = ClampedScale;
+    EndSortKeyChange(EInteractiveObjectSortKey::Scale, Handle.SlotIndex);
+
+    UpdateObjectScale(DenseIndex, ClampedScale);
+    UpdateSpatialEntry(DenseIndex);
+    RecordScaleChange(Handle, PreviousScale, ClampedScale);
+    MarkObjectChanged(Record.ObjectId);
+    return true;
+}
+
+int32 UInteractiveObjectManagerSubsystem::UndoLastOperation()
+{
+    TraceCall(EInteractiveObjectTraceOp::UndoLastOperation);
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    TArray<FInteractiveObjectJournalRecord> Records;
+    if (!Journal.PopUndoBatch(Records))
+    {
+        return 0;
+    }
+
+    const int32 AppliedCount = ApplyJournalRecords(Records, true);
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("UndoLastOperation: reverted %d of %d operations."),
+        AppliedCount,
+        Records.Num()
+    );
+
+    return AppliedCount;
+}
+
+int32 UInteractiveObjectManagerSubsystem::RedoLastOperation()
+{
+    TraceCall(EInteractiveObjectTraceOp::RedoLastOperation);
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    TArray<FInteractiveObjectJournalRecord> Records;
+    if (!Journal.PopRedoBatch(Records))
+    {
+        return 0;
+    }
+
+    const int32 AppliedCount = ApplyJournalRecords(Records, false);
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("RedoLastOperation: applied %d of %d operations."),
+        AppliedCount,
+        Records.Num()
+    );
+
+    return AppliedCount;
+}
+
+bool UInteractiveObjectManagerSubsystem::CanUndo() const
+{
+    return Journal.CanUndo();
+}
+
+bool UInteractiveObjectManagerSubsystem::CanRedo() const
+{
+    return Journal.CanRedo();
+}
+
+void UInteractiveObjectManagerSubsystem::ClearHistory()
+{
+    Journal.Reset(CVarJournalCapacity.GetValueOnGameThread());
+    SET_MEMORY_STAT(STAT_IOM_JournalMemory, Journal.GetAllocatedSize());
+}
+
+void UInteractiveObjectManagerSubsystem::NotifyObjectTransformChanged(FInteractiveObjectHandle Handle)
+{
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    if (DenseIndex != INDEX_NONE)
+    {
+        UpdateSpatialEntry(DenseIndex);
+        MarkCheckpointDirty(DenseIndex);
+        bIsSnapshotDirty = true;
+    }
+}
+
+bool UInteractiveObjectManagerSubsystem::IsSharingDynamicMaterials() const
+{
+    return bIsSharingDynamicMaterials;
+}
+
+bool UInteractiveObjectManagerSubsystem::HasWriteAheadLogFailed() const
+{
+    return bHasWriteAheadLogFailed;
+}
+
+UMaterialInstanceDynamic* UInteractiveObjectManagerSubsystem::AcquireSharedMaterial(UMaterialInterface* ParentMaterial, FName ParameterName, const FLinearColor& Color)
+{
+    return MaterialCache.Acquire(ParentMaterial, ParameterName, Color, this);
+}
+
+void UInteractiveObjectManagerSubsystem::ReleaseSharedMaterial(UMaterialInstanceDynamic* MaterialInstance)
+{
+    MaterialCache.Release(MaterialInstance);
+}
+
+FInteractiveObjectRegistrySnapshotPtr UInteractiveObjectManagerSubsystem::AcquireSnapshot() const
+{
+    return SnapshotPublisher.Acquire();
+}
+
+void UInteractiveObjectManagerSubsystem::QueryObjectsInRadius(const FVector& Center, float Radius, TArray<FInteractiveObjectHandle>& OutHandles) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_SpatialQuery);
+
+    TArray<int32> SlotIndices;
+    SpatialIndex.QuerySphere(Center, FMath::Max(Radius, 0.0f), SlotIndices);
+
+    OutHandles.Reset();
+    AppendHandlesForSlots(SlotIndices, OutHandles);
+}
+
+void UInteractiveObjectManagerSubsystem::QueryObjectsInBox(const FBox& Box, TArray<FInteractiveObjectHandle>& OutHandles) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_SpatialQuery);
+
+    OutHandles.Reset();
+    if (!Box.IsValid)
+    {
+        return;
+    }
+
+    TArray<int32> SlotIndices;
+    SpatialIndex.QueryBox(Box, SlotIndices);
+    AppendHandlesForSlots(SlotIndices, OutHandles);
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::QueryObjectAlongRay(const FVector& RayOrigin, const FVector& RayDirection, float MaxDistance, float& OutHitDistance) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_RayQuery);
+
+    OutHitDistance = 0.0f;
+
+    const FVector NormalizedDirection = RayDirection.GetSafeNormal();
+    if (NormalizedDirection.IsZero())
+    {
+        return FInteractiveObjectHandle();
+    }
+
+    const int32 HitSlotIndex = SpatialIndex.Raycast(RayOrigin, NormalizedDirection, MaxDistance, OutHitDistance);
+    return (HitSlotIndex != INDEX_NONE) ? MakeHandleForSlot(HitSlotIndex) : FInteractiveObjectHandle();
+}
+
+void UInteractiveObjectManagerSubsystem::QueryObjectsInScreenRect(const FMatrix& ViewProjectionMatrix, const FIntRect& ViewRect, const FVector2D& RectStart, const FVector2D& RectEnd, TArray<FInteractiveObjectHandle>& OutHandles) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_ScreenRectQuery);
+
+    OutHandles.Reset();
+
+    const FVector2D ViewMin(ViewRect.Min.X, ViewRect.Min.Y);
+    const FVector2D ViewSize(ViewRect.Width(), ViewRect.Height());
+    if (ViewSize.X <= 0.0 || ViewSize.Y <= 0.0)
+    {
+        return;
+    }
+
+    const FVector2D RectMin = FVector2D::Min(RectStart, RectEnd);
+    const FVector2D RectMax = FVector2D::Max(RectStart, RectEnd);
+
+    // Rectangle in normalized device coordinates. Screen Y grows down, NDC Y grows up.
+    const FVector2D NdcMin(
+        (RectMin.X - ViewMin.X) / ViewSize.X * 2.0 - 1.0,
+        1.0 - (RectMax.Y - ViewMin.Y) / ViewSize.Y * 2.0
+    );
+    const FVector2D NdcMax(
+        (RectMax.X - ViewMin.X) / ViewSize.X * 2.0 - 1.0,
+        1.0 - (RectMin.Y - ViewMin.Y) / ViewSize.Y * 2.0
+    );
+
+    const FVector2D NdcCenter = (NdcMin + NdcMax) * 0.5;
+    const FVector2D NdcHalfSize = FVector2D::Max((NdcMax - NdcMin) * 0.5, FVector2D(UE_KINDA_SMALL_NUMBER));
+
+    // Remap clip space so that the rectangle covers the whole [-1, 1] range, which turns the
+    // view frustum into the sub-frustum behind the rectangle.
+    const FMatrix RectRemap(
+        FPlane(1.0 / NdcHalfSize.X, 0.0, 0.0, 0.0),
+        FPlane(0.0, 1.0 / NdcHalfSize.Y, 0.0, 0.0),
+        FPlane(0.0, 0.0, 1.0, 0.0),
+        FPlane(-NdcCenter.X / NdcHalfSize.X, -NdcCenter.Y / NdcHalfSize.Y, 0.0, 1.0)
+    );
+
+    FConvexVolume RectFrustum;
+    GetViewFrustumBounds(RectFrustum, ViewProjectionMatrix * RectRemap, false);
+
+    TArray<int32> CandidateSlots;
+    SpatialIndex.QueryConvexVolume(RectFrustum, CandidateSlots);
+    if (CandidateSlots.Num() == 0)
+    {
+        return;
+    }
+
+    // Box overlap is conservative, keep only objects whose center lands inside the rectangle.
+    TArray<uint8> IsInsideRect;
+    IsInsideRect.SetNumZeroed(CandidateSlots.Num());
+
+    ParallelFor(
+        TEXT("IOM.ScreenRectProjection"),
+        CandidateSlots.Num(),
+        1024,
+        [this, &CandidateSlots, &IsInsideRect, &ViewProjectionMatrix, &NdcMin, &NdcMax](int32 CandidateIndex)
+        {
+            FVector Center;
+            FVector Extent;
+            if (!SpatialIndex.GetEntry(CandidateSlots[CandidateIndex], Center, Extent))
+            {
+                return;
+            }
+
+            const FVector4 ClipPosition = ViewProjectionMatrix.TransformFVector4(FVector4(Center, 1.0));
+            if (ClipPosition.W <= 0.0)
+            {
+                return;
+            }
+
+            const double NdcX = ClipPosition.X / ClipPosition.W;
+            const double NdcY = ClipPosition.Y / ClipPosition.W;
+
+            IsInsideRect[CandidateIndex] = (NdcX >= NdcMin.X && NdcX <= NdcMax.X && NdcY >= NdcMin.Y && NdcY <= NdcMax.Y) ? 1 : 0;
+        }
+    );
+
+    OutHandles.Reserve(CandidateSlots.Num());
+    for (int32 CandidateIndex = 0; CandidateIndex < CandidateSlots.Num(); ++CandidateIndex)
+    {
+        if (IsInsideRect[CandidateIndex] != 0)
+        {
+            OutHandles.Add(MakeHandleForSlot(CandidateSlots[CandidateIndex]));
+        }
+    }
+}
+
+int32 UInteractiveObjectManagerSubsystem::GetObjectIdForHandle(FInteractiveObjectHandle Handle) const
+{
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    return (DenseIndex != INDEX_NONE) ? RegisteredObjects[DenseIndex].ObjectId : INDEX_NONE;
+}
+
+void UInteractiveObjectManagerSubsystem::QueryObjectsInFrustum(const FConvexVolume& Frustum, TArray<FInteractiveObjectHandle>& OutHandles) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_SpatialQuery);
+
+    TArray<int32> SlotIndices;
+    SpatialIndex.QueryConvexVolume(Frustum, SlotIndices);
+
+    OutHandles.Reset();
+    AppendHandlesForSlots(SlotIndices, OutHandles);
+}
+
+bool UInteractiveObjectManagerSubsystem::GetObjectColor(FInteractiveObjectHandle Handle, FLinearColor& OutColor) const
+{
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    if (DenseIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutColor = ObjectColumns.Colors[DenseIndex];
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::GetObjectUniformScale(FInteractiveObjectHandle Handle, float& OutUniformScale) const
+{
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    if (DenseIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutUniformScale = ObjectColumns.Scales[DenseIndex];
+    return true;
+}
+
+bool UInteractiveObjectManagerSubsystem::DeleteObject(FInteractiveObjectHandle Handle)
+{
+    if (FInteractiveObjectTraceEvent* TraceEvent = TraceCall(EInteractiveObjectTraceOp::DeleteObject))
+    {
+        TraceEvent->Objects.Add(GetTraceObjectIndex(Handle));
+    }
+
+    TGuardValue<bool> TracedCallGuard(bIsInsideTracedCall, true);
+
+    FInteractiveObjectRecord* Record = FindRecordByHandle(Handle);
+    if (Record == nullptr)
+    {
+        return false;
+    }
+
+    UInteractiveObjectComponent* InteractiveComponent = Record->Component.Get();
+    AActor* OwnerActor = (InteractiveComponent != nullptr) ? InteractiveComponent->GetOwner() : nullptr;
+
+    const int32 DenseIndex = Slots[Handle.SlotIndex].DenseIndex;
+    RecordSpawnOrDelete(EInteractiveObjectJournalOp::Delete, Handle, ObjectColumns.Colors[DenseIndex], ObjectColumns.Scales[DenseIndex]);
+
+    // Remove the record first so that the EndPlay driven unregister becomes a no-op.
+    // This also drops the object from the selection, and the instance of an instanced object.
+    RemoveRecordAtIndex(DenseIndex);
+
+    if (OwnerActor != nullptr && !ReleaseActorToPool(OwnerActor))
+    {
+        OwnerActor->Destroy();
+    }
+
+    return true;
+}
+
+void UInteractiveObjectManagerSubsystem::HandleActorDestroyed(AActor* DestroyedActor)
+{
+    if (DestroyedActor == nullptr || RegisteredObjects.Num() == 0)
+    {
+        return;
+    }
+
+    TInlineComponentArray<UInteractiveObjectComponent*> InteractiveComponents(DestroyedActor);
+    for (UInteractiveObjectComponent* InteractiveComponent : InteractiveComponents)
+    {
+        // No-op when EndPlay already unregistered the component.
+        UnregisterInteractiveObject(InteractiveComponent);
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::HandlePostGarbageCollect()
+{
+    // Restart from the end so that records added since the last sweep are covered too.
+    SweepCursor = RegisteredObjects.Num() - 1;
+}
+
+void UInteractiveObjectManagerSubsystem::SweepInvalidRecords(int32 MaxRecords)
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_SweepInvalidRecords);
+
+    // Walk backwards so that swap-remove only ever moves records we already visited.
+    SweepCursor = FMath::Min(SweepCursor, RegisteredObjects.Num() - 1);
+
+    int32 CheckedRecords = 0;
+    while (SweepCursor >= 0 && CheckedRecords < MaxRecords)
+    {
+        if (!RegisteredObjects[SweepCursor].IsValid())
+        {
+            RemoveRecordAtIndex(SweepCursor);
+        }
+
+        --SweepCursor;
+        ++CheckedRecords;
+    }
+
+    if (SweepCursor < 0)
+    {
+        SweepCursor = INDEX_NONE;
+    }
+
+    InvalidateSelectionIfNoLongerValid();
+}
+
+int32 UInteractiveObjectManagerSubsystem::FindDenseIndex(FInteractiveObjectHandle Handle) const
+{
+    if (!Slots.IsValidIndex(Handle.SlotIndex))
+    {
+        return INDEX_NONE;
+    }
+
+    const FInteractiveObjectSlot& Slot = Slots[Handle.SlotIndex];
+    return (Slot.Generation == Handle.Generation) ? Slot.DenseIndex : INDEX_NONE;
+}
+
+UInteractiveObjectManagerSubsystem::FInteractiveObjectRecord* UInteractiveObjectManagerSubsystem::FindRecordByHandle(FInteractiveObjectHandle Handle)
+{
+    const int32 DenseIndex = FindDenseIndex(Handle);
+    return (DenseIndex != INDEX_NONE) ? &RegisteredObjects[DenseIndex] : nullptr;
+}
+
+const UInteractiveObjectManagerSubsystem::FInteractiveObjectRecord* UInteractiveObjectManagerSubsystem::FindRecordByHandle(FInteractiveObjectHandle Handle) const
+{
+    return const_cast<UInteractiveObjectManagerSubsystem*>(this)->FindRecordByHandle(Handle);
+}
+
+UInteractiveObjectManagerSubsystem::FInteractiveObjectRecord* UInteractiveObjectManagerSubsystem::FindRecordById(int32 ObjectId)
+{
+    const int32* SlotIndexPtr = ObjectIdToSlot.Find(ObjectId);
+    if (SlotIndexPtr == nullptr)
+    {
+        return nullptr;
+    }
+
+    FInteractiveObjectRecord& Record = RegisteredObjects[Slots[*SlotIndexPtr].DenseIndex];
+    return Record.IsValid() ? &Record : nullptr;
+}
+
+UInteractiveObjectManagerSubsystem::FInteractiveObjectRecord* UInteractiveObjectManagerSubsystem::FindRecordByComponent(UInteractiveObjectComponent* InteractiveComponent)
+{
+    if (InteractiveComponent == nullptr)
+    {
+        return nullptr;
+    }
+
+    const int32* SlotIndexPtr = ComponentToSlot.Find(InteractiveComponent);
+    return (SlotIndexPtr != nullptr) ? &RegisteredObjects[Slots[*SlotIndexPtr].DenseIndex] : nullptr;
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::AddRecord(int32 ObjectId, UInteractiveObjectComponent* InteractiveComponent)
+{
+    FInteractiveObjectRecord NewRecord;
+    NewRecord.ObjectId = ObjectId;
+    NewRecord.Component = InteractiveComponent;
+    // The name interns case insensitively, the text keeps the spelling of this object.
+    FString DisplayString = InteractiveComponent->GetDisplayNameForUI();
+    NewRecord.DisplayName = FName(*DisplayString);
+    NewRecord.DisplayText = FText::FromString(MoveTemp(DisplayString));
+
+    const AActor* OwnerActor = InteractiveComponent->GetOwner();
+
+    // Seed the columns from the state the component carried before registration.
+    const FInteractiveObjectHandle NewHandle = AddRecord(
+        MoveTemp(NewRecord),
+        InteractiveComponent->GetCurrentColor(),
+        InteractiveComponent->GetCurrentScale(),
+        ResolvePrimitiveType((OwnerActor != nullptr) ? OwnerActor->GetClass() : nullptr)
+    );
+
+    ComponentToSlot.Add(InteractiveComponent, NewHandle.SlotIndex);
+    return NewHandle;
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::AddRecord(FInteractiveObjectRecord&& NewRecord, const FLinearColor& Color, float UniformScale, EInteractiveObjectPrimitiveType PrimitiveType)
+{
+    const int32 SlotIndex = (FreeSlotIndices.Num() > 0) ? FreeSlotIndices.Pop(EAllowShrinking::No) : Slots.AddDefaulted();
+    FInteractiveObjectSlot& Slot = Slots[SlotIndex];
+
+    if (SelectionBits.Num() < Slots.Num())
+    {
+        SelectionBits.Add(false, Slots.Num() - SelectionBits.Num());
+    }
+
+    const int32 ObjectId = NewRecord.ObjectId;
+    if (NewRecord.DisplayText.IsEmpty())
+    {
+        NewRecord.DisplayText = FText::FromName(NewRecord.DisplayName);
+    }
+
+    Slot.DenseIndex = RegisteredObjects.Add(MoveTemp(NewRecord));
+
+    ObjectColumns.OwningSlots.Add(SlotIndex);
+    ObjectColumns.Colors.Add(Color);
+    ObjectColumns.Hues.Add(Color.LinearRGBToHSV().R);
+    ObjectColumns.Scales.Add(UniformScale);
+    ObjectColumns.Types.Add(PrimitiveType);
+    ObjectColumns.Flags.Add(PendingRegistrationFlags);
+
+    ObjectIdToSlot.Add(ObjectId, SlotIndex);
+
+    UpdateSpatialEntry(Slot.DenseIndex);
+    InsertIntoSortIndices(SlotIndex);
+
+    MarkObjectAdded(ObjectId);
+    MarkCheckpointDirty(Slot.DenseIndex);
+
+    const FInteractiveObjectHandle NewHandle = MakeHandleForSlot(SlotIndex);
+
+    // Recording and replay number objects in registration order, see FInteractiveObjectTraceEvent.
+    if (bIsRecordingTrace)
+    {
+        TraceObjectIndices.Add(ObjectId, TraceObjectIndices.Num());
+    }
+    else if (ActiveReplay.bIsStarted)
+    {
+        ActiveReplay.Objects.Add(NewHandle);
+    }
+
+    UpdateRegistryStats();
+    return NewHandle;
+}
+
+void UInteractiveObjectManagerSubsystem::RemoveRecordAtIndex(int32 Index)
+{
+    if (!RegisteredObjects.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    const FInteractiveObjectRecord& RemovedRecord = RegisteredObjects[Index];
+    const FInteractiveObjectHandle RemovedHandle = GetHandleAtDenseIndex(Index);
+
+    ObjectIdToSlot.Remove(RemovedRecord.ObjectId);
+
+    if (RemovedRecord.InstanceIndex == INDEX_NONE)
+    {
+        ComponentToSlot.Remove(RemovedRecord.Component);
+    }
+
+    MarkObjectRemoved(RemovedRecord.ObjectId);
+
+    if (bIsCheckpointTrackingEnabled)
+    {
+        CheckpointDeletedIds.Add(RemovedRecord.ObjectId);
+    }
+
+    // Hand the latest visual state back so the component stays correct while detached.
+    if (UInteractiveObjectComponent* InteractiveComponent = RemovedRecord.Component.Get())
+    {
+        InteractiveComponent->HandleUnregisteredFromManager(ObjectColumns.Colors[Index], ObjectColumns.Scales[Index]);
+    }
+
+    // An instanced object has nothing to hand its state back to, it ends with its instance.
+    if (RemovedRecord.InstanceIndex != INDEX_NONE)
+    {
+        RemoveObjectInstance(Index);
+    }
+
+    // A released slot must not stay selected, the next registration reuses it.
+    if (SelectionBits[RemovedHandle.SlotIndex])
+    {
+        SetSlotSelected(RemovedHandle.SlotIndex, false);
+        MarkSelectionDirty();
+    }
+
+    SpatialIndex.Remove(RemovedHandle.SlotIndex);
+    RemoveFromSortIndices(RemovedHandle.SlotIndex);
+
+    // Release the slot. Bumping the generation turns every outstanding handle stale.
+    FInteractiveObjectSlot& RemovedSlot = Slots[RemovedHandle.SlotIndex];
+    RemovedSlot.DenseIndex = INDEX_NONE;
+    RemovedSlot.Generation = (RemovedSlot.Generation == MAX_int32) ? 1 : RemovedSlot.Generation + 1;
+    FreeSlotIndices.Add(RemovedHandle.SlotIndex);
+
+    RegisteredObjects.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    ObjectColumns.RemoveAtSwap(Index);
+
+    // The former last record now lives at Index, point its slot there.
+    if (RegisteredObjects.IsValidIndex(Index))
+    {
+        Slots[ObjectColumns.OwningSlots[Index]].DenseIndex = Index;
+    }
+
+    if (SelectedHandle == RemovedHandle)
+    {
+        PromotePrimarySelection();
+        MarkSelectionDirty();
+    }
+
+    UpdateRegistryStats();
+}
+
+bool UInteractiveObjectManagerSubsystem::FInteractiveObjectRecord::IsValid() const
+{
+    return Component.IsValid() || InstanceIndex != INDEX_NONE;
+}
+
+void UInteractiveObjectManagerSubsystem::FObjectColumns::SetColor(int32 Index, const FLinearColor& NewColor)
+{
+    Colors[Index] = NewColor;
+    Hues[Index] = NewColor.LinearRGBToHSV().R;
+}
+
+void UInteractiveObjectManagerSubsystem::FObjectColumns::RemoveAtSwap(int32 Index)
+{
+    OwningSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Colors.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Hues.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Scales.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Types.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Flags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UInteractiveObjectManagerSubsystem::FObjectColumns::Empty()
+{
+    OwningSlots.Empty();
+    Colors.Empty();
+    Hues.Empty();
+    Scales.Empty();
+    Types.Empty();
+    Flags.Empty();
+}
+
+SIZE_T UInteractiveObjectManagerSubsystem::FObjectColumns::GetAllocatedSize() const
+{
+    return OwningSlots.GetAllocatedSize()
+        + Colors.GetAllocatedSize()
+        + Hues.GetAllocatedSize()
+        + Scales.GetAllocatedSize()
+        + Types.GetAllocatedSize()
+        + Flags.GetAllocatedSize();
+}
+
+SIZE_T UInteractiveObjectManagerSubsystem::GetRegistryAllocatedSize() const
+{
+    SIZE_T TotalBytes = RegisteredObjects.GetAllocatedSize()
+        + ObjectColumns.GetAllocatedSize()
+        + Slots.GetAllocatedSize()
+        + FreeSlotIndices.GetAllocatedSize()
+        + SelectionBits.GetAllocatedSize()
+        + ObjectIdToSlot.GetAllocatedSize()
+        + ComponentToSlot.GetAllocatedSize()
+        + SpatialIndex.GetAllocatedSize();
+
+    for (const FObjectSortIndex& SortIndex : SortIndices)
+    {
+        TotalBytes += SortIndex.SortedSlots.GetAllocatedSize();
+    }
+
+    return TotalBytes;
+}
+
+void UInteractiveObjectManagerSubsystem::UpdateSpatialEntry(int32 DenseIndex)
+{
+    const FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+
+    FVector BoundsOrigin;
+    FVector BoundsExtent;
+
+    if (Record.InstanceIndex != INDEX_NONE)
+    {
+        UClass* ObjectClass = nullptr;
+        FTransform InstanceTransform;
+        if (!GetObjectClassAndTransform(DenseIndex, ObjectClass, InstanceTransform))
+        {
+            return;
+        }
+
+        const FBoxSphereBounds InstanceBounds = InstanceBatches[Record.InstanceBatchIndex].MeshBounds.TransformBy(InstanceTransform);
+        BoundsOrigin = InstanceBounds.Origin;
+        BoundsExtent = InstanceBounds.BoxExtent;
+    }
+    else
+    {
+        const UInteractiveObjectComponent* InteractiveComponent = Record.Component.Get();
+        const AActor* OwnerActor = (InteractiveComponent != nullptr) ? InteractiveComponent->GetOwner() : nullptr;
+        if (OwnerActor == nullptr)
+        {
+            return;
+        }
+
+        OwnerActor->GetActorBounds(false, BoundsOrigin, BoundsExtent);
+    }
+
+    SpatialIndex.Update(ObjectColumns.OwningSlots[DenseIndex], BoundsOrigin, BoundsExtent);
+}
+
+void UInteractiveObjectManagerSubsystem::PublishSnapshotIfDirty()
+{
+    if (!bIsSnapshotDirty || !CVarSnapshotEnabled.GetValueOnGameThread())
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_IOM_PublishSnapshot);
+
+    bIsSnapshotDirty = false;
+
+    const int32 NumObjects = RegisteredObjects.Num();
+    FInteractiveObjectSnapshotPublisher::FWritableSnapshotRef Snapshot = SnapshotPublisher.AllocateForWrite(NumObjects);
+
+    Snapshot->Colors.Append(ObjectColumns.Colors);
+    Snapshot->Scales.Append(ObjectColumns.Scales);
+    Snapshot->Types.Append(ObjectColumns.Types);
+
+    for (int32 DenseIndex = 0; DenseIndex < NumObjects; ++DenseIndex)
+    {
+        const int32 SlotIndex = ObjectColumns.OwningSlots[DenseIndex];
+
+        FVector BoundsCenter = FVector::ZeroVector;
+        FVector BoundsExtent = FVector::ZeroVector;
+        SpatialIndex.GetEntry(SlotIndex, BoundsCenter, BoundsExtent);
+
+        Snapshot->ObjectIds.Add(RegisteredObjects[DenseIndex].ObjectId);
+        Snapshot->Handles.Add(MakeHandleForSlot(SlotIndex));
+        Snapshot->Locations.Add(BoundsCenter);
+    }
+
+    SET_MEMORY_STAT(STAT_IOM_SnapshotMemory, Snapshot->GetAllocatedSize());
+
+    SnapshotPublisher.Publish(Snapshot);
+}
+
+void UInteractiveObjectManagerSubsystem::AppendHandlesForSlots(const TArray<int32>& SlotIndices, TArray<FInteractiveObjectHandle>& OutHandles) const
+{
+    OutHandles.Reserve(OutHandles.Num() + SlotIndices.Num());
+
+    for (const int32 SlotIndex : SlotIndices)
+    {
+        OutHandles.Add(MakeHandleForSlot(SlotIndex));
+    }
+}
+
+bool UInteractiveObjectManagerSubsystem::IsSlotOrderedBefore(EInteractiveObjectSortKey SortKey, int32 SlotA, int32 SlotB) const
+{
+    const int32 DenseIndexA = Slots[SlotA].DenseIndex;
+    const int32 DenseIndexB = Slots[SlotB].DenseIndex;
+    const int32 ObjectIdA = RegisteredObjects[DenseIndexA].ObjectId;
+    const int32 ObjectIdB = RegisteredObjects[DenseIndexB].ObjectId;
+
+    switch (SortKey)
+    {
+    case EInteractiveObjectSortKey::Name:
+    {
+        // FName comparison is lexical and case insensitive, without building strings.
+        const FInteractiveObjectRecord& RecordA = RegisteredObjects[DenseIndexA];
+        const FInteractiveObjectRecord& RecordB = RegisteredObjects[DenseIndexB];
+        const int32 NameOrder = RecordA.DisplayName.Compare(RecordB.DisplayName);
+        if (NameOrder != 0)
+        {
+            return NameOrder < 0;
+        }
+
+        // Names differing only in case share an FName, their texts keep the spelling apart.
+        const int32 SpellingOrder = RecordA.DisplayText.ToString().Compare(RecordB.DisplayText.ToString(), ESearchCase::CaseSensitive);
+        if (SpellingOrder != 0)
+        {
+            return SpellingOrder < 0;
+        }
+        break;
+    }
+    case EInteractiveObjectSortKey::Type:
+        if (ObjectColumns.Types[DenseIndexA] != ObjectColumns.Types[DenseIndexB])
+        {
+            return ObjectColumns.Types[DenseIndexA] < ObjectColumns.Types[DenseIndexB];
+        }
+        break;
+    case EInteractiveObjectSortKey::ColorHue:
+    {
+        const float HueA = ObjectColumns.Hues[DenseIndexA];
+        const float HueB = ObjectColumns.Hues[DenseIndexB];
+        if (HueA != HueB)
+        {
+            return HueA < HueB;
+        }
+        break;
+    }
+    case EInteractiveObjectSortKey::Scale:
+        if (ObjectColumns.Scales[DenseIndexA] != ObjectColumns.Scales[DenseIndexB])
+        {
+            return ObjectColumns.Scales[DenseIndexA] < ObjectColumns.Scales[DenseIndexB];
+        }
+        break;
+    default:
+        break;
+    }
+
+    return ObjectIdA < ObjectIdB;
+}
+
+void UInteractiveObjectManagerSubsystem::RebuildSortIndex(EInteractiveObjectSortKey SortKey)
+{
+    SCOPE_CYCLE_COUNTER(STAT_IOM_RebuildSortIndex);
+
+    FObjectSortIndex& SortIndex = SortIndices[static_cast<int32>(SortKey)];
+
+    SortIndex.SortedSlots = ObjectColumns.OwningSlots;
+    SortIndex.SortedSlots.Sort([this, SortKey](int32 SlotA, int32 SlotB)
+    {
+        return IsSlotOrderedBefore(SortKey, SlotA, SlotB);
+    });
+
+    SortIndex.bIsBuilt = true;
+    SortIndex.UpdatesSinceLastFetch = 0;
+}
+
+void UInteractiveObjectManagerSubsystem::InsertIntoSortIndices(int32 SlotIndex)
+{
+    for (int32 SortKeyIndex = 0; SortKeyIndex < NumSortKeys; ++SortKeyIndex)
+    {
+        EndSortKeyChange(static_cast<EInteractiveObjectSortKey>(SortKeyIndex), SlotIndex);
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::RemoveFromSortIndices(int32 SlotIndex)
+{
+    for (int32 SortKeyIndex = 0; SortKeyIndex < NumSortKeys; ++SortKeyIndex)
+    {
+        FObjectSortIndex& SortIndex = SortIndices[SortKeyIndex];
+
+        BeginSortKeyChange(static_cast<EInteractiveObjectSortKey>(SortKeyIndex), SlotIndex);
+        if (SortIndex.bIsBuilt)
+        {
+            CountSortIndexUpdate(SortIndex);
+        }
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::BeginSortKeyChange(EInteractiveObjectSortKey SortKey, int32 SlotIndex)
+{
+    FObjectSortIndex& SortIndex = SortIndices[static_cast<int32>(SortKey)];
+    if (!SortIndex.bIsBuilt)
+    {
+        return;
+    }
+
+    // The key has not changed yet, so the slot sits exactly at its lower bound.
+    const int32 Position = Algo::LowerBound(SortIndex.SortedSlots, SlotIndex, [this, SortKey](int32 SlotA, int32 SlotB)
+    {
+        return IsSlotOrderedBefore(SortKey, SlotA, SlotB);
+    });
+
+    if (SortIndex.SortedSlots.IsValidIndex(Position) && SortIndex.SortedSlots[Position] == SlotIndex)
+    {
+        SortIndex.SortedSlots.RemoveAt(Position, 1, EAllowShrinking::No);
+    }
+    else
+    {
+        SortIndex.SortedSlots.Remove(SlotIndex);
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::EndSortKeyChange(EInteractiveObjectSortKey SortKey, int32 SlotIndex)
+{
+    FObjectSortIndex& SortIndex = SortIndices[static_cast<int32>(SortKey)];
+    if (!SortIndex.bIsBuilt)
+    {
+        return;
+    }
+
+    const int32 Position = Algo::LowerBound(SortIndex.SortedSlots, SlotIndex, [this, SortKey](int32 SlotA, int32 SlotB)
+    {
+        return IsSlotOrderedBefore(SortKey, SlotA, SlotB);
+    });
+
+    SortIndex.SortedSlots.Insert(SlotIndex, Position);
+    CountSortIndexUpdate(SortIndex);
+}
+
+void UInteractiveObjectManagerSubsystem::PrepareSortIndexForBulkChange(EInteractiveObjectSortKey SortKey, int32 ChangeCount)
+{
+    FObjectSortIndex& SortIndex = SortIndices[static_cast<int32>(SortKey)];
+    if (SortIndex.bIsBuilt && SortIndex.UpdatesSinceLastFetch + ChangeCount > CVarSortIndexRebuildThreshold.GetValueOnGameThread())
+    {
+        SortIndex.SortedSlots.Empty();
+        SortIndex.bIsBuilt = false;
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::CountSortIndexUpdate(FObjectSortIndex& SortIndex)
+{
+    // Each update shifts part of the array. Past the threshold one sort on the next fetch is cheaper.
+    ++SortIndex.UpdatesSinceLastFetch;
+    if (SortIndex.UpdatesSinceLastFetch > CVarSortIndexRebuildThreshold.GetValueOnGameThread())
+    {
+        SortIndex.SortedSlots.Empty();
+        SortIndex.bIsBuilt = false;
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::ResetSortIndices()
+{
+    for (FObjectSortIndex& SortIndex : SortIndices)
+    {
+        SortIndex.SortedSlots.Empty();
+        SortIndex.bIsBuilt = false;
+        SortIndex.UpdatesSinceLastFetch = 0;
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::UpdateRegistryStats() const
+{
+    SET_DWORD_STAT(STAT_IOM_RegisteredObjects, RegisteredObjects.Num());
+    SET_MEMORY_STAT(STAT_IOM_RegistryMemory, GetRegistryAllocatedSize());
+}
+
+EInteractiveObjectPrimitiveType UInteractiveObjectManagerSubsystem::ResolvePrimitiveType(const UClass* ObjectClass) const
+{
+    if (ObjectClass != nullptr)
+    {
+        if (LoadedCubeClass != nullptr && ObjectClass->IsChildOf(LoadedCubeClass))
+        {
+            return EInteractiveObjectPrimitiveType::Cube;
+        }
+
+        if (LoadedSphereClass != nullptr && ObjectClass->IsChildOf(LoadedSphereClass))
+        {
+            return EInteractiveObjectPrimitiveType::Sphere;
+        }
+    }
+
+    return EInteractiveObjectPrimitiveType::Other;
+}
+
+void UInteractiveObjectManagerSubsystem::SetSlotSelected(int32 SlotIndex, bool bSelected)
+{
+    FBitReference SelectionBit = SelectionBits[SlotIndex];
+    if (SelectionBit == bSelected)
+    {
+        return;
+    }
+
+    SelectionBit = bSelected;
+    SelectedObjectCount += bSelected ? 1 : -1;
+}
+
+void UInteractiveObjectManagerSubsystem::ResetSelectionSet()
+{
+    // A single selected object is always the primary one, clear its bit instead of the whole set.
+    if (SelectedObjectCount == 1 && SelectedHandle.IsSet())
+    {
+        SetSlotSelected(SelectedHandle.SlotIndex, false);
+    }
+    else if (SelectedObjectCount > 0)
+    {
+        SelectionBits.SetRange(0, SelectionBits.Num(), false);
+        SelectedObjectCount = 0;
+    }
+
+    SelectedHandle.Reset();
+}
+
+void UInteractiveObjectManagerSubsystem::PromotePrimarySelection()
+{
+    const int32 FirstSelectedSlot = SelectionBits.Find(true);
+    if (FirstSelectedSlot == INDEX_NONE)
+    {
+        SelectedHandle.Reset();
+        return;
+    }
+
+    SelectedHandle = MakeHandleForSlot(FirstSelectedSlot);
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::GetHandleAtDenseIndex(int32 DenseIndex) const
+{
+    return MakeHandleForSlot(ObjectColumns.OwningSlots[DenseIndex]);
+}
+
+FInteractiveObjectHandle UInteractiveObjectManagerSubsystem::MakeHandleForSlot(int32 SlotIndex) const
+{
+    FInteractiveObjectHandle Handle;
+    Handle.SlotIndex = SlotIndex;
+    Handle.Generation = Slots[SlotIndex].Generation;
+    return Handle;
+}
+
+int32 UInteractiveObjectManagerSubsystem::GetSelectedObjectId() const
+{
+    const FInteractiveObjectRecord* Record = FindRecordByHandle(SelectedHandle);
+    return (Record != nullptr) ? Record->ObjectId : INDEX_NONE;
+}
+
+void UInteractiveObjectManagerSubsystem::InvalidateSelectionIfNoLongerValid()
+{
+    if (!SelectedHandle.IsSet())
+    {
+        return;
+    }
+
+    const FInteractiveObjectRecord* Record = FindRecordByHandle(SelectedHandle);
+    if (Record == nullptr || !Record->IsValid())
+    {
+        SelectedHandle.Reset();
+        MarkSelectionDirty();
+    }
+}
+
+void UInteractiveObjectManagerSubsystem::MarkObjectAdded(int32 ObjectId)
+{
+    bIsSnapshotDirty = true;
+
+    PendingAddedIds.Add(ObjectId);
+    bIsObjectsListDirty = true;
+}
+
+void UInteractiveObjectManagerSubsystem::MarkObjectRemoved(int32 ObjectId)
+{
+    bIsSnapshotDirty = true;
+
+    PendingChangedIds.Remove(ObjectId);
+
+    // Listeners never saw an object that is added and removed within one flush.
+    if (PendingAddedIds.Remove(ObjectId) == 0)
+    {
+        PendingRemovedIds.Add(ObjectId);
+    }
+
+    bIsObjectsListDirty = true;
+}
+
+void UInteractiveObjectManagerSubsystem::MarkObjectChanged(int32 ObjectId)
+{
+    bIsSnapshotDirty = true;
+
+    // Added items already carry their latest state.
+    if (PendingAddedIds.Contains(ObjectId))
+    {
+        return;
+    }
+
+    PendingChangedIds.Add(ObjectId);
+    bIsObjectsListDirty = true;
+}
+
+void UInteractiveObjectManagerSubsystem::FillListItem(int32 DenseIndex, FInteractiveObjectListItem& OutItem) const
+{
+    const FInteractiveObjectRecord& Record = RegisteredObjects[DenseIndex];
+
+    OutItem.Id = Record.ObjectId;
+    OutItem.Handle = GetHandleAtDenseIndex(DenseIndex);
+    OutItem.DisplayNameText = Record.IsValid() ? Record.DisplayText : GetUnknownDisplayText();
+}
+
+void UInteractiveObjectManagerSubsystem::MarkSelectionDirty()
+{
+    bIsSelectionDirty = true;
+}
+
+void UInteractiveObjectManagerSubsystem::BroadcastObjectsListChanged()
+{
+    TArray<FInteractiveObjectListItem> Items;
+    GetInteractiveObjectsList(Items);
+
+    OnObjectsListChanged.Broadcast(Items);
+}
+
+void UInteractiveObjectManagerSubsystem::BroadcastObjectsListDelta()
+{
+    FInteractiveObjectsListDelta Delta;
+    Delta.ListVersion = ++ObjectsListVersion;
+
+    // Keep added rows in registration order regardless of set iteration order.
+    TArray<int32> AddedIds = PendingAddedIds.Array();
+    AddedIds.Sort();
+
+    Delta.AddedItems.Reserve(AddedIds.Num());
+    for (const int32 AddedId : AddedIds)
+    {
+        FInteractiveObjectListItem ListItem;
+        if (GetObjectListItem(AddedId, ListItem))
+        {
+            Delta.AddedItems.Add(ListItem);
+        }
+    }
+
+    Delta.RemovedIds = PendingRemovedIds.Array();
+    Delta.ChangedIds = PendingChangedIds.Array();
+
+    PendingAddedIds.Reset();
+    PendingRemovedIds.Reset();
+    PendingChangedIds.Reset();
+
+    OnObjectsListDelta.Broadcast(Delta);
+}
+
+void UInteractiveObjectManagerSubsystem::BroadcastSelectedObjectChanged()
+{
+    OnSelectedObjectChanged.Broadcast(GetSelectedObjectId());
+    OnSelectionChanged.Broadcast(SelectedObjectCount);
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * How much the time per operation may grow from 1000 to 100000 objects. Cache misses on the larger registry
+ * account for a few times, a cost linear in the registry size for a hundred.
+ */
+static const double RegistryBenchmarkMaxCostGrowth = 8.0;
+
+/** Times below this are dominated by timer resolution, so growth is measured from here at least. */
+static const double RegistryBenchmarkMinBaseCostNs = 25.0;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FInteractiveObjectRegistryBenchmarkTest,
+    "InteractiveObjectManager.Registry.Benchmark",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FInteractiveObjectRegistryBenchmarkTest::RunTest(const FString& Parameters)
+{
+    const TArray<UInteractiveObjectManagerSubsystem::FRegistryBenchmarkResult> Results = UInteractiveObjectManagerSubsystem::RunRegistryBenchmark(100000, 100000);
+    if (!TestEqual(TEXT("Measured registry sizes"), Results.Num(), 3))
+    {
+        return false;
+    }
+
+    const UInteractiveObjectManagerSubsystem::FRegistryBenchmarkResult& Baseline = Results[0];
+    bool bHasPassed = true;
+
+    auto TestCostGrowth = [this, &bHasPassed](const TCHAR* OperationName, int32 NumObjects, double BaselineNs, double MeasuredNs)
+    {
+        const double AllowedNs = FMath::Max(BaselineNs, RegistryBenchmarkMinBaseCostNs) * RegistryBenchmarkMaxCostGrowth;
+        bHasPassed &= TestTrue(
+            FString::Printf(TEXT("%s at %d objects takes %.1f ns, at most %.1f ns"), OperationName, NumObjects, MeasuredNs, AllowedNs),
+            MeasuredNs <= AllowedNs
+        );
+    };
+
+    for (int32 ResultIndex = 1; ResultIndex < Results.Num(); ++ResultIndex)
+    {
+        const UInteractiveObjectManagerSubsystem::FRegistryBenchmarkResult& Result = Results[ResultIndex];
+        TestCostGrowth(TEXT("Register"), Result.NumObjects, Baseline.RegisterNs, Result.RegisterNs);
+        TestCostGrowth(TEXT("Select"), Result.NumObjects, Baseline.SelectNs, Result.SelectNs);
+        TestCostGrowth(TEXT("Unregister"), Result.NumObjects, Baseline.UnregisterNs, Result.UnregisterNs);
+    }
+
+    return bHasPassed;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,21 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "UI/InteractiveObjectListEntryWidget.h"
+
+void UInteractiveObjectListEntryWidget::RefreshFromListItem()
+{
+    const UInteractiveObjectListItemObject* ItemObject = GetListItem<UInteractiveObjectListItemObject>();
+    if (ItemObject == nullptr)
+    {
+        return;
+    }
+
+    OnObjectListItemSet(ItemObject->Item, ItemObject->OwningRoot);
+}
+
+void UInteractiveObjectListEntryWidget::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+    IUserObjectListEntry::NativeOnListItemObjectSet(ListItemObject);
+
+    RefreshFromListItem();
+}
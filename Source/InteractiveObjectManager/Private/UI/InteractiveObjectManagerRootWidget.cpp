@@ -1,377 +1,637 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#include "UI/InteractiveObjectManagerRootWidget.h"
-
-#include "InteractiveObjectManagerLog.h"
-#include "Settings/InteractiveObjectSettings.h"
-#include "Subsystems/InteractiveObjectManagerSubsystem.h"
-
-#include "Engine/World.h"
-
-UInteractiveObjectManagerRootWidget::UInteractiveObjectManagerRootWidget()
-{
-}
-
-void UInteractiveObjectManagerRootWidget::RequestSpawnDefaultObject()
-{
-    if (!ManagerSubsystem.IsValid())
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget::RequestSpawnDefaultObject called but manager subsystem is not valid.")
-        );
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
-    if (Subsystem == nullptr)
-    {
-        return;
-    }
-
-    Subsystem->SpawnDefaultObject();
-}
-
-void UInteractiveObjectManagerRootWidget::RequestSpawnObjectOfType(EInteractiveObjectSpawnType SpawnType)
-{
-    if (!ManagerSubsystem.IsValid())
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget::RequestSpawnObjectOfType called but manager subsystem is not valid.")
-        );
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
-    if (Subsystem == nullptr)
-    {
-        return;
-    }
-
-    Subsystem->SpawnObjectOfType(SpawnType);
-}
-
-void UInteractiveObjectManagerRootWidget::NativeConstruct()
-{
-    Super::NativeConstruct();
-
-    UWorld* World = GetWorld();
-    if (World == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget: NativeConstruct called but World is null.")
-        );
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* Subsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>();
-    if (Subsystem == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget: Could not find UInteractiveObjectManagerSubsystem in this World.")
-        );
-        return;
-    }
-
-    ManagerSubsystem = Subsystem;
-
-    Subsystem->OnObjectsListChanged.AddDynamic(
-        this,
-        &UInteractiveObjectManagerRootWidget::HandleObjectsListChanged
-    );
-
-    Subsystem->OnSelectedObjectChanged.AddDynamic(
-        this,
-        &UInteractiveObjectManagerRootWidget::HandleSelectedObjectChanged
-    );
-
-    UE_LOG(
-        LogInteractiveObjectManager,
-        Log,
-        TEXT("InteractiveObjectManagerRootWidget: Connected to manager subsystem in NativeConstruct and subscribed to delegates.")
-    );
-
-    SynchronizeInitialState();
-}
-
-void UInteractiveObjectManagerRootWidget::NativeDestruct()
-{
-    if (ManagerSubsystem.IsValid())
-    {
-        UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
-        if (Subsystem != nullptr)
-        {
-            Subsystem->OnObjectsListChanged.RemoveDynamic(
-                this,
-                &UInteractiveObjectManagerRootWidget::HandleObjectsListChanged
-            );
-
-            Subsystem->OnSelectedObjectChanged.RemoveDynamic(
-                this,
-                &UInteractiveObjectManagerRootWidget::HandleSelectedObjectChanged
-            );
-
-            UE_LOG(
-                LogInteractiveObjectManager,
-                Log,
-                TEXT("InteractiveObjectManagerRootWidget: Unsubscribed from manager subsystem in NativeDestruct.")
-            );
-        }
-    }
-
-    ManagerSubsystem.Reset();
-
-    Super::NativeDestruct();
-}
-
-void UInteractiveObjectManagerRootWidget::RequestSelectObjectById(int32 ObjectId)
-{
-    if (!ManagerSubsystem.IsValid())
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget::RequestSelectObjectById called but manager subsystem is not valid.")
-        );
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
-    if (Subsystem == nullptr)
-    {
-        return;
-    }
-
-    const bool bSelectionChanged = Subsystem->SelectObjectById(ObjectId);
-    if (!bSelectionChanged)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Log,
-            TEXT("InteractiveObjectManagerRootWidget::RequestSelectObjectById did not change selection for Id %d."),
-            ObjectId
-        );
-    }
-}
-
-void UInteractiveObjectManagerRootWidget::HandleObjectsListChanged(const TArray<FInteractiveObjectListItem>& Objects)
-{
-    OnObjectsListUpdated(Objects);
-}
-
-void UInteractiveObjectManagerRootWidget::HandleSelectedObjectChanged(int32 SelectedObjectId)
-{
-    if (!ManagerSubsystem.IsValid())
-    {
-        const FText NoneText = FText::FromString(TEXT("None"));
-        OnSelectedObjectInfoUpdated(false, INDEX_NONE, NoneText);
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
-    if (Subsystem == nullptr)
-    {
-        const FText NoneText = FText::FromString(TEXT("None"));
-        OnSelectedObjectInfoUpdated(false, INDEX_NONE, NoneText);
-        return;
-    }
-
-    bool bHasSelection = false;
-    const FInteractiveObjectListItem SelectedItem = Subsystem->GetSelectedObjectInfo(bHasSelection);
-
-    if (!bHasSelection)
-    {
-        const FText NoneText = FText::FromString(TEXT("None"));
-        OnSelectedObjectInfoUpdated(false, INDEX_NONE, NoneText);
-    }
-    else
-    {
-        const FText DisplayNameText = FText::FromString(SelectedItem.DisplayName);
-        OnSelectedObjectInfoUpdated(true, SelectedItem.Id, DisplayNameText);
-    }
-}
-
-void UInteractiveObjectManagerRootWidget::SynchronizeInitialState()
-{
-    if (!ManagerSubsystem.IsValid())
-    {
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
-    if (Subsystem == nullptr)
-    {
-        return;
-    }
-
-    // Initial list snapshot.
-    TArray<FInteractiveObjectListItem> Items;
-    Subsystem->GetInteractiveObjectsList(Items);
-    OnObjectsListUpdated(Items);
-
-    // Initial selection snapshot.
-    bool bHasSelection = false;
-    const FInteractiveObjectListItem SelectedItem = Subsystem->GetSelectedObjectInfo(bHasSelection);
-
-    if (!bHasSelection)
-    {
-        const FText NoneText = FText::FromString(TEXT("None"));
-        OnSelectedObjectInfoUpdated(false, INDEX_NONE, NoneText);
-    }
-    else
-    {
-        const FText DisplayNameText = FText::FromString(SelectedItem.DisplayName);
-        OnSelectedObjectInfoUpdated(true, SelectedItem.Id, DisplayNameText);
-    }
-}
-
-void UInteractiveObjectManagerRootWidget::RequestApplyColor(const FLinearColor& NewColor)
-{
-    if (!ManagerSubsystem.IsValid())
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget::RequestApplyColor called but manager subsystem is not valid.")
-        );
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
-    if (Subsystem == nullptr)
-    {
-        return;
-    }
-
-    const bool bApplied = Subsystem->SetSelectedObjectColor(NewColor);
-    if (!bApplied)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Log,
-            TEXT("InteractiveObjectManagerRootWidget::RequestApplyColor did not apply color, probably no object is selected.")
-        );
-    }
-}
-
-void UInteractiveObjectManagerRootWidget::RequestApplyScale(float NewUniformScale)
-{
-    if (!ManagerSubsystem.IsValid())
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget::RequestApplyScale called but manager subsystem is not valid.")
-        );
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
-    if (Subsystem == nullptr)
-    {
-        return;
-    }
-
-    const bool bApplied = Subsystem->SetSelectedObjectUniformScale(NewUniformScale);
-    if (!bApplied)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Log,
-            TEXT("InteractiveObjectManagerRootWidget::RequestApplyScale did not apply scale, probably no object is selected.")
-        );
-    }
-}
-
-void UInteractiveObjectManagerRootWidget::RequestDeleteSelectedObject()
-{
-    if (!ManagerSubsystem.IsValid())
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget::RequestDeleteSelectedObject called but manager subsystem is not valid.")
-        );
-        return;
-    }
-
-    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
-    if (Subsystem == nullptr)
-    {
-        return;
-    }
-
-    const bool bDeleted = Subsystem->DeleteSelectedObject();
-    if (!bDeleted)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Log,
-            TEXT("InteractiveObjectManagerRootWidget::RequestDeleteSelectedObject did not delete anything, probably no object is selected.")
-        );
-    }
-}
-
-void UInteractiveObjectManagerRootWidget::GetCurrentSettings(FInteractiveObjectSettingsViewData& OutSettings)
-{
-    UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get();
-    if (Settings == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Error,
-            TEXT("InteractiveObjectManagerRootWidget::GetCurrentSettings: Settings object is null. Using hardcoded defaults.")
-        );
-
-        FInteractiveObjectRuntimeSettings RuntimeDefaults;
-        RuntimeDefaults.ApplySafeDefaults();
-
-        OutSettings.DefaultSpawnType = RuntimeDefaults.DefaultSpawnType;
-        OutSettings.DefaultColor = RuntimeDefaults.DefaultColor;
-        OutSettings.DefaultUniformScale = RuntimeDefaults.DefaultScale.X;
-
-        return;
-    }
-
-    Settings->ToViewData(OutSettings);
-}
-
-void UInteractiveObjectManagerRootWidget::ApplySettingsFromUI(const FInteractiveObjectSettingsViewData& NewSettings)
-{
-    UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get();
-    if (Settings == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget::ApplySettingsFromUI: Settings object is null. Changes will be ignored.")
-        );
-        return;
-    }
-
-    Settings->UpdateFromViewData(NewSettings);
-    Settings->ApplyDefaultsIfInvalid();
-}
-
-void UInteractiveObjectManagerRootWidget::SaveSettingsToIni()
-{
-    UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get();
-    if (Settings == nullptr)
-    {
-        UE_LOG(
-            LogInteractiveObjectManager,
-            Warning,
-            TEXT("InteractiveObjectManagerRootWidget::SaveSettingsToIni: Settings object is null. Nothing will be saved.")
-        );
-        return;
-    }
-
-    Settings->SaveToConfig();
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#include "UI/InteractiveObjectManagerRootWidget.h"
+
+#include "InteractiveObjectManagerLog.h"
+#include "Settings/InteractiveObjectSettings.h"
+#include "Subsystems/InteractiveObjectManagerSubsystem.h"
+#include "UI/InteractiveObjectListEntryWidget.h"
+
+#include "Components/ListView.h"
+#include "Engine/World.h"
+
+UInteractiveObjectManagerRootWidget::UInteractiveObjectManagerRootWidget()
+    : AppliedObjectsListVersion(0)
+    , bUsesIncrementalListUpdates(false)
+{
+}
+
+void UInteractiveObjectManagerRootWidget::RequestSpawnDefaultObject()
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestSpawnDefaultObject called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    Subsystem->SpawnDefaultObject();
+}
+
+void UInteractiveObjectManagerRootWidget::RequestSpawnObjectOfType(EInteractiveObjectSpawnType SpawnType)
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestSpawnObjectOfType called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    Subsystem->SpawnObjectOfType(SpawnType);
+}
+
+void UInteractiveObjectManagerRootWidget::NativeConstruct()
+{
+    Super::NativeConstruct();
+
+    UWorld* World = GetWorld();
+    if (World == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget: NativeConstruct called but World is null.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = World->GetSubsystem<UInteractiveObjectManagerSubsystem>();
+    if (Subsystem == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget: Could not find UInteractiveObjectManagerSubsystem in this World.")
+        );
+        return;
+    }
+
+    ManagerSubsystem = Subsystem;
+
+    // Deliver pending changes to existing listeners first, so that the initial snapshot
+    // taken below matches the current list version exactly.
+    Subsystem->FlushPendingNotifications();
+
+    // A bound list view is patched here. Otherwise the row events are optional,
+    // older Blueprints only implement the full list event.
+    const UClass* WidgetClass = GetClass();
+    bUsesIncrementalListUpdates = ListView_Objects == nullptr &&
+        WidgetClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UInteractiveObjectManagerRootWidget, OnObjectRowsAdded)) &&
+        WidgetClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UInteractiveObjectManagerRootWidget, OnObjectRowsRemoved));
+
+    Subsystem->OnObjectsListDelta.AddDynamic(
+        this,
+        &UInteractiveObjectManagerRootWidget::HandleObjectsListDelta
+    );
+
+    Subsystem->OnSelectedObjectChanged.AddDynamic(
+        this,
+        &UInteractiveObjectManagerRootWidget::HandleSelectedObjectChanged
+    );
+
+    Subsystem->OnSelectionChanged.AddDynamic(
+        this,
+        &UInteractiveObjectManagerRootWidget::HandleSelectionChanged
+    );
+
+    UE_LOG(
+        LogInteractiveObjectManager,
+        Log,
+        TEXT("InteractiveObjectManagerRootWidget: Connected to manager subsystem in NativeConstruct and subscribed to delegates.")
+    );
+
+    SynchronizeInitialState();
+}
+
+void UInteractiveObjectManagerRootWidget::NativeDestruct()
+{
+    if (ManagerSubsystem.IsValid())
+    {
+        UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+        if (Subsystem != nullptr)
+        {
+            Subsystem->OnObjectsListDelta.RemoveDynamic(
+                this,
+                &UInteractiveObjectManagerRootWidget::HandleObjectsListDelta
+            );
+
+            Subsystem->OnSelectedObjectChanged.RemoveDynamic(
+                this,
+                &UInteractiveObjectManagerRootWidget::HandleSelectedObjectChanged
+            );
+
+            Subsystem->OnSelectionChanged.RemoveDynamic(
+                this,
+                &UInteractiveObjectManagerRootWidget::HandleSelectionChanged
+            );
+
+            UE_LOG(
+                LogInteractiveObjectManager,
+                Log,
+                TEXT("InteractiveObjectManagerRootWidget: Unsubscribed from manager subsystem in NativeDestruct.")
+            );
+        }
+    }
+
+    ManagerSubsystem.Reset();
+
+    Super::NativeDestruct();
+}
+
+void UInteractiveObjectManagerRootWidget::RequestSelectObjectById(int32 ObjectId)
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestSelectObjectById called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    const bool bSelectionChanged = Subsystem->SelectObjectById(ObjectId);
+    if (!bSelectionChanged)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectManagerRootWidget::RequestSelectObjectById did not change selection for Id %d."),
+            ObjectId
+        );
+    }
+}
+
+void UInteractiveObjectManagerRootWidget::RequestSelectObject(FInteractiveObjectHandle Handle)
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestSelectObject called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    const bool bSelectionChanged = Subsystem->SelectObject(Handle);
+    if (!bSelectionChanged)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectManagerRootWidget::RequestSelectObject did not change selection for slot %d, generation %d."),
+            Handle.SlotIndex,
+            Handle.Generation
+        );
+    }
+}
+
+void UInteractiveObjectManagerRootWidget::RequestToggleObjectSelection(FInteractiveObjectHandle Handle)
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestToggleObjectSelection called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    Subsystem->ToggleObjectSelection(Handle);
+}
+
+void UInteractiveObjectManagerRootWidget::RequestSelectAllObjects()
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestSelectAllObjects called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    Subsystem->SelectAllObjects();
+}
+
+void UInteractiveObjectManagerRootWidget::RequestClearSelection()
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestClearSelection called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    Subsystem->ClearSelection();
+}
+
+bool UInteractiveObjectManagerRootWidget::IsObjectSelected(FInteractiveObjectHandle Handle) const
+{
+    const UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    return Subsystem != nullptr && Subsystem->IsObjectSelected(Handle);
+}
+
+void UInteractiveObjectManagerRootWidget::HandleObjectsListDelta(const FInteractiveObjectsListDelta& Delta)
+{
+    // A gap in versions means this widget missed a delta, so the rows can no longer be patched.
+    const bool bIsNextVersion = (Delta.ListVersion == AppliedObjectsListVersion + 1);
+    const bool bCanPatchRows = bUsesIncrementalListUpdates || ListView_Objects != nullptr;
+    if (!bCanPatchRows || !bIsNextVersion)
+    {
+        RebuildObjectsList();
+        return;
+    }
+
+    AppliedObjectsListVersion = Delta.ListVersion;
+
+    TArray<FInteractiveObjectListItem> ChangedItems;
+    if (Delta.ChangedIds.Num() > 0 && ManagerSubsystem.IsValid())
+    {
+        UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+
+        ChangedItems.Reserve(Delta.ChangedIds.Num());
+
+        for (const int32 ChangedId : Delta.ChangedIds)
+        {
+            FInteractiveObjectListItem ChangedItem;
+            if (Subsystem->GetObjectListItem(ChangedId, ChangedItem))
+            {
+                ChangedItems.Add(ChangedItem);
+            }
+        }
+    }
+
+    if (bUsesIncrementalListUpdates)
+    {
+        if (Delta.RemovedIds.Num() > 0)
+        {
+            OnObjectRowsRemoved(Delta.RemovedIds);
+        }
+
+        if (Delta.AddedItems.Num() > 0)
+        {
+            OnObjectRowsAdded(Delta.AddedItems);
+        }
+
+        if (ChangedItems.Num() > 0)
+        {
+            OnObjectRowsChanged(ChangedItems);
+        }
+
+        return;
+    }
+
+    for (const int32 RemovedId : Delta.RemovedIds)
+    {
+        TObjectPtr<UInteractiveObjectListItemObject> RemovedItemObject;
+        if (ObjectListItems.RemoveAndCopyValue(RemovedId, RemovedItemObject))
+        {
+            ListView_Objects->RemoveItem(RemovedItemObject);
+        }
+    }
+
+    for (const FInteractiveObjectListItem& AddedItem : Delta.AddedItems)
+    {
+        ListView_Objects->AddItem(CreateObjectListItem(AddedItem));
+    }
+
+    // Only items scrolled into view have an entry to refresh, the others pick the data up once they get one.
+    for (const FInteractiveObjectListItem& ChangedItem : ChangedItems)
+    {
+        const TObjectPtr<UInteractiveObjectListItemObject>* FoundItemObject = ObjectListItems.Find(ChangedItem.Id);
+        UInteractiveObjectListItemObject* ItemObject = (FoundItemObject != nullptr) ? FoundItemObject->Get() : nullptr;
+        if (ItemObject == nullptr)
+        {
+            continue;
+        }
+
+        ItemObject->Item = ChangedItem;
+
+        if (UInteractiveObjectListEntryWidget* EntryWidget = ListView_Objects->GetEntryWidgetFromItem<UInteractiveObjectListEntryWidget>(ItemObject))
+        {
+            EntryWidget->RefreshFromListItem();
+        }
+    }
+}
+
+void UInteractiveObjectManagerRootWidget::RebuildObjectsList()
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    TArray<FInteractiveObjectListItem> Items;
+    Subsystem->GetInteractiveObjectsList(Items);
+    AppliedObjectsListVersion = Subsystem->GetObjectsListVersion();
+
+    if (ListView_Objects == nullptr)
+    {
+        OnObjectsListUpdated(Items);
+        return;
+    }
+
+    ObjectListItems.Reset();
+    ObjectListItems.Reserve(Items.Num());
+
+    TArray<UInteractiveObjectListItemObject*> ItemObjects;
+    ItemObjects.Reserve(Items.Num());
+
+    for (const FInteractiveObjectListItem& Item : Items)
+    {
+        ItemObjects.Add(CreateObjectListItem(Item));
+    }
+
+    ListView_Objects->SetListItems(ItemObjects);
+}
+
+UInteractiveObjectListItemObject* UInteractiveObjectManagerRootWidget::CreateObjectListItem(const FInteractiveObjectListItem& Item)
+{
+    UInteractiveObjectListItemObject* ItemObject = NewObject<UInteractiveObjectListItemObject>(this);
+    ItemObject->Item = Item;
+    ItemObject->OwningRoot = this;
+
+    ObjectListItems.Add(Item.Id, ItemObject);
+    return ItemObject;
+}
+
+void UInteractiveObjectManagerRootWidget::HandleSelectedObjectChanged(int32 SelectedObjectId)
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        const FText NoneText = FText::FromString(TEXT("None"));
+        OnSelectedObjectInfoUpdated(false, INDEX_NONE, NoneText);
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        const FText NoneText = FText::FromString(TEXT("None"));
+        OnSelectedObjectInfoUpdated(false, INDEX_NONE, NoneText);
+        return;
+    }
+
+    bool bHasSelection = false;
+    const FInteractiveObjectListItem SelectedItem = Subsystem->GetSelectedObjectInfo(bHasSelection);
+
+    if (!bHasSelection)
+    {
+        const FText NoneText = FText::FromString(TEXT("None"));
+        OnSelectedObjectInfoUpdated(false, INDEX_NONE, NoneText);
+    }
+    else
+    {
+        OnSelectedObjectInfoUpdated(true, SelectedItem.Id, SelectedItem.DisplayNameText);
+    }
+}
+
+void UInteractiveObjectManagerRootWidget::HandleSelectionChanged(int32 SelectedCount)
+{
+    OnSelectionSetUpdated(SelectedCount);
+}
+
+void UInteractiveObjectManagerRootWidget::SynchronizeInitialState()
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    // Initial list snapshot. Later changes arrive as deltas on top of this version.
+    RebuildObjectsList();
+
+    // Initial selection snapshot.
+    bool bHasSelection = false;
+    const FInteractiveObjectListItem SelectedItem = Subsystem->GetSelectedObjectInfo(bHasSelection);
+
+    if (!bHasSelection)
+    {
+        const FText NoneText = FText::FromString(TEXT("None"));
+        OnSelectedObjectInfoUpdated(false, INDEX_NONE, NoneText);
+    }
+    else
+    {
+        OnSelectedObjectInfoUpdated(true, SelectedItem.Id, SelectedItem.DisplayNameText);
+    }
+
+    OnSelectionSetUpdated(Subsystem->GetSelectedObjectCount());
+}
+
+void UInteractiveObjectManagerRootWidget::RequestApplyColor(const FLinearColor& NewColor)
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestApplyColor called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    const int32 AppliedCount = Subsystem->SetSelectedObjectsColor(NewColor);
+    if (AppliedCount == 0)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectManagerRootWidget::RequestApplyColor did not apply color, probably no object is selected.")
+        );
+    }
+}
+
+void UInteractiveObjectManagerRootWidget::RequestApplyScale(float NewUniformScale)
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestApplyScale called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    const int32 AppliedCount = Subsystem->SetSelectedObjectsUniformScale(NewUniformScale);
+    if (AppliedCount == 0)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectManagerRootWidget::RequestApplyScale did not apply scale, probably no object is selected.")
+        );
+    }
+}
+
+void UInteractiveObjectManagerRootWidget::RequestDeleteSelectedObject()
+{
+    if (!ManagerSubsystem.IsValid())
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::RequestDeleteSelectedObject called but manager subsystem is not valid.")
+        );
+        return;
+    }
+
+    UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get();
+    if (Subsystem == nullptr)
+    {
+        return;
+    }
+
+    const int32 DeletedCount = Subsystem->DeleteSelectedObjects();
+    if (DeletedCount == 0)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Log,
+            TEXT("InteractiveObjectManagerRootWidget::RequestDeleteSelectedObject did not delete anything, probably no object is selected.")
+        );
+    }
+}
+
+void UInteractiveObjectManagerRootWidget::GetCurrentSettings(FInteractiveObjectSettingsViewData& OutSettings)
+{
+    UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get();
+    if (Settings == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Error,
+            TEXT("InteractiveObjectManagerRootWidget::GetCurrentSettings: Settings object is null. Using hardcoded defaults.")
+        );
+
+        FInteractiveObjectRuntimeSettings RuntimeDefaults;
+        RuntimeDefaults.ApplySafeDefaults();
+
+        OutSettings.DefaultSpawnType = RuntimeDefaults.DefaultSpawnType;
+        OutSettings.DefaultColor = RuntimeDefaults.DefaultColor;
+        OutSettings.DefaultUniformScale = RuntimeDefaults.DefaultScale.X;
+
+        return;
+    }
+
+    Settings->ToViewData(OutSettings);
+}
+
+void UInteractiveObjectManagerRootWidget::ApplySettingsFromUI(const FInteractiveObjectSettingsViewData& NewSettings)
+{
+    // The subsystem applies them the same way and records the change in a session trace.
+    if (UInteractiveObjectManagerSubsystem* Subsystem = ManagerSubsystem.Get())
+    {
+        Subsystem->ApplySettings(NewSettings);
+        return;
+    }
+
+    UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get();
+    if (Settings == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::ApplySettingsFromUI: Settings object is null. Changes will be ignored.")
+        );
+        return;
+    }
+
+    Settings->UpdateFromViewData(NewSettings);
+    Settings->ApplyDefaultsIfInvalid();
+}
+
+void UInteractiveObjectManagerRootWidget::SaveSettingsToIni()
+{
+    UInteractiveObjectSettings* Settings = UInteractiveObjectSettings::Get();
+    if (Settings == nullptr)
+    {
+        UE_LOG(
+            LogInteractiveObjectManager,
+            Warning,
+            TEXT("InteractiveObjectManagerRootWidget::SaveSettingsToIni: Settings object is null. Nothing will be saved.")
+        );
+        return;
+    }
+
+    Settings->SaveToConfig();
 }
\ No newline at end of file
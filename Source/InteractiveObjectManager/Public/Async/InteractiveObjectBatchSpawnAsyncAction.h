@@ -0,0 +1,67 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "InteractiveObjectManagerTypes.h"
+#include "InteractiveObjectBatchSpawnAsyncAction.generated.h"
+
+class UInteractiveObjectManagerSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FInteractiveObjectBatchSpawnAsyncPin, int32, SpawnedCount, int32, RequestedCount);
+
+/**
+ * Latent Blueprint node that spawns many interactive objects under a per frame time budget.
+ *
+ * Thin wrapper over UInteractiveObjectManagerSubsystem::SpawnObjectsBatch.
+ * OnProgress fires at most once per frame, OnCompleted fires once when the batch
+ * finished or was cancelled.
+ */
+UCLASS()
+class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectBatchSpawnAsyncAction : public UBlueprintAsyncActionBase
+{
+    GENERATED_BODY()
+
+public:
+    /** Spawns Count objects of SpawnType over several frames. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"))
+    static UInteractiveObjectBatchSpawnAsyncAction* SpawnObjectsBatchAsync(
+        UObject* WorldContextObject,
+        int32 Count,
+        EInteractiveObjectSpawnType SpawnType,
+        const FInteractiveObjectBatchSpawnParams& Params
+    );
+
+    // UBlueprintAsyncActionBase interface
+    virtual void Activate() override;
+
+    /** Fired at most once per frame while the batch is in progress. */
+    UPROPERTY(BlueprintAssignable)
+    FInteractiveObjectBatchSpawnAsyncPin OnProgress;
+
+    /** Fired once when the batch finished or was cancelled. */
+    UPROPERTY(BlueprintAssignable)
+    FInteractiveObjectBatchSpawnAsyncPin OnCompleted;
+
+private:
+    /** Subsystem that owns the batch. */
+    TWeakObjectPtr<UInteractiveObjectManagerSubsystem> ManagerSubsystem;
+
+    /** Spawn request captured by the factory function. */
+    int32 RequestedCount = 0;
+    EInteractiveObjectSpawnType RequestedSpawnType = EInteractiveObjectSpawnType::Cube;
+    FInteractiveObjectBatchSpawnParams RequestedParams;
+
+    /** Id returned by the subsystem, INDEX_NONE until activated. */
+    int32 BatchId = INDEX_NONE;
+
+    UFUNCTION()
+    void HandleSpawnBatchProgress(int32 InBatchId, int32 SpawnedCount, int32 InRequestedCount);
+
+    UFUNCTION()
+    void HandleSpawnBatchCompleted(int32 InBatchId, int32 SpawnedCount, int32 InRequestedCount);
+
+    /** Fires OnCompleted, unbinds from the subsystem and releases this action. */
+    void Finish(int32 SpawnedCount);
+};
\ No newline at end of file
@@ -0,0 +1,86 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+
+#include <atomic>
+
+class UInteractiveObjectManagerSubsystem;
+
+/**
+ * Multi producer, single consumer queue of deferred subsystem mutations.
+ *
+ * Any thread may enqueue. Only the owning subsystem executes, on the game thread. Enqueue is lock free
+ * (TQueue in Mpsc mode: one atomic exchange per command).
+ *
+ * Ordering guarantees:
+ * - Commands enqueued by one thread execute in the order that thread enqueued them.
+ * - Commands from different threads execute in the order their enqueues took effect. Two enqueues
+ *   racing on different threads have no defined order relative to each other.
+ * - A command that enqueues another command runs before it.
+ * - Every command runs exactly once: executed with the subsystem, or discarded with nullptr when the
+ *   queue is closed or destroyed first.
+ */
+class INTERACTIVEOBJECTMANAGER_API FInteractiveObjectCommandQueue
+{
+public:
+    /** Deferred mutation. Subsystem is nullptr when the command is discarded instead of executed. */
+    typedef TUniqueFunction<void(UInteractiveObjectManagerSubsystem* Subsystem)> FCommand;
+
+    FInteractiveObjectCommandQueue();
+    ~FInteractiveObjectCommandQueue();
+
+    /** Adds a command. Any thread. Runs the command discarded right away if the queue is closed. */
+    void Enqueue(FCommand&& Command);
+
+    /**
+     * Executes queued commands in order. Consumer thread only.
+     * Stops after MaxCommands when positive. Returns the number of commands executed.
+     */
+    int32 Execute(UInteractiveObjectManagerSubsystem* Subsystem, int32 MaxCommands);
+
+    /** Stops accepting commands and discards the queued ones. Consumer thread only. */
+    void Close();
+
+    /** Approximate number of queued commands. Any thread. */
+    int32 GetNumPending() const;
+
+    /** Counters of one RunStressTest run. */
+    struct FStressTestResult
+    {
+        int64 ExpectedCount = 0;
+        int64 ExecutedCount = 0;
+
+        /** Commands that never ran. */
+        int64 LostCount = 0;
+
+        /** Commands that ran more than once. */
+        int64 DuplicatedCount = 0;
+
+        int64 OrderViolations = 0;
+        int64 FutureFailures = 0;
+
+        /** True if every command ran exactly once, in per producer order, and every future resolved. */
+        bool HasPassed() const
+        {
+            return ExecutedCount == ExpectedCount && LostCount == 0 && DuplicatedCount == 0 && OrderViolations == 0 && FutureFailures == 0;
+        }
+    };
+
+    /**
+     * Enqueues CommandsPerProducer commands from each of NumProducers task graph producers while the calling
+     * thread drains, then checks that every command ran once and in per producer order, and that futures
+     * resolved. Logs throughput and violations. Used by the IOM.Commands.StressTest console command
+     * and the InteractiveObjectManager.Commands.StressTest automation test.
+     */
+    static FStressTestResult RunStressTest(int32 NumProducers, int32 CommandsPerProducer);
+
+private:
+    TQueue<FCommand, EQueueMode::Mpsc> Commands;
+
+    std::atomic<int32> NumPending;
+
+    std::atomic<bool> bIsClosed;
+};
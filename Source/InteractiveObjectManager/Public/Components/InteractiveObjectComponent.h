@@ -1,128 +1,233 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#pragma once
-
-#include "Components/ActorComponent.h"
-#include "InteractiveObjectComponent.generated.h"
-
-class UStaticMeshComponent;
-class USceneComponent;
-class UMaterialInstanceDynamic;
-class UInteractiveObjectManagerSubsystem;
-
-/**
- * Attach this component to any Actor to make it manageable by the Interactive Object Manager.
- *
- * Responsibilities:
- * - Stores current color and uniform scale for the interactive object.
- * - Locates the target StaticMeshComponent (auto or explicit).
- * - Creates dynamic material instances on demand and applies color changes.
- * - Applies uniform scale to the mesh or the owning Actor.
- * - Registers and unregisters with the Interactive Object Manager subsystem.
- */
-UCLASS(ClassGroup = (Interactive), meta = (BlueprintSpawnableComponent))
-class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectComponent : public UActorComponent
-{
-    GENERATED_BODY()
-
-public:
-    UInteractiveObjectComponent();
-
-    /** Set a new color for this interactive object and apply it to dynamic materials. */
-    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
-    void ApplyColor(const FLinearColor& NewColor);
-
-    /** Set a new uniform scale for this interactive object and apply it. */
-    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
-    void ApplyScale(float NewScale);
-
-    /** Returns the current color stored by this component. */
-    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
-    FLinearColor GetCurrentColor() const;
-
-    /** Returns the current uniform scale stored by this component. */
-    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
-    float GetCurrentScale() const;
-
-    /** Returns a display name that should be shown in UI lists. */
-    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
-    FString GetDisplayNameForUI() const;
-
-protected:
-    virtual void BeginPlay() override;
-    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-
-private:
-    /** Current color for this interactive object. Applied to dynamic material instances. */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
-    FLinearColor CurrentColor;
-
-    /** Current uniform scale (X = Y = Z) for this interactive object. */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (ClampMin = "0.01", AllowPrivateAccess = "true"))
-    float CurrentScale;
-
-    /**
-     * Optional explicit target StaticMeshComponent.
-     * If not set, the component will try to find a UStaticMeshComponent on the owner Actor.
-     */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
-    TWeakObjectPtr<UStaticMeshComponent> TargetMeshComponent;
-
-    /**
-     * Optional explicit component to receive scale changes.
-     * If not set, the component falls back to the mesh or the Actor root.
-     */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
-    TWeakObjectPtr<USceneComponent> ScaleTargetComponent;
-
-    /** Optional label that overrides actor name in UI lists. */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
-    FString DisplayLabel;
-
-    /** Dynamic material instances created on the target mesh when color is changed. */
-    UPROPERTY(Transient)
-    TArray<TObjectPtr<UMaterialInstanceDynamic>> DynamicMaterialInstances;
-
-    /** Material parameter name used to drive the color on dynamic material instances. */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
-    FName ColorParameterName;
-
-    /** Avoids spamming logs when a mesh cannot be found. */
-    bool bHasLoggedMissingMesh;
-
-    /** Tracks whether dynamic material instances were already initialized. */
-    bool bAreDynamicMaterialsInitialized;
-
-    /** Cached pointer to the world manager subsystem. */
-    TWeakObjectPtr<UInteractiveObjectManagerSubsystem> CachedManagerSubsystem;
-
-    /** Resolve or cache the target StaticMeshComponent for this interactive object. */
-    UStaticMeshComponent* GetEffectiveMeshComponent();
-
-    /**
-     * Resolve the component that will receive uniform scale.
-     * Priority:
-     * - ScaleTargetComponent (if set)
-     * - Effective mesh component
-     * - Owner root component
-     */
-    USceneComponent* GetEffectiveScaleComponent();
-
-    /** Create dynamic material instances on the target mesh if not already created. */
-    void InitializeDynamicMaterials();
-
-    /** Apply the currently stored color to all dynamic material instances. */
-    void ApplyColorInternal();
-
-    /** Apply the currently stored uniform scale to the chosen scale target. */
-    void ApplyScaleInternal();
-
-    /** Register this interactive object in the manager subsystem. */
-    void RegisterWithManager();
-
-    /** Unregister this interactive object from the manager subsystem. */
-    void UnregisterFromManager();
-
-    /** Log a warning about missing mesh once. */
-    void LogMissingMeshIfNeeded();
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "InteractiveObjectManagerTypes.h"
+#include "InteractiveObjectComponent.generated.h"
+
+class UStaticMeshComponent;
+class USceneComponent;
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+class UInteractiveObjectManagerSubsystem;
+
+/**
+ * Attach this component to any Actor to make it manageable by the Interactive Object Manager.
+ *
+ * While registered, the live color and uniform scale are stored in the manager subsystem columns
+ * and this component acts as a view over them. While detached it keeps its own copy.
+ *
+ * Responsibilities:
+ * - Exposes current color and uniform scale for the interactive object.
+ * - Locates the target StaticMeshComponent (auto or explicit).
+ * - Applies color changes through dynamic material instances created on demand, or through custom primitive data.
+ * - Takes dynamic material instances from the manager shared material cache when sharing is enabled.
+ * - Applies uniform scale to the mesh or the owning Actor.
+ * - Registers and unregisters with the Interactive Object Manager subsystem.
+ * - Reports owner movement to the manager so its spatial index stays current.
+ * - Parks and revives its owner when the manager recycles it through the actor pool.
+ */
+UCLASS(ClassGroup = (Interactive), meta = (BlueprintSpawnableComponent))
+class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UInteractiveObjectComponent();
+
+    /** Set a new color for this interactive object and apply it to dynamic materials. Goes through the manager while registered. */
+    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
+    void ApplyColor(const FLinearColor& NewColor);
+
+    /** Set a new uniform scale for this interactive object and apply it. Goes through the manager while registered. */
+    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
+    void ApplyScale(float NewScale);
+
+    /** Returns the current color, read from the manager while registered. */
+    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
+    FLinearColor GetCurrentColor() const;
+
+    /** Returns the current uniform scale, read from the manager while registered. */
+    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
+    float GetCurrentScale() const;
+
+    /** Returns a display name that should be shown in UI lists. The manager resolves it once at registration and caches it. */
+    UFUNCTION(BlueprintCallable, Category = "Interactive Object")
+    FString GetDisplayNameForUI() const;
+
+    /**
+     * Unregisters from the manager, hides the owner and disables its collision and tick.
+     * Dynamic material instances are kept so that reuse skips their creation.
+     * Shared instances go back to the manager cache.
+     */
+    void DeactivateForPool();
+
+    /** Restores the owner state saved by DeactivateForPool and registers with the manager again. */
+    void ActivateFromPool();
+
+    /** Returns true while the owner is parked in the manager actor pool. */
+    bool IsPooled() const;
+
+    /** Called by the manager after registration. The manager owns color and scale from now on. */
+    void HandleRegisteredWithManager(FInteractiveObjectHandle Handle);
+
+    /** Called by the manager on unregistration with the last color and scale it stored. */
+    void HandleUnregisteredFromManager(const FLinearColor& LastColor, float LastScale);
+
+    /** Pushes a color to the dynamic material instances without storing it. */
+    void UpdateMaterialColor(const FLinearColor& NewColor);
+
+    /** Pushes a uniform scale to the scale target without storing it. */
+    void UpdateAppliedScale(float NewScale);
+
+    /**
+     * Colors NumObjects standalone mesh components once per color mode and logs the UObjects, memory and
+     * garbage collection time each mode costs. Used by the IOM.Color.Benchmark console command.
+     */
+    static void RunColorModeBenchmark(int32 NumObjects);
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    /** Initial color for this interactive object, and its color while not registered with the manager. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
+    FLinearColor CurrentColor;
+
+    /** Initial uniform scale (X = Y = Z) for this interactive object, and its scale while not registered with the manager. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (ClampMin = "0.01", AllowPrivateAccess = "true"))
+    float CurrentScale;
+
+    /**
+     * Optional explicit target StaticMeshComponent.
+     * If not set, the component will try to find a UStaticMeshComponent on the owner Actor.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
+    TWeakObjectPtr<UStaticMeshComponent> TargetMeshComponent;
+
+    /**
+     * Optional explicit component to receive scale changes.
+     * If not set, the component falls back to the mesh or the Actor root.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
+    TWeakObjectPtr<USceneComponent> ScaleTargetComponent;
+
+    /** Optional label that overrides actor name in UI lists. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
+    FString DisplayLabel;
+
+    /** Dynamic material instances created on the target mesh when color is changed. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UMaterialInstanceDynamic>> DynamicMaterialInstances;
+
+    /** Original material of every slot of the target mesh, parents of the shared instances. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UMaterialInterface>> SharedMaterialParents;
+
+    /** Shared instance currently assigned to every slot, owned by the manager cache and never modified here. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UMaterialInstanceDynamic>> SharedMaterialInstances;
+
+    /** Manager whose cache SharedMaterialInstances were acquired from. Kept while parked in the pool. */
+    TWeakObjectPtr<UInteractiveObjectManagerSubsystem> SharedMaterialSubsystem;
+
+    /** Material parameter name used to drive the color on dynamic material instances. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
+    FName ColorParameterName;
+
+    /**
+     * How the color reaches the target mesh.
+     * Custom primitive data creates no material objects and keeps objects sharing a material batchable,
+     * but the material has to read the color from primitive data.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (AllowPrivateAccess = "true"))
+    EInteractiveObjectColorMode ColorMode;
+
+    /** First of the four custom primitive data floats that receive the color as RGBA. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (ClampMin = "0", EditCondition = "ColorMode == EInteractiveObjectColorMode::CustomPrimitiveData", AllowPrivateAccess = "true"))
+    int32 ColorPrimitiveDataIndex;
+
+    /**
+     * Material assigned to every slot of the target mesh in custom primitive data mode, shared by all objects.
+     * Required by that mode: without it the component colors through dynamic material instances instead,
+     * since the materials of the mesh usually do not read primitive data.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interactive Object", meta = (EditCondition = "ColorMode == EInteractiveObjectColorMode::CustomPrimitiveData", AllowPrivateAccess = "true"))
+    TObjectPtr<UMaterialInterface> PrimitiveDataMaterial;
+
+    /** Avoids spamming logs when a mesh cannot be found. */
+    bool bHasLoggedMissingMesh;
+
+    /** Tracks whether the materials of the color mode were already initialized. */
+    bool bAreDynamicMaterialsInitialized;
+
+    /** True if colors go through shared instances from the manager cache instead of DynamicMaterialInstances. */
+    bool bUsesSharedDynamicMaterials;
+
+    /** True if colors go to custom primitive data. False in that mode without a PrimitiveDataMaterial. */
+    bool bUsesCustomPrimitiveData;
+
+    /** True while the owner is parked in the manager actor pool. */
+    bool bIsPooled;
+
+    /** Owner collision state captured when entering the pool. */
+    bool bWasOwnerCollisionEnabled;
+
+    /** Owner tick state captured when entering the pool. */
+    bool bWasOwnerTickEnabled;
+
+    /** Cached pointer to the world manager subsystem. */
+    TWeakObjectPtr<UInteractiveObjectManagerSubsystem> CachedManagerSubsystem;
+
+    /** Handle issued by the manager, unset while not registered. */
+    FInteractiveObjectHandle ManagerHandle;
+
+    /** Root component whose transform updates are forwarded to the manager while registered. */
+    TWeakObjectPtr<USceneComponent> ObservedRootComponent;
+
+    /** Handle of the TransformUpdated binding on ObservedRootComponent. */
+    FDelegateHandle RootTransformUpdatedHandle;
+
+    /** Forwards owner movement to the manager spatial index. */
+    void HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+    /** Returns the manager that owns this component's visual state, or nullptr while detached. */
+    UInteractiveObjectManagerSubsystem* GetOwningManager() const;
+
+    /** Resolve or cache the target StaticMeshComponent for this interactive object. */
+    UStaticMeshComponent* GetEffectiveMeshComponent();
+
+    /**
+     * Resolve the component that will receive uniform scale.
+     * Priority:
+     * - ScaleTargetComponent (if set)
+     * - Effective mesh component
+     * - Owner root component
+     */
+    USceneComponent* GetEffectiveScaleComponent();
+
+    /**
+     * Create dynamic material instances on the target mesh if not already created.
+     * In custom primitive data mode assigns PrimitiveDataMaterial instead, falling back to dynamic
+     * material instances when it is not set.
+     * With material sharing enabled in the manager only records the slot parents.
+     */
+    void InitializeDynamicMaterials();
+
+    /** Assigns the shared instance of NewColor to every slot and releases the previous ones. */
+    void UpdateSharedMaterials(FName ParameterName, const FLinearColor& NewColor);
+
+    /** Returns every shared instance to the manager cache. The mesh keeps showing them. */
+    void ReleaseSharedMaterials();
+
+    /** Register this interactive object in the manager subsystem. */
+    void RegisterWithManager();
+
+    /** Unregister this interactive object from the manager subsystem. */
+    void UnregisterFromManager();
+
+    /** Log a warning about missing mesh once. */
+    void LogMissingMeshIfNeeded();
 };
\ No newline at end of file
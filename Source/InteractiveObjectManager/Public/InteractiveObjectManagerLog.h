@@ -1,7 +1,7 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#pragma once
-
-#include "Logging/LogMacros.h"
-
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "Logging/LogMacros.h"
+
 DECLARE_LOG_CATEGORY_EXTERN(LogInteractiveObjectManager, Log, All);
\ No newline at end of file
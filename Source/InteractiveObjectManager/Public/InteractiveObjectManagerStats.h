@@ -0,0 +1,13 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+/**
+ * Stat group for the Interactive Object Manager.
+ *
+ * Use "stat InteractiveObjectManager" in the console to inspect registry,
+ * selection and spawn costs at runtime.
+ */
+DECLARE_STATS_GROUP(TEXT("InteractiveObjectManager"), STATGROUP_InteractiveObjectManager, STATCAT_Advanced);
\ No newline at end of file
@@ -1,28 +1,207 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "InteractiveObjectManagerTypes.generated.h"
-
-/**
- * Spawn type used by the Interactive Object Manager for default object creation.
- *
- * Defines which primitive shape is used when the system spawns a new interactive object
- * without an explicit type override.
- */
-UENUM(BlueprintType)
-enum class EInteractiveObjectSpawnType : uint8
-{
-	/** Spawn a default cube shaped interactive object. */
-	Cube UMETA(DisplayName = "Cube"),
-
-	/** Spawn a default sphere shaped interactive object. */
-	Sphere UMETA(DisplayName = "Sphere"),
-
-	/**
-	 * Spawn a randomly selected supported primitive type.
-	 * Exact selection rules are defined by the Interactive Object Manager.
-	 */
-	Random UMETA(DisplayName = "Random")
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InteractiveObjectManagerTypes.generated.h"
+
+/**
+ * Spawn type used by the Interactive Object Manager for default object creation.
+ *
+ * Defines which primitive shape is used when the system spawns a new interactive object
+ * without an explicit type override.
+ */
+UENUM(BlueprintType)
+enum class EInteractiveObjectSpawnType : uint8
+{
+	/** Spawn a default cube shaped interactive object. */
+	Cube UMETA(DisplayName = "Cube"),
+
+	/** Spawn a default sphere shaped interactive object. */
+	Sphere UMETA(DisplayName = "Sphere"),
+
+	/**
+	 * Spawn a randomly selected supported primitive type.
+	 * Exact selection rules are defined by the Interactive Object Manager.
+	 */
+	Random UMETA(DisplayName = "Random")
+};
+
+/**
+ * Primitive type of a registered interactive object, resolved against the preloaded primitive classes.
+ */
+UENUM(BlueprintType)
+enum class EInteractiveObjectPrimitiveType : uint8
+{
+	/** Instance of the configured cube primitive class. */
+	Cube UMETA(DisplayName = "Cube"),
+
+	/** Instance of the configured sphere primitive class. */
+	Sphere UMETA(DisplayName = "Sphere"),
+
+	/** Any other actor with an interactive component, for example placed in the level. */
+	Other UMETA(DisplayName = "Other")
+};
+
+/**
+ * Order of the pages returned by UInteractiveObjectManagerSubsystem::GetInteractiveObjectsPage.
+ * Objects with equal keys are ordered by Id.
+ */
+UENUM(BlueprintType)
+enum class EInteractiveObjectSortKey : uint8
+{
+	/** Runtime Id, which is also registration order. */
+	Id UMETA(DisplayName = "Id"),
+
+	/** Display name, case insensitive. */
+	Name UMETA(DisplayName = "Name"),
+
+	/** Primitive type. */
+	Type UMETA(DisplayName = "Type"),
+
+	/** Hue of the current color. */
+	ColorHue UMETA(DisplayName = "Color Hue"),
+
+	/** Current uniform scale. */
+	Scale UMETA(DisplayName = "Scale")
+};
+
+/**
+ * How the Interactive Object Manager draws the primitives it spawns.
+ */
+UENUM(BlueprintType)
+enum class EInteractiveObjectRenderingMode : uint8
+{
+	/** Every object is an actor of its class with its own mesh component. */
+	Actors UMETA(DisplayName = "Actors"),
+
+	/** Objects of one class are instances of a shared instanced static mesh component. */
+	Instanced UMETA(DisplayName = "Instanced Static Mesh"),
+
+	/** As Instanced, with a hierarchical instanced static mesh component that culls and LODs per cluster. */
+	HierarchicalInstanced UMETA(DisplayName = "Hierarchical Instanced Static Mesh")
+};
+
+/**
+ * How an interactive component pushes its color to the mesh.
+ */
+UENUM(BlueprintType)
+enum class EInteractiveObjectColorMode : uint8
+{
+	/** One dynamic material instance per material slot and object, color set as a vector parameter. */
+	DynamicMaterial UMETA(DisplayName = "Dynamic Material Instance"),
+
+	/** Color written to custom primitive data of the mesh, read by a material every object shares. */
+	CustomPrimitiveData UMETA(DisplayName = "Custom Primitive Data")
+};
+
+/**
+ * Per object flags stored by the Interactive Object Manager subsystem.
+ */
+enum class EInteractiveObjectFlags : uint8
+{
+	None = 0,
+
+	/** The object was spawned by the subsystem rather than placed in the level. */
+	SpawnedByManager = 1 << 0,
+
+	/** The object's actor was taken from the actor pool instead of being constructed. */
+	ReusedFromPool = 1 << 1,
+
+	/** The object changed since the last checkpoint serialized it. */
+	CheckpointDirty = 1 << 2,
+
+	/** The object is drawn as an instance of a shared instanced mesh and has no actor. */
+	Instanced = 1 << 3
+};
+ENUM_CLASS_FLAGS(EInteractiveObjectFlags);
+
+/**
+ * Generational handle to an object registered in the Interactive Object Manager subsystem.
+ *
+ * SlotIndex addresses a registry slot that is reused after the object is removed.
+ * Generation is bumped every time the slot is released, so a handle to a removed object
+ * is detected as stale in O(1) without scanning the registry.
+ *
+ * Handles are plain values and are cheap to store in UI rows or other systems.
+ */
+USTRUCT(BlueprintType)
+struct INTERACTIVEOBJECTMANAGER_API FInteractiveObjectHandle
+{
+	GENERATED_BODY()
+
+	/** Index of the registry slot, or INDEX_NONE for an unset handle. */
+	UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+	int32 SlotIndex = INDEX_NONE;
+
+	/** Generation of the slot at the time the handle was issued. Zero is never issued. */
+	UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+	int32 Generation = 0;
+
+	/** Returns true if the handle was issued by the subsystem. Does not check that the object is still alive. */
+	bool IsSet() const
+	{
+		return SlotIndex != INDEX_NONE && Generation != 0;
+	}
+
+	/** Resets the handle to the unset state. */
+	void Reset()
+	{
+		SlotIndex = INDEX_NONE;
+		Generation = 0;
+	}
+
+	bool operator==(const FInteractiveObjectHandle& Other) const
+	{
+		return SlotIndex == Other.SlotIndex && Generation == Other.Generation;
+	}
+
+	bool operator!=(const FInteractiveObjectHandle& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FInteractiveObjectHandle& Handle)
+	{
+		return HashCombineFast(::GetTypeHash(Handle.SlotIndex), ::GetTypeHash(Handle.Generation));
+	}
+};
+
+/**
+ * Parameters for spawning many interactive objects over several frames.
+ *
+ * Used by UInteractiveObjectManagerSubsystem::SpawnObjectsBatch and the matching async action.
+ */
+USTRUCT(BlueprintType)
+struct INTERACTIVEOBJECTMANAGER_API FInteractiveObjectBatchSpawnParams
+{
+	GENERATED_BODY()
+
+	/** Maximum time in milliseconds spent spawning per frame. At least one object is spawned per frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager", meta = (ClampMin = "0.0"))
+	float FrameBudgetMilliseconds = 2.0f;
+
+	/** Objects are placed at random inside a disc of this radius around the world origin. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager", meta = (ClampMin = "0.0"))
+	float SpawnRadius = 1000.0f;
+
+	/** World Z coordinate of spawned objects. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager")
+	float SpawnHeight = 100.0f;
+
+	/** If false, the default color from UInteractiveObjectSettings is used. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager")
+	bool bOverrideColor = false;
+
+	/** Color applied to every spawned object when bOverrideColor is set. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager", meta = (EditCondition = "bOverrideColor"))
+	FLinearColor Color = FLinearColor::White;
+
+	/** If false, the default scale from UInteractiveObjectSettings is used. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager")
+	bool bOverrideUniformScale = false;
+
+	/** Uniform scale applied to every spawned object when bOverrideUniformScale is set. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager", meta = (EditCondition = "bOverrideUniformScale", ClampMin = "0.01"))
+	float UniformScale = 1.0f;
 };
\ No newline at end of file
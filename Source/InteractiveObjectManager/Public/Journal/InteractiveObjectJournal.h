@@ -0,0 +1,135 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InteractiveObjectManagerTypes.h"
+
+/** Operation stored in a journal record. */
+enum class EInteractiveObjectJournalOp : uint8
+{
+    Spawn,
+    Delete,
+    SetColor,
+    SetScale
+};
+
+/**
+ * One journaled operation, fixed size and trivially copyable.
+ *
+ * Colors are stored as half floats. Spawn and Delete keep what is needed to bring the object back:
+ * class, location, rotation, color and scale. SetColor and SetScale only use their before and after pair.
+ */
+struct FInteractiveObjectJournalRecord
+{
+    FInteractiveObjectHandle Handle;
+
+    /** Records sharing a batch are undone and redone together. */
+    uint32 Batch = 0;
+
+    EInteractiveObjectJournalOp Op = EInteractiveObjectJournalOp::SetColor;
+
+    /** Index into the journal class table, Spawn and Delete only. */
+    uint16 ClassIndex = 0;
+
+    FFloat16Color BeforeColor;
+    FFloat16Color AfterColor;
+
+    float BeforeScale = 1.0f;
+    float AfterScale = 1.0f;
+
+    /** Actor location, Spawn and Delete only. */
+    FVector3f Location = FVector3f::ZeroVector;
+
+    /** Actor rotation quaternion as X, Y, Z, W, Spawn and Delete only. Plain floats keep the record 4 byte aligned. */
+    float Rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    void SetRotation(const FQuat& InRotation);
+    FQuat GetRotation() const;
+};
+
+/**
+ * Bounded undo and redo history of registry operations.
+ *
+ * Records live in a ring buffer of fixed capacity. Once full, the oldest whole batch is dropped to make
+ * room, so undo never stops halfway through a batch. A single batch larger than the whole ring cannot be
+ * undone and clears the history instead.
+ *
+ * Recording after an undo discards the redo tail. A batch is undone as one step only while its records
+ * are contiguous: a spawn batch interleaved with other operations across frames undoes in several steps.
+ *
+ * Game thread only.
+ */
+class INTERACTIVEOBJECTMANAGER_API FInteractiveObjectJournal
+{
+public:
+    /** Clears the history and sets the number of records kept. A capacity of 0 disables recording. */
+    void Reset(int32 InCapacity);
+
+    /**
+     * Opens a batch that groups every record until the matching EndBatch. Nested calls join the outer batch.
+     * Pass a batch returned earlier to keep appending to it, or 0 for a new one. Returns the open batch.
+     */
+    uint32 BeginBatch(uint32 ContinueBatch = 0);
+
+    void EndBatch();
+
+    /** Appends a record in the open batch, or in a batch of its own. Discards the redo tail. */
+    void Add(FInteractiveObjectJournalRecord&& Record);
+
+    /** Returns the class table index for Class, adding it if needed. */
+    uint16 FindOrAddClass(UClass* Class);
+
+    /** Class stored at ClassIndex, or nullptr once it is gone. */
+    UClass* GetClass(uint16 ClassIndex) const;
+
+    /** Moves the newest undoable batch to the redo side. Records are returned newest first. */
+    bool PopUndoBatch(TArray<FInteractiveObjectJournalRecord>& OutRecords);
+
+    /** Moves the oldest redoable batch back to the undo side. Records are returned oldest first. */
+    bool PopRedoBatch(TArray<FInteractiveObjectJournalRecord>& OutRecords);
+
+    /** Rewrites handles of respawned objects in every stored record. */
+    void RemapHandles(const TMap<FInteractiveObjectHandle, FInteractiveObjectHandle>& OldToNewHandles);
+
+    bool CanUndo() const;
+    bool CanRedo() const;
+
+    int32 GetNumRecords() const;
+    int32 GetNumUndoable() const;
+    int32 GetCapacity() const;
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    FInteractiveObjectJournalRecord& GetRecord(int32 LogicalIndex);
+    const FInteractiveObjectJournalRecord& GetRecord(int32 LogicalIndex) const;
+
+    /** Drops the oldest batch. Returns false if that batch is Batch itself. */
+    bool DropOldestBatch(uint32 Batch);
+
+    /** Ring storage, grows up to Capacity. */
+    TArray<FInteractiveObjectJournalRecord> Records;
+
+    /** Physical index of the oldest record. */
+    int32 Head = 0;
+
+    /** Number of stored records, undoable first, then redoable. */
+    int32 NumRecords = 0;
+
+    /** Records [0, NumUndoable) are applied, the rest can be redone. */
+    int32 NumUndoable = 0;
+
+    int32 Capacity = 0;
+
+    /** Batch handed to records added while a batch is open. */
+    uint32 OpenBatch = 0;
+    int32 OpenBatchDepth = 0;
+
+    uint32 NextBatch = 1;
+
+    /** Batch that outgrew the ring. Further records of it are ignored. */
+    uint32 OverflowedBatch = 0;
+
+    TArray<TWeakObjectPtr<UClass>> Classes;
+};
@@ -0,0 +1,101 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InteractiveObjectMaterialCache.generated.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
+/** Identity of a shared material instance: parent material, color parameter and quantized color. */
+USTRUCT()
+struct FInteractiveObjectSharedMaterialKey
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TObjectPtr<UMaterialInterface> ParentMaterial;
+
+    UPROPERTY(Transient)
+    FName ParameterName;
+
+    /** Color quantized to 8 bits per sRGB channel. */
+    UPROPERTY(Transient)
+    FColor Color = FColor::White;
+
+    bool operator==(const FInteractiveObjectSharedMaterialKey& Other) const
+    {
+        return ParentMaterial == Other.ParentMaterial && ParameterName == Other.ParameterName && Color == Other.Color;
+    }
+
+    friend uint32 GetTypeHash(const FInteractiveObjectSharedMaterialKey& Key)
+    {
+        return HashCombineFast(HashCombineFast(GetTypeHash(Key.ParentMaterial), GetTypeHash(Key.ParameterName)), Key.Color.DWColor());
+    }
+};
+
+/** One shared material instance and the number of material slots pointing at it. */
+USTRUCT()
+struct FInteractiveObjectSharedMaterial
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TObjectPtr<UMaterialInstanceDynamic> MaterialInstance;
+
+    int32 NumReferences = 0;
+};
+
+/**
+ * Reference counted dynamic material instances shared by interactive objects of the same color.
+ *
+ * Colors are quantized to 8 bits per sRGB channel before the lookup, so objects colored from the same
+ * palette end up on a handful of instances instead of one each. HDR components above 1 are clamped.
+ * A shared instance is never recolored: a color change acquires the instance of the new color and
+ * releases the old one, which leaves the cache once nothing references it.
+ *
+ * Owned by the Interactive Object Manager subsystem. Game thread only.
+ */
+USTRUCT()
+struct INTERACTIVEOBJECTMANAGER_API FInteractiveObjectMaterialCache
+{
+    GENERATED_BODY()
+
+    /**
+     * Returns the instance of ParentMaterial with ParameterName set to Color, creating it in Outer on a miss,
+     * and adds a reference to it. Returns nullptr without a parent material.
+     */
+    UMaterialInstanceDynamic* Acquire(UMaterialInterface* ParentMaterial, FName ParameterName, const FLinearColor& Color, UObject* Outer);
+
+    /** Drops a reference taken by Acquire. Null and instances not owned by the cache are ignored. */
+    void Release(UMaterialInstanceDynamic* MaterialInstance);
+
+    /** Drops every instance and clears the statistics. Instances still assigned to meshes stay valid there. */
+    void Reset();
+
+    /** Distinct instances alive. */
+    int32 GetNumInstances() const;
+
+    /** Material slots pointing at a cached instance. Without the cache each would own an instance. */
+    int32 GetNumReferences() const;
+
+    int64 GetNumAcquires() const;
+    int64 GetNumHits() const;
+
+    /** Instances created on misses since the last reset. */
+    int64 GetNumCreated() const;
+
+private:
+    UPROPERTY(Transient)
+    TMap<FInteractiveObjectSharedMaterialKey, FInteractiveObjectSharedMaterial> Entries;
+
+    /** Key of every cached instance, for Release. */
+    UPROPERTY(Transient)
+    TMap<TObjectPtr<UMaterialInstanceDynamic>, FInteractiveObjectSharedMaterialKey> KeysByInstance;
+
+    int32 NumReferences = 0;
+    int64 NumAcquires = 0;
+    int64 NumHits = 0;
+    int64 NumCreated = 0;
+};
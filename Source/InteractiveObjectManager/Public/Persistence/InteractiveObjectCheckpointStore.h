@@ -0,0 +1,75 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Persistence/InteractiveObjectSceneFile.h"
+
+/**
+ * Contents of one checkpoint segment, gathered on the game thread and written by a background task.
+ *
+ * Segments form chains. The first segment of a chain (Sequence 0) holds every object, later ones only
+ * the objects changed since the previous segment and the Ids deleted meanwhile. Object Ids are only
+ * meaningful within a chain, which never spans two sessions.
+ */
+struct FInteractiveObjectCheckpointData
+{
+    uint64 Chain = 0;
+    int32 Sequence = 0;
+
+    TArray<FString> ClassPaths;
+
+    /** New and changed objects. ObjectId identifies the object within the chain. */
+    TArray<FInteractiveObjectSceneRecord> Records;
+
+    /** Objects deleted since the previous segment of the chain. */
+    TArray<int32> DeletedObjectIds;
+};
+
+/** Outcome of FInteractiveObjectCheckpointStore::WriteSegment. */
+struct FInteractiveObjectCheckpointWriteResult
+{
+    bool bIsWritten = false;
+
+    uint64 Chain = 0;
+    int32 Sequence = 0;
+    int32 NumRecords = 0;
+    int32 NumDeleted = 0;
+
+    int64 UncompressedBytes = 0;
+    int64 CompressedBytes = 0;
+
+    double CompressSeconds = 0.0;
+    double WriteSeconds = 0.0;
+
+    FString Error;
+};
+
+/**
+ * Checkpoint segments on disk, under Saved/InteractiveObjects/Checkpoints.
+ *
+ * A segment file is a fixed header followed by one compressed block holding a scene file image of the
+ * segment records, then its deleted Ids. Files are named after chain and sequence, so a directory listing
+ * sorts them in replay order. Writing goes through FInteractiveObjectSceneFile::ReplaceFile, so a crash never
+ * leaves a partial segment, and loading falls back to the backup a replacement interrupted midway leaves behind.
+ */
+class INTERACTIVEOBJECTMANAGER_API FInteractiveObjectCheckpointStore
+{
+public:
+    static constexpr uint32 SegmentMagic = 0x434D4F49; // "IOMC"
+    static constexpr uint32 CurrentVersion = 1;
+
+    static FString GetDirectory();
+
+    /**
+     * Compresses and writes one segment. Safe from any thread.
+     * Once the first segment of a new chain is on disk, the files of every older chain are deleted.
+     */
+    static FInteractiveObjectCheckpointWriteResult WriteSegment(const FInteractiveObjectCheckpointData& Data);
+
+    /**
+     * Replays the newest chain that has a first segment, up to its last contiguous segment, and returns the
+     * merged objects as a scene file held in memory. Returns nullptr and fills OutError if there is none.
+     */
+    static TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> LoadLatest(int32& OutNumSegments, FString& OutError);
+};
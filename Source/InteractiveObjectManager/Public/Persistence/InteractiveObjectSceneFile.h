@@ -0,0 +1,161 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Fixed 64 byte header at the start of a scene file.
+ *
+ * Layout of a scene file, little endian:
+ * - header
+ * - class table at HeaderSize: NumClasses entries of a uint32 byte length followed by a UTF-8 class path
+ * - zero padding up to RecordsOffset, a multiple of SceneRecordsAlignment
+ * - NumObjects records of RecordSize bytes each
+ *
+ * Checkpoint identifies the save. A write-ahead log started right after the save carries the same value,
+ * so recovery only replays a log on top of the scene it continues.
+ *
+ * Records are plain data at a fixed stride, so a memory mapped file is read in place without parsing.
+ * Readers accept any RecordSize at least as large as the one they know and ignore the extra bytes,
+ * so later versions can append fields without breaking older readers.
+ */
+struct FInteractiveObjectSceneFileHeader
+{
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    uint32 HeaderSize = 0;
+    uint32 RecordSize = 0;
+    uint64 NumObjects = 0;
+    uint64 RecordsOffset = 0;
+    uint32 NumClasses = 0;
+    uint32 ClassTableSize = 0;
+    uint64 Checkpoint = 0;
+    uint8 Reserved[16] = {};
+};
+
+/** One saved object. Plain data, read straight out of the mapped file. */
+struct FInteractiveObjectSceneRecord
+{
+    float Location[3] = {};
+
+    /** Rotation quaternion as X, Y, Z, W. */
+    float Rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    float UniformScale = 1.0f;
+
+    FFloat16Color Color;
+
+    /** Index into the scene file class table. */
+    uint16 ClassIndex = 0;
+
+    uint16 Reserved16 = 0;
+
+    /** Runtime Id of the object when it was saved, 0 if unknown. Used to replay write-ahead log records. */
+    int32 ObjectId = 0;
+
+    void SetTransform(const FVector& InLocation, const FQuat& InRotation);
+    FVector GetLocation() const;
+    FQuat GetRotation() const;
+    FLinearColor GetColor() const;
+};
+
+/**
+ * Read only view of a scene file, memory mapped where the platform supports it.
+ *
+ * Shared between the subsystem and the spawn batch restoring it, and safe to read from any thread.
+ */
+class INTERACTIVEOBJECTMANAGER_API FInteractiveObjectSceneFile
+{
+public:
+    static constexpr uint32 SceneMagic = 0x534D4F49; // "IOMS"
+    static constexpr uint32 CurrentVersion = 1;
+    static constexpr uint64 SceneRecordsAlignment = 64;
+
+    FInteractiveObjectSceneFile();
+    ~FInteractiveObjectSceneFile();
+
+    /**
+     * Maps and validates the file, or its backup if a Write was interrupted before the new file was in place.
+     * Returns nullptr and fills OutError if it is missing, truncated or of an unknown version.
+     */
+    static TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> Open(const FString& FilePath, FString& OutError);
+
+    /**
+     * Writes a scene file. Goes through a temporary file, flushed to disk, that replaces FilePath only once fully
+     * written. The previous file is kept under GetBackupPath until the replacement is in place, so a failed or
+     * interrupted save never leaves a truncated scene behind, nor no scene at all.
+     */
+    static bool Write(const FString& FilePath, uint64 InCheckpoint, const TArray<FString>& InClassPaths, TConstArrayView<FInteractiveObjectSceneRecord> InRecords, FString& OutError);
+
+    /** Builds the complete file contents in memory, as Write would store them. */
+    static void BuildImage(uint64 InCheckpoint, const TArray<FString>& InClassPaths, TConstArrayView<FInteractiveObjectSceneRecord> InRecords, TArray64<uint8>& OutBytes);
+
+    /** Wraps file contents already in memory, for example a decompressed checkpoint. Bytes past the records are ignored. */
+    static TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> FromMemory(TArray64<uint8>&& Bytes, FString& OutError);
+
+    /** Default scene location, Saved/InteractiveObjects/Scene.iom. */
+    static FString GetDefaultPath();
+
+    /** Name the previous file of FilePath is kept under while Write replaces it. */
+    static FString GetBackupPath(const FString& FilePath);
+
+    /** FilePath, or its backup if a replacement was interrupted before the new file was in place. */
+    static FString GetReadPath(const FString& FilePath);
+
+    /**
+     * Replaces FilePath the way Write does: WriteContents fills a temporary file, which is flushed to disk and
+     * moved into place while the previous file waits under GetBackupPath. WriteContents returns false on failure.
+     */
+    static bool ReplaceFile(const FString& FilePath, TFunctionRef<bool(IFileHandle&)> WriteContents, FString& OutError);
+
+    /**
+     * Writes NumObjects synthetic records to a temporary scene file, reads them back through Open and logs
+     * write and read throughput. Used by the IOM.Scene.Benchmark console command.
+     */
+    static void RunBenchmark(int32 NumObjects);
+
+    int32 Num() const;
+
+    const FInteractiveObjectSceneRecord& GetRecord(int32 Index) const;
+
+    const TArray<FString>& GetClassPaths() const;
+
+    uint32 GetVersion() const;
+
+    uint64 GetCheckpoint() const;
+
+    /** True if the file is read through a memory mapping rather than a copy in memory. */
+    bool IsMapped() const;
+
+    /** File size in bytes. */
+    int64 GetSize() const;
+
+private:
+    /** Header, class table and padding up to the first record. */
+    static void BuildPrefix(uint64 InCheckpoint, const TArray<FString>& InClassPaths, int32 InNumRecords, TArray<uint8>& OutPrefix);
+
+    /** Validates the header and reads the class table. */
+    bool Parse(FString& OutError);
+
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    /** File contents on platforms without memory mapping, or an image handed to FromMemory. */
+    TArray64<uint8> FallbackBytes;
+
+    const uint8* Data;
+    int64 Size;
+
+    const uint8* Records;
+    int64 RecordStride;
+    int32 NumRecords;
+    uint32 Version;
+    uint64 Checkpoint;
+
+    TArray<FString> ClassPaths;
+};
@@ -0,0 +1,238 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/CircularQueue.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
+#include <type_traits>
+
+class FEvent;
+class FRunnableThread;
+class IFileHandle;
+
+/** Operation stored in a write-ahead log record. */
+enum class EInteractiveObjectWalOp : uint8
+{
+    /** Binds ClassIndex to a class path for the Spawn records that follow. */
+    DefineClass,
+    Spawn,
+    Delete,
+    SetColor,
+    SetScale
+};
+
+/** When the writer forces committed records to stable storage. */
+enum class EInteractiveObjectWalFsyncPolicy : uint8
+{
+    /** Never fsync. Records survive a crash of the process, not of the machine. */
+    Never,
+
+    /** Fsync after every group commit. */
+    EveryCommit,
+
+    /** Fsync at most once per interval, after a group commit. */
+    Interval
+};
+
+/**
+ * One logged mutation, as queued by the game thread. Objects are identified by their runtime Id.
+ * Plain data: class paths stay in the log class table, so queuing a record never copies a string.
+ */
+struct FInteractiveObjectWalRecord
+{
+    EInteractiveObjectWalOp Op = EInteractiveObjectWalOp::SetColor;
+
+    /** Class of a DefineClass or Spawn record. */
+    uint16 ClassIndex = 0;
+
+    int32 ObjectId = INDEX_NONE;
+
+    /** Spawn and SetColor. */
+    FLinearColor Color = FLinearColor::White;
+
+    /** Spawn and SetScale. */
+    float UniformScale = 1.0f;
+
+    /** Spawn only. */
+    FVector3f Location = FVector3f::ZeroVector;
+    FQuat4f Rotation = FQuat4f::Identity;
+};
+
+static_assert(std::is_trivially_copyable_v<FInteractiveObjectWalRecord>, "Write-ahead log records are copied into the ring as plain data.");
+
+/** Settings applied when a log is opened. */
+struct FInteractiveObjectWalSettings
+{
+    EInteractiveObjectWalFsyncPolicy FsyncPolicy = EInteractiveObjectWalFsyncPolicy::EveryCommit;
+
+    /** Longest time a record waits in the queue before the writer commits it with everything queued since. */
+    int32 GroupCommitMilliseconds = 5;
+
+    /** Minimum time between two fsyncs under EInteractiveObjectWalFsyncPolicy::Interval. */
+    int32 FsyncIntervalMilliseconds = 100;
+
+    /** Records the queue holds before Append spills into the overflow list. */
+    int32 QueueCapacity = 65536;
+
+    /** Records the overflow list holds. Allocated when the log opens, Append drops records beyond it. */
+    int32 OverflowCapacity = 65536;
+};
+
+/**
+ * Append-only log of registry mutations, written by a background thread.
+ *
+ * The game thread is the only producer: Append copies the record into a fixed size single producer, single
+ * consumer ring, one lock free enqueue with no allocation. The writer wakes every GroupCommitMilliseconds,
+ * drains whatever is queued and writes it with a single file write (group commit), then fsyncs according to
+ * the policy. If the ring is full, Append never waits: the record goes to an overflow list owned by the producer,
+ * which later Append and DrainOverflow calls move into the ring, oldest first, as the writer frees room.
+ *
+ * The overflow list is bounded and allocated up front, so Append never allocates. Once both are full the writer
+ * has stalled for a whole ring and overflow worth of records, and the log drops instead of blocking the game:
+ * the record is counted as dropped and the log stops accepting records. Everything queued before still commits,
+ * so the file stays a consistent prefix of the session rather than a log with holes in it.
+ *
+ * A failed write or fsync puts the log in a failed state: the error is logged once, HasFailed turns true,
+ * nothing more is written or counted as committed, and Append drops every later record. The owner is expected
+ * to close the log and stop relying on it.
+ *
+ * File layout, little endian: a 16 byte header (magic, version, base checkpoint), then frames of a uint32
+ * payload size, a uint32 CRC32 of the payload and the payload. A crash can leave a torn frame at the end;
+ * Replay stops at the first frame that is truncated or fails its checksum.
+ *
+ * The base checkpoint ties the log to the scene file it continues. Replay refuses a log whose base does not
+ * match, which is what makes a crash between saving a scene and restarting the log safe.
+ */
+class INTERACTIVEOBJECTMANAGER_API FInteractiveObjectWriteAheadLog : public FRunnable
+{
+public:
+    static constexpr uint32 LogMagic = 0x574D4F49; // "IOMW"
+    static constexpr uint32 CurrentVersion = 1;
+
+    FInteractiveObjectWriteAheadLog();
+    virtual ~FInteractiveObjectWriteAheadLog() override;
+
+    /**
+     * Truncates FilePath, writes the header for BaseCheckpoint and starts the writer thread.
+     * Closes a log that is already open first. Returns false and fills OutError on failure.
+     */
+    bool Open(const FString& FilePath, uint64 BaseCheckpoint, const FInteractiveObjectWalSettings& Settings, FString& OutError);
+
+    /** Commits everything queued, fsyncs and stops the writer thread. */
+    void Close();
+
+    bool IsOpen() const;
+
+    /** True once a write or fsync failed. Records committed before stay valid, nothing after them is durable. Any thread. */
+    bool HasFailed() const;
+
+    /**
+     * Queues a record for the writer, or spills it into the overflow list. Producer thread only.
+     * Ignored while the log is closed, after it dropped a record and after it failed.
+     */
+    void Append(const FInteractiveObjectWalRecord& Record);
+
+    /**
+     * Adds ClassPath to the class table of the log and queues the DefineClass record binding it.
+     * Returns the class index for later Spawn records. Producer thread only, meant for the first object of a class.
+     */
+    uint16 DefineClass(const FString& ClassPath);
+
+    /** Moves overflowed records into the ring while it has room. Producer thread only, called once per frame. */
+    void DrainOverflow();
+
+    /**
+     * Reads every intact record of the log at FilePath in order and passes it to Visitor, together with
+     * the class path of DefineClass records (empty for every other operation).
+     * Fails if the file is unreadable or was started for another checkpoint than ExpectedBaseCheckpoint.
+     * A torn tail is not an error, replay simply ends there.
+     */
+    static bool Replay(const FString& FilePath, uint64 ExpectedBaseCheckpoint, TFunctionRef<void(const FInteractiveObjectWalRecord& Record, const FString& ClassPath)> Visitor, int32& OutNumRecords, FString& OutError);
+
+    /** Log location for a scene file, next to it with the .wal extension. */
+    static FString GetPathForScene(const FString& SceneFilePath);
+
+    /**
+     * Appends NumRecords records to a temporary log under each fsync policy, replays them and logs the
+     * producer cost per record, group commit sizes and writer throughput. Used by the IOM.WAL.Benchmark console command.
+     */
+    static void RunBenchmark(int32 NumRecords);
+
+    int64 GetNumAppended() const;
+    int64 GetNumCommitted() const;
+    int64 GetNumGroupCommits() const;
+    int64 GetNumFsyncs() const;
+    int64 GetBytesWritten() const;
+
+    /** Appends that found the queue full, or records already waiting, and went to the overflow list. */
+    int64 GetNumStalls() const;
+
+    /** Records waiting in the overflow list. */
+    int32 GetNumOverflowed() const;
+
+    /** Records refused because the queue and the overflow list were full, or appended after that or after a failure. */
+    int64 GetNumDropped() const;
+
+    //~ Begin FRunnable Interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+    //~ End FRunnable Interface
+
+private:
+    /** Drains the queue into one write, then fsyncs if the policy asks for it. Writer thread only. */
+    void CommitPending();
+
+    /** Enters the failed state and logs What once. Writer thread, or the producer once the writer is stopped. */
+    void MarkFailed(const TCHAR* What, int64 NumRecords);
+
+    /** Moves overflowed records into the ring until it is full. Returns true once the overflow list is empty. */
+    bool MoveOverflowToQueue();
+
+    TUniquePtr<TCircularQueue<FInteractiveObjectWalRecord>> Queue;
+    TUniquePtr<IFileHandle> FileHandle;
+    FRunnableThread* Thread;
+    FEvent* WakeEvent;
+
+    FInteractiveObjectWalSettings ActiveSettings;
+
+    /**
+     * Records that found the ring full, in append order from OverflowHead on. Producer thread only.
+     * Consumed from the front without shifting, and emptied once fully drained.
+     */
+    TArray<FInteractiveObjectWalRecord> Overflow;
+    int32 OverflowHead;
+
+    /** True once a record was dropped. Later records are dropped too, so the file keeps no holes. Producer thread only. */
+    bool bHasDroppedRecords;
+
+    /** Class path of every class index defined in this log. Appended by the producer, read by the writer. */
+    TArray<FString> ClassPaths;
+    mutable FCriticalSection ClassPathsLock;
+
+    /** Frames of the commit in progress. Writer thread only, kept to reuse its allocation. */
+    TArray<uint8> CommitBuffer;
+
+    /** Platform time of the last fsync. Writer thread only. */
+    double LastFsyncTime;
+
+    /** True when commits were written since the last fsync. Writer thread only. */
+    bool bHasUnsyncedCommits;
+
+    std::atomic<bool> bIsStopRequested;
+
+    /** Set on the first failed write or fsync, cleared by Open. */
+    std::atomic<bool> bHasFailed;
+
+    /** Written by the producer only. */
+    int64 NumAppended;
+    int64 NumStalls;
+    int64 NumDropped;
+
+    std::atomic<int64> NumCommitted;
+    std::atomic<int64> NumGroupCommits;
+    std::atomic<int64> NumFsyncs;
+    std::atomic<int64> BytesWritten;
+};
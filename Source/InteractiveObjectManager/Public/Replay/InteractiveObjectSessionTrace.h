@@ -0,0 +1,119 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InteractiveObjectManagerTypes.h"
+#include "Settings/InteractiveObjectSettings.h"
+
+/** Subsystem call stored in a session trace. */
+enum class EInteractiveObjectTraceOp : uint8
+{
+    SpawnDefaultObject,
+    SpawnObjectOfType,
+    SpawnObjectsBatch,
+    SelectObject,
+    SelectObjectById,
+    SelectObjectByIndex,
+    AddObjectToSelection,
+    RemoveObjectFromSelection,
+    ToggleObjectSelection,
+    SelectObjects,
+    SelectAllObjects,
+    ClearSelection,
+    SetObjectColor,
+    SetObjectUniformScale,
+    SetSelectedObjectColor,
+    SetSelectedObjectUniformScale,
+    SetSelectedObjectsColor,
+    SetSelectedObjectsUniformScale,
+    DeleteObject,
+    DeleteSelectedObject,
+    DeleteSelectedObjects,
+    UndoLastOperation,
+    RedoLastOperation,
+    ApplySettings,
+
+    Count
+};
+
+/**
+ * One recorded call.
+ *
+ * Objects are referred to by trace index: objects present when the recording started are numbered in registry
+ * order, then every object registered afterwards takes the next index. Replaying the same calls with the same
+ * spawn seed registers the same objects in the same order, so trace indices identify them in both sessions.
+ */
+struct FInteractiveObjectTraceEvent
+{
+    EInteractiveObjectTraceOp Op = EInteractiveObjectTraceOp::SpawnDefaultObject;
+
+    /** Frames since the recording started. */
+    uint32 Frame = 0;
+
+    /** Seconds since the recording started. */
+    double Time = 0.0;
+
+    /** Trace indices registered when the call was made. Replay holds the call back until as many are registered. */
+    int32 NumRegistered = 0;
+
+    /** Trace indices of the objects the call refers to. INDEX_NONE for a handle that was already stale. */
+    TArray<int32, TInlineAllocator<1>> Objects;
+
+    /** Count of SpawnObjectsBatch, dense index of SelectObjectByIndex. */
+    int32 Count = 0;
+
+    /** SelectObjects only. */
+    bool bAddToSelection = false;
+
+    EInteractiveObjectSpawnType SpawnType = EInteractiveObjectSpawnType::Cube;
+    FLinearColor Color = FLinearColor::White;
+    float UniformScale = 1.0f;
+
+    /** SpawnObjectsBatch only. */
+    FInteractiveObjectBatchSpawnParams BatchParams;
+
+    /** ApplySettings only. */
+    FInteractiveObjectSettingsViewData Settings;
+};
+
+/**
+ * Recorded session: the state a replay starts from and every traced call, in order.
+ *
+ * File layout, little endian: magic, version, spawn seed, initial object count, settings and the map name,
+ * then the event count and the events. Each event stores its op, frame and time as packed deltas from the
+ * previous event and only the fields its op uses, which keeps long sessions at a few bytes per call.
+ */
+class INTERACTIVEOBJECTMANAGER_API FInteractiveObjectSessionTrace
+{
+public:
+    static constexpr uint32 TraceMagic = 0x544D4F49; // "IOMT"
+    static constexpr uint32 CurrentVersion = 1;
+
+    /** Seed of the spawn random stream when the recording started. */
+    uint32 Seed = 0;
+
+    /** Objects registered when the recording started. They take the first trace indices. */
+    int32 NumInitialObjects = 0;
+
+    /** Default spawn settings when the recording started. */
+    FInteractiveObjectSettingsViewData InitialSettings;
+
+    /** Map the session was recorded in. Informational. */
+    FString MapName;
+
+    TArray<FInteractiveObjectTraceEvent> Events;
+
+    /** Writes the trace to FilePath. Returns false and fills OutError on failure. */
+    bool Save(const FString& FilePath, FString& OutError);
+
+    /** Replaces this trace with the one stored at FilePath. Returns false and fills OutError on failure. */
+    bool Load(const FString& FilePath, FString& OutError);
+
+    /** Default trace location, Saved/InteractiveObjects/Session.iomtrace. */
+    static FString GetDefaultPath();
+
+private:
+    /** Reads or writes the events, depending on the archive direction. */
+    void SerializeEvents(FArchive& Ar);
+};
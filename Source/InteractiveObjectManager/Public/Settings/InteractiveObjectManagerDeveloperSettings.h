@@ -1,54 +1,113 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Engine/DeveloperSettings.h"
-#include "InteractiveObjectManagerTypes.h"
-#include "InteractiveObjectManagerDeveloperSettings.generated.h"
-
-class AActor;
-
-/**
- * Editor facing settings for the Interactive Object Manager.
- *
- * These settings are exposed in Project Settings under:
- * Project Settings - Game - Interactive Object Manager
- *
- * Responsibilities:
- * - Allow designers to choose which actor classes are used for cube and sphere primitives.
- * - Keep configuration in config files without hard coded asset paths.
- *
- * Runtime defaults for spawn type, color and scale are still handled by UInteractiveObjectSettings.
- */
-UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Interactive Object Manager"))
-class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectManagerDeveloperSettings : public UDeveloperSettings
-{
-    GENERATED_BODY()
-
-public:
-    UInteractiveObjectManagerDeveloperSettings();
-
-    // UDeveloperSettings interface
-
-    /** Places this settings object under the "Game" category in Project Settings. */
-    virtual FName GetCategoryName() const override;
-
-    /**
-     * Actor class used as a cube primitive in the demo.
-     *
-     * Expected to reference a Blueprint such as BP_InteractiveCube
-     * that already has UInteractiveObjectComponent attached and configured.
-     */
-    UPROPERTY(EditAnywhere, Config, Category = "Primitives", meta = (ToolTip = "Actor class used to represent cube primitives in the demo. Should have UInteractiveObjectComponent attached."))
-    TSoftClassPtr<AActor> CubePrimitiveClass;
-
-    /**
-     * Actor class used as a sphere primitive in the demo.
-     *
-     * Expected to reference a Blueprint such as BP_InteractiveSphere
-     * that already has UInteractiveObjectComponent attached and configured.
-     */
-    UPROPERTY(EditAnywhere, Config, Category = "Primitives", meta = (ToolTip = "Actor class used to represent sphere primitives in the demo. Should have UInteractiveObjectComponent attached."))
-    TSoftClassPtr<AActor> SpherePrimitiveClass;
-};
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "InteractiveObjectManagerTypes.h"
+#include "InteractiveObjectManagerDeveloperSettings.generated.h"
+
+class AActor;
+class UMaterialInterface;
+
+/**
+ * Editor facing settings for the Interactive Object Manager.
+ *
+ * These settings are exposed in Project Settings under:
+ * Project Settings - Game - Interactive Object Manager
+ *
+ * Responsibilities:
+ * - Allow designers to choose which actor classes are used for cube and sphere primitives.
+ * - List additional archetype classes that are preloaded at world init.
+ * - Configure the per class actor pool.
+ * - Choose between actors and shared instanced meshes for spawned primitives.
+ * - Share dynamic material instances between objects of the same color.
+ * - Keep configuration in config files without hard coded asset paths.
+ *
+ * Runtime defaults for spawn type, color and scale are still handled by UInteractiveObjectSettings.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Interactive Object Manager"))
+class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectManagerDeveloperSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    UInteractiveObjectManagerDeveloperSettings();
+
+    // UDeveloperSettings interface
+
+    /** Places this settings object under the "Game" category in Project Settings. */
+    virtual FName GetCategoryName() const override;
+
+    /**
+     * Actor class used as a cube primitive in the demo.
+     *
+     * Expected to reference a Blueprint such as BP_InteractiveCube
+     * that already has UInteractiveObjectComponent attached and configured.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Primitives", meta = (ToolTip = "Actor class used to represent cube primitives in the demo. Should have UInteractiveObjectComponent attached."))
+    TSoftClassPtr<AActor> CubePrimitiveClass;
+
+    /**
+     * Actor class used as a sphere primitive in the demo.
+     *
+     * Expected to reference a Blueprint such as BP_InteractiveSphere
+     * that already has UInteractiveObjectComponent attached and configured.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Primitives", meta = (ToolTip = "Actor class used to represent sphere primitives in the demo. Should have UInteractiveObjectComponent attached."))
+    TSoftClassPtr<AActor> SpherePrimitiveClass;
+
+    /**
+     * Additional archetype classes streamed in together with the primitives at world init.
+     *
+     * The subsystem keeps hard references to every class listed here so that
+     * future archetypes spawn without a synchronous load.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Primitives", meta = (ToolTip = "Additional actor classes preloaded asynchronously at world init."))
+    TArray<TSoftClassPtr<AActor>> AdditionalPreloadClasses;
+
+    /** When enabled, deleted objects are hidden and reused by later spawns instead of being destroyed. */
+    UPROPERTY(EditAnywhere, Config, Category = "Pooling", meta = (ToolTip = "Reuse deleted interactive actors instead of destroying them."))
+    bool bEnableActorPooling;
+
+    /** Number of inactive actors spawned per preloaded class after the classes finished loading. */
+    UPROPERTY(EditAnywhere, Config, Category = "Pooling", meta = (ClampMin = "0", EditCondition = "bEnableActorPooling", ToolTip = "Inactive actors spawned per class after load. Prewarm is spread across frames."))
+    int32 PoolPrewarmCount;
+
+    /** Maximum number of inactive actors kept per class. Actors released to a full pool are destroyed. */
+    UPROPERTY(EditAnywhere, Config, Category = "Pooling", meta = (ClampMin = "0", EditCondition = "bEnableActorPooling", ToolTip = "Maximum inactive actors kept per class."))
+    int32 PoolMaxSize;
+
+    /**
+     * How spawned objects are drawn. Read when a world starts.
+     *
+     * In the instanced modes the subsystem draws every object of a class as an instance of one shared
+     * component instead of spawning an actor, as long as the class defaults have a static mesh and an
+     * interactive component. Instances have no collision, selection goes through the subsystem queries.
+     * Objects placed in the level and classes without a static mesh are still actors.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ToolTip = "Draw spawned objects as actors or as instances of one shared mesh component per class."))
+    EInteractiveObjectRenderingMode RenderingMode;
+
+    /**
+     * Material applied to instanced objects, streamed in together with the primitive classes.
+     *
+     * Instances carry their color as per instance custom data: red, green and blue in floats 0 to 2.
+     * The material has to read them through PerInstanceCustomData nodes. When unset, instances keep
+     * the materials of the class mesh and every instance shows the same color.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (EditCondition = "RenderingMode != EInteractiveObjectRenderingMode::Actors", ToolTip = "Material for instanced objects. Reads the color from PerInstanceCustomData 0 to 2."))
+    TSoftObjectPtr<UMaterialInterface> InstancedMaterial;
+
+    /**
+     * When enabled, interactive components that color through dynamic material instances share them.
+     *
+     * Instead of one instance per material slot and object, the subsystem keeps one reference counted
+     * instance per parent material and color, quantized to 8 bits per sRGB channel. Read when a world starts.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ToolTip = "Share dynamic material instances between objects of the same color instead of creating one per object."))
+    bool bShareDynamicMaterials;
+
+    /** Collects the soft paths of all configured primitive and archetype classes. Null entries are skipped. */
+    void GetPrimitiveClassPaths(TArray<FSoftObjectPath>& OutClassPaths) const;
+};
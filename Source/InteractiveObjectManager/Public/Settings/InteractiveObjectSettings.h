@@ -1,262 +1,262 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "HAL/CriticalSection.h"
-#include "InteractiveObjectManagerTypes.h"
-#include "UObject/NoExportTypes.h"
-#include "InteractiveObjectSettings.generated.h"
-
-/**
- * Runtime settings for the Interactive Object Manager.
- *
- * This structure represents a validated snapshot of configuration values that are used
- * by the runtime systems. It is populated from ini via UInteractiveObjectSettings and
- * can be safely passed to UI or other systems as a value object.
- *
- * Primitive actor classes (cube, sphere, etc.) are configured separately via
- * UInteractiveObjectManagerDeveloperSettings and Project Settings.
- */
-USTRUCT(BlueprintType)
-struct INTERACTIVEOBJECTMANAGER_API FInteractiveObjectRuntimeSettings
-{
-    GENERATED_BODY()
-
-    /** Default spawn type used when creating new interactive objects. */
-    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default primitive type used for newly spawned interactive objects."))
-    EInteractiveObjectSpawnType DefaultSpawnType = EInteractiveObjectSpawnType::Cube;
-
-    /** Default color applied to newly spawned interactive objects. */
-    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default linear color used when spawning new interactive objects."))
-    FLinearColor DefaultColor = FLinearColor::White;
-
-    /** Default non uniform scale applied to newly spawned interactive objects. */
-    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default scale applied to interactive objects when no explicit scale is provided."))
-    FVector DefaultScale = FVector(1.0f, 1.0f, 1.0f);
-
-    /**
-     * Validates the current settings values.
-     *
-     * Returns true if all values are considered safe to use at runtime,
-     * for example the default scale is strictly positive and non zero.
-     */
-    bool IsValid() const;
-
-    /**
-     * Applies safe default values to all fields.
-     *
-     * Intended to be used when config values are missing or invalid so that
-     * the system can continue running without hard failures.
-     */
-    void ApplySafeDefaults();
-};
-
-/**
- * Lightweight view data used by UI to display and edit settings.
- *
- * This structure is intended for Blueprint and UMG. It exposes only the fields
- * that are required by the Settings Tab and uses a uniform scale float instead
- * of a full FVector for simplicity.
- */
-USTRUCT(BlueprintType)
-struct INTERACTIVEOBJECTMANAGER_API FInteractiveObjectSettingsViewData
-{
-    GENERATED_BODY()
-
-    /** Default spawn type used when creating new interactive objects. */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager")
-    EInteractiveObjectSpawnType DefaultSpawnType = EInteractiveObjectSpawnType::Cube;
-
-    /** Default color applied to newly spawned interactive objects. */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager")
-    FLinearColor DefaultColor = FLinearColor::White;
-
-    /**
-     * Default uniform scale applied to newly spawned interactive objects.
-     *
-     * The same value is applied to all three components of the runtime scale vector.
-     */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager", meta = (ClampMin = "0.1", ClampMax = "10.0"))
-    float DefaultUniformScale = 1.0f;
-};
-
-/**
- * Central configuration object for the Interactive Object Manager.
- *
- * Responsibilities:
- * - Load settings from ini files via GConfig.
- * - Save validated settings back to ini.
- * - Provide a thread safe runtime copy of settings to the rest of the module.
- *
- * Ini section: [InteractiveObjectManager.Settings]
- *
- * Note that primitive actor classes (cube, sphere) are not stored here.
- * They are configured via UInteractiveObjectManagerDeveloperSettings in Project Settings.
- */
-UCLASS(Config = Game, DefaultConfig)
-class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectSettings : public UObject
-{
-    GENERATED_BODY()
-
-public:
-    /**
-     * Returns the singleton instance of the settings object.
-     *
-     * The instance is provided via GetMutableDefault and is expected
-     * to live for the entire application lifetime.
-     */
-    static UInteractiveObjectSettings* Get();
-
-    /**
-     * Loads settings from the configured ini section using GConfig.
-     *
-     * This method reads raw values from the ini file, performs validation and
-     * updates the internal runtime settings structure. Invalid or missing values
-     * are replaced with safe defaults and a warning is logged.
-     */
-    void LoadFromConfig();
-
-    /**
-     * Saves the current runtime settings to the ini file using GConfig.
-     *
-     * The method writes the validated runtime values into the ini section and
-     * flushes the config so that changes persist between application runs.
-     */
-    void SaveToConfig() const;
-
-    /**
-     * Validates the current runtime settings and applies safe defaults when required.
-     *
-     * This method does not touch the ini file. It only ensures that the internal
-     * runtime settings structure is in a safe and consistent state.
-     */
-    void ApplyDefaultsIfInvalid();
-
-    /**
-     * Returns a copy of the current runtime settings in a thread safe way.
-     *
-     * Callers receive a value copy that can be safely used without any additional
-     * synchronization.
-     */
-    FInteractiveObjectRuntimeSettings GetRuntimeSettingsCopy() const;
-
-    /**
-     * Replaces the current runtime settings with the provided values.
-     *
-     * The provided settings are not automatically persisted to ini.
-     * Call SaveToConfig after updating the runtime settings if persistence is required.
-     */
-    void UpdateRuntimeSettings(const FInteractiveObjectRuntimeSettings& NewSettings);
-
-    /**
-     * Fills the provided view data structure with the current runtime settings.
-     *
-     * This method is intended for UI code that needs to display current configuration
-     * values in UMG or CommonUI.
-     */
-    void ToViewData(FInteractiveObjectSettingsViewData& OutViewData) const;
-
-    /**
-     * Updates runtime settings from the provided view data.
-     *
-     * Values are clamped and validated before being stored. Changes are not
-     * automatically persisted to ini. Call SaveToConfig when persistence is required.
-     */
-    void UpdateFromViewData(const FInteractiveObjectSettingsViewData& InViewData);
-
-    /** Editor facing default spawn type, used for inspection and tweaking in the editor. */
-    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default spawn type exposed to the editor. Does not automatically write to ini."))
-    EInteractiveObjectSpawnType Editor_DefaultSpawnType = EInteractiveObjectSpawnType::Cube;
-
-    /** Editor facing default color, used for inspection and tweaking in the editor. */
-    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default color exposed to the editor. Does not automatically write to ini."))
-    FLinearColor Editor_DefaultColor = FLinearColor::White;
-
-    /** Editor facing default scale, used for inspection and tweaking in the editor. */
-    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default scale exposed to the editor. Does not automatically write to ini."))
-    FVector Editor_DefaultScale = FVector(1.0f, 1.0f, 1.0f);
-
-    /** Convenience accessor for the default spawn type. */
-    EInteractiveObjectSpawnType GetDefaultSpawnType() const;
-
-    /** Convenience accessor for the default color. */
-    FLinearColor GetDefaultColor() const;
-
-    /** Convenience accessor for the default scale. */
-    FVector GetDefaultScale() const;
-
-    /**
-     * Returns a copy of the current runtime settings for use in Blueprint.
-     *
-     * This helper is intended as a thin bridge between C++ config handling
-     * and UI logic implemented in UMG or CommonUI.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
-    static FInteractiveObjectRuntimeSettings GetRuntimeSettingsForBlueprint();
-
-    /**
-     * Applies new runtime settings provided by Blueprint and optionally saves them to config.
-     *
-     * If NewSettings are invalid, safe defaults will be applied instead.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
-    static void ApplyRuntimeSettingsFromBlueprint(const FInteractiveObjectRuntimeSettings& NewSettings, bool bSaveToConfig);
-
-private:
-    /** Runtime validated settings used by the Interactive Object Manager systems. */
-    FInteractiveObjectRuntimeSettings RuntimeSettings;
-
-    /** Synchronization primitive used to protect access to RuntimeSettings. */
-    mutable FCriticalSection SettingsCriticalSection;
-
-    /** Returns the ini section name used by this settings object. */
-    static const TCHAR* GetConfigSectionName();
-
-    /** Returns the ini key name used for the default spawn type. */
-    static const TCHAR* GetDefaultSpawnTypeKey();
-
-    /** Returns the ini key name used for the default color. */
-    static const TCHAR* GetDefaultColorKey();
-
-    /** Returns the ini key name used for the default scale. */
-    static const TCHAR* GetDefaultScaleKey();
-
-    /**
-     * Loads the default spawn type from config into the provided settings structure.
-     *
-     * Invalid or missing values are replaced with a safe default and logged.
-     */
-    void LoadSpawnTypeFromConfig(FInteractiveObjectRuntimeSettings& OutSettings);
-
-    /**
-     * Loads the default color from config into the provided settings structure.
-     *
-     * Invalid or missing values are replaced with a safe default and logged.
-     */
-    void LoadColorFromConfig(FInteractiveObjectRuntimeSettings& OutSettings);
-
-    /**
-     * Loads the default scale from config into the provided settings structure.
-     *
-     * Invalid or missing values are replaced with a safe default and logged.
-     */
-    void LoadScaleFromConfig(FInteractiveObjectRuntimeSettings& OutSettings);
-
-    /** Writes the default spawn type from the runtime settings to the ini file. */
-    void SaveSpawnTypeToConfig(const FInteractiveObjectRuntimeSettings& InSettings) const;
-
-    /** Writes the default color from the runtime settings to the ini file. */
-    void SaveColorToConfig(const FInteractiveObjectRuntimeSettings& InSettings) const;
-
-    /** Writes the default scale from the runtime settings to the ini file. */
-    void SaveScaleToConfig(const FInteractiveObjectRuntimeSettings& InSettings) const;
-
-    /**
-     * Logs a warning about an invalid config value for a given key.
-     *
-     * KeyName is the logical key that failed validation, Reason provides human readable
-     * context that can be copied into the project documentation or wiki.
-     */
-    static void LogInvalidValue(const FString& KeyName, const FString& Reason);
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "InteractiveObjectManagerTypes.h"
+#include "UObject/NoExportTypes.h"
+#include "InteractiveObjectSettings.generated.h"
+
+/**
+ * Runtime settings for the Interactive Object Manager.
+ *
+ * This structure represents a validated snapshot of configuration values that are used
+ * by the runtime systems. It is populated from ini via UInteractiveObjectSettings and
+ * can be safely passed to UI or other systems as a value object.
+ *
+ * Primitive actor classes (cube, sphere, etc.) are configured separately via
+ * UInteractiveObjectManagerDeveloperSettings and Project Settings.
+ */
+USTRUCT(BlueprintType)
+struct INTERACTIVEOBJECTMANAGER_API FInteractiveObjectRuntimeSettings
+{
+    GENERATED_BODY()
+
+    /** Default spawn type used when creating new interactive objects. */
+    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default primitive type used for newly spawned interactive objects."))
+    EInteractiveObjectSpawnType DefaultSpawnType = EInteractiveObjectSpawnType::Cube;
+
+    /** Default color applied to newly spawned interactive objects. */
+    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default linear color used when spawning new interactive objects."))
+    FLinearColor DefaultColor = FLinearColor::White;
+
+    /** Default non uniform scale applied to newly spawned interactive objects. */
+    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default scale applied to interactive objects when no explicit scale is provided."))
+    FVector DefaultScale = FVector(1.0f, 1.0f, 1.0f);
+
+    /**
+     * Validates the current settings values.
+     *
+     * Returns true if all values are considered safe to use at runtime,
+     * for example the default scale is strictly positive and non zero.
+     */
+    bool IsValid() const;
+
+    /**
+     * Applies safe default values to all fields.
+     *
+     * Intended to be used when config values are missing or invalid so that
+     * the system can continue running without hard failures.
+     */
+    void ApplySafeDefaults();
+};
+
+/**
+ * Lightweight view data used by UI to display and edit settings.
+ *
+ * This structure is intended for Blueprint and UMG. It exposes only the fields
+ * that are required by the Settings Tab and uses a uniform scale float instead
+ * of a full FVector for simplicity.
+ */
+USTRUCT(BlueprintType)
+struct INTERACTIVEOBJECTMANAGER_API FInteractiveObjectSettingsViewData
+{
+    GENERATED_BODY()
+
+    /** Default spawn type used when creating new interactive objects. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager")
+    EInteractiveObjectSpawnType DefaultSpawnType = EInteractiveObjectSpawnType::Cube;
+
+    /** Default color applied to newly spawned interactive objects. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager")
+    FLinearColor DefaultColor = FLinearColor::White;
+
+    /**
+     * Default uniform scale applied to newly spawned interactive objects.
+     *
+     * The same value is applied to all three components of the runtime scale vector.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InteractiveObjectManager", meta = (ClampMin = "0.1", ClampMax = "10.0"))
+    float DefaultUniformScale = 1.0f;
+};
+
+/**
+ * Central configuration object for the Interactive Object Manager.
+ *
+ * Responsibilities:
+ * - Load settings from ini files via GConfig.
+ * - Save validated settings back to ini.
+ * - Provide a thread safe runtime copy of settings to the rest of the module.
+ *
+ * Ini section: [InteractiveObjectManager.Settings]
+ *
+ * Note that primitive actor classes (cube, sphere) are not stored here.
+ * They are configured via UInteractiveObjectManagerDeveloperSettings in Project Settings.
+ */
+UCLASS(Config = Game, DefaultConfig)
+class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectSettings : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Returns the singleton instance of the settings object.
+     *
+     * The instance is provided via GetMutableDefault and is expected
+     * to live for the entire application lifetime.
+     */
+    static UInteractiveObjectSettings* Get();
+
+    /**
+     * Loads settings from the configured ini section using GConfig.
+     *
+     * This method reads raw values from the ini file, performs validation and
+     * updates the internal runtime settings structure. Invalid or missing values
+     * are replaced with safe defaults and a warning is logged.
+     */
+    void LoadFromConfig();
+
+    /**
+     * Saves the current runtime settings to the ini file using GConfig.
+     *
+     * The method writes the validated runtime values into the ini section and
+     * flushes the config so that changes persist between application runs.
+     */
+    void SaveToConfig() const;
+
+    /**
+     * Validates the current runtime settings and applies safe defaults when required.
+     *
+     * This method does not touch the ini file. It only ensures that the internal
+     * runtime settings structure is in a safe and consistent state.
+     */
+    void ApplyDefaultsIfInvalid();
+
+    /**
+     * Returns a copy of the current runtime settings in a thread safe way.
+     *
+     * Callers receive a value copy that can be safely used without any additional
+     * synchronization.
+     */
+    FInteractiveObjectRuntimeSettings GetRuntimeSettingsCopy() const;
+
+    /**
+     * Replaces the current runtime settings with the provided values.
+     *
+     * The provided settings are not automatically persisted to ini.
+     * Call SaveToConfig after updating the runtime settings if persistence is required.
+     */
+    void UpdateRuntimeSettings(const FInteractiveObjectRuntimeSettings& NewSettings);
+
+    /**
+     * Fills the provided view data structure with the current runtime settings.
+     *
+     * This method is intended for UI code that needs to display current configuration
+     * values in UMG or CommonUI.
+     */
+    void ToViewData(FInteractiveObjectSettingsViewData& OutViewData) const;
+
+    /**
+     * Updates runtime settings from the provided view data.
+     *
+     * Values are clamped and validated before being stored. Changes are not
+     * automatically persisted to ini. Call SaveToConfig when persistence is required.
+     */
+    void UpdateFromViewData(const FInteractiveObjectSettingsViewData& InViewData);
+
+    /** Editor facing default spawn type, used for inspection and tweaking in the editor. */
+    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default spawn type exposed to the editor. Does not automatically write to ini."))
+    EInteractiveObjectSpawnType Editor_DefaultSpawnType = EInteractiveObjectSpawnType::Cube;
+
+    /** Editor facing default color, used for inspection and tweaking in the editor. */
+    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default color exposed to the editor. Does not automatically write to ini."))
+    FLinearColor Editor_DefaultColor = FLinearColor::White;
+
+    /** Editor facing default scale, used for inspection and tweaking in the editor. */
+    UPROPERTY(EditAnywhere, Category = "InteractiveObjectManager", meta = (ToolTip = "Default scale exposed to the editor. Does not automatically write to ini."))
+    FVector Editor_DefaultScale = FVector(1.0f, 1.0f, 1.0f);
+
+    /** Convenience accessor for the default spawn type. */
+    EInteractiveObjectSpawnType GetDefaultSpawnType() const;
+
+    /** Convenience accessor for the default color. */
+    FLinearColor GetDefaultColor() const;
+
+    /** Convenience accessor for the default scale. */
+    FVector GetDefaultScale() const;
+
+    /**
+     * Returns a copy of the current runtime settings for use in Blueprint.
+     *
+     * This helper is intended as a thin bridge between C++ config handling
+     * and UI logic implemented in UMG or CommonUI.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
+    static FInteractiveObjectRuntimeSettings GetRuntimeSettingsForBlueprint();
+
+    /**
+     * Applies new runtime settings provided by Blueprint and optionally saves them to config.
+     *
+     * If NewSettings are invalid, safe defaults will be applied instead.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
+    static void ApplyRuntimeSettingsFromBlueprint(const FInteractiveObjectRuntimeSettings& NewSettings, bool bSaveToConfig);
+
+private:
+    /** Runtime validated settings used by the Interactive Object Manager systems. */
+    FInteractiveObjectRuntimeSettings RuntimeSettings;
+
+    /** Synchronization primitive used to protect access to RuntimeSettings. */
+    mutable FCriticalSection SettingsCriticalSection;
+
+    /** Returns the ini section name used by this settings object. */
+    static const TCHAR* GetConfigSectionName();
+
+    /** Returns the ini key name used for the default spawn type. */
+    static const TCHAR* GetDefaultSpawnTypeKey();
+
+    /** Returns the ini key name used for the default color. */
+    static const TCHAR* GetDefaultColorKey();
+
+    /** Returns the ini key name used for the default scale. */
+    static const TCHAR* GetDefaultScaleKey();
+
+    /**
+     * Loads the default spawn type from config into the provided settings structure.
+     *
+     * Invalid or missing values are replaced with a safe default and logged.
+     */
+    void LoadSpawnTypeFromConfig(FInteractiveObjectRuntimeSettings& OutSettings);
+
+    /**
+     * Loads the default color from config into the provided settings structure.
+     *
+     * Invalid or missing values are replaced with a safe default and logged.
+     */
+    void LoadColorFromConfig(FInteractiveObjectRuntimeSettings& OutSettings);
+
+    /**
+     * Loads the default scale from config into the provided settings structure.
+     *
+     * Invalid or missing values are replaced with a safe default and logged.
+     */
+    void LoadScaleFromConfig(FInteractiveObjectRuntimeSettings& OutSettings);
+
+    /** Writes the default spawn type from the runtime settings to the ini file. */
+    void SaveSpawnTypeToConfig(const FInteractiveObjectRuntimeSettings& InSettings) const;
+
+    /** Writes the default color from the runtime settings to the ini file. */
+    void SaveColorToConfig(const FInteractiveObjectRuntimeSettings& InSettings) const;
+
+    /** Writes the default scale from the runtime settings to the ini file. */
+    void SaveScaleToConfig(const FInteractiveObjectRuntimeSettings& InSettings) const;
+
+    /**
+     * Logs a warning about an invalid config value for a given key.
+     *
+     * KeyName is the logical key that failed validation, Reason provides human readable
+     * context that can be copied into the project documentation or wiki.
+     */
+    static void LogInvalidValue(const FString& KeyName, const FString& Reason);
 };
\ No newline at end of file
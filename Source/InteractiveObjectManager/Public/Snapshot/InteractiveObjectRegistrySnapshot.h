@@ -0,0 +1,106 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InteractiveObjectManagerTypes.h"
+
+/**
+ * Immutable copy of the interactive object registry, safe to read from any thread.
+ *
+ * All arrays have Num() entries and are parallel: index i of every array describes the same object.
+ * Order matches the registry dense order at publish time and is not stable across snapshots.
+ */
+struct INTERACTIVEOBJECTMANAGER_API FInteractiveObjectRegistrySnapshot
+{
+    /** Publish counter, strictly increasing across snapshots of one publisher. */
+    uint64 Version = 0;
+
+    /** Engine frame in which the snapshot was published. */
+    uint64 FrameNumber = 0;
+
+    TArray<int32> ObjectIds;
+    TArray<FInteractiveObjectHandle> Handles;
+
+    /** World space bounds centers, as stored in the subsystem spatial index. */
+    TArray<FVector> Locations;
+
+    TArray<FLinearColor> Colors;
+    TArray<float> Scales;
+    TArray<EInteractiveObjectPrimitiveType> Types;
+
+    int32 Num() const;
+
+    /** Clears all arrays, keeping their allocations for reuse. */
+    void ResetForReuse(int32 ExpectedNum);
+
+    SIZE_T GetAllocatedSize() const;
+};
+
+typedef TSharedPtr<const FInteractiveObjectRegistrySnapshot, ESPMode::ThreadSafe> FInteractiveObjectRegistrySnapshotPtr;
+
+/**
+ * Publishes registry snapshots from one writer to any number of reader threads, RCU style.
+ *
+ * The writer fills a snapshot nobody else can see, then swaps it in as current. Readers take a
+ * reference to the current snapshot and keep reading it for as long as they like; a replaced snapshot
+ * lives until its last reader lets go. The swap itself is a pointer exchange under a reader-writer lock
+ * held only for a reference count update, so neither side ever waits for the other's work.
+ *
+ * Double buffered: the snapshot retired by the previous publish is refilled in place by the next
+ * write as soon as no reader holds it, so steady state publishing does not allocate.
+ *
+ * AllocateForWrite and Publish must be called from a single writer thread. Acquire is safe from any thread.
+ */
+class INTERACTIVEOBJECTMANAGER_API FInteractiveObjectSnapshotPublisher
+{
+public:
+    typedef TSharedRef<FInteractiveObjectRegistrySnapshot, ESPMode::ThreadSafe> FWritableSnapshotRef;
+
+    /** Returns a snapshot only the writer can see, reset and sized for ExpectedNum objects. */
+    FWritableSnapshotRef AllocateForWrite(int32 ExpectedNum);
+
+    /** Makes the snapshot current and stamps it with the next version. Must not be modified afterwards. */
+    void Publish(const FWritableSnapshotRef& Snapshot);
+
+    /** Returns the current snapshot, or nullptr before the first publish. Any thread. */
+    FInteractiveObjectRegistrySnapshotPtr Acquire() const;
+
+    /** Drops the current and retired snapshots. Readers keep the ones they already hold. */
+    void Reset();
+
+    /** Version of the last published snapshot, 0 before the first publish. */
+    uint64 GetPublishedVersion() const;
+
+    /** Counters of one RunStressTest run, summed over all readers. */
+    struct FStressTestResult
+    {
+        int64 TotalAcquires = 0;
+
+        /** Acquires that returned the version the reader had already seen. Expected, not a failure. */
+        int64 TotalStaleReads = 0;
+
+        /** Versions going backwards, mismatched column sizes or entries not matching their version. */
+        int64 TotalViolations = 0;
+    };
+
+    /**
+     * Runs NumReaders task graph readers against a private publisher while the calling thread
+     * publishes NumPublishes synthetic snapshots of NumObjects entries, then logs throughput and
+     * any consistency violation seen by the readers. Used by the IOM.Snapshot.StressTest console command
+     * and the InteractiveObjectManager.Snapshot.StressTest automation test.
+     */
+    static FStressTestResult RunStressTest(int32 NumReaders, int32 NumPublishes, int32 NumObjects);
+
+private:
+    /** Guards the Current pointer exchange only. */
+    mutable FRWLock CurrentLock;
+
+    TSharedPtr<FInteractiveObjectRegistrySnapshot, ESPMode::ThreadSafe> Current;
+
+    /** Snapshot replaced by the last publish. Writer thread only. */
+    TSharedPtr<FInteractiveObjectRegistrySnapshot, ESPMode::ThreadSafe> Retired;
+
+    /** Last stamped version. Writer thread only. */
+    uint64 LastVersion = 0;
+};
@@ -0,0 +1,122 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FConvexVolume;
+
+/**
+ * Loose uniform grid over axis aligned bounding boxes, keyed by registry slot index.
+ *
+ * Each entry lives in the single cell that contains its center. Boxes extending at most one
+ * cell size from their center on every axis are kept in the grid, so queries only widen their
+ * search range by one cell. Larger boxes are kept in a separate list that every query tests
+ * linearly, so a few of them never widen the search for all the others. Add, update and remove
+ * are O(1); queries touch only the cells in range, or every occupied cell when that is cheaper.
+ * Ray queries walk the grid front to back and stop once no closer hit is possible.
+ *
+ * Not thread safe. Owned and updated by UInteractiveObjectManagerSubsystem on the game thread.
+ */
+class INTERACTIVEOBJECTMANAGER_API FInteractiveObjectSpatialHash
+{
+public:
+    explicit FInteractiveObjectSpatialHash(float InCellSize = 500.0f);
+
+    /** Removes all entries and changes the cell size. */
+    void Reset(float NewCellSize);
+
+    /** Inserts or moves the entry of a slot. */
+    void Update(int32 SlotIndex, const FVector& Center, const FVector& Extent);
+
+    /** Removes the entry of a slot. Does nothing if the slot has no entry. */
+    void Remove(int32 SlotIndex);
+
+    /** Appends slots whose box overlaps the query sphere. */
+    void QuerySphere(const FVector& Center, float Radius, TArray<int32>& OutSlots) const;
+
+    /** Appends slots whose box overlaps the query box. */
+    void QueryBox(const FBox& Box, TArray<int32>& OutSlots) const;
+
+    /** Appends slots whose box intersects the convex volume, for example a view frustum. */
+    void QueryConvexVolume(const FConvexVolume& Volume, TArray<int32>& OutSlots) const;
+
+    /**
+     * Finds the closest box hit by the ray within MaxDistance. Direction must be normalized.
+     * Returns the slot, or INDEX_NONE on a miss. Rays starting inside a box hit it at distance 0.
+     */
+    int32 Raycast(const FVector& Origin, const FVector& Direction, float MaxDistance, float& OutHitDistance) const;
+
+    /** Returns the box stored for a slot. Returns false if the slot has no entry. */
+    bool GetEntry(int32 SlotIndex, FVector& OutCenter, FVector& OutExtent) const;
+
+    /** Number of entries. */
+    int32 Num() const;
+
+    /** Bytes allocated by entries and cells. */
+    SIZE_T GetAllocatedSize() const;
+
+    /**
+     * Compares sphere queries and raycasts against a brute force scan over NumEntries random
+     * boxes and logs timings. Used by the IOM.Spatial.Benchmark console command.
+     */
+    static void RunBenchmark(int32 NumEntries, int32 NumQueries);
+
+private:
+    struct FEntry
+    {
+        FVector Center = FVector::ZeroVector;
+        FVector Extent = FVector::ZeroVector;
+        FIntVector Cell = FIntVector::ZeroValue;
+
+        /** Position inside the cell array, or inside OversizedSlots. INDEX_NONE when the slot has no entry. */
+        int32 IndexInCell = INDEX_NONE;
+
+        /** True when the box is too large for the grid and the entry lives in OversizedSlots. */
+        bool bIsOversized = false;
+    };
+
+    /** Entries indexed by slot. Slots without an entry have IndexInCell == INDEX_NONE. */
+    TArray<FEntry> Entries;
+
+    /** Slot indices per occupied cell. */
+    TMap<FIntVector, TArray<int32>> Cells;
+
+    float CellSize;
+    float InverseCellSize;
+
+    /** Slots whose box extends more than CellSize from its center on some axis. Tested by every query. */
+    TArray<int32> OversizedSlots;
+
+    /** Smallest and largest coordinate of any occupied cell, rays are clipped against the range. */
+    mutable FIntVector MinOccupiedCell;
+    mutable FIntVector MaxOccupiedCell;
+
+    /** Set once a cell on the border of the range empties. The range is recomputed by the next raycast. */
+    mutable bool bIsOccupiedCellRangeDirty;
+
+    int32 NumEntries;
+
+    FIntVector ToCell(const FVector& Location) const;
+
+    /** Adds the entry to its cell, or to OversizedSlots. */
+    void AddToCell(int32 SlotIndex, FEntry& Entry);
+
+    /** Removes the entry from its cell, or from OversizedSlots. */
+    void RemoveFromCell(FEntry& Entry);
+
+    /** Recomputes MinOccupiedCell and MaxOccupiedCell from the occupied cells if they are dirty. */
+    void RefreshOccupiedCellRange() const;
+
+    /** Calls Visitor for every entry whose cell lies in the box widened by a cell, and for every oversized entry. */
+    void ForEachCandidateInBox(const FBox& SearchBox, TFunctionRef<void(int32 SlotIndex, const FEntry& Entry)> Visitor) const;
+
+    /** Walks the grid cells along the ray from EnterDistance to ExitDistance, keeping the closest hit in InOutBestSlotIndex. */
+    void RaycastGrid(const FVector& Origin, const FVector& Direction, const FVector& InverseDirection, float EnterDistance, float ExitDistance, int32& InOutBestSlotIndex, float& InOutBestDistance) const;
+
+    /** Tests the ray against one entry and keeps it in InOutBestSlotIndex if it is the closest hit so far. */
+    void TestRayEntry(int32 SlotIndex, const FVector& Origin, const FVector& InverseDirection, int32& InOutBestSlotIndex, float& InOutBestDistance) const;
+
+    /** Slab test of a ray against a box. Returns the entry distance clamped to zero, or false on a miss. */
+    static bool IntersectRayBox(const FVector& Origin, const FVector& InverseDirection, const FVector& BoxMin, const FVector& BoxMax, float MaxDistance, float& OutEnterDistance, float& OutExitDistance);
+};
@@ -1,151 +1,1339 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Subsystems/WorldSubsystem.h"
-#include "InteractiveObjectManagerTypes.h"
-#include "InteractiveObjectManagerSubsystem.generated.h"
-
-class UInteractiveObjectComponent;
-
-/**
- * Lightweight item used by UI to present interactive objects.
- */
-USTRUCT(BlueprintType)
-struct FInteractiveObjectListItem
-{
-    GENERATED_BODY()
-
-    /** Runtime Id assigned by the subsystem. */
-    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
-    int32 Id = INDEX_NONE;
-
-    /** Human readable display name for UI. */
-    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
-    FString DisplayName;
-};
-
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInteractiveObjectsListChangedDynamic, const TArray<FInteractiveObjectListItem>&, Objects);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSelectedInteractiveObjectChangedDynamic, int32, SelectedObjectId);
-
-/**
- * World level subsystem that keeps track of all interactive objects in a world
- * and exposes a simple selection and operation API for UI.
- *
- * Primitive actor classes (cube, sphere) are resolved from
- * UInteractiveObjectManagerDeveloperSettings in Project Settings.
- */
-UCLASS()
-class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectManagerSubsystem : public UWorldSubsystem
-{
-    GENERATED_BODY()
-
-public:
-    UInteractiveObjectManagerSubsystem();
-
-    // UWorldSubsystem interface
-    virtual void Deinitialize() override;
-
-    /**
-     * Spawns a new interactive primitive using default settings.
-     *
-     * Default spawn type is taken from UInteractiveObjectSettings.
-     * Primitive actor class is resolved from developer settings.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void SpawnDefaultObject();
-
-    /**
-     * Spawns a new interactive primitive of the given type.
-     *
-     * Cube or sphere actor class is resolved from developer settings
-     * (no hardcoded asset paths in code).
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void SpawnObjectOfType(EInteractiveObjectSpawnType SpawnType);
-
-    /** Registers an interactive object component in this world. */
-    void RegisterInteractiveObject(UInteractiveObjectComponent* InteractiveComponent);
-
-    /** Unregisters an interactive object component from this world. */
-    void UnregisterInteractiveObject(UInteractiveObjectComponent* InteractiveComponent);
-
-    /** Returns a lightweight snapshot of all interactive objects for UI. */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void GetInteractiveObjectsList(TArray<FInteractiveObjectListItem>& OutItems);
-
-    /** Selects an object by its runtime Id. Returns true if selection changed. */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    bool SelectObjectById(int32 ObjectId);
-
-    /** Selects an object by its index in the current list. Mostly for simple debug cases. */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    bool SelectObjectByIndex(int32 Index);
-
-    /** Clears current selection. Returns true if there was a selection before. */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    bool ClearSelection();
-
-    /** Returns info about currently selected object, if any. */
-    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager")
-    FInteractiveObjectListItem GetSelectedObjectInfo(bool& bOutIsValid) const;
-
-    /**
-     * Returns current visual state (color and uniform scale) of the selected object, if any.
-     *
-     * bOutHasSelection will be true only when there is a valid selected interactive object.
-     * When there is no selection or it became invalid, OutColor and OutScale are filled with
-     * safe default values taken from UInteractiveObjectSettings (or hardcoded fallback).
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void GetSelectedObjectVisualState(bool& bOutHasSelection, FLinearColor& OutColor, float& OutScale) const;
-
-    /** Sets color on the currently selected object. Returns true if operation succeeded. */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    bool SetSelectedObjectColor(const FLinearColor& NewColor);
-
-    /** Sets uniform scale on the currently selected object. Returns true if operation succeeded. */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    bool SetSelectedObjectUniformScale(float NewUniformScale);
-
-    /** Destroys the currently selected object. Returns true if an object was removed. */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    bool DeleteSelectedObject();
-
-    /** Fired whenever the list of interactive objects changes. */
-    UPROPERTY(BlueprintAssignable, Category = "InteractiveObjectManager")
-    FInteractiveObjectsListChangedDynamic OnObjectsListChanged;
-
-    /** Fired whenever the selected object changes. SelectedObjectId can be INDEX_NONE. */
-    UPROPERTY(BlueprintAssignable, Category = "InteractiveObjectManager")
-    FSelectedInteractiveObjectChangedDynamic OnSelectedObjectChanged;
-
-private:
-    struct FInteractiveObjectRecord
-    {
-        int32 ObjectId = INDEX_NONE;
-        TWeakObjectPtr<UInteractiveObjectComponent> Component;
-    };
-
-    /** Next runtime Id to assign to a newly registered object. */
-    int32 NextObjectId;
-
-    /** Id of the currently selected interactive object, or INDEX_NONE if none is selected. */
-    int32 SelectedObjectId;
-
-    /** Weak pointer to the currently selected component. */
-    TWeakObjectPtr<UInteractiveObjectComponent> SelectedObject;
-
-    /** All interactive objects registered in this world. */
-    TArray<FInteractiveObjectRecord> RegisteredObjects;
-
-    void CleanupInvalidRecords();
-
-    FInteractiveObjectRecord* FindRecordById(int32 ObjectId);
-    FInteractiveObjectRecord* FindRecordByComponent(UInteractiveObjectComponent* InteractiveComponent);
-
-    void InvalidateSelectionIfNoLongerValid();
-    void BroadcastObjectsListChanged();
-    void BroadcastSelectedObjectChanged();
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "InteractiveObjectManagerTypes.h"
+#include "Async/Future.h"
+#include "Math/RandomStream.h"
+#include "Commands/InteractiveObjectCommandQueue.h"
+#include "Journal/InteractiveObjectJournal.h"
+#include "Materials/InteractiveObjectMaterialCache.h"
+#include "Persistence/InteractiveObjectCheckpointStore.h"
+#include "Persistence/InteractiveObjectSceneFile.h"
+#include "Persistence/InteractiveObjectWriteAheadLog.h"
+#include "Replay/InteractiveObjectSessionTrace.h"
+#include "Snapshot/InteractiveObjectRegistrySnapshot.h"
+#include "Spatial/InteractiveObjectSpatialHash.h"
+#include "Tasks/Task.h"
+#include "InteractiveObjectManagerSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UInteractiveObjectComponent;
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+struct FConvexVolume;
+
+/**
+ * Lightweight item used by UI to present interactive objects.
+ */
+USTRUCT(BlueprintType)
+struct FInteractiveObjectListItem
+{
+    GENERATED_BODY()
+
+    /** Runtime Id assigned by the subsystem. */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+    int32 Id = INDEX_NONE;
+
+    /** Generational handle of the object. Preferred over Id for select, edit and delete calls. */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+    FInteractiveObjectHandle Handle;
+
+    /**
+     * Display name as a string. Deprecated: left empty by the subsystem, because filling it copied a string
+     * for every row of every list refresh. Bind DisplayNameText instead, or fill it through
+     * UInteractiveObjectManagerSubsystem::FillListItemDisplayNameStrings where a string is really needed.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager", meta = (DeprecatedProperty, DeprecationMessage = "Use DisplayNameText. Empty unless filled by FillListItemDisplayNameStrings."))
+    FString DisplayName;
+
+    /** Human readable display name for UI. Shares the text resolved at registration, copying it does not allocate. */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+    FText DisplayNameText;
+};
+
+/**
+ * Incremental change set of the interactive objects list between two flushes.
+ *
+ * Listeners that track ListVersion can apply deltas in order and only touch affected rows.
+ * If a delta arrives with a version that does not directly follow the last applied one,
+ * the listener missed an update and should resync from GetInteractiveObjectsList.
+ */
+USTRUCT(BlueprintType)
+struct FInteractiveObjectsListDelta
+{
+    GENERATED_BODY()
+
+    /** Monotonically increasing list version after this delta is applied. */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+    int64 ListVersion = 0;
+
+    /** Objects registered since the previous delta. */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+    TArray<FInteractiveObjectListItem> AddedItems;
+
+    /** Runtime Ids of objects removed since the previous delta. */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+    TArray<int32> RemovedIds;
+
+    /** Runtime Ids of objects whose presented state changed since the previous delta. */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+    TArray<int32> ChangedIds;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInteractiveObjectsListChangedDynamic, const TArray<FInteractiveObjectListItem>&, Objects);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInteractiveObjectsListDeltaDynamic, const FInteractiveObjectsListDelta&, Delta);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSelectedInteractiveObjectChangedDynamic, int32, SelectedObjectId);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInteractiveObjectSelectionChangedDynamic, int32, SelectedCount);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FInteractiveObjectSpawnBatchProgressDynamic, int32, BatchId, int32, SpawnedCount, int32, RequestedCount);
+
+/**
+ * Inactive actors of one class, parked hidden and without collision until the next spawn of that class.
+ */
+USTRUCT()
+struct FInteractiveObjectActorPool
+{
+    GENERATED_BODY()
+
+    /** Parked actors. Used from the back. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AActor>> InactiveActors;
+
+    /** Estimated memory of one parked actor including its components, measured on first release. */
+    int64 EstimatedBytesPerActor = 0;
+
+    /** Spawns served from this pool. */
+    int32 Hits = 0;
+
+    /** Spawns of this class that had to construct a new actor. */
+    int32 Misses = 0;
+
+    /** Released actors destroyed because the pool was full. */
+    int32 Overflows = 0;
+};
+
+/**
+ * Objects of one class drawn as instances of a single instanced static mesh component.
+ *
+ * Instance indices stay dense: removing an object moves the last instance into its index,
+ * and InstanceSlots maps every index back to the registry slot of the object it draws.
+ */
+USTRUCT()
+struct FInteractiveObjectInstanceBatch
+{
+    GENERATED_BODY()
+
+    /** Class the objects of this batch stand for in journal, scene and log records. */
+    UPROPERTY(Transient)
+    TObjectPtr<UClass> ObjectClass;
+
+    /** Actor spawned by the subsystem to own MeshComponent. */
+    UPROPERTY(Transient)
+    TObjectPtr<AActor> OwnerActor;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UInstancedStaticMeshComponent> MeshComponent;
+
+    /** Registry slot of the object drawn by each instance index. */
+    TArray<int32> InstanceSlots;
+
+    /** Bounds of the class mesh at unit scale, transformed per instance for the spatial index. */
+    FBoxSphereBounds MeshBounds = FBoxSphereBounds(ForceInit);
+
+    /** Display names of the objects in this batch are this name suffixed with their Id. Spelled as the class is. */
+    FString DisplayBaseName;
+
+    EInteractiveObjectPrimitiveType PrimitiveType = EInteractiveObjectPrimitiveType::Other;
+};
+
+/**
+ * World level subsystem that keeps track of all interactive objects in a world
+ * and exposes a simple selection and operation API for UI.
+ *
+ * Primitive actor classes (cube, sphere) are resolved from
+ * UInteractiveObjectManagerDeveloperSettings in Project Settings.
+ *
+ * List and selection notifications are coalesced: mutations only mark them dirty
+ * and they are broadcast once per frame from Tick (rate limited by the
+ * IOM.Notifications.MaxFlushRate console variable) or from FlushPendingNotifications.
+ *
+ * Per object visual state (color, scale, primitive type, flags and owning slot) lives in
+ * contiguous columns owned by the subsystem, parallel to the dense record array.
+ * UInteractiveObjectComponent reads and writes through them while registered.
+ *
+ * Selection is a set of objects stored as a bitset over registry slots. The most recently
+ * selected object is the primary selection, which the single object selection API reports.
+ * Bulk operations on the selection run in one pass and produce one coalesced notification.
+ *
+ * Object bounds are kept in a loose grid spatial index, updated on register, move, scale
+ * and unregister, and answered by the QueryObjectsIn* functions. Cell size comes from
+ * the IOM.Spatial.CellSize console variable.
+ *
+ * Worker threads read the registry through FInteractiveObjectRegistrySnapshot, an immutable copy
+ * published at most once per frame from Tick when something changed. See AcquireSnapshot.
+ *
+ * Deleted objects are parked in a per class actor pool and reused by later spawns of that class.
+ * Pool prewarm and max sizes come from developer settings.
+ *
+ * With an instanced rendering mode in developer settings, spawned objects have no actor. Each class
+ * is drawn by one shared instanced static mesh component, color goes to per instance custom data and
+ * scale to the instance transform. Records of such objects hold an instance instead of a component,
+ * and the handle based API treats both kinds alike. See FInteractiveObjectInstanceBatch.
+ *
+ * Interactive components that still color through dynamic material instances can take them from a shared,
+ * reference counted cache keyed by parent material and quantized color. See FInteractiveObjectMaterialCache.
+ *
+ * Records are removed when their component ends play or their actor is destroyed.
+ * Records whose component was collected without either event are swept incrementally
+ * after garbage collection, within the IOM.Registry.SweepBudget per frame.
+ * Query functions never mutate the registry.
+ */
+UCLASS()
+class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectManagerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UInteractiveObjectManagerSubsystem();
+
+    // UWorldSubsystem interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual bool IsTickableWhenPaused() const override;
+
+    /**
+     * Spawns a new interactive primitive using default settings.
+     *
+     * Default spawn type is taken from UInteractiveObjectSettings.
+     * Primitive actor class is resolved from developer settings.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void SpawnDefaultObject();
+
+    /**
+     * Spawns a new interactive primitive of the given type.
+     *
+     * Cube or sphere actor class is resolved from developer settings
+     * (no hardcoded asset paths in code).
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void SpawnObjectOfType(EInteractiveObjectSpawnType SpawnType);
+
+    /**
+     * Queues Count objects of the given type to be spawned over the following frames.
+     *
+     * Each frame spends at most Params.FrameBudgetMilliseconds on spawning. Progress is reported
+     * once per frame through OnSpawnBatchProgress and completion through OnSpawnBatchCompleted.
+     * Batches are processed in the order they were queued.
+     *
+     * Returns the batch Id, or INDEX_NONE if Count is not positive.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    int32 SpawnObjectsBatch(int32 Count, EInteractiveObjectSpawnType SpawnType, const FInteractiveObjectBatchSpawnParams& Params);
+
+    /** Stops a queued batch. Already spawned objects stay. OnSpawnBatchCompleted fires with the partial count. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool CancelSpawnBatch(int32 BatchId);
+
+    /** Returns true while the batch still has objects left to spawn. */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager")
+    bool IsSpawnBatchPending(int32 BatchId) const;
+
+    /** Registers an interactive object component in this world. */
+    void RegisterInteractiveObject(UInteractiveObjectComponent* InteractiveComponent);
+
+    /** Unregisters an interactive object component from this world. */
+    void UnregisterInteractiveObject(UInteractiveObjectComponent* InteractiveComponent);
+
+    /** Returns the list item of a single object. Returns false if no object has this Id. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool GetObjectListItem(int32 ObjectId, FInteractiveObjectListItem& OutItem) const;
+
+    /** Returns the version of the objects list, incremented by every broadcast delta. */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager")
+    int64 GetObjectsListVersion() const;
+
+    /**
+     * Fills OutItems with at most Count objects starting at Offset in the order given by SortKey.
+     * Returns the total number of objects, so UI can size a virtualized list.
+     *
+     * Each sort key has an index that is built on the first page request for that key and then
+     * maintained incrementally, so fetching a page costs O(Count). A key that receives more than
+     * IOM.List.SortIndexRebuildThreshold changes between two page requests drops its index and
+     * rebuilds it on the next request instead.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    int32 GetInteractiveObjectsPage(int32 Offset, int32 Count, EInteractiveObjectSortKey SortKey, bool bAscending, TArray<FInteractiveObjectListItem>& OutItems);
+
+    /** Returns a lightweight snapshot of all interactive objects for UI. */
+    UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "InteractiveObjectManager")
+    void GetInteractiveObjectsList(TArray<FInteractiveObjectListItem>& OutItems) const;
+
+    /** Fills the deprecated DisplayName string of every item from its DisplayNameText. Allocates one string per item. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    static void FillListItemDisplayNameStrings(UPARAM(ref) TArray<FInteractiveObjectListItem>& Items);
+
+    /** Returns true if the handle refers to an object that is still registered. O(1). */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager")
+    bool IsObjectHandleValid(FInteractiveObjectHandle Handle) const;
+
+    /** Returns the handle of the object with the given runtime Id, or an unset handle. */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager")
+    FInteractiveObjectHandle GetHandleForObjectId(int32 ObjectId) const;
+
+    /** Returns the handle of a registered component, or an unset handle. */
+    FInteractiveObjectHandle GetHandleForComponent(const UInteractiveObjectComponent* InteractiveComponent) const;
+
+    /** Returns the display name resolved at registration, or empty text if the handle is stale. */
+    const FText& GetObjectDisplayName(FInteractiveObjectHandle Handle) const;
+
+    /** Returns the registered component behind a handle, or nullptr if the handle is stale. */
+    UInteractiveObjectComponent* ResolveHandle(FInteractiveObjectHandle Handle) const;
+
+    /** Replaces the selection with the object behind the handle. Returns true if selection changed. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool SelectObject(FInteractiveObjectHandle Handle);
+
+    /** Adds an object to the selection and makes it the primary selection. Returns true if selection changed. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Selection")
+    bool AddObjectToSelection(FInteractiveObjectHandle Handle);
+
+    /** Removes an object from the selection. Another selected object becomes primary if needed. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Selection")
+    bool RemoveObjectFromSelection(FInteractiveObjectHandle Handle);
+
+    /** Adds the object to the selection if it is not selected, removes it otherwise. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Selection")
+    bool ToggleObjectSelection(FInteractiveObjectHandle Handle);
+
+    /**
+     * Selects all objects behind the handles in one pass. Stale handles are skipped.
+     *
+     * Replaces the current selection unless bAddToSelection is true.
+     * The last valid handle becomes the primary selection. Returns the number of valid handles.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Selection")
+    int32 SelectObjects(const TArray<FInteractiveObjectHandle>& Handles, bool bAddToSelection);
+
+    /** Selects every registered object. Returns the selection size. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Selection")
+    int32 SelectAllObjects();
+
+    /** Returns true if the handle is valid and its object is part of the selection. */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager|Selection")
+    bool IsObjectSelected(FInteractiveObjectHandle Handle) const;
+
+    /** Returns the number of selected objects. */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager|Selection")
+    int32 GetSelectedObjectCount() const;
+
+    /** Fills OutHandles with the handles of all selected objects, in slot order. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Selection", meta = (BlueprintPure = "false"))
+    void GetSelectedObjectHandles(TArray<FInteractiveObjectHandle>& OutHandles) const;
+
+    /** Sets color on every selected object in one pass. Returns the number of objects changed. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Selection")
+    int32 SetSelectedObjectsColor(const FLinearColor& NewColor);
+
+    /** Sets uniform scale on every selected object in one pass. Returns the number of objects changed. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Selection")
+    int32 SetSelectedObjectsUniformScale(float NewUniformScale);
+
+    /**
+     * Removes every selected object. Returns the number of objects removed.
+     *
+     * Like DeleteSelectedObject, the selection moves to a remaining object afterwards.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Selection")
+    int32 DeleteSelectedObjects();
+
+    /** Returns the handle of the primary selected object, or an unset handle. */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager")
+    FInteractiveObjectHandle GetSelectedObjectHandle() const;
+
+    /** Selects an object by its runtime Id. Returns true if selection changed. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool SelectObjectById(int32 ObjectId);
+
+    /**
+     * Selects an object by its index in the current list. Mostly for simple debug cases.
+     *
+     * The registry uses swap-remove, so indices are only meaningful until the next removal.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool SelectObjectByIndex(int32 Index);
+
+    /** Clears the whole selection. Returns true if there was a selection before. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool ClearSelection();
+
+    /** Returns info about currently selected object, if any. */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager")
+    FInteractiveObjectListItem GetSelectedObjectInfo(bool& bOutIsValid) const;
+
+    /**
+     * Returns current visual state (color and uniform scale) of the selected object, if any.
+     *
+     * bOutHasSelection will be true only when there is a valid selected interactive object.
+     * When there is no selection or it became invalid, OutColor and OutScale are filled with
+     * safe default values taken from UInteractiveObjectSettings (or hardcoded fallback).
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void GetSelectedObjectVisualState(bool& bOutHasSelection, FLinearColor& OutColor, float& OutScale) const;
+
+    /** Sets color on the primary selected object. Returns true if operation succeeded. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool SetSelectedObjectColor(const FLinearColor& NewColor);
+
+    /** Sets uniform scale on the primary selected object. Returns true if operation succeeded. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool SetSelectedObjectUniformScale(float NewUniformScale);
+
+    /** Removes the primary selected object. Returns true if an object was removed. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool DeleteSelectedObject();
+
+    /** Sets color on the object behind the handle. Returns false if the handle is stale. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool SetObjectColor(FInteractiveObjectHandle Handle, const FLinearColor& NewColor);
+
+    /** Sets uniform scale on the object behind the handle. Returns false if the handle is stale. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool SetObjectUniformScale(FInteractiveObjectHandle Handle, float NewUniformScale);
+
+    /** Reads the color of the object behind the handle. Returns false if the handle is stale. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool GetObjectColor(FInteractiveObjectHandle Handle, FLinearColor& OutColor) const;
+
+    /** Reads the uniform scale of the object behind the handle. Returns false if the handle is stale. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool GetObjectUniformScale(FInteractiveObjectHandle Handle, float& OutUniformScale) const;
+
+    /**
+     * Removes the object behind the handle. Returns true if an object was removed.
+     *
+     * The actor is parked in the pool of its class for reuse, or destroyed when
+     * pooling is disabled or the pool is full.
+     *
+     * If the object was selected, the selection is cleared. DeleteSelectedObject
+     * additionally moves the selection to another remaining object.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    bool DeleteObject(FInteractiveObjectHandle Handle);
+
+    /**
+     * Broadcasts pending list and selection notifications immediately.
+     *
+     * Call after a bulk operation when listeners must observe the result before the next frame.
+     * Ignores the flush rate limit. Does nothing when no notification is pending.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void FlushPendingNotifications();
+
+    /**
+     * Refreshes the spatial index entry of an object from its actor bounds.
+     *
+     * Called by UInteractiveObjectComponent when its owner moves. Scale changes made
+     * through the subsystem update the index on their own.
+     */
+    void NotifyObjectTransformChanged(FInteractiveObjectHandle Handle);
+
+    /** True if interactive components should take their dynamic material instances from AcquireSharedMaterial. */
+    bool IsSharingDynamicMaterials() const;
+
+    /**
+     * True after the write-ahead log failed to write or fsync and was closed. Changes made since are not
+     * recoverable after a crash until the default scene is saved again, which starts a new log.
+     */
+    bool HasWriteAheadLogFailed() const;
+
+    /**
+     * Returns a dynamic material instance of ParentMaterial with ParameterName set to Color, shared with every
+     * caller asking for the same parent, parameter and quantized color. Must not be modified by the caller.
+     * Each successful call is balanced by one ReleaseSharedMaterial. See FInteractiveObjectMaterialCache.
+     */
+    UMaterialInstanceDynamic* AcquireSharedMaterial(UMaterialInterface* ParentMaterial, FName ParameterName, const FLinearColor& Color);
+
+    /** Drops a reference taken by AcquireSharedMaterial. Safe to call with nullptr or after the world is gone. */
+    void ReleaseSharedMaterial(UMaterialInstanceDynamic* MaterialInstance);
+
+    /**
+     * Returns the closest object whose bounds box is hit by the ray within MaxDistance, or an unset handle.
+     *
+     * Runs against the spatial index only, no physics trace. Used for click selection.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Spatial", meta = (BlueprintPure = "false"))
+    FInteractiveObjectHandle QueryObjectAlongRay(const FVector& RayOrigin, const FVector& RayDirection, float MaxDistance, float& OutHitDistance) const;
+
+    /** Returns the runtime Id of the object behind the handle, or INDEX_NONE if the handle is stale. */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager")
+    int32 GetObjectIdForHandle(FInteractiveObjectHandle Handle) const;
+
+    /** Fills OutHandles with objects whose bounds overlap the sphere. Order is unspecified. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Spatial", meta = (BlueprintPure = "false"))
+    void QueryObjectsInRadius(const FVector& Center, float Radius, TArray<FInteractiveObjectHandle>& OutHandles) const;
+
+    /** Fills OutHandles with objects whose bounds overlap the box. Order is unspecified. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Spatial", meta = (BlueprintPure = "false"))
+    void QueryObjectsInBox(const FBox& Box, TArray<FInteractiveObjectHandle>& OutHandles) const;
+
+    /** Fills OutHandles with objects whose bounds intersect the convex volume, for example a view frustum. */
+    void QueryObjectsInFrustum(const FConvexVolume& Frustum, TArray<FInteractiveObjectHandle>& OutHandles) const;
+
+    /**
+     * Fills OutHandles with objects whose bounds center projects inside a screen rectangle.
+     *
+     * Candidates are pre-culled with the sub-frustum spanned by the rectangle through the spatial index,
+     * then projected in parallel. RectStart and RectEnd are opposite corners in the same pixel space as
+     * ViewRect, in any order. Used for marquee selection.
+     */
+    void QueryObjectsInScreenRect(const FMatrix& ViewProjectionMatrix, const FIntRect& ViewRect, const FVector2D& RectStart, const FVector2D& RectEnd, TArray<FInteractiveObjectHandle>& OutHandles) const;
+
+    /**
+     * Returns the latest published registry snapshot, or nullptr before the first publish. Safe from any thread.
+     *
+     * The snapshot stays valid and unchanged for as long as the caller holds the pointer. Worker tasks should
+     * acquire once per job and keep the pointer rather than the subsystem. Snapshots lag the game thread by up
+     * to one frame and are only published while IOM.Snapshot.Enabled is set.
+     */
+    FInteractiveObjectRegistrySnapshotPtr AcquireSnapshot() const;
+
+    /**
+     * Queues a mutation for the next frame. Safe from any thread.
+     *
+     * Queued commands run on the game thread in one pass at the start of the subsystem tick, before spawn
+     * batches and the notification flush, so their changes show up in the same frame's notifications and
+     * snapshot. See FInteractiveObjectCommandQueue for ordering. The command receives nullptr instead of the
+     * subsystem when it is discarded because the world is shutting down.
+     */
+    void EnqueueCommand(FInteractiveObjectCommandQueue::FCommand&& Command);
+
+    /** Queued SpawnObjectsBatch. Any thread. Resolves on the game thread to the batch Id, or INDEX_NONE. */
+    TFuture<int32> EnqueueSpawnObjectsBatch(int32 Count, EInteractiveObjectSpawnType SpawnType, const FInteractiveObjectBatchSpawnParams& Params);
+
+    /** Queued SelectObject. Any thread. Resolves on the game thread to the call result. */
+    TFuture<bool> EnqueueSelectObject(FInteractiveObjectHandle Handle);
+
+    /** Queued SelectObjects. Any thread. Resolves on the game thread to the number of objects selected. */
+    TFuture<int32> EnqueueSelectObjects(TArray<FInteractiveObjectHandle>&& Handles, bool bAddToSelection);
+
+    /** Queued SetObjectColor. Any thread. Resolves on the game thread to the call result. */
+    TFuture<bool> EnqueueSetObjectColor(FInteractiveObjectHandle Handle, const FLinearColor& NewColor);
+
+    /** Queued SetObjectUniformScale. Any thread. Resolves on the game thread to the call result. */
+    TFuture<bool> EnqueueSetObjectUniformScale(FInteractiveObjectHandle Handle, float NewUniformScale);
+
+    /** Queued DeleteObject. Any thread. Resolves on the game thread to the call result. */
+    TFuture<bool> EnqueueDeleteObject(FInteractiveObjectHandle Handle);
+
+    /**
+     * Reverts the most recent spawn, delete, color or scale operation still in the journal.
+     * A bulk operation or spawn batch is reverted as a whole. Deleted objects are spawned again from their
+     * class, location, color and scale. Returns the number of operations reverted, 0 if there was nothing to undo.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|History")
+    int32 UndoLastOperation();
+
+    /** Applies the most recently undone operation again. Returns the number of operations applied. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|History")
+    int32 RedoLastOperation();
+
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager|History")
+    bool CanUndo() const;
+
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager|History")
+    bool CanRedo() const;
+
+    /** Forgets every undo and redo step. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|History")
+    void ClearHistory();
+
+    /**
+     * Writes archetype class, transform, color and scale of every registered object to a binary scene file.
+     * An empty FilePath saves to Saved/InteractiveObjects/Scene.iom. Logs gather and write throughput.
+     * Saving to the default path while the write-ahead log is open checkpoints it: the log restarts empty on top of the new file.
+     * Also available as the IOM.Scene.Save console command.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Persistence")
+    bool SaveScene(const FString& FilePath);
+
+    /**
+     * Restores the objects of a scene file through the batch spawn path, FrameBudgetMilliseconds per frame.
+     * The file stays memory mapped until the batch completes. bReplaceExisting deletes every registered object first.
+     * An empty FilePath loads Saved/InteractiveObjects/Scene.iom. Returns the spawn batch Id, or INDEX_NONE on failure.
+     * Also available as the IOM.Scene.Load console command.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Persistence")
+    int32 LoadScene(const FString& FilePath, bool bReplaceExisting = true, float FrameBudgetMilliseconds = 8.0f);
+
+    /**
+     * Starts a checkpoint of the objects changed since the previous one. Objects are serialized a few at a time,
+     * within IOM.Checkpoint.FrameBudgetMs per frame, then compressed and written by a background task.
+     * bFull serializes every object and starts a new chain. Returns false if checkpoints are disabled, one is
+     * still in progress or nothing changed. Also runs every IOM.Checkpoint.IntervalSeconds, and is available
+     * as the IOM.Checkpoint.Save console command.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Persistence")
+    bool RequestCheckpoint(bool bFull = false);
+
+    /**
+     * Restores the objects of the latest checkpoint chain through the batch spawn path, like LoadScene.
+     * Returns the spawn batch Id, or INDEX_NONE on failure. Also available as the IOM.Checkpoint.Load console command.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Persistence")
+    int32 LoadLatestCheckpoint(bool bReplaceExisting = true, float FrameBudgetMilliseconds = 8.0f);
+
+    /** Applies new default spawn settings, as the root widget settings panel does. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
+    void ApplySettings(const FInteractiveObjectSettingsViewData& NewSettings);
+
+    /**
+     * Starts recording every spawn, selection, color, scale, delete, undo, redo and settings call with its frame and time.
+     * Reseeds the spawn random stream and stores the seed, so a replay places objects identically.
+     * Scene and checkpoint loads are not recorded. An empty FilePath records to Saved/InteractiveObjects/Session.iomtrace.
+     * The trace is written when the recording stops. Also available as the IOM.Trace.Record console command.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Trace")
+    bool StartTraceRecording(const FString& FilePath);
+
+    /** Stops the recording and writes the trace. Also available as the IOM.Trace.Stop console command. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Trace")
+    bool StopTraceRecording();
+
+    /**
+     * Replays a recorded trace once primitive classes are loaded, from the state the recording started from, usually a fresh world.
+     * bOriginalPacing holds every call back until the time it was recorded at. Otherwise calls run as soon as the objects
+     * they refer to are registered. Logs frame time statistics when done, to compare builds on an identical workload.
+     * Also available as the IOM.Trace.Replay console command, or -IOMReplay=FilePath on the command line for headless runs,
+     * with -IOMReplayOriginalPacing and -IOMReplayExit to quit once done.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Trace")
+    bool StartTraceReplay(const FString& FilePath, bool bOriginalPacing = false);
+
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager|Trace")
+    bool IsRecordingTrace() const;
+
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager|Trace")
+    bool IsReplayingTrace() const;
+
+    /** Logs registry, actor pool and shared material statistics. Also available as the IOM.Report console command. */
+    void LogRuntimeReport() const;
+
+    /** Time per operation at one registry size of RunRegistryBenchmark, in nanoseconds. */
+    struct FRegistryBenchmarkResult
+    {
+        int32 NumObjects = 0;
+        double RegisterNs = 0.0;
+        double IdLookupNs = 0.0;
+        double HandleLookupNs = 0.0;
+        double SelectNs = 0.0;
+        double UnregisterNs = 0.0;
+    };
+
+    /**
+     * Registers 1000 records and every tenfold up to MaxObjects in a registry outside of any world, looks NumLookups
+     * of them up by Id and by handle, selects NumLookups of them and unregisters them all again. Logs and returns the
+     * time per operation at each size, which should stay flat as the registry grows. Used by the IOM.Registry.Benchmark
+     * console command and the InteractiveObjectManager.Registry.Benchmark automation test.
+     */
+    static TArray<FRegistryBenchmarkResult> RunRegistryBenchmark(int32 MaxObjects, int32 NumLookups);
+
+    /**
+     * Fired whenever the list of interactive objects changes. Coalesced to at most one broadcast per flush.
+     *
+     * Ships the full list, which is only built while something is bound.
+     * Prefer OnObjectsListDelta for large object counts.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "InteractiveObjectManager")
+    FInteractiveObjectsListChangedDynamic OnObjectsListChanged;
+
+    /** Fired whenever the list of interactive objects changes, with only the added, removed and changed entries. */
+    UPROPERTY(BlueprintAssignable, Category = "InteractiveObjectManager")
+    FInteractiveObjectsListDeltaDynamic OnObjectsListDelta;
+
+    /** Fired whenever the selected object changes. SelectedObjectId can be INDEX_NONE. Coalesced to at most one broadcast per flush. */
+    UPROPERTY(BlueprintAssignable, Category = "InteractiveObjectManager")
+    FSelectedInteractiveObjectChangedDynamic OnSelectedObjectChanged;
+
+    /** Fired together with OnSelectedObjectChanged, with the number of selected objects. */
+    UPROPERTY(BlueprintAssignable, Category = "InteractiveObjectManager")
+    FInteractiveObjectSelectionChangedDynamic OnSelectionChanged;
+
+    /** Fired at most once per frame for the spawn batch currently in progress. */
+    UPROPERTY(BlueprintAssignable, Category = "InteractiveObjectManager")
+    FInteractiveObjectSpawnBatchProgressDynamic OnSpawnBatchProgress;
+
+    /** Fired when a spawn batch finished or was cancelled. */
+    UPROPERTY(BlueprintAssignable, Category = "InteractiveObjectManager")
+    FInteractiveObjectSpawnBatchProgressDynamic OnSpawnBatchCompleted;
+
+private:
+    /** Cold per object data. Hot state lives in FObjectColumns at the same dense index. */
+    struct FInteractiveObjectRecord
+    {
+        int32 ObjectId = INDEX_NONE;
+
+        /** Component of an actor backed object. Unset for instanced objects. */
+        TWeakObjectPtr<UInteractiveObjectComponent> Component;
+
+        /** Batch and instance drawing an instanced object, INDEX_NONE for actor backed objects. */
+        int32 InstanceBatchIndex = INDEX_NONE;
+        int32 InstanceIndex = INDEX_NONE;
+
+        /**
+         * Display name resolved once at registration, interned. Only a sort key: names differing in case
+         * share one entry, so the spelling shown comes from DisplayText.
+         */
+        FName DisplayName;
+
+        /** Text built once from the original display string and shared by every list item of this object. */
+        FText DisplayText;
+
+        /** True while the object exists, through its component or its instance. */
+        bool IsValid() const;
+    };
+
+    /**
+     * Structure of arrays holding the hot per object state, parallel to RegisteredObjects.
+     * All columns always have the same length and are swap-removed together.
+     */
+    struct FObjectColumns
+    {
+        /** Slot that owns the object at this dense index. Combined with the slot generation it forms the handle. */
+        TArray<int32> OwningSlots;
+
+        TArray<FLinearColor> Colors;
+
+        /** Hue of Colors, derived once per color change so sorting by hue compares plain floats. */
+        TArray<float> Hues;
+
+        TArray<float> Scales;
+        TArray<EInteractiveObjectPrimitiveType> Types;
+        TArray<EInteractiveObjectFlags> Flags;
+
+        /** Writes a color and its hue. Every color change goes through here to keep Hues in step. */
+        void SetColor(int32 Index, const FLinearColor& NewColor);
+
+        void RemoveAtSwap(int32 Index);
+        void Empty();
+        SIZE_T GetAllocatedSize() const;
+    };
+
+    /**
+     * Registry slot addressed by FInteractiveObjectHandle::SlotIndex.
+     *
+     * Slots are never removed, only released to FreeSlotIndices and reused.
+     * Generation is bumped on release so that older handles become stale.
+     */
+    struct FInteractiveObjectSlot
+    {
+        int32 Generation = 1;
+        int32 DenseIndex = INDEX_NONE;
+    };
+
+    /** Slots ordered by one sort key. Only maintained after the first page request for the key. */
+    struct FObjectSortIndex
+    {
+        /** Slot indices in ascending key order, ties broken by object Id. */
+        TArray<int32> SortedSlots;
+
+        /** True while SortedSlots is current. */
+        bool bIsBuilt = false;
+
+        /** Incremental updates applied since the last page request. */
+        int32 UpdatesSinceLastFetch = 0;
+    };
+
+    static constexpr int32 NumSortKeys = static_cast<int32>(EInteractiveObjectSortKey::Scale) + 1;
+
+    /** Spawn request queued by SpawnObjectsBatch. Color and scale are resolved when queued. */
+    struct FPendingSpawnBatch
+    {
+        int32 BatchId = INDEX_NONE;
+        EInteractiveObjectSpawnType SpawnType = EInteractiveObjectSpawnType::Cube;
+        FInteractiveObjectBatchSpawnParams Params;
+        int32 RequestedCount = 0;
+        int32 ProcessedCount = 0;
+        int32 SpawnedCount = 0;
+
+        /** Journal batch the spawns of this batch are recorded in, 0 before the first spawn. */
+        uint32 JournalBatch = 0;
+
+        /** Scene file restored by this batch, one object per record. Null for batches spawning at random. */
+        TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe> SceneFile;
+
+        /** Classes of the scene file class table, nullptr where a class failed to load. Kept alive by SceneClasses. */
+        TArray<UClass*> SceneFileClasses;
+
+        /** Platform time at which the batch was queued. */
+        double QueueTime = 0.0;
+
+        /** False for batches rebuilding a previous session, whose spawns are not recorded for undo. */
+        bool bIsJournaled = true;
+    };
+
+    /** Next runtime Id to assign to a newly registered object. */
+    int32 NextObjectId;
+
+    /** Handle of the primary selected interactive object, unset if none is selected. Always part of SelectionBits. */
+    FInteractiveObjectHandle SelectedHandle;
+
+    /** Selection set, one bit per slot. Kept as long as Slots. Released slots are always cleared. */
+    TBitArray<> SelectionBits;
+
+    /** Number of set bits in SelectionBits. */
+    int32 SelectedObjectCount;
+
+    /**
+     * All interactive objects registered in this world, stored densely.
+     *
+     * Records are removed with swap-remove, so the order is not stable across removals.
+     * Slots, ObjectIdToSlot and ComponentToSlot locate a record in O(1).
+     */
+    TArray<FInteractiveObjectRecord> RegisteredObjects;
+
+    /** Hot per object state, parallel to RegisteredObjects. */
+    FObjectColumns ObjectColumns;
+
+    /** Flags stored for the next registration. Set around spawns driven by the subsystem. */
+    EInteractiveObjectFlags PendingRegistrationFlags;
+
+    /** Handle slots. A live slot points at its record in RegisteredObjects. */
+    TArray<FInteractiveObjectSlot> Slots;
+
+    /** Released slots waiting to be reused by the next registration. */
+    TArray<int32> FreeSlotIndices;
+
+    /** Bounding boxes of registered objects, keyed by slot index. */
+    FInteractiveObjectSpatialHash SpatialIndex;
+
+    /** Publishes registry snapshots for worker threads. */
+    FInteractiveObjectSnapshotPublisher SnapshotPublisher;
+
+    /** True when the registry changed since the last published snapshot. */
+    bool bIsSnapshotDirty;
+
+    /** Mutations queued from any thread, executed at the start of Tick. */
+    FInteractiveObjectCommandQueue CommandQueue;
+
+    /** Undo and redo history of spawn, delete, color and scale operations. */
+    FInteractiveObjectJournal Journal;
+
+    /** True while undo or redo replays journal records, which must not be recorded again. */
+    bool bIsApplyingJournal;
+
+    /** Log of every mutation since the last checkpoint of the default scene. Open while IOM.WAL.Enabled is set. */
+    FInteractiveObjectWriteAheadLog WriteAheadLog;
+
+    /** Classes already defined in the open log, with their log class index. Filled when objects register. */
+    TMap<const UClass*, uint16> WriteAheadLogClassIndices;
+
+    /** True until the first tick after class loading restores the last checkpoint and replays the log. */
+    bool bIsWriteAheadRecoveryPending;
+
+    /** True once the open log reported an I/O error and was closed. Cleared when a new log opens. */
+    bool bHasWriteAheadLogFailed;
+
+    /** Write-ahead log recovery whose objects are still being respawned. */
+    struct FWriteAheadRecovery
+    {
+        /** Spawn batch restoring the recovered objects, INDEX_NONE while no recovery is in flight. */
+        int32 BatchId = INDEX_NONE;
+
+        /** Log records replayed on top of the default scene. */
+        int32 NumReplayed = 0;
+
+        /** Platform time at which the recovery started. */
+        double StartTime = 0.0;
+    };
+
+    FWriteAheadRecovery WriteAheadRecovery;
+
+    /** Checkpoint being serialized on the game thread, a slice per frame. */
+    struct FActiveCheckpoint
+    {
+        /** Segment being filled. Handed to the write task once every object is serialized. */
+        FInteractiveObjectCheckpointData Data;
+
+        /** Objects left to serialize by a delta checkpoint. A full checkpoint walks the slots instead. */
+        TArray<int32> ObjectIds;
+
+        /** Next entry of ObjectIds, or next slot of a full checkpoint. */
+        int32 Cursor = 0;
+
+        /** Classes already in Data.ClassPaths, with their class index. */
+        TMap<const UClass*, uint16> ClassIndices;
+
+        bool bIsInProgress = false;
+        bool bIsFull = false;
+
+        double StartTime = 0.0;
+        int32 NumSlices = 0;
+        double LongestSliceSeconds = 0.0;
+    };
+
+    FActiveCheckpoint ActiveCheckpoint;
+
+    /** Compresses and writes the last serialized checkpoint. At most one is in flight. */
+    UE::Tasks::TTask<FInteractiveObjectCheckpointWriteResult> CheckpointWriteTask;
+
+    /** Outcome of the last finished checkpoint write, for the runtime report. */
+    FInteractiveObjectCheckpointWriteResult LastCheckpointWrite;
+
+    /** True when objects are tracked for checkpoints. Set from IOM.Checkpoint.Enabled when a game world starts. */
+    bool bIsCheckpointTrackingEnabled;
+
+    /** Objects flagged CheckpointDirty since the last checkpoint started. Can hold Ids deleted meanwhile. */
+    TArray<int32> CheckpointDirtyIds;
+
+    /** Objects deleted since the last checkpoint started. */
+    TArray<int32> CheckpointDeletedIds;
+
+    /** Chain the next delta checkpoint continues, 0 until the first full checkpoint. */
+    uint64 CheckpointChain;
+
+    int32 NextCheckpointSequence;
+
+    /** Platform time the last checkpoint started, or the world started. */
+    double LastCheckpointTime;
+
+    /** Spawn placement and random class picks. Seeded from IOM.Spawn.Seed, a trace recording or a replay. */
+    FRandomStream SpawnRandomStream;
+
+    /** Session being recorded, written when the recording stops. */
+    FInteractiveObjectSessionTrace RecordingTrace;
+    FString RecordingTracePath;
+    bool bIsRecordingTrace;
+    uint64 TraceStartFrame;
+    double TraceStartTime;
+
+    /** Trace index of every object registered since the recording started, keyed by object Id. */
+    TMap<int32, int32> TraceObjectIndices;
+
+    /** True inside a traced call, so the traced calls it makes are not recorded again. */
+    bool bIsInsideTracedCall;
+
+    /** Trace being replayed. */
+    struct FActiveReplay
+    {
+        FInteractiveObjectSessionTrace Trace;
+        FString FilePath;
+
+        bool bIsActive = false;
+
+        /** False until primitive classes are loaded and the initial state is restored. */
+        bool bIsStarted = false;
+
+        bool bOriginalPacing = false;
+        bool bExitWhenDone = false;
+
+        /** Next event to execute. */
+        int32 Cursor = 0;
+
+        /** Handle of every trace index registered so far. */
+        TArray<FInteractiveObjectHandle> Objects;
+
+        uint64 StartFrame = 0;
+        double StartTime = 0.0;
+
+        /** Platform time the next event started waiting for its objects, 0 while none waits. */
+        double WaitStartTime = 0.0;
+
+        double LastTickTime = 0.0;
+        int32 NumFrames = 0;
+        double LongestFrameSeconds = 0.0;
+        int32 NumDivergences = 0;
+    };
+
+    FActiveReplay ActiveReplay;
+
+    /** Sort indices used by GetInteractiveObjectsPage, one per EInteractiveObjectSortKey. */
+    TStaticArray<FObjectSortIndex, NumSortKeys> SortIndices;
+
+    /** True when the object list changed since the last flush. */
+    bool bIsObjectsListDirty;
+
+    /** Version of the objects list, incremented once per broadcast delta. */
+    int64 ObjectsListVersion;
+
+    /** Ids registered since the last flush. */
+    TSet<int32> PendingAddedIds;
+
+    /** Ids removed since the last flush that listeners already know about. */
+    TSet<int32> PendingRemovedIds;
+
+    /** Ids whose presented state changed since the last flush. */
+    TSet<int32> PendingChangedIds;
+
+    /** True when the selection changed since the last flush. */
+    bool bIsSelectionDirty;
+
+    /** Real time in seconds of the last notification flush. Used to honour the flush rate limit. */
+    double LastNotificationFlushTime;
+
+    /** Maps runtime object Id to its slot index. */
+    TMap<int32, int32> ObjectIdToSlot;
+
+    /** Maps a registered component to its slot index. Weak keys still hash after the component dies, so stale entries can be removed. */
+    TMap<TWeakObjectPtr<UInteractiveObjectComponent>, int32> ComponentToSlot;
+
+    /**
+     * Dense index the incremental sweep continues from, walking towards zero.
+     * INDEX_NONE when no sweep is pending.
+     */
+    int32 SweepCursor;
+
+    /** Next Id to assign to a spawn batch. */
+    int32 NextSpawnBatchId;
+
+    /** Spawn batches waiting to be processed, front first. */
+    TArray<FPendingSpawnBatch> PendingSpawnBatches;
+
+    /** Streams primitive classes in at world init. */
+    FStreamableManager StreamableManager;
+
+    /** Handle of the in flight primitive class load. */
+    TSharedPtr<FStreamableHandle> PrimitiveClassesLoadHandle;
+
+    /** Hard reference to the loaded cube class. */
+    UPROPERTY(Transient)
+    TObjectPtr<UClass> LoadedCubeClass;
+
+    /** Hard reference to the loaded sphere class. */
+    UPROPERTY(Transient)
+    TObjectPtr<UClass> LoadedSphereClass;
+
+    /** Hard references to additional archetype classes listed in developer settings. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UClass>> LoadedAdditionalClasses;
+
+    /** Hard references to classes loaded from scene files. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UClass>> SceneClasses;
+
+    /** True once the primitive class load finished. Spawn requests are queued until then. */
+    bool bArePrimitiveClassesLoaded;
+
+    /** True after the first successful spawn, used to log time to first spawn once. */
+    bool bHasSpawnedFirstObject;
+
+    /** Platform time of Initialize. */
+    double InitializeTime;
+
+    /** Platform time at which the primitive classes finished loading. */
+    double PrimitiveClassesLoadedTime;
+
+    /** Actor pools keyed by actor class. */
+    UPROPERTY(Transient)
+    TMap<TObjectPtr<UClass>, FInteractiveObjectActorPool> ActorPools;
+
+    /** Rendering mode from developer settings, read at world init so that a world never mixes modes. */
+    EInteractiveObjectRenderingMode RenderingMode;
+
+    /** Hard reference to the material of instanced objects, null to keep the class mesh materials. */
+    UPROPERTY(Transient)
+    TObjectPtr<UMaterialInterface> LoadedInstancedMaterial;
+
+    /** Instanced batches, one per class drawn instanced. Never removed while the world runs. */
+    UPROPERTY(Transient)
+    TArray<FInteractiveObjectInstanceBatch> InstanceBatches;
+
+    /** Batch index of every class spawned so far, INDEX_NONE for classes drawn as actors. */
+    TMap<const UClass*, int32> InstanceBatchIndices;
+
+    /** Material sharing from developer settings, read at world init. */
+    bool bIsSharingDynamicMaterials;
+
+    /** Dynamic material instances shared between interactive components of the same color. */
+    UPROPERTY(Transient)
+    FInteractiveObjectMaterialCache MaterialCache;
+
+    /** Spawns served from any pool. */
+    int32 TotalPoolHits;
+
+    /** Spawns that missed every pool. */
+    int32 TotalPoolMisses;
+
+    /** Pooling settings from developer settings, read at world init. */
+    bool bIsActorPoolingEnabled;
+    int32 PoolPrewarmCount;
+    int32 PoolMaxSize;
+
+    /** True while pools still need to be filled up to the prewarm count. */
+    bool bIsPoolPrewarmPending;
+
+    /** True while prewarm spawns are running. Registration is skipped for those actors. */
+    bool bIsPrewarmingPool;
+
+    /** Handle of the world actor destroyed callback. */
+    FDelegateHandle ActorDestroyedHandle;
+
+    /** Handle of the post garbage collection callback. */
+    FDelegateHandle PostGarbageCollectHandle;
+
+    /** Unregisters interactive components of an actor that is being destroyed. */
+    void HandleActorDestroyed(AActor* DestroyedActor);
+
+    /** Schedules an incremental sweep, collected components may have left stale records behind. */
+    void HandlePostGarbageCollect();
+
+    /** Removes up to MaxRecords records whose component is no longer valid. Continues where the last call stopped. */
+    void SweepInvalidRecords(int32 MaxRecords);
+
+    /** Adds Record to the journal unless undo or redo is replaying it. */
+    void AddJournalRecord(FInteractiveObjectJournalRecord&& Record);
+
+    /**
+     * Returns the log class index of ObjectClass, defining the class in the log on first use. Returns 0 while the log is closed.
+     * Called when objects register, so that logging their spawn only finds the index.
+     */
+    uint16 FindOrAddWriteAheadLogClass(const UClass* ObjectClass);
+
+    /** Journals and logs a color change of the object at Handle. */
+    void RecordColorChange(FInteractiveObjectHandle Handle, const FLinearColor& PreviousColor, const FLinearColor& NewColor);
+
+    /** Journals and logs a scale change of the object at Handle. */
+    void RecordScaleChange(FInteractiveObjectHandle Handle, float PreviousScale, float NewScale);
+
+    /** Journals and logs the spawn or deletion of the object at Handle. Runs while the object is registered. */
+    void RecordSpawnOrDelete(EInteractiveObjectJournalOp Op, FInteractiveObjectHandle Handle, const FLinearColor& Color, float UniformScale);
+
+    /** Replays undo or redo records in the given order. Returns the number of records applied. */
+    int32 ApplyJournalRecords(const TArray<FInteractiveObjectJournalRecord>& Records, bool bIsUndo);
+
+    /**
+     * Replays the write-ahead log on the records of the default scene file and queues the result as a budgeted
+     * scene restore replacing the registered objects. Runs once, when the world starts in WAL mode.
+     */
+    void RecoverFromWriteAheadLog();
+
+    /** Checkpoints the default scene and opens a fresh log once the recovery batch finished or was cancelled. */
+    void FinishWriteAheadRecovery(int32 RestoredCount);
+
+    /** Opens a fresh write-ahead log next to the default scene, continuing Checkpoint. */
+    bool OpenWriteAheadLog(uint64 Checkpoint);
+
+    /** Writes every registered object to a scene file stamped with Checkpoint. */
+    bool WriteSceneFile(const FString& FilePath, uint64 Checkpoint);
+
+    /** Queues a spawn batch restoring the objects of SceneFile. SourceName is only used for logging. */
+    int32 QueueSceneRestore(const TSharedPtr<const FInteractiveObjectSceneFile, ESPMode::ThreadSafe>& SceneFile, const FString& SourceName, bool bReplaceExisting, float FrameBudgetMilliseconds, double StartTime);
+
+    /** Fills the scene record of the object at a dense index, placed at ObjectTransform. */
+    void FillSceneRecord(int32 DenseIndex, const FTransform& ObjectTransform, uint16 ClassIndex, FInteractiveObjectSceneRecord& OutRecord) const;
+
+    /**
+     * Appends an event for a call to the recording and returns it for the caller to fill in.
+     * Returns nullptr while not recording, or inside another traced call.
+     */
+    FInteractiveObjectTraceEvent* TraceCall(EInteractiveObjectTraceOp Op);
+
+    /** Trace index of a recorded object, INDEX_NONE if Handle is stale. */
+    int32 GetTraceObjectIndex(FInteractiveObjectHandle Handle) const;
+
+    /** Restores the initial state of a replay once classes are loaded, then executes the events that are due. */
+    void ProcessTraceReplay();
+
+    /** Repeats one recorded call. */
+    void ExecuteTraceEvent(const FInteractiveObjectTraceEvent& Event);
+
+    /** Replayed handle of a trace index. */
+    FInteractiveObjectHandle GetReplayHandle(int32 TraceIndex) const;
+
+    /** Logs the replay statistics and ends the replay. */
+    void FinishTraceReplay();
+
+    /** Flags the object at a dense index for the next checkpoint. */
+    void MarkCheckpointDirty(int32 DenseIndex);
+
+    /** Collects a finished checkpoint write, starts the periodic checkpoint and serializes the next slice. */
+    void ProcessCheckpoint();
+
+    /** Logs and keeps the result of the checkpoint write task once it completed. */
+    void CollectCheckpointWrite();
+
+    /** Adds the object at a dense index to the active checkpoint and clears its dirty flag. */
+    void SerializeCheckpointObject(int32 DenseIndex);
+
+    /** Hands the serialized checkpoint to a background task for compression and writing. */
+    void FinishCheckpoint();
+
+    /** Loads a class listed in a scene file or log and keeps it referenced. Returns nullptr and warns if it cannot be loaded. */
+    UClass* LoadSceneClass(const FString& ClassPath);
+
+    /** Deletes every registered object as one journal batch. */
+    void DeleteAllObjects();
+
+    /** Runs queued commands, up to the IOM.Commands.MaxPerFrame budget. */
+    void ExecuteQueuedCommands();
+
+    /** Spawns objects from the queued batches until the front batch frame budget is used up. */
+    void ProcessPendingSpawnBatches();
+
+    /** Starts streaming all primitive classes from developer settings. */
+    void RequestPrimitiveClassesLoad();
+
+    /** Stores hard references to the streamed classes and releases queued spawns. */
+    void HandlePrimitiveClassesLoaded();
+
+    /** Spawns the next object of a scene restoring batch. */
+    FInteractiveObjectHandle SpawnSceneObject(const FPendingSpawnBatch& Batch);
+
+    /** Spawns the object of a scene record. Classes is the loaded scene file class table. */
+    FInteractiveObjectHandle SpawnSceneRecord(const FInteractiveObjectSceneRecord& Record, const TArray<UClass*>& Classes);
+
+    /** Resolves the actor class for a spawn type from the preloaded classes. Random picks per call. */
+    UClass* ResolveSpawnClass(EInteractiveObjectSpawnType SpawnType) const;
+
+    /** Picks a random location inside the spawn disc described by Params. */
+    FVector ComputeRandomSpawnLocation(const FInteractiveObjectBatchSpawnParams& Params) const;
+
+    /**
+     * Spawns one object of ClassToSpawn as an instance or an actor, depending on the rendering mode,
+     * and journals the spawn. Returns the handle of the new object, unset on failure.
+     */
+    FInteractiveObjectHandle SpawnInteractiveObject(UClass* ClassToSpawn, const FVector& SpawnLocation, const FLinearColor& Color, float UniformScale, const FQuat& SpawnRotation = FQuat::Identity);
+
+    /** Spawns or reuses one actor and applies color and scale through its interactive component. */
+    AActor* SpawnInteractiveActor(UClass* ClassToSpawn, const FVector& SpawnLocation, const FLinearColor& Color, float UniformScale, const FQuat& SpawnRotation);
+
+    /** Returns the batch drawing ObjectClass, creating it on first use. INDEX_NONE if the class is drawn as actors. */
+    int32 FindOrAddInstanceBatch(UClass* ObjectClass);
+
+    /** Adds an instance to a batch and registers the object it draws. */
+    FInteractiveObjectHandle SpawnInstancedObject(int32 BatchIndex, const FVector& SpawnLocation, const FLinearColor& Color, float UniformScale, const FQuat& SpawnRotation);
+
+    /** Removes the instance of the object at a dense index and moves the last instance of its batch into its index. */
+    void RemoveObjectInstance(int32 DenseIndex);
+
+    /** Pushes a color to the instance or the component of the object at a dense index without storing it. */
+    void UpdateObjectColor(int32 DenseIndex, const FLinearColor& NewColor);
+
+    /** Pushes a uniform scale to the instance or the component of the object at a dense index without storing it. */
+    void UpdateObjectScale(int32 DenseIndex, float NewScale);
+
+    /** Class and world transform of the object at a dense index. Returns false if its actor or instance is gone. */
+    bool GetObjectClassAndTransform(int32 DenseIndex, UClass*& OutClass, FTransform& OutTransform) const;
+
+    /** Pops a valid parked actor of the class and moves it to the spawn transform. Returns nullptr on a pool miss. */
+    AActor* AcquirePooledActor(UClass* ActorClass, const FVector& SpawnLocation, const FQuat& SpawnRotation);
+
+    /** Parks the actor in the pool of its class. Returns false if pooling is disabled or the pool is full. */
+    bool ReleaseActorToPool(AActor* Actor);
+
+    /** Spawns parked actors for every loaded class until the prewarm count or the frame budget is reached. */
+    void ProcessPoolPrewarm();
+
+    /** Publishes pooled actor count, hit rate and memory to the stat group. */
+    void UpdatePoolStats() const;
+
+    /** Returns the dense index of a live handle, or INDEX_NONE if the handle is stale. */
+    int32 FindDenseIndex(FInteractiveObjectHandle Handle) const;
+
+    FInteractiveObjectRecord* FindRecordByHandle(FInteractiveObjectHandle Handle);
+    const FInteractiveObjectRecord* FindRecordByHandle(FInteractiveObjectHandle Handle) const;
+    FInteractiveObjectRecord* FindRecordById(int32 ObjectId);
+    FInteractiveObjectRecord* FindRecordByComponent(UInteractiveObjectComponent* InteractiveComponent);
+
+    /** Allocates a slot, adds a record to the dense store and both lookup indices. Returns the new handle. */
+    FInteractiveObjectHandle AddRecord(int32 ObjectId, UInteractiveObjectComponent* InteractiveComponent);
+
+    /** Allocates a slot for a filled in record and seeds its columns. Component lookup is left to the caller. */
+    FInteractiveObjectHandle AddRecord(FInteractiveObjectRecord&& NewRecord, const FLinearColor& Color, float UniformScale, EInteractiveObjectPrimitiveType PrimitiveType);
+
+    /** Removes the record at Index with swap-remove, releases its slot and patches the slot of the moved record. */
+    void RemoveRecordAtIndex(int32 Index);
+
+    /** Bytes allocated by the registry: records, columns, slots, selection and lookup indices. */
+    SIZE_T GetRegistryAllocatedSize() const;
+
+    /** Inserts or moves the spatial index entry of the object at a dense index, using its actor or instance bounds. */
+    void UpdateSpatialEntry(int32 DenseIndex);
+
+    /** Strict weak order of two live slots under a sort key. Ties are broken by object Id. */
+    bool IsSlotOrderedBefore(EInteractiveObjectSortKey SortKey, int32 SlotA, int32 SlotB) const;
+
+    /** Sorts all live slots into the index of a key and marks it built. */
+    void RebuildSortIndex(EInteractiveObjectSortKey SortKey);
+
+    /** Inserts a newly registered slot into every built sort index. */
+    void InsertIntoSortIndices(int32 SlotIndex);
+
+    /** Removes a slot from every built sort index. Must run before its record leaves the registry. */
+    void RemoveFromSortIndices(int32 SlotIndex);
+
+    /** Takes a slot out of the index of SortKey before its key changes. Pair with EndSortKeyChange. */
+    void BeginSortKeyChange(EInteractiveObjectSortKey SortKey, int32 SlotIndex);
+
+    /** Puts a slot back into the index of SortKey after its key changed. */
+    void EndSortKeyChange(EInteractiveObjectSortKey SortKey, int32 SlotIndex);
+
+    /** Drops the index of SortKey when a bulk change of ChangeCount objects would cost more than a rebuild. */
+    void PrepareSortIndexForBulkChange(EInteractiveObjectSortKey SortKey, int32 ChangeCount);
+
+    /** Counts an incremental update and drops the index once the rebuild threshold is exceeded. */
+    void CountSortIndexUpdate(FObjectSortIndex& SortIndex);
+
+    /** Drops every sort index. */
+    void ResetSortIndices();
+
+    /** Copies the registry into a snapshot and publishes it if anything changed since the last one. */
+    void PublishSnapshotIfDirty();
+
+    /** Converts slot indices returned by the spatial index into handles. */
+    void AppendHandlesForSlots(const TArray<int32>& SlotIndices, TArray<FInteractiveObjectHandle>& OutHandles) const;
+
+    /** Publishes registered object count and registry memory to the stat group. */
+    void UpdateRegistryStats() const;
+
+    /** Classifies an actor class against the preloaded primitive classes. */
+    EInteractiveObjectPrimitiveType ResolvePrimitiveType(const UClass* ObjectClass) const;
+
+    /** Returns the runtime Id of the selected object, or INDEX_NONE. */
+    int32 GetSelectedObjectId() const;
+
+    /** Sets or clears the selection bit of a slot and keeps SelectedObjectCount in sync. */
+    void SetSlotSelected(int32 SlotIndex, bool bSelected);
+
+    /** Clears all selection bits and the primary selection. Does not mark the selection dirty. */
+    void ResetSelectionSet();
+
+    /** Makes the lowest selected slot the primary selection, or clears it when nothing is selected. */
+    void PromotePrimarySelection();
+
+    /** Returns the current handle of a live slot. */
+    FInteractiveObjectHandle MakeHandleForSlot(int32 SlotIndex) const;
+
+    /** Returns the handle of the object at a dense index. */
+    FInteractiveObjectHandle GetHandleAtDenseIndex(int32 DenseIndex) const;
+
+    void InvalidateSelectionIfNoLongerValid();
+
+    /** Records an added object for the next delta. */
+    void MarkObjectAdded(int32 ObjectId);
+
+    /** Records a removed object for the next delta. Cancels out a pending add of the same object. */
+    void MarkObjectRemoved(int32 ObjectId);
+
+    /** Records a changed object for the next delta. Ignored for objects that are pending as added. */
+    void MarkObjectChanged(int32 ObjectId);
+
+    /** Fills a list item from the object at a dense index. */
+    void FillListItem(int32 DenseIndex, FInteractiveObjectListItem& OutItem) const;
+
+    /** Marks the selection as changed. The broadcast happens on the next flush. */
+    void MarkSelectionDirty();
+
+    void BroadcastObjectsListChanged();
+    void BroadcastObjectsListDelta();
+    void BroadcastSelectedObjectChanged();
 };
\ No newline at end of file
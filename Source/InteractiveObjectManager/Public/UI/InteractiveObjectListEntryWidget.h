@@ -0,0 +1,53 @@
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "Blueprint/IUserObjectListEntry.h"
+#include "Blueprint/UserWidget.h"
+#include "Subsystems/InteractiveObjectManagerSubsystem.h"
+#include "InteractiveObjectListEntryWidget.generated.h"
+
+class UInteractiveObjectManagerRootWidget;
+
+/**
+ * Item of the objects list view. One per registered object, owned by the root widget.
+ *
+ * Holds the latest list data of its object. The list view creates entry widgets only for visible
+ * items and hands them these objects as they scroll into view.
+ */
+UCLASS(BlueprintType)
+class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectListItemObject : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+    FInteractiveObjectListItem Item;
+
+    /** Root widget the entry forwards clicks to. */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager")
+    TObjectPtr<UInteractiveObjectManagerRootWidget> OwningRoot;
+};
+
+/**
+ * Base class for entry widgets of the objects list view.
+ *
+ * The entry class set on ListView_Objects must derive from this class. Entries are recycled while
+ * scrolling, so a Blueprint entry fills itself in OnObjectListItemSet instead of on construction.
+ */
+UCLASS(Abstract, Blueprintable)
+class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectListEntryWidget : public UUserWidget, public IUserObjectListEntry
+{
+    GENERATED_BODY()
+
+public:
+    /** Calls OnObjectListItemSet with the current data of the item this entry shows. */
+    void RefreshFromListItem();
+
+protected:
+    virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+
+    /** Called when the entry is assigned an item, and again when the data of that item changes. */
+    UFUNCTION(BlueprintImplementableEvent, Category = "InteractiveObjectManager")
+    void OnObjectListItemSet(const FInteractiveObjectListItem& Item, UInteractiveObjectManagerRootWidget* OwningRoot);
+};
@@ -1,126 +1,208 @@
-// Copyright  2025 Vladyslav Popushoi. All rights reserved.
-
-#pragma once
-
-#include "CommonActivatableWidget.h"
-#include "InteractiveObjectManagerTypes.h"
-#include "InteractiveObjectManagerRootWidget.generated.h"
-
-class UInteractiveObjectManagerSubsystem;
-struct FInteractiveObjectSettingsViewData;
-
-/**
- * Root CommonUI widget for the Interactive Object Manager demo.
- *
- * Responsibilities:
- * - Connects to UInteractiveObjectManagerSubsystem.
- * - Listens for list and selection changes.
- * - Bridges subsystem data to Blueprint via events and simple request functions.
- */
-UCLASS(Abstract, BlueprintType, Blueprintable)
-class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectManagerRootWidget : public UCommonActivatableWidget
-{
-    GENERATED_BODY()
-
-public:
-    UInteractiveObjectManagerRootWidget();
-
-    /**
-     * Called from Main tab when user presses Spawn (default) button.
-     * Asks the manager subsystem to spawn an object using default settings.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void RequestSpawnDefaultObject();
-
-    /**
-     * Called from Main tab when user presses Spawn Cube or Spawn Sphere buttons.
-     * Asks the manager subsystem to spawn an object of the given primitive type.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void RequestSpawnObjectOfType(EInteractiveObjectSpawnType SpawnType);
-
-    /**
-     * Called from list entry widgets when user clicks an object in the list.
-     * Forwards selection request to the manager subsystem.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void RequestSelectObjectById(int32 ObjectId);
-
-    /**
-     * Called from Main tab when user presses Apply color button.
-     * Forwards color request to the manager subsystem for the currently selected object.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void RequestApplyColor(const FLinearColor& NewColor);
-
-    /**
-     * Called from Main tab when user presses Apply scale button.
-     * Forwards uniform scale request to the manager subsystem for the currently selected object.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void RequestApplyScale(float NewUniformScale);
-
-    /**
-     * Called from Main tab when user presses Delete selected button.
-     * Asks the manager subsystem to delete the currently selected object.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
-    void RequestDeleteSelectedObject();
-
-    /**
-     * Called from Settings tab when it is activated or needs to refresh values.
-     * Fills OutSettings with the current runtime settings for UI.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
-    void GetCurrentSettings(FInteractiveObjectSettingsViewData& OutSettings);
-
-    /**
-     * Called from Settings tab when user presses Apply or Save.
-     * Updates runtime settings from UI values without touching the ini file.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
-    void ApplySettingsFromUI(const FInteractiveObjectSettingsViewData& NewSettings);
-
-    /**
-     * Called from Settings tab when user presses Save.
-     * Saves current validated runtime settings to the ini file.
-     */
-    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
-    void SaveSettingsToIni();
-
-protected:
-    // We use Construct/Destruct instead of OnActivated/OnDeactivated,
-    // because CommonUI activation requires CommonGameViewportClient,
-    // which is not configured in this demo project.
-    virtual void NativeConstruct() override;
-    virtual void NativeDestruct() override;
-
-    /**
-     * Called whenever the list of interactive objects changes.
-     * Blueprint is expected to rebuild the visual list (ScrollBox/ListView) from this data.
-     */
-    UFUNCTION(BlueprintImplementableEvent, Category = "InteractiveObjectManager")
-    void OnObjectsListUpdated(const TArray<FInteractiveObjectListItem>& Objects);
-
-    /**
-     * Called whenever current selection changes.
-     * If bHasSelection is false, SelectedObjectId will be INDEX_NONE and SelectedDisplayName can be "None".
-     */
-    UFUNCTION(BlueprintImplementableEvent, Category = "InteractiveObjectManager")
-    void OnSelectedObjectInfoUpdated(bool bHasSelection, int32 SelectedObjectId, const FText& SelectedDisplayName);
-
-private:
-    /** Cached pointer to the world subsystem. */
-    TWeakObjectPtr<UInteractiveObjectManagerSubsystem> ManagerSubsystem;
-
-    /** Delegate handler for list changes. */
-    UFUNCTION()
-    void HandleObjectsListChanged(const TArray<FInteractiveObjectListItem>& Objects);
-
-    /** Delegate handler for selection changes. */
-    UFUNCTION()
-    void HandleSelectedObjectChanged(int32 SelectedObjectId);
-
-    /** Performs an initial sync from the subsystem when the widget is constructed. */
-    void SynchronizeInitialState();
+// Copyright © 2025 Vladyslav Popushoi. All rights reserved.
+
+#pragma once
+
+#include "CommonActivatableWidget.h"
+#include "InteractiveObjectManagerTypes.h"
+#include "InteractiveObjectManagerRootWidget.generated.h"
+
+class UInteractiveObjectListItemObject;
+class UInteractiveObjectManagerSubsystem;
+class UListView;
+struct FInteractiveObjectSettingsViewData;
+struct FInteractiveObjectsListDelta;
+
+/**
+ * Root CommonUI widget for the Interactive Object Manager demo.
+ *
+ * Responsibilities:
+ * - Connects to UInteractiveObjectManagerSubsystem.
+ * - Listens for list and selection changes.
+ * - Applies list deltas item by item: to the bound ListView_Objects list view, which only creates
+ *   entries for visible rows, otherwise through the row events when the Blueprint implements them.
+ *   Without either the whole list is rebuilt through OnObjectsListUpdated.
+ * - Bridges subsystem data to Blueprint via events and simple request functions.
+ */
+UCLASS(Abstract, BlueprintType, Blueprintable)
+class INTERACTIVEOBJECTMANAGER_API UInteractiveObjectManagerRootWidget : public UCommonActivatableWidget
+{
+    GENERATED_BODY()
+
+public:
+    UInteractiveObjectManagerRootWidget();
+
+    /**
+     * Called from Main tab when user presses Spawn (default) button.
+     * Asks the manager subsystem to spawn an object using default settings.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestSpawnDefaultObject();
+
+    /**
+     * Called from Main tab when user presses Spawn Cube or Spawn Sphere buttons.
+     * Asks the manager subsystem to spawn an object of the given primitive type.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestSpawnObjectOfType(EInteractiveObjectSpawnType SpawnType);
+
+    /**
+     * Called from list entry widgets when user clicks an object in the list.
+     * Forwards selection request to the manager subsystem.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestSelectObjectById(int32 ObjectId);
+
+    /**
+     * Called from list entry widgets that store the object handle of their row.
+     * Forwards selection request to the manager subsystem. Stale handles are ignored.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestSelectObject(FInteractiveObjectHandle Handle);
+
+    /**
+     * Called from list entry widgets on a modifier click (for example Ctrl + click).
+     * Adds the object to the selection or removes it from there.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestToggleObjectSelection(FInteractiveObjectHandle Handle);
+
+    /** Called from Main tab when user presses Select all. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestSelectAllObjects();
+
+    /** Called from Main tab when user presses Clear selection. */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestClearSelection();
+
+    /** Lets list entry widgets highlight rows that are part of the selection. */
+    UFUNCTION(BlueprintPure, Category = "InteractiveObjectManager")
+    bool IsObjectSelected(FInteractiveObjectHandle Handle) const;
+
+    /**
+     * Called from Main tab when user presses Apply color button.
+     * Forwards color request to the manager subsystem for all selected objects.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestApplyColor(const FLinearColor& NewColor);
+
+    /**
+     * Called from Main tab when user presses Apply scale button.
+     * Forwards uniform scale request to the manager subsystem for all selected objects.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestApplyScale(float NewUniformScale);
+
+    /**
+     * Called from Main tab when user presses Delete selected button.
+     * Asks the manager subsystem to delete all selected objects.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager")
+    void RequestDeleteSelectedObject();
+
+    /**
+     * Called from Settings tab when it is activated or needs to refresh values.
+     * Fills OutSettings with the current runtime settings for UI.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
+    void GetCurrentSettings(FInteractiveObjectSettingsViewData& OutSettings);
+
+    /**
+     * Called from Settings tab when user presses Apply or Save.
+     * Updates runtime settings from UI values without touching the ini file.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
+    void ApplySettingsFromUI(const FInteractiveObjectSettingsViewData& NewSettings);
+
+    /**
+     * Called from Settings tab when user presses Save.
+     * Saves current validated runtime settings to the ini file.
+     */
+    UFUNCTION(BlueprintCallable, Category = "InteractiveObjectManager|Settings")
+    void SaveSettingsToIni();
+
+protected:
+    // We use Construct/Destruct instead of OnActivated/OnDeactivated,
+    // because CommonUI activation requires CommonGameViewportClient,
+    // which is not configured in this demo project.
+    virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
+
+    /**
+     * Called whenever the list of interactive objects changes.
+     * Blueprint is expected to rebuild the visual list (ScrollBox/ListView) from this data.
+     *
+     * Only used for the initial sync, for resyncs after a missed delta and for
+     * Blueprints that do not implement the row events below.
+     * Not called while ListView_Objects is bound.
+     */
+    UFUNCTION(BlueprintImplementableEvent, Category = "InteractiveObjectManager")
+    void OnObjectsListUpdated(const TArray<FInteractiveObjectListItem>& Objects);
+
+    /** Called with rows that should be appended to the visual list. */
+    UFUNCTION(BlueprintImplementableEvent, Category = "InteractiveObjectManager")
+    void OnObjectRowsAdded(const TArray<FInteractiveObjectListItem>& AddedItems);
+
+    /** Called with Ids of rows that should be removed from the visual list. Unknown Ids can be ignored. */
+    UFUNCTION(BlueprintImplementableEvent, Category = "InteractiveObjectManager")
+    void OnObjectRowsRemoved(const TArray<int32>& RemovedIds);
+
+    /** Called with the latest data of rows that should be refreshed in place. */
+    UFUNCTION(BlueprintImplementableEvent, Category = "InteractiveObjectManager")
+    void OnObjectRowsChanged(const TArray<FInteractiveObjectListItem>& ChangedItems);
+
+    /**
+     * Called whenever current selection changes.
+     * If bHasSelection is false, SelectedObjectId will be INDEX_NONE and SelectedDisplayName can be "None".
+     */
+    UFUNCTION(BlueprintImplementableEvent, Category = "InteractiveObjectManager")
+    void OnSelectedObjectInfoUpdated(bool bHasSelection, int32 SelectedObjectId, const FText& SelectedDisplayName);
+
+    /**
+     * Called whenever the selection set changes, after OnSelectedObjectInfoUpdated.
+     * Rows can refresh their highlight through IsObjectSelected.
+     */
+    UFUNCTION(BlueprintImplementableEvent, Category = "InteractiveObjectManager")
+    void OnSelectionSetUpdated(int32 SelectedCount);
+
+    /**
+     * List view showing the objects. Optional. When bound, it takes precedence over the row events and
+     * OnObjectsListUpdated. Its entry class must derive from UInteractiveObjectListEntryWidget.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "InteractiveObjectManager", meta = (BindWidgetOptional))
+    TObjectPtr<UListView> ListView_Objects;
+
+private:
+    /** Cached pointer to the world subsystem. */
+    TWeakObjectPtr<UInteractiveObjectManagerSubsystem> ManagerSubsystem;
+
+    /** Last list version applied to the visual list. Used to detect missed deltas. */
+    int64 AppliedObjectsListVersion;
+
+    /** True when the Blueprint implements the row events and can apply deltas in place. */
+    bool bUsesIncrementalListUpdates;
+
+    /** Items of ListView_Objects by object Id. */
+    UPROPERTY(Transient)
+    TMap<int32, TObjectPtr<UInteractiveObjectListItemObject>> ObjectListItems;
+
+    /** Delegate handler for list deltas. */
+    UFUNCTION()
+    void HandleObjectsListDelta(const FInteractiveObjectsListDelta& Delta);
+
+    /** Rebuilds the whole visual list from a fresh subsystem snapshot. */
+    void RebuildObjectsList();
+
+    /** Creates the list view item of Item and indexes it by Id. Does not add it to ListView_Objects. */
+    UInteractiveObjectListItemObject* CreateObjectListItem(const FInteractiveObjectListItem& Item);
+
+    /** Delegate handler for selection changes. */
+    UFUNCTION()
+    void HandleSelectedObjectChanged(int32 SelectedObjectId);
+
+    /** Delegate handler for selection set changes. */
+    UFUNCTION()
+    void HandleSelectionChanged(int32 SelectedCount);
+
+    /** Performs an initial sync from the subsystem when the widget is constructed. */
+    void SynchronizeInitialState();
 };
\ No newline at end of file